@@ -9,15 +9,21 @@ let package = Package(
         .library(name: "PLzmaSDK-Static", type: .static, targets: ["PLzmaSDK"]),
         .library(name: "PLzmaSDK-Dynamic", type: .dynamic, targets: ["PLzmaSDK"])
     ],
+    traits: [
+        .trait(name: "Multithread",
+               description: "Build multithreaded encoders/decoders of the original LZMA SDK.")
+    ],
     targets: [
         .target(name: "libplzma",
                 path: "src",
                 cSettings: [
                     .define("LIBPLZMA_VERSION_BUILD", to: "1448"),
+                    .define("LIBPLZMA_MULTITHREAD", to: "1", .when(traits: ["Multithread"])),
                     .unsafeFlags(["-fPIC"])
                 ],
                 cxxSettings: [
                     .define("LIBPLZMA_VERSION_BUILD", to: "1448"),
+                    .define("LIBPLZMA_MULTITHREAD", to: "1", .when(traits: ["Multithread"])),
                     .unsafeFlags(["-fPIC", "-fno-rtti"])
                 ]),
         .target(name: "PLzmaSDK",
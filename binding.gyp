@@ -1,4 +1,7 @@
 {
+  'variables': {
+    'plzma_multithread%': 0
+  },
   'targets': [
     {
       'target_name': 'plzmasdk',
@@ -35,6 +38,7 @@
         'src/C/LzmaDec.c',
         'src/C/LzmaEnc.c',
         'src/C/MtCoder.c',
+        'src/C/MtDec.c',
         'src/C/Ppmd7.c',
         'src/C/Ppmd7Dec.c',
         'src/C/Ppmd7Enc.c',
@@ -91,6 +95,7 @@
         'src/CPP/7zip/Common/OutBuffer.cpp',
         'src/CPP/7zip/Common/ProgressUtils.cpp',
         'src/CPP/7zip/Common/PropId.cpp',
+        'src/CPP/7zip/Common/StreamBinder.cpp',
         'src/CPP/7zip/Common/StreamObjects.cpp',
         'src/CPP/7zip/Common/StreamUtils.cpp',
         'src/CPP/7zip/Common/UniqBlocks.cpp',
@@ -144,20 +149,24 @@
         'src/CPP/Windows/TimeUtils.cpp',
         'src/plzma.cpp',
         'src/plzma_base_callback.cpp',
+        'src/plzma_block_cache.cpp',
         'src/plzma_common.cpp',
         'src/plzma_decoder_impl.cpp',
+        'src/plzma_dir_scanner.cpp',
         'src/plzma_encoder_impl.cpp',
         'src/plzma_exception.cpp',
         'src/plzma_extract_callback.cpp',
         'src/plzma_file_utils.cpp',
         'src/plzma_in_streams.cpp',
         'src/plzma_item.cpp',
+        'src/plzma_item_table.cpp',
         'src/plzma_open_callback.cpp',
         'src/plzma_out_streams.cpp',
         'src/plzma_path.cpp',
         'src/plzma_path_utils.cpp',
         'src/plzma_progress.cpp',
         'src/plzma_raw_heap_memory.cpp',
+        'src/plzma_stats.cpp',
         'src/plzma_string.cpp',
         'src/plzma_update_callback.cpp'
       ],
@@ -165,6 +174,9 @@
       'cflags_cc!': [ '-fno-exceptions' ],
       'cflags_cc': [ '-fno-rtti' ],
       'conditions': [
+        ['plzma_multithread==1', {
+          'defines': [ 'LIBPLZMA_MULTITHREAD=1' ]
+        }],
         ['OS=="mac"', {
           'xcode_settings': {
             'GCC_ENABLE_CPP_EXCEPTIONS': 'YES',
@@ -0,0 +1,587 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// The encode/decode throughput benchmark.
+//
+// Generates the synthetic corpora in memory, encodes each of them to 7z, xz and tar archives
+// with the requested methods and levels, decodes the archives back and reports the results in JSON.
+// If the library uses the optimized LZMA decoder kernel, the LZMA/LZMA2 archives are also decoded
+// with the portable C kernel, see 'decode_portable_*' results.
+// The 'solid-scaling' extracts the N and 8 * N small items of the solid 7z archive, the time must grow linearly,
+// see 'solid_scaling' results.
+//
+// Usage: libplzma_bench [--scale <factor>] [--levels <1,5,9>] [--threads <number>]
+//                       [--corpora <text,random,small-files,huge-file,solid-scaling>] [--types <7z,xz,tar>]
+//                       [--methods <LZMA,LZMA2,PPMd>] [--output <path>]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <libplzma.hpp>
+#include <libplzma.h>
+
+#if defined(LIBPLZMA_OS_WINDOWS)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace plzma;
+
+struct BenchItem final {
+    std::string name;
+    std::vector<uint8_t> content;
+};
+
+struct BenchCorpus final {
+    std::string name;
+    std::vector<BenchItem> items;
+    uint64_t size = 0;
+    uint64_t checksum = 0;
+};
+
+struct BenchOptions final {
+    double scale = 1.0;
+    uint32_t threads = 0;
+    std::vector<std::string> levels{"1", "5", "9"};
+    std::vector<std::string> corpora{"text", "random", "small-files", "huge-file", "solid-scaling"};
+    std::vector<std::string> types{"7z", "xz", "tar"};
+    std::vector<std::string> methods{"LZMA", "LZMA2", "PPMd"};
+    const char * output = nullptr;
+};
+
+static void bench_free_callback(void * LIBPLZMA_NULLABLE memory) {
+    // the content is owned by the corpus
+}
+
+static uint64_t bench_peak_rss() {
+#if defined(LIBPLZMA_OS_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    memset(&counters, 0, sizeof(counters));
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    memset(&usage, 0, sizeof(usage));
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss); // bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+#endif
+}
+
+static std::vector<std::string> bench_split(const char * list) {
+    std::vector<std::string> values;
+    std::string value;
+    for (const char * c = list; *c; c++) {
+        if (*c == ',') {
+            if (!value.empty()) {
+                values.push_back(value);
+            }
+            value.clear();
+        } else {
+            value.push_back(*c);
+        }
+    }
+    if (!value.empty()) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+static std::string bench_json_escape(const char * value) {
+    std::string escaped;
+    char buff[8];
+    for (const char * c = value; c && *c; c++) {
+        switch (*c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    snprintf(buff, sizeof(buff), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+                    escaped += buff;
+                } else {
+                    escaped.push_back(*c);
+                }
+                break;
+        }
+    }
+    return escaped;
+}
+
+// The order independent checksum, the extracted items might be ordered differently than added.
+static uint64_t bench_checksum(const uint8_t * content, const size_t size) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sum += content[i];
+    }
+    return sum;
+}
+
+static bool bench_contains(const std::vector<std::string> & values, const char * value) {
+    for (const auto & v : values) {
+        if (v == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t bench_next_random(uint32_t & seed) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+static void bench_fill_text(std::vector<uint8_t> & content, const size_t size, uint32_t seed) {
+    static const char * const words[] = {
+        "the", "of", "and", "archive", "stream", "block", "encoder", "decoder", "item", "path",
+        "memory", "solid", "dictionary", "filter", "progress", "thread", "compress", "extract",
+        "size", "content", "header", "method", "level", "match", "finder", "literal", "position"
+    };
+    static const size_t wordsCount = sizeof(words) / sizeof(words[0]);
+    content.clear();
+    content.reserve(size);
+    size_t lineLength = 0;
+    while (content.size() < size) {
+        const char * word = words[bench_next_random(seed) % wordsCount];
+        for (const char * c = word; *c && content.size() < size; c++) {
+            content.push_back(static_cast<uint8_t>(*c));
+        }
+        lineLength += strlen(word) + 1;
+        if (content.size() < size) {
+            if (lineLength > 72) {
+                content.push_back('\n');
+                lineLength = 0;
+            } else {
+                content.push_back(' ');
+            }
+        }
+    }
+}
+
+static void bench_fill_random(std::vector<uint8_t> & content, const size_t size, uint32_t seed) {
+    content.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<uint8_t>(bench_next_random(seed));
+    }
+}
+
+static std::vector<BenchCorpus> bench_make_corpora(const BenchOptions & options) {
+    std::vector<BenchCorpus> corpora;
+    const double scale = options.scale;
+    if (bench_contains(options.corpora, "text")) {
+        BenchCorpus corpus;
+        corpus.name = "text";
+        corpus.items.resize(1);
+        corpus.items[0].name = "text.txt";
+        bench_fill_text(corpus.items[0].content, static_cast<size_t>(8.0 * 1024 * 1024 * scale), 1);
+        corpora.push_back(std::move(corpus));
+    }
+    if (bench_contains(options.corpora, "random")) {
+        BenchCorpus corpus;
+        corpus.name = "random";
+        corpus.items.resize(1);
+        corpus.items[0].name = "random.bin";
+        bench_fill_random(corpus.items[0].content, static_cast<size_t>(8.0 * 1024 * 1024 * scale), 2);
+        corpora.push_back(std::move(corpus));
+    }
+    if (bench_contains(options.corpora, "small-files")) {
+        BenchCorpus corpus;
+        corpus.name = "small-files";
+        const size_t itemsCount = static_cast<size_t>(2048.0 * scale);
+        corpus.items.resize(itemsCount > 0 ? itemsCount : 1);
+        uint32_t seed = 3;
+        char name[64];
+        for (size_t i = 0; i < corpus.items.size(); i++) {
+            snprintf(name, sizeof(name), "dir%u/file%u.txt", static_cast<unsigned>(i % 16), static_cast<unsigned>(i));
+            corpus.items[i].name = name;
+            bench_fill_text(corpus.items[i].content, 512 + (bench_next_random(seed) % 3584), seed);
+        }
+        corpora.push_back(std::move(corpus));
+    }
+    if (bench_contains(options.corpora, "huge-file")) {
+        BenchCorpus corpus;
+        corpus.name = "huge-file";
+        corpus.items.resize(1);
+        corpus.items[0].name = "huge.bin";
+        // Text with the random islands, the mix of the compressible and incompressible content.
+        std::vector<uint8_t> & content = corpus.items[0].content;
+        bench_fill_text(content, static_cast<size_t>(64.0 * 1024 * 1024 * scale), 4);
+        uint32_t seed = 5;
+        for (size_t offset = 0; (offset + 64 * 1024) <= content.size(); offset += 1024 * 1024) {
+            for (size_t i = 0; i < 64 * 1024; i++) {
+                content[offset + i] = static_cast<uint8_t>(bench_next_random(seed));
+            }
+        }
+        corpora.push_back(std::move(corpus));
+    }
+    for (auto & corpus : corpora) {
+        for (const auto & item : corpus.items) {
+            corpus.size += item.content.size();
+            corpus.checksum += bench_checksum(item.content.data(), item.content.size());
+        }
+    }
+    return corpora;
+}
+
+static const char * bench_type_name(const plzma_file_type type) {
+    switch (type) {
+        case plzma_file_type_7z: return "7z";
+        case plzma_file_type_xz: return "xz";
+        case plzma_file_type_tar: return "tar";
+        default: break;
+    }
+    return "unknown";
+}
+
+static const char * bench_method_name(const plzma_method method) {
+    switch (method) {
+        case plzma_method_LZMA: return "LZMA";
+        case plzma_method_LZMA2: return "LZMA2";
+        case plzma_method_PPMd: return "PPMd";
+        default: break;
+    }
+    return "unknown";
+}
+
+static double bench_per_second(const double value, const double seconds) {
+    return (seconds > 0.0) ? (value / seconds) : 0.0;
+}
+
+// Decodes the archive to the arena and returns the decoding time in seconds or the negative value on error.
+static double bench_decode(const RawHeapMemorySize & archiveContent,
+                           const plzma_file_type type,
+                           const BenchCorpus & corpus,
+                           const BenchOptions & options) {
+    auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, &bench_free_callback), type);
+    decoder->setNumberOfThreads(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    if (!decoder->open()) {
+        return -1.0;
+    }
+    auto items = decoder->items();
+    if (!decoder->extractToArena(items)) {
+        return -1.0;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (decoder->arenaSize() != corpus.size ||
+        bench_checksum(static_cast<const uint8_t *>(decoder->arena()), static_cast<size_t>(decoder->arenaSize())) != corpus.checksum) {
+        return -1.0;
+    }
+    return seconds;
+}
+
+static bool bench_run(const BenchCorpus & corpus,
+                      const plzma_file_type type,
+                      const plzma_method method,
+                      const uint8_t level,
+                      const BenchOptions & options,
+                      std::string & json) {
+    auto archiveStream = makeSharedOutStream(corpus.size);
+    auto encoder = makeSharedEncoder(archiveStream, type, method);
+    encoder->setNumberOfThreads(options.threads);
+    if (type != plzma_file_type_tar) {
+        encoder->setCompressionLevel(level);
+    }
+    for (const auto & item : corpus.items) {
+        void * memory = const_cast<uint8_t *>(item.content.data());
+        if (item.content.empty()) {
+            continue;
+        }
+        encoder->add(makeSharedInStream(memory, item.content.size(), &bench_free_callback), Path(item.name.c_str()));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!encoder->open() || !encoder->compress()) {
+        return false;
+    }
+    const double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto archiveContent = archiveStream->copyContent();
+    archiveStream->erase();
+
+    const double decodeSeconds = bench_decode(archiveContent, type, corpus, options);
+    if (decodeSeconds < 0.0) {
+        return false;
+    }
+    const double sizeMB = static_cast<double>(corpus.size) / (1024.0 * 1024.0);
+    const double itemsCount = static_cast<double>(corpus.items.size());
+    char buff[1024];
+
+    // The LZMA/LZMA2 content is also decoded with the portable C kernel for comparison.
+    std::string portable;
+    if (type != plzma_file_type_tar && method != plzma_method_PPMd && plzma_lzma_decoder_optimized()) {
+        plzma_set_lzma_decoder_optimized(false);
+        const double portableSeconds = bench_decode(archiveContent, type, corpus, options);
+        plzma_set_lzma_decoder_optimized(true);
+        if (portableSeconds < 0.0) {
+            return false;
+        }
+        snprintf(buff, sizeof(buff), ", \"decode_portable_seconds\": %.6f, \"decode_portable_mb_per_sec\": %.3f",
+                 portableSeconds, bench_per_second(sizeMB, portableSeconds));
+        portable = buff;
+        fprintf(stderr, "%s %s %s level %u: decode with the portable kernel %.3f sec\n",
+                corpus.name.c_str(), bench_type_name(type), bench_method_name(method), static_cast<unsigned>(level), portableSeconds);
+    }
+
+    snprintf(buff, sizeof(buff),
+             "%s    {\"corpus\": \"%s\", \"type\": \"%s\", \"method\": \"%s\", \"level\": %u, \"items\": %u, "
+             "\"input_size\": %llu, \"compressed_size\": %llu, \"ratio\": %.4f, "
+             "\"encode_seconds\": %.6f, \"encode_mb_per_sec\": %.3f, \"encode_items_per_sec\": %.3f, "
+             "\"decode_seconds\": %.6f, \"decode_mb_per_sec\": %.3f, \"decode_items_per_sec\": %.3f%s, "
+             "\"peak_rss_bytes\": %llu}",
+             json.empty() ? "" : ",\n",
+             corpus.name.c_str(),
+             bench_type_name(type),
+             (type == plzma_file_type_tar) ? "none" : bench_method_name(method),
+             (type == plzma_file_type_tar) ? 0U : static_cast<unsigned>(level),
+             static_cast<unsigned>(corpus.items.size()),
+             static_cast<unsigned long long>(corpus.size),
+             static_cast<unsigned long long>(archiveContent.second),
+             (corpus.size > 0) ? (static_cast<double>(archiveContent.second) / static_cast<double>(corpus.size)) : 0.0,
+             encodeSeconds, bench_per_second(sizeMB, encodeSeconds), bench_per_second(itemsCount, encodeSeconds),
+             decodeSeconds, bench_per_second(sizeMB, decodeSeconds), bench_per_second(itemsCount, decodeSeconds),
+             portable.c_str(),
+             static_cast<unsigned long long>(bench_peak_rss()));
+    json += buff;
+    fprintf(stderr, "%s %s %s level %u: encode %.3f sec, decode %.3f sec\n",
+            corpus.name.c_str(),
+            bench_type_name(type),
+            (type == plzma_file_type_tar) ? "none" : bench_method_name(method),
+            (type == plzma_file_type_tar) ? 0U : static_cast<unsigned>(level),
+            encodeSeconds, decodeSeconds);
+    return true;
+}
+
+// Extracts all items of the solid archive with the small items and returns the extracting time in seconds or the negative value on error.
+static double bench_solid_items_seconds(const size_t itemsCount, const size_t itemSize, const BenchOptions & options) {
+    std::vector<uint8_t> content;
+    bench_fill_text(content, itemsCount * itemSize, static_cast<uint32_t>(itemsCount));
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, plzma_file_type_7z, plzma_method_LZMA2);
+    encoder->setShouldCreateSolidArchive(true);
+    encoder->setCompressionLevel(1);
+    encoder->setNumberOfThreads(options.threads);
+    char name[32];
+    for (size_t i = 0; i < itemsCount; i++) {
+        snprintf(name, sizeof(name), "%u.txt", static_cast<unsigned>(i));
+        encoder->add(makeSharedInStream(content.data() + (i * itemSize), itemSize, &bench_free_callback), Path(name));
+    }
+    if (!encoder->open() || !encoder->compress()) {
+        return -1.0;
+    }
+    const auto archiveContent = archiveStream->copyContent();
+    
+    auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, &bench_free_callback), plzma_file_type_7z);
+    decoder->setNumberOfThreads(options.threads);
+    if (!decoder->open() || decoder->count() != itemsCount) {
+        return -1.0;
+    }
+    auto items = decoder->items();
+    auto itemStreams = makeShared<ItemOutStreamArray>(items->count());
+    for (plzma_size_t i = 0; i < items->count(); i++) {
+        itemStreams->push(ItemOutStreamArray::ElementType(items->at(i), makeSharedOutStream()));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    if (!decoder->extract(itemStreams)) {
+        return -1.0;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t checksum = 0;
+    for (plzma_size_t i = 0; i < itemStreams->count(); i++) {
+        const auto itemContent = itemStreams->at(i).second->copyContent();
+        if (itemContent.second != itemSize) {
+            return -1.0;
+        }
+        checksum += bench_checksum(static_cast<const uint8_t *>(itemContent.first), itemContent.second);
+    }
+    return (checksum == bench_checksum(content.data(), content.size())) ? seconds : -1.0;
+}
+
+// Each solid block is decoded once per extract call, so the time grows linearly with the number of the items.
+static bool bench_solid_scaling(const BenchOptions & options, std::string & json) {
+    size_t itemsCount = static_cast<size_t>(2048.0 * options.scale);
+    itemsCount = (itemsCount > 0) ? itemsCount : 1;
+    const double seconds = bench_solid_items_seconds(itemsCount, 1024, options);
+    const double seconds8 = bench_solid_items_seconds(itemsCount * 8, 1024, options);
+    if (seconds < 0.0 || seconds8 < 0.0) {
+        return false;
+    }
+    char buff[512];
+    snprintf(buff, sizeof(buff),
+             "{\"items\": %u, \"seconds\": %.6f, \"items_8x\": %u, \"seconds_8x\": %.6f, \"growth\": %.3f}",
+             static_cast<unsigned>(itemsCount), seconds, static_cast<unsigned>(itemsCount * 8), seconds8,
+             (seconds > 0.0) ? (seconds8 / seconds) : 0.0);
+    json = buff;
+    fprintf(stderr, "solid-scaling: %u items %.3f sec, %u items %.3f sec\n",
+            static_cast<unsigned>(itemsCount), seconds, static_cast<unsigned>(itemsCount * 8), seconds8);
+    return true;
+}
+
+static bool bench_parse_options(int argc, char * argv[], BenchOptions & options) {
+    for (int i = 1; i < argc; i++) {
+        const char * arg = argv[i];
+        const char * value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--scale") == 0) {
+            options.scale = atof(value);
+            if (options.scale <= 0.0) {
+                return false;
+            }
+        } else if (strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--levels") == 0) {
+            options.levels = bench_split(value);
+        } else if (strcmp(arg, "--corpora") == 0) {
+            options.corpora = bench_split(value);
+        } else if (strcmp(arg, "--types") == 0) {
+            options.types = bench_split(value);
+        } else if (strcmp(arg, "--methods") == 0) {
+            options.methods = bench_split(value);
+        } else if (strcmp(arg, "--output") == 0) {
+            options.output = value;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+int main(int argc, char * argv[]) {
+    BenchOptions options;
+    if (!bench_parse_options(argc, argv, options)) {
+        fprintf(stderr, "Usage: %s [--scale <factor>] [--levels <1,5,9>] [--threads <number>]\n"
+                        "       [--corpora <text,random,small-files,huge-file,solid-scaling>] [--types <7z,xz,tar>]\n"
+                        "       [--methods <LZMA,LZMA2,PPMd>] [--output <path>]\n", argv[0]);
+        return 1;
+    }
+
+    std::string results;
+    std::string corporaJson;
+    std::string solidScaling;
+    try {
+        const auto corpora = bench_make_corpora(options);
+        char buff[256];
+        for (const auto & corpus : corpora) {
+            snprintf(buff, sizeof(buff), "%s    {\"name\": \"%s\", \"items\": %u, \"size\": %llu}",
+                     corporaJson.empty() ? "" : ",\n",
+                     corpus.name.c_str(),
+                     static_cast<unsigned>(corpus.items.size()),
+                     static_cast<unsigned long long>(corpus.size));
+            corporaJson += buff;
+        }
+
+        const plzma_file_type types[] = { plzma_file_type_7z, plzma_file_type_xz, plzma_file_type_tar };
+        const plzma_method methods[] = { plzma_method_LZMA, plzma_method_LZMA2, plzma_method_PPMd };
+        for (const auto & corpus : corpora) {
+            for (const auto type : types) {
+                if (!bench_contains(options.types, bench_type_name(type))) {
+                    continue;
+                } else if (type == plzma_file_type_xz && corpus.items.size() != 1) {
+                    continue; // xz is a single item archive
+                } else if (type == plzma_file_type_tar) {
+                    if (!bench_run(corpus, type, plzma_method_LZMA, 0, options, results)) {
+                        fprintf(stderr, "Failed: %s %s\n", corpus.name.c_str(), bench_type_name(type));
+                        return 2;
+                    }
+                    continue; // the tar content is not compressed
+                }
+                for (const auto method : methods) {
+                    if (!bench_contains(options.methods, bench_method_name(method)) ||
+                        (type == plzma_file_type_xz && method != plzma_method_LZMA2)) {
+                        continue; // xz supports only LZMA2
+                    }
+                    for (const auto & levelString : options.levels) {
+                        const uint8_t level = static_cast<uint8_t>(atoi(levelString.c_str()));
+                        if (!bench_run(corpus, type, method, level, options, results)) {
+                            fprintf(stderr, "Failed: %s %s %s level %u\n",
+                                    corpus.name.c_str(), bench_type_name(type), bench_method_name(method), static_cast<unsigned>(level));
+                            return 2;
+                        }
+                    }
+                }
+            }
+        }
+        if (bench_contains(options.corpora, "solid-scaling") && !bench_solid_scaling(options, solidScaling)) {
+            fprintf(stderr, "Failed: solid-scaling\n");
+            return 2;
+        }
+    } catch (const Exception & exception) {
+        fprintf(stderr, "PLZMA Exception [%i]: %s %s\n", static_cast<int>(exception.code()),
+                exception.what() ? exception.what() : "", exception.reason() ? exception.reason() : "");
+        return 3;
+    }
+
+    std::string json("{\n  \"version\": \"");
+    json += bench_json_escape(plzma_version());
+    char buff[512];
+    const plzma_kernel_t kernels = plzma_kernels();
+    snprintf(buff, sizeof(buff), "\",\n  \"scale\": %.3f,\n  \"threads\": %u,\n  \"lzma_decoder\": \"%s\",\n"
+             "  \"kernels\": { \"crc32\": \"%s\", \"crc64\": \"%s\", \"sha256\": \"%s\", \"aes\": \"%s\" },\n  \"corpora\": [\n",
+             options.scale, static_cast<unsigned>(options.threads), plzma_lzma_decoder_optimized() ? "optimized" : "portable",
+             (kernels & plzma_kernel_crc32_clmul) ? "clmul" : "portable",
+             (kernels & plzma_kernel_crc64_clmul) ? "clmul" : "portable",
+             (kernels & plzma_kernel_sha256_hw) ? "hardware" : "portable",
+             (kernels & plzma_kernel_aes_hw_256) ? "hardware-256" : ((kernels & plzma_kernel_aes_hw) ? "hardware" : "portable"));
+    json += buff;
+    json += corporaJson;
+    json += "\n  ],\n  \"results\": [\n";
+    json += results;
+    json += "\n  ]";
+    if (!solidScaling.empty()) {
+        json += ",\n  \"solid_scaling\": ";
+        json += solidScaling;
+    }
+    json += "\n}\n";
+
+    FILE * file = options.output ? fopen(options.output, "wb") : stdout;
+    if (!file) {
+        fprintf(stderr, "Can't open output file: %s\n", options.output);
+        return 4;
+    }
+    const bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+    if (file != stdout) {
+        fclose(file);
+    }
+    return written ? 0 : 4;
+}
@@ -28,11 +28,16 @@
 #include <thread>
 
 #include "plzma_public_tests.hpp"
+#include "../src/plzma_dir_scanner.hpp"
 
 #include "../test_files/file__shutuptakemoney_jpg.h"
 #include "../test_files/file__southpark_jpg.h"
 #include "../test_files/file__munchen_jpg.h"
 #include "../test_files/file__zombies_jpg.h"
+#include "../test_files/file__15_tar.h"
+#include "../test_files/file__16_tar_xz.h"
+#include "../test_files/file__1_7z.h"
+#include "../test_files/file__2_7z.h"
 
 using namespace plzma;
 
@@ -207,6 +212,499 @@ int test_plzma_encode_xz_from_file_to_file_and_stream(void) {
     return 0;
 }
 
+int test_plzma_encode_decode_number_of_threads(void) {
+    uint8_t * contents[4] = { FILE__zombies_jpg_PTR, FILE__southpark_jpg_PTR, FILE__shutuptakemoney_jpg_PTR, FILE__munchen_jpg_PTR };
+    const size_t sizes[4] = { FILE__zombies_jpg_SIZE, FILE__southpark_jpg_SIZE, FILE__shutuptakemoney_jpg_SIZE, FILE__munchen_jpg_SIZE };
+    const char * names[4] = { "zombies.jpg", "southpark.jpg", "shutuptakemoney.jpg", "munchen.jpg" };
+    const plzma_file_type types[2] = { plzma_file_type_xz, plzma_file_type_7z };
+    for (size_t i = 0; i < 2; i++) {
+        const plzma_size_t itemsCount = (types[i] == plzma_file_type_xz) ? 1 : 4;
+        auto outStream = makeSharedOutStream();
+        auto encoder = makeSharedEncoder(outStream, types[i], plzma_method_LZMA2);
+        PLZMA_TESTS_ASSERT(encoder->numberOfThreads() == 0)
+        encoder->setNumberOfThreads(4);
+        PLZMA_TESTS_ASSERT(encoder->numberOfThreads() == 4)
+        for (plzma_size_t j = 0; j < itemsCount; j++) {
+            encoder->add(makeSharedInStream(contents[j], sizes[j], dummy_free), Path(names[j]));
+        }
+        PLZMA_TESTS_ASSERT(encoder->open() == true)
+        PLZMA_TESTS_ASSERT(encoder->compress() == true)
+        const auto archiveContent = outStream->copyContent();
+        PLZMA_TESTS_ASSERT(archiveContent.second > 0)
+        
+        for (uint32_t threads = 0; threads <= 4; threads += 2) {
+            auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, dummy_free), types[i]);
+            PLZMA_TESTS_ASSERT(decoder->numberOfThreads() == 0)
+            decoder->setNumberOfThreads(threads);
+            PLZMA_TESTS_ASSERT(decoder->numberOfThreads() == threads)
+            PLZMA_TESTS_ASSERT(decoder->open() == true)
+            PLZMA_TESTS_ASSERT(decoder->count() == itemsCount)
+            
+            auto itemStreams = makeShared<ItemOutStreamArray>();
+            for (plzma_size_t j = 0; j < itemsCount; j++) {
+                itemStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(j), makeSharedOutStream()));
+            }
+            PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+            for (plzma_size_t j = 0; j < itemsCount; j++) {
+                const auto & pair = itemStreams->at(j);
+                const auto itemContent = pair.second->copyContent();
+                plzma_size_t index = 0; // the single xz item has no path
+                while (itemsCount > 1 && index < itemsCount && strcmp(pair.first->path().utf8(), names[index]) != 0) {
+                    index++;
+                }
+                PLZMA_TESTS_ASSERT(index < itemsCount)
+                PLZMA_TESTS_ASSERT(itemContent.second == sizes[index])
+                PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), contents[index], sizes[index]) == 0)
+            }
+            PLZMA_TESTS_ASSERT(decoder->test() == true)
+        }
+    }
+    
+    // The xz stream of the tar archive is decoded with any number of threads.
+    for (uint32_t threads = 0; threads <= 4; threads += 2) {
+        auto decoder = makeSharedDecoder(makeSharedInStream(FILE__16_tar_xz_PTR, FILE__16_tar_xz_SIZE, dummy_free), plzma_file_type_xz);
+        decoder->setNumberOfThreads(threads);
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        PLZMA_TESTS_ASSERT(decoder->count() == 1)
+        auto itemStreams = makeShared<ItemOutStreamArray>();
+        auto itemStream = makeSharedOutStream();
+        itemStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(0), itemStream));
+        PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+        const auto itemContent = itemStream->copyContent();
+        PLZMA_TESTS_ASSERT(itemContent.second == FILE__15_tar_SIZE)
+        PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), FILE__15_tar_PTR, FILE__15_tar_SIZE) == 0)
+    }
+    return 0;
+}
+
+static bool encoder_method_properties_throws(const plzma_file_type type, const plzma_method method, const plzma_method_properties & properties) {
+    auto encoder = makeSharedEncoder(makeSharedOutStream(), type, method);
+    try {
+        encoder->setMethodProperties(properties);
+    } catch (const Exception & exception) {
+        return exception.code() == plzma_error_code_invalid_arguments;
+    }
+    return false;
+}
+
+int test_plzma_encode_decode_method_properties(void) {
+    const plzma_method_properties defaults = { 0, 0, 0, 0, plzma_match_finder_default, -1, -1, -1 };
+    plzma_method_properties properties = defaults;
+    properties.dictionary_size = 1024;
+    PLZMA_TESTS_ASSERT(encoder_method_properties_throws(plzma_file_type_7z, plzma_method_LZMA, properties))
+    properties = defaults;
+    properties.block_size = 1024 * 1024;
+    PLZMA_TESTS_ASSERT(encoder_method_properties_throws(plzma_file_type_7z, plzma_method_LZMA, properties))
+    properties = defaults;
+    properties.word_size = 274;
+    PLZMA_TESTS_ASSERT(encoder_method_properties_throws(plzma_file_type_xz, plzma_method_LZMA, properties))
+    properties = defaults;
+    properties.match_finder = static_cast<plzma_match_finder>(7);
+    PLZMA_TESTS_ASSERT(encoder_method_properties_throws(plzma_file_type_7z, plzma_method_LZMA2, properties))
+    properties = defaults;
+    properties.literal_context_bits = 3;
+    properties.literal_position_bits = 2;
+    PLZMA_TESTS_ASSERT(encoder_method_properties_throws(plzma_file_type_7z, plzma_method_LZMA2, properties))
+    PLZMA_TESTS_ASSERT(!encoder_method_properties_throws(plzma_file_type_7z, plzma_method_LZMA, properties))
+    properties = defaults;
+    properties.position_bits = 2;
+    PLZMA_TESTS_ASSERT(encoder_method_properties_throws(plzma_file_type_7z, plzma_method_PPMd, properties))
+    PLZMA_TESTS_ASSERT(!encoder_method_properties_throws(plzma_file_type_7z, plzma_method_PPMd, defaults))
+    
+    // The tar archive of the images is compressed with the default and the custom properties.
+    uint8_t * content = FILE__15_tar_PTR;
+    const size_t contentSize = FILE__15_tar_SIZE;
+    
+    const plzma_file_type types[2] = { plzma_file_type_xz, plzma_file_type_7z };
+    for (size_t i = 0; i < 2; i++) {
+        size_t archiveSizes[2] = { 0, 0 };
+        for (size_t j = 0; j < 2; j++) {
+            auto outStream = makeSharedOutStream();
+            auto encoder = makeSharedEncoder(outStream, types[i], plzma_method_LZMA2);
+            properties = encoder->methodProperties();
+            PLZMA_TESTS_ASSERT(properties.dictionary_size == 0 && properties.block_size == 0 && properties.word_size == 0)
+            PLZMA_TESTS_ASSERT(properties.match_finder_cycles == 0 && properties.match_finder == plzma_match_finder_default)
+            PLZMA_TESTS_ASSERT(properties.literal_context_bits == -1 && properties.literal_position_bits == -1 && properties.position_bits == -1)
+            if (j == 1) {
+                properties.dictionary_size = 64 * 1024;
+                properties.block_size = 128 * 1024;
+                properties.word_size = 16;
+                properties.match_finder_cycles = 8;
+                properties.match_finder = plzma_match_finder_hc4;
+                properties.literal_context_bits = 1;
+                properties.literal_position_bits = 1;
+                properties.position_bits = 0;
+                encoder->setMethodProperties(properties);
+                const auto appliedProperties = encoder->methodProperties();
+                PLZMA_TESTS_ASSERT(appliedProperties.dictionary_size == properties.dictionary_size)
+                PLZMA_TESTS_ASSERT(appliedProperties.block_size == properties.block_size)
+                PLZMA_TESTS_ASSERT(appliedProperties.match_finder == plzma_match_finder_hc4)
+                PLZMA_TESTS_ASSERT(appliedProperties.position_bits == 0)
+            }
+            encoder->setNumberOfThreads(1);
+            encoder->add(makeSharedInStream(content, contentSize, dummy_free), Path("15.tar"));
+            PLZMA_TESTS_ASSERT(encoder->open() == true)
+            PLZMA_TESTS_ASSERT(encoder->compress() == true)
+            const auto archiveContent = outStream->copyContent();
+            PLZMA_TESTS_ASSERT(archiveContent.second > 0)
+            archiveSizes[j] = archiveContent.second;
+            
+            auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, dummy_free), types[i]);
+            PLZMA_TESTS_ASSERT(decoder->open() == true)
+            auto itemStreams = makeShared<ItemOutStreamArray>();
+            auto itemStream = makeSharedOutStream();
+            itemStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(0), itemStream));
+            PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+            const auto itemContent = itemStream->copyContent();
+            PLZMA_TESTS_ASSERT(itemContent.second == contentSize)
+            PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), content, contentSize) == 0)
+        }
+        std::flush(std::cout) << "Default method properties archive size: " << archiveSizes[0] << ", custom: " << archiveSizes[1] << std::endl;
+        PLZMA_TESTS_ASSERT(archiveSizes[0] != archiveSizes[1])
+    }
+    return 0;
+}
+
+static bool encoder_filter_throws(const plzma_file_type type, const plzma_filter filter, const uint32_t deltaDistance) {
+    try {
+        auto encoder = makeSharedEncoder(makeSharedOutStream(), type, plzma_method_LZMA2);
+        encoder->setFilterDeltaDistance(deltaDistance);
+        encoder->setFilter(filter);
+    } catch (const Exception & exception) {
+        return exception.code() == plzma_error_code_invalid_arguments;
+    }
+    return false;
+}
+
+int test_plzma_encode_decode_filters(void) {
+    PLZMA_TESTS_ASSERT(encoder_filter_throws(plzma_file_type_xz, plzma_filter_BCJ2, 1))
+    PLZMA_TESTS_ASSERT(encoder_filter_throws(plzma_file_type_7z, static_cast<plzma_filter>(12), 1))
+    PLZMA_TESTS_ASSERT(encoder_filter_throws(plzma_file_type_7z, plzma_filter_Delta, 0))
+    PLZMA_TESTS_ASSERT(encoder_filter_throws(plzma_file_type_xz, plzma_filter_Delta, 257))
+#if defined(LIBPLZMA_MULTITHREAD)
+    const bool bcj2Supported = true;
+#else
+    const bool bcj2Supported = false; // the single-threaded coders mixer can't encode BCJ2
+#endif
+    PLZMA_TESTS_ASSERT(encoder_filter_throws(plzma_file_type_7z, plzma_filter_BCJ2, 256) != bcj2Supported)
+    
+    // Tabular data: rows of the slowly changing 32-bit little-endian values.
+    const size_t contentSize = 256 * 1024;
+    uint8_t * content = static_cast<uint8_t *>(plzma_malloc(contentSize));
+    PLZMA_TESTS_ASSERT(content != nullptr)
+    uint32_t seed = 1, value = 0;
+    for (size_t i = 0; i < contentSize; i += 4) {
+        seed = seed * 1103515245 + 12345;
+        value += (seed >> 16) % 64;
+        content[i] = static_cast<uint8_t>(value);
+        content[i + 1] = static_cast<uint8_t>(value >> 8);
+        content[i + 2] = static_cast<uint8_t>(value >> 16);
+        content[i + 3] = static_cast<uint8_t>(value >> 24);
+    }
+    
+    const plzma_filter filters[12] = {
+        plzma_filter_auto, plzma_filter_none, plzma_filter_BCJ, plzma_filter_BCJ2, plzma_filter_ARM64, plzma_filter_ARM,
+        plzma_filter_ARMT, plzma_filter_PPC, plzma_filter_SPARC, plzma_filter_IA64, plzma_filter_RISCV, plzma_filter_Delta
+    };
+    const plzma_file_type types[2] = { plzma_file_type_xz, plzma_file_type_7z };
+    for (size_t i = 0; i < 2; i++) {
+        size_t archiveSizes[12] = { 0 };
+        for (size_t j = 0; j < 12; j++) {
+            if (filters[j] == plzma_filter_BCJ2 && (types[i] == plzma_file_type_xz || !bcj2Supported)) {
+                continue;
+            }
+            auto outStream = makeSharedOutStream();
+            auto encoder = makeSharedEncoder(outStream, types[i], plzma_method_LZMA2);
+            PLZMA_TESTS_ASSERT(encoder->filter() == plzma_filter_auto)
+            PLZMA_TESTS_ASSERT(encoder->filterDeltaDistance() == 1)
+            encoder->setFilter(filters[j]);
+            encoder->setFilterDeltaDistance(4);
+            PLZMA_TESTS_ASSERT(encoder->filter() == filters[j])
+            PLZMA_TESTS_ASSERT(encoder->filterDeltaDistance() == 4)
+            encoder->setNumberOfThreads(1);
+            encoder->add(makeSharedInStream(content, contentSize, dummy_free), Path("content.bin"));
+            PLZMA_TESTS_ASSERT(encoder->open() == true)
+            PLZMA_TESTS_ASSERT(encoder->compress() == true)
+            const auto archiveContent = outStream->copyContent();
+            PLZMA_TESTS_ASSERT(archiveContent.second > 0)
+            archiveSizes[j] = archiveContent.second;
+            
+            auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, dummy_free), types[i]);
+            PLZMA_TESTS_ASSERT(decoder->open() == true)
+            auto itemStreams = makeShared<ItemOutStreamArray>();
+            auto itemStream = makeSharedOutStream();
+            itemStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(0), itemStream));
+            PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+            const auto itemContent = itemStream->copyContent();
+            PLZMA_TESTS_ASSERT(itemContent.second == contentSize)
+            PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), content, contentSize) == 0)
+        }
+        std::flush(std::cout) << "No filter archive size: " << archiveSizes[1] << ", Delta:4: " << archiveSizes[11] << std::endl;
+        PLZMA_TESTS_ASSERT(archiveSizes[11] < archiveSizes[1])
+    }
+    
+    plzma_free(content);
+    return 0;
+}
+
+static void session_item_content(const plzma_size_t index, uint8_t ** content, size_t * size) {
+    switch (index) {
+        case 0: *content = FILE__zombies_jpg_PTR; *size = FILE__zombies_jpg_SIZE; break;
+        case 1: *content = FILE__southpark_jpg_PTR; *size = FILE__southpark_jpg_SIZE; break;
+        default: *content = FILE__shutuptakemoney_jpg_PTR; *size = FILE__shutuptakemoney_jpg_SIZE; break;
+    }
+}
+
+static bool session_write_items(SharedPtr<EncoderSession> & session, const plzma_size_t itemsCount) {
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        session_item_content(i, &content, &size);
+        for (size_t offset = 0; offset < size; offset += 4099) {
+            const size_t chunkSize = ((size - offset) < 4099) ? (size - offset) : 4099;
+            if (!session->write(content + offset, static_cast<plzma_size_t>(chunkSize))) {
+                return false;
+            }
+        }
+        session->nextItem();
+    }
+    return session->finish();
+}
+
+static int session_items_must_match(const plzma_file_type type, const void * archive, const size_t archiveSize, const plzma_size_t itemsCount) {
+    auto decoder = makeSharedDecoder(makeSharedInStream(archive, archiveSize), type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == itemsCount)
+    auto itemsStreams = makeShared<ItemOutStreamArray>(itemsCount);
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(i), makeSharedOutStream()));
+    }
+    PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        const auto & pair = itemsStreams->at(i);
+        const auto itemContent = pair.second->copyContent();
+        unsigned index = 0; // the single xz item has no path
+        PLZMA_TESTS_ASSERT(type == plzma_file_type_xz || sscanf(pair.first->path().utf8(), "%u", &index) == 1)
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        session_item_content(index, &content, &size);
+        PLZMA_TESTS_ASSERT(itemContent.second == size)
+        PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), content, size) == 0)
+    }
+    return 0;
+}
+
+static int encode_session(const plzma_file_type type) {
+    const plzma_size_t itemsCount = (type == plzma_file_type_xz) ? 1 : 3;
+    
+    // The first tar item has the known size, others are unknown.
+    auto items = makeShared<ItemArray>(itemsCount);
+    char name[32];
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        snprintf(name, sizeof(name), "%u.jpg", static_cast<unsigned>(i));
+        auto item = makeShared<Item>(Path(name), i);
+        item->setSize((type == plzma_file_type_tar && i == 0) ? FILE__zombies_jpg_SIZE : 0);
+        items->push(static_cast<SharedPtr<Item> &&>(item));
+    }
+    
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, type, plzma_method_LZMA2);
+    encoder->setCompressionLevel(1);
+    auto session = encoder->openSession(items);
+    PLZMA_TESTS_ASSERT(session)
+    PLZMA_TESTS_ASSERT(session_write_items(session, itemsCount) == true)
+    try {
+        session->write(FILE__zombies_jpg_PTR, 1);
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    
+    const auto archiveContent = archiveStream->copyContent();
+    PLZMA_TESTS_ASSERT(archiveContent.second > 0)
+    PLZMA_TESTS_ASSERT(session_items_must_match(type, archiveContent.first, archiveContent.second, itemsCount) == 0)
+    
+    // The session of the opened encoder or the encoder with added streams.
+    try {
+        encoder->openSession(items);
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    encoder = makeSharedEncoder(makeSharedOutStream(), type, plzma_method_LZMA2);
+    encoder->add(makeSharedInStream(FILE__zombies_jpg_PTR, FILE__zombies_jpg_SIZE, dummy_free), Path("added.jpg"));
+    try {
+        encoder->openSession(items);
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    
+    // Releasing the unfinished session aborts the compression.
+    encoder = makeSharedEncoder(makeSharedOutStream(), type, plzma_method_LZMA2);
+    session = encoder->openSession(items);
+    PLZMA_TESTS_ASSERT(session)
+    PLZMA_TESTS_ASSERT(session->write(FILE__zombies_jpg_PTR, 4099) == true)
+    session.clear();
+    
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+    plzma_out_stream cOutStream = plzma_out_stream_create_memory_stream();
+    plzma_encoder cEncoder = plzma_encoder_create(&cOutStream, type, plzma_method_LZMA2, plzma_context{nullptr, nullptr});
+    PLZMA_TESTS_ASSERT(cEncoder.exception == nullptr)
+    plzma_item_array cItems{static_cast<void *>(items.get()), nullptr};
+    plzma_encoder_session cSession = plzma_encoder_open_session(&cEncoder, &cItems);
+    PLZMA_TESTS_ASSERT(cSession.exception == nullptr)
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        session_item_content(i, &content, &size);
+        PLZMA_TESTS_ASSERT(plzma_encoder_session_write(&cSession, content, static_cast<plzma_size_t>(size)) == true)
+        plzma_encoder_session_next_item(&cSession);
+    }
+    PLZMA_TESTS_ASSERT(plzma_encoder_session_finish(&cSession) == true)
+    PLZMA_TESTS_ASSERT(cSession.exception == nullptr)
+    plzma_encoder_session_release(&cSession);
+    plzma_encoder_release(&cEncoder);
+    plzma_memory cArchiveContent = plzma_out_stream_copy_content(&cOutStream);
+    PLZMA_TESTS_ASSERT(cArchiveContent.exception == nullptr && cArchiveContent.memory != nullptr)
+    PLZMA_TESTS_ASSERT(session_items_must_match(type, cArchiveContent.memory, cArchiveContent.size, itemsCount) == 0)
+    plzma_free(cArchiveContent.memory);
+    plzma_out_stream_release(&cOutStream);
+#endif
+    return 0;
+}
+
+struct SequentialOutContext final {
+    std::string content;
+    bool opened;
+    bool closed;
+};
+
+static bool sequential_out_open_callback(void * LIBPLZMA_NULLABLE context) {
+    static_cast<SequentialOutContext *>(context)->opened = true;
+    return true;
+}
+
+static void sequential_out_close_callback(void * LIBPLZMA_NULLABLE context) {
+    static_cast<SequentialOutContext *>(context)->closed = true;
+}
+
+static bool sequential_out_write_callback(void * LIBPLZMA_NULLABLE context, const void * LIBPLZMA_NONNULL data, uint32_t size) {
+    static_cast<SequentialOutContext *>(context)->content.append(static_cast<const char *>(data), size);
+    return true;
+}
+
+static int encode_session_sequential(const plzma_file_type type) {
+    const plzma_size_t itemsCount = (type == plzma_file_type_xz) ? 1 : 3;
+    
+    // The tar items of the sequential output stream have the known sizes.
+    auto items = makeShared<ItemArray>(itemsCount);
+    char name[32];
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        session_item_content(i, &content, &size);
+        snprintf(name, sizeof(name), "%u.jpg", static_cast<unsigned>(i));
+        auto item = makeShared<Item>(Path(name), i);
+        item->setSize(size);
+        items->push(static_cast<SharedPtr<Item> &&>(item));
+    }
+    
+    SequentialOutContext context{std::string(), false, false};
+    auto encoder = makeSharedEncoder(makeSharedSequentialOutStream(sequential_out_open_callback,
+                                                                   sequential_out_close_callback,
+                                                                   sequential_out_write_callback,
+                                                                   plzma_context{&context, nullptr}), type, plzma_method_LZMA2);
+    encoder->setCompressionLevel(1);
+    auto session = encoder->openSession(items);
+    PLZMA_TESTS_ASSERT(session)
+    PLZMA_TESTS_ASSERT(session_write_items(session, itemsCount) == true)
+    PLZMA_TESTS_ASSERT(context.opened == true)
+    PLZMA_TESTS_ASSERT(context.closed == true)
+    PLZMA_TESTS_ASSERT(context.content.size() > 0)
+    PLZMA_TESTS_ASSERT(session_items_must_match(type, context.content.data(), context.content.size(), itemsCount) == 0)
+    
+    if (type == plzma_file_type_tar) {
+        // The header of the item with unknown size can't be rewritten.
+        items->at(itemsCount - 1)->setSize(0);
+        encoder = makeSharedEncoder(makeSharedSequentialOutStream(sequential_out_open_callback,
+                                                                  sequential_out_close_callback,
+                                                                  sequential_out_write_callback,
+                                                                  plzma_context{&context, nullptr}), type, plzma_method_LZMA2);
+        try {
+            encoder->openSession(items);
+            PLZMA_TESTS_ASSERT(false)
+        } catch (const Exception & exception) {
+            PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+        }
+        items->at(itemsCount - 1)->setSize(FILE__shutuptakemoney_jpg_SIZE);
+    }
+    
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+    SequentialOutContext cContext{std::string(), false, false};
+    plzma_out_stream cOutStream = plzma_out_stream_create_sequential_with_callbacks(sequential_out_open_callback,
+                                                                                    sequential_out_close_callback,
+                                                                                    sequential_out_write_callback,
+                                                                                    plzma_context{&cContext, nullptr});
+    PLZMA_TESTS_ASSERT(cOutStream.exception == nullptr)
+    plzma_encoder cEncoder = plzma_encoder_create(&cOutStream, type, plzma_method_LZMA2, plzma_context{nullptr, nullptr});
+    PLZMA_TESTS_ASSERT(cEncoder.exception == nullptr)
+    plzma_item_array cItems{static_cast<void *>(items.get()), nullptr};
+    plzma_encoder_session cSession = plzma_encoder_open_session(&cEncoder, &cItems);
+    PLZMA_TESTS_ASSERT(cSession.exception == nullptr)
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        session_item_content(i, &content, &size);
+        PLZMA_TESTS_ASSERT(plzma_encoder_session_write(&cSession, content, static_cast<plzma_size_t>(size)) == true)
+        plzma_encoder_session_next_item(&cSession);
+    }
+    PLZMA_TESTS_ASSERT(plzma_encoder_session_finish(&cSession) == true)
+    PLZMA_TESTS_ASSERT(cContext.closed == true)
+    PLZMA_TESTS_ASSERT(session_items_must_match(type, cContext.content.data(), cContext.content.size(), itemsCount) == 0)
+    plzma_encoder_session_release(&cSession);
+    plzma_encoder_release(&cEncoder);
+    plzma_out_stream_release(&cOutStream);
+#endif
+    return 0;
+}
+
+int test_plzma_encode_session(void) {
+    int ret = 0;
+    if ( (ret = encode_session(plzma_file_type_xz)) ) {
+        return ret;
+    }
+    if ( (ret = encode_session_sequential(plzma_file_type_xz)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_TAR)
+    if ( (ret = encode_session(plzma_file_type_tar)) ) {
+        return ret;
+    }
+    if ( (ret = encode_session_sequential(plzma_file_type_tar)) ) {
+        return ret;
+    }
+#endif
+    try {
+        makeSharedEncoder(makeSharedSequentialOutStream(sequential_out_open_callback,
+                                                        sequential_out_close_callback,
+                                                        sequential_out_write_callback), plzma_file_type_7z, plzma_method_LZMA2);
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    auto items = makeShared<ItemArray>(1);
+    items->push(makeShared<Item>(Path("1.txt"), 0));
+    auto encoder = makeSharedEncoder(makeSharedOutStream(), plzma_file_type_7z, plzma_method_LZMA2);
+    try {
+        encoder->openSession(items);
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    return ret;
+}
+
 int test_plzma_encode_test2(void) {
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
     plzma_out_stream stream = plzma_out_stream_create_memory_stream();
@@ -215,6 +713,17 @@ int test_plzma_encode_test2(void) {
     plzma_encoder encoder = plzma_encoder_create(&stream, plzma_file_type_7z, plzma_method_LZMA, plzma_context{nullptr, nullptr});
     PLZMA_TESTS_ASSERT(encoder.exception == nullptr)
     PLZMA_TESTS_ASSERT(encoder.object != nullptr)
+    PLZMA_TESTS_ASSERT(plzma_encoder_number_of_threads(&encoder) == 0)
+    plzma_encoder_set_number_of_threads(&encoder, 2);
+    PLZMA_TESTS_ASSERT(encoder.exception == nullptr)
+    PLZMA_TESTS_ASSERT(plzma_encoder_number_of_threads(&encoder) == 2)
+    plzma_method_properties properties = plzma_encoder_method_properties(&encoder);
+    PLZMA_TESTS_ASSERT(encoder.exception == nullptr)
+    PLZMA_TESTS_ASSERT(properties.dictionary_size == 0 && properties.literal_context_bits == -1)
+    properties.block_size = 1024 * 1024; // LZMA2 only
+    plzma_encoder_set_method_properties(&encoder, &properties);
+    PLZMA_TESTS_ASSERT(encoder.exception != nullptr)
+    PLZMA_TESTS_ASSERT(plzma_exception_code(encoder.exception) == plzma_error_code_invalid_arguments)
     plzma_out_stream_release(&stream);
     plzma_encoder_release(&encoder);
 #endif // !LIBPLZMA_NO_C_BINDINGS
@@ -253,6 +762,442 @@ int test_plzma_encode_test3(void) {
     return 0;
 }
 
+static SharedPtr<Decoder> encode_dir(const Path & dir, const uint32_t numberOfThreads) {
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, plzma_file_type_7z, plzma_method_LZMA);
+    encoder->setNumberOfThreads(numberOfThreads);
+    encoder->add(dir);
+    if (!encoder->open() || !encoder->compress()) {
+        return SharedPtr<Decoder>();
+    }
+    const auto archiveContent = archiveStream->copyContent();
+    const void * archiveMemory = archiveContent.first;
+    auto decoder = makeSharedDecoder(makeSharedInStream(archiveMemory, archiveContent.second), plzma_file_type_7z); // copied
+    return decoder->open() ? decoder : SharedPtr<Decoder>();
+}
+
+int test_plzma_encode_dir_scan(void) {
+    const auto root = Path::tmpPath().appendingRandomComponent();
+    PLZMA_TESTS_ASSERT(root.createDir(false) == true)
+    char name[64];
+    plzma_size_t filesCount = 0;
+    for (unsigned d = 0; d < 6; d++) {
+        snprintf(name, sizeof(name), "d%u/s%u/t%u", d, d % 2, d % 3);
+        Path dir = root.appending(name);
+        PLZMA_TESTS_ASSERT(dir.createDir(true) == true)
+        for (int level = 2; level >= 0; level--) { // t, s and d
+            for (unsigned f = 0; f < 5 + d; f++) {
+                snprintf(name, sizeof(name), "f%u.txt", f);
+                FILE * file = dir.appending(name).openFile("w+b");
+                PLZMA_TESTS_ASSERT(file != nullptr)
+                fprintf(file, "%u %u %d", d, f, level);
+                fclose(file);
+                filesCount++;
+            }
+            dir.removeLastComponent();
+        }
+    }
+    PLZMA_TESTS_ASSERT(root.appending("empty").createDir(false) == true)
+    
+#if defined(LIBPLZMA_HAVE_DIR_SCANNER)
+    // The parallel scanner reads the same files, in the same order and with the same stat as the serial directory iterator.
+    DirScanner scanner(root, 0);
+    Vector<DirScanner::File> files(scanner.scan(4));
+    PLZMA_TESTS_ASSERT(files.count() == filesCount)
+    plzma_size_t scannedIndex = 0;
+    auto scannedIt = root.openDir();
+    while (scannedIt->next()) {
+        if (!scannedIt->isDir()) {
+            PLZMA_TESTS_ASSERT(scannedIndex < files.count())
+            const auto & file = files.at(scannedIndex++);
+            const auto stat = scannedIt->fullPath().stat();
+            PLZMA_TESTS_ASSERT(file.path == scannedIt->path())
+            PLZMA_TESTS_ASSERT(file.stat.size == stat.size)
+            PLZMA_TESTS_ASSERT(file.stat.timestamp.last_modification == stat.timestamp.last_modification)
+            PLZMA_TESTS_ASSERT(file.stat.timestamp.creation == stat.timestamp.creation)
+        }
+    }
+    scannedIt->close();
+    PLZMA_TESTS_ASSERT(scannedIndex == filesCount)
+#endif
+    
+    // The archive contains the same files as via the directory iterator.
+    auto parallel = encode_dir(root, 4);
+    PLZMA_TESTS_ASSERT(parallel)
+    PLZMA_TESTS_ASSERT(parallel->count() == filesCount)
+    const Path rootName = root.lastComponent();
+    plzma_size_t iteratedCount = 0;
+    auto it = root.openDir();
+    while (it->next()) {
+        if (!it->isDir()) {
+            auto item = parallel->findItem(rootName.appending(it->path()));
+            PLZMA_TESTS_ASSERT(item)
+            PLZMA_TESTS_ASSERT(item->size() == it->fullPath().stat().size)
+            iteratedCount++;
+        }
+    }
+    it->close();
+    PLZMA_TESTS_ASSERT(iteratedCount == filesCount)
+    PLZMA_TESTS_ASSERT(root.remove() == true)
+    
+    bool notFound = false;
+    try {
+        encode_dir(root, 2);
+    } catch (const Exception & exception) {
+        notFound = true;
+    }
+    PLZMA_TESTS_ASSERT(notFound == true)
+    return 0;
+}
+
+// The content of the items of the test archives by the item path.
+static bool update_item_content(const char * path, const uint8_t ** content, size_t * size) {
+    if (strcmp(path, "M\xc3\xbcnchen.jpg") == 0 || strcmp(path, "\xd0\x9c\xd1\x8e\xd0\xbd\xd1\x85\xd0\xb5\xd0\xbd.jpg") == 0) {
+        *content = FILE__munchen_jpg_PTR;
+        *size = FILE__munchen_jpg_SIZE;
+    } else if (strcmp(path, "shutuptakemoney.jpg") == 0) {
+        *content = FILE__shutuptakemoney_jpg_PTR;
+        *size = FILE__shutuptakemoney_jpg_SIZE;
+    } else if (strcmp(path, "SouthPark.jpg") == 0) {
+        *content = FILE__southpark_jpg_PTR;
+        *size = FILE__southpark_jpg_SIZE;
+    } else if (strcmp(path, "zombies.jpg") == 0) {
+        *content = FILE__zombies_jpg_PTR;
+        *size = FILE__zombies_jpg_SIZE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static int encode_update(const plzma_file_type type, uint8_t * archive, const size_t archiveSize, const bool solid) {
+    const plzma_size_t itemsCount = 5;
+    char names[] = "M\xc3\xbcnchen.jpg\nshutuptakemoney.jpg\nSouthPark.jpg\nzombies.jpg\n\xd0\x9c\xd1\x8e\xd0\xbd\xd1\x85\xd0\xb5\xd0\xbd.jpg\n";
+    const size_t namesSize = strlen(names);
+    
+    // Append the new item.
+    auto appendedStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(appendedStream, type, plzma_method_LZMA2);
+    encoder->setShouldCreateSolidArchive(solid);
+    encoder->setCompressionLevel(1);
+    encoder->setUpdateArchive(makeSharedInStream(archive, archiveSize, dummy_free));
+    encoder->add(makeSharedInStream(names, namesSize, dummy_free), Path("names.txt"));
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto appendedContent = appendedStream->copyContent();
+    if (type == plzma_file_type_7z) {
+        // The packed content of the existing items is copied.
+        uint64_t packSizes[2] = { 0, 0 };
+        const plzma_size_t counts[2] = { itemsCount, itemsCount + 1 };
+        const void * contents[2] = { archive, appendedContent.first };
+        const size_t contentsSizes[2] = { archiveSize, appendedContent.second };
+        for (int a = 0; a < 2; a++) {
+            auto decoder = makeSharedDecoder(makeSharedInStream(contents[a], contentsSizes[a]), type); // copied
+            PLZMA_TESTS_ASSERT(decoder->open() == true)
+            PLZMA_TESTS_ASSERT(decoder->count() == counts[a])
+            for (plzma_size_t i = 0; i < counts[a]; i++) {
+                auto item = decoder->itemAt(i);
+                if (strcmp(item->path().utf8(), "names.txt") != 0) {
+                    packSizes[a] += item->packSize();
+                }
+            }
+        }
+        PLZMA_TESTS_ASSERT(packSizes[0] > 0 && packSizes[0] == packSizes[1])
+    }
+    
+    // Replace the existing item of the appended archive.
+    auto updatedStream = makeSharedOutStream();
+    encoder = makeSharedEncoder(updatedStream, type, plzma_method_LZMA2);
+    encoder->setShouldCreateSolidArchive(solid);
+    encoder->setCompressionLevel(1);
+    encoder->setUpdateArchive(makeSharedInStream(appendedContent.first, appendedContent.second, dummy_free));
+    encoder->add(makeSharedInStream(FILE__zombies_jpg_PTR, FILE__zombies_jpg_SIZE, dummy_free), Path("SouthPark.jpg"));
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto updatedContent = updatedStream->copyContent();
+    
+    auto decoder = makeSharedDecoder(makeSharedInStream(updatedContent.first, updatedContent.second, dummy_free), type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == itemsCount + 1)
+    auto itemsStreams = makeShared<ItemOutStreamArray>(itemsCount + 1);
+    for (plzma_size_t i = 0; i < itemsCount + 1; i++) {
+        itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(i), makeSharedOutStream()));
+    }
+    PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+    plzma_size_t replaced = 0, appended = 0;
+    for (plzma_size_t i = 0; i < itemsCount + 1; i++) {
+        const auto & pair = itemsStreams->at(i);
+        const auto itemContent = pair.second->copyContent();
+        const char * path = pair.first->path().utf8();
+        const uint8_t * expected = nullptr;
+        size_t expectedSize = 0;
+        if (strcmp(path, "names.txt") == 0) {
+            expected = reinterpret_cast<const uint8_t *>(names);
+            expectedSize = namesSize;
+            appended++;
+        } else if (strcmp(path, "SouthPark.jpg") == 0) {
+            expected = FILE__zombies_jpg_PTR;
+            expectedSize = FILE__zombies_jpg_SIZE;
+            replaced++;
+        } else {
+            PLZMA_TESTS_ASSERT(update_item_content(path, &expected, &expectedSize) == true)
+        }
+        PLZMA_TESTS_ASSERT(itemContent.second == expectedSize)
+        PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), expected, expectedSize) == 0)
+    }
+    PLZMA_TESTS_ASSERT(replaced == 1 && appended == 1)
+    return 0;
+}
+
+int test_plzma_encode_update(void) {
+    int ret = 0;
+    if ( (ret = encode_update(plzma_file_type_7z, FILE__2_7z_PTR, FILE__2_7z_SIZE, true)) ) {
+        return ret;
+    }
+    if ( (ret = encode_update(plzma_file_type_7z, FILE__1_7z_PTR, FILE__1_7z_SIZE, false)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_TAR)
+    if ( (ret = encode_update(plzma_file_type_tar, FILE__15_tar_PTR, FILE__15_tar_SIZE, false)) ) {
+        return ret;
+    }
+#endif
+    auto encoder = makeSharedEncoder(makeSharedOutStream(), plzma_file_type_xz, plzma_method_LZMA2);
+    try {
+        encoder->setUpdateArchive(makeSharedInStream(FILE__16_tar_xz_PTR, FILE__16_tar_xz_SIZE, dummy_free));
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    return ret;
+}
+
+// The paths of the items of the source archive, the removed and renamed items are nested in the directories.
+static const char * const removeRenamePaths[7] = { "zombies.jpg", "shutuptakemoney.jpg", "dir/SouthPark.jpg", "dir/munchen.jpg",
+    "dir/sub/zombies.jpg", "dirx/shutuptakemoney.jpg", "removed.jpg" };
+
+static void remove_rename_content(const plzma_size_t index, uint8_t ** content, size_t * size) {
+    switch (index % 4) {
+        case 0: *content = FILE__zombies_jpg_PTR; *size = FILE__zombies_jpg_SIZE; break;
+        case 1: *content = FILE__shutuptakemoney_jpg_PTR; *size = FILE__shutuptakemoney_jpg_SIZE; break;
+        case 2: *content = FILE__southpark_jpg_PTR; *size = FILE__southpark_jpg_SIZE; break;
+        default: *content = FILE__munchen_jpg_PTR; *size = FILE__munchen_jpg_SIZE; break;
+    }
+}
+
+static RawHeapMemorySize remove_rename_source(const plzma_file_type type, const bool solid) {
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, type, plzma_method_LZMA2);
+    encoder->setShouldCreateSolidArchive(solid);
+    encoder->setCompressionLevel(1);
+    for (plzma_size_t i = 0; i < 7; i++) {
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        remove_rename_content(i, &content, &size);
+        encoder->add(makeSharedInStream(content, size, dummy_free), Path(removeRenamePaths[i]));
+    }
+    if (!encoder->open() || !encoder->compress()) {
+        return RawHeapMemorySize(RawHeapMemory(), 0);
+    }
+    return archiveStream->copyContent();
+}
+
+static bool encode_remove_rename_fails(const plzma_file_type type, const RawHeapMemorySize & archive, const char * LIBPLZMA_NONNULL renamedPath, const char * LIBPLZMA_NONNULL newPath, const char * LIBPLZMA_NULLABLE addedPath) {
+    auto encoder = makeSharedEncoder(makeSharedOutStream(), type, plzma_method_LZMA2);
+    encoder->setUpdateArchive(makeSharedInStream(static_cast<const void *>(archive.first), archive.second)); // copied
+    encoder->rename(Path(renamedPath), Path(newPath));
+    if (addedPath) {
+        encoder->add(makeSharedInStream(FILE__munchen_jpg_PTR, FILE__munchen_jpg_SIZE, dummy_free), Path(addedPath));
+    }
+    try {
+        encoder->open();
+    } catch (const Exception & exception) {
+        return exception.code() == plzma_error_code_invalid_arguments;
+    }
+    return false;
+}
+
+// The index of the source archive item by the original or the expected new path.
+static plzma_size_t remove_rename_index(const char * const * paths, const SharedPtr<Item> & item) {
+    for (plzma_size_t i = 0; i < 7; i++) {
+        if (paths[i] && strcmp(paths[i], item->path().utf8()) == 0) {
+            return i;
+        }
+    }
+    return 7;
+}
+
+static int encode_remove_rename(const plzma_file_type type, const bool solid) {
+    const auto archive = remove_rename_source(type, solid);
+    PLZMA_TESTS_ASSERT(archive.second > 0)
+    
+    // The directory operations are applied to all nested items, but not to the items with the same name prefix.
+    auto editedStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(editedStream, type, plzma_method_LZMA2);
+    encoder->setShouldCreateSolidArchive(solid);
+    encoder->setCompressionLevel(1);
+    encoder->setUpdateArchive(makeSharedInStream(static_cast<const void *>(archive.first), archive.second));
+    encoder->remove(Path("removed.jpg"));
+    encoder->remove(Path("dir/sub"));
+    encoder->rename(Path("dir"), Path("moved"));
+    encoder->rename(Path("zombies.jpg"), Path("new/zombies.jpg"));
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto editedContent = editedStream->copyContent();
+    
+    // The new paths of the remaining items by the source index.
+    const char * paths[7] = { "new/zombies.jpg", "shutuptakemoney.jpg", "moved/SouthPark.jpg", "moved/munchen.jpg", nullptr, "dirx/shutuptakemoney.jpg", nullptr };
+    auto decoder = makeSharedDecoder(makeSharedInStream(editedContent.first, editedContent.second, dummy_free), type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    auto itemsStreams = makeShared<ItemOutStreamArray>(5);
+    for (plzma_size_t i = 0; i < 5; i++) {
+        itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(i), makeSharedOutStream()));
+    }
+    PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+    uint64_t packSize = 0;
+    for (plzma_size_t i = 0; i < 5; i++) {
+        const auto & pair = itemsStreams->at(i);
+        const plzma_size_t index = remove_rename_index(paths, pair.first);
+        PLZMA_TESTS_ASSERT(index < 7)
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        remove_rename_content(index, &content, &size);
+        const auto itemContent = pair.second->copyContent();
+        PLZMA_TESTS_ASSERT(itemContent.second == size)
+        PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), content, size) == 0)
+        packSize += pair.first->packSize();
+    }
+    if (type == plzma_file_type_7z && !solid) {
+        // The packed content of the remaining and renamed items is copied.
+        uint64_t originalPackSize = 0;
+        decoder = makeSharedDecoder(makeSharedInStream(static_cast<const void *>(archive.first), archive.second), type);
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        for (plzma_size_t i = 0; i < decoder->count(); i++) {
+            auto item = decoder->itemAt(i);
+            const plzma_size_t index = remove_rename_index(removeRenamePaths, item);
+            if (index != 4 && index != 6) {
+                originalPackSize += item->packSize();
+            }
+        }
+        PLZMA_TESTS_ASSERT(packSize > 0 && packSize == originalPackSize)
+    }
+    
+    // The unknown item of the updated archive.
+    encoder = makeSharedEncoder(makeSharedOutStream(), type, plzma_method_LZMA2);
+    encoder->setUpdateArchive(makeSharedInStream(static_cast<const void *>(archive.first), archive.second));
+    encoder->rename(Path("unknown.jpg"), Path("known.jpg"));
+    try {
+        encoder->open();
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    
+    // The new path collides with the existing item, the nested item of the renamed directory or the added item.
+    PLZMA_TESTS_ASSERT(encode_remove_rename_fails(type, archive, "zombies.jpg", "shutuptakemoney.jpg", nullptr) == true)
+    PLZMA_TESTS_ASSERT(encode_remove_rename_fails(type, archive, "dir/sub", "dirx", nullptr) == false)
+    PLZMA_TESTS_ASSERT(encode_remove_rename_fails(type, archive, "dir/sub/zombies.jpg", "dirx/shutuptakemoney.jpg", nullptr) == true)
+    PLZMA_TESTS_ASSERT(encode_remove_rename_fails(type, archive, "dir", "dirx", nullptr) == false)
+    PLZMA_TESTS_ASSERT(encode_remove_rename_fails(type, archive, "shutuptakemoney.jpg", "added.jpg", "added.jpg") == true)
+    return 0;
+}
+
+static int encode_remove_multi_block_solid(void) {
+    // The second solid block is created by appending the items to the single block solid archive.
+    auto appendedStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(appendedStream, plzma_file_type_7z, plzma_method_LZMA2);
+    encoder->setCompressionLevel(1);
+    encoder->setUpdateArchive(makeSharedInStream(FILE__2_7z_PTR, FILE__2_7z_SIZE, dummy_free));
+    char path[32];
+    for (plzma_size_t i = 0; i < 3; i++) {
+        uint8_t * content = nullptr;
+        size_t size = 0;
+        remove_rename_content(i, &content, &size);
+        snprintf(path, sizeof(path), "second/%u.jpg", static_cast<unsigned>(i));
+        encoder->add(makeSharedInStream(content, size, dummy_free), Path(path));
+    }
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto appendedContent = appendedStream->copyContent();
+    
+    auto editedStream = makeSharedOutStream();
+    encoder = makeSharedEncoder(editedStream, plzma_file_type_7z, plzma_method_LZMA2);
+    encoder->setCompressionLevel(1);
+    encoder->setUpdateArchive(makeSharedInStream(appendedContent.first, appendedContent.second, dummy_free));
+    encoder->remove(Path("second/1.jpg"));
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto editedContent = editedStream->copyContent();
+    
+    // The packed content of the untouched first block is copied, the second block is repacked without the removed item.
+    uint64_t firstPackSizes[2] = { 0, 0 };
+    uint64_t secondPackSizes[2] = { 0, 0 };
+    const RawHeapMemorySize * contents[2] = { &appendedContent, &editedContent };
+    for (int a = 0; a < 2; a++) {
+        auto decoder = makeSharedDecoder(makeSharedInStream(contents[a]->first, contents[a]->second, dummy_free), plzma_file_type_7z);
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        PLZMA_TESTS_ASSERT(decoder->count() == static_cast<plzma_size_t>((a == 0) ? 8 : 7))
+        auto itemsStreams = makeShared<ItemOutStreamArray>(decoder->count());
+        for (plzma_size_t i = 0; i < decoder->count(); i++) {
+            itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(i), makeSharedOutStream()));
+        }
+        PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+        for (plzma_size_t i = 0; i < itemsStreams->count(); i++) {
+            const auto & pair = itemsStreams->at(i);
+            const char * itemPath = pair.first->path().utf8();
+            const bool inSecond = strncmp(itemPath, "second/", 7) == 0;
+            const uint8_t * content = nullptr;
+            size_t size = 0;
+            if (inSecond) {
+                unsigned number = 0;
+                PLZMA_TESTS_ASSERT(sscanf(itemPath + 7, "%u", &number) == 1)
+                PLZMA_TESTS_ASSERT(number < 3 && (a == 0 || number != 1))
+                uint8_t * secondContent = nullptr;
+                remove_rename_content(number, &secondContent, &size);
+                content = secondContent;
+            } else {
+                PLZMA_TESTS_ASSERT(update_item_content(itemPath, &content, &size) == true)
+            }
+            const auto itemContent = pair.second->copyContent();
+            PLZMA_TESTS_ASSERT(itemContent.second == size)
+            PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), content, size) == 0)
+            (inSecond ? secondPackSizes : firstPackSizes)[a] += pair.first->packSize();
+        }
+    }
+    PLZMA_TESTS_ASSERT(firstPackSizes[0] > 0 && firstPackSizes[0] == firstPackSizes[1])
+    PLZMA_TESTS_ASSERT(secondPackSizes[1] > 0 && secondPackSizes[1] < secondPackSizes[0])
+    PLZMA_TESTS_ASSERT(editedContent.second < appendedContent.second)
+    return 0;
+}
+
+int test_plzma_encode_remove_rename(void) {
+    int ret = 0;
+    if ( (ret = encode_remove_rename(plzma_file_type_7z, true)) ) {
+        return ret;
+    }
+    if ( (ret = encode_remove_rename(plzma_file_type_7z, false)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_TAR)
+    if ( (ret = encode_remove_rename(plzma_file_type_tar, false)) ) {
+        return ret;
+    }
+#endif
+    if ( (ret = encode_remove_multi_block_solid()) ) {
+        return ret;
+    }
+    auto encoder = makeSharedEncoder(makeSharedOutStream(), plzma_file_type_7z, plzma_method_LZMA2);
+    encoder->remove(Path("zombies.jpg"));
+    try {
+        encoder->open();
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    return ret;
+}
+
 int main(int argc, char* argv[]) {
     std::flush(std::cout) << plzma_version();
     int ret = 0;
@@ -262,6 +1207,18 @@ int main(int argc, char* argv[]) {
             return ret;
         }
         
+        if ( (ret = test_plzma_encode_decode_number_of_threads()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_encode_decode_method_properties()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_encode_decode_filters()) ) {
+            return ret;
+        }
+        
         if ( (ret = test_plzma_encode_test2()) ) {
             return ret;
         }
@@ -273,6 +1230,24 @@ int main(int argc, char* argv[]) {
         if ( (ret = test_plzma_encode_example()) ) {
             return ret;
         }
+        
+        if ( (ret = test_plzma_encode_dir_scan()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_encode_update()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_encode_remove_rename()) ) {
+            return ret;
+        }
+        
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+        if ( (ret = test_plzma_encode_session()) ) {
+            return ret;
+        }
+#endif
     } catch (const Exception & e) {
         std::flush(std::cout) << "PLZMA Exception [" << e.code() << "]:" << std::endl;
         if (e.what()) {
@@ -308,3 +1283,7 @@ int main(int argc, char* argv[]) {
 #include "../test_files/file__southpark_jpg.h"
 #include "../test_files/file__munchen_jpg.h"
 #include "../test_files/file__zombies_jpg.h"
+#include "../test_files/file__15_tar.h"
+#include "../test_files/file__16_tar_xz.h"
+#include "../test_files/file__1_7z.h"
+#include "../test_files/file__2_7z.h"
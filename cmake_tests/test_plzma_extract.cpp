@@ -30,6 +30,20 @@
 #include "plzma_public_tests.hpp"
 
 #include "../test_files/file__1_7z.h"
+#include "../test_files/file__2_7z.h"
+#include "../test_files/file__3_7z.h"
+#include "../test_files/file__4_7z.h"
+#include "../test_files/file__5_7z.h"
+#include "../test_files/file__6_7z.h"
+#include "../test_files/file__7_7z.h"
+#include "../test_files/file__8_7z.h"
+#include "../test_files/file__15_tar.h"
+#include "../test_files/file__16_tar_xz.h"
+
+#include "../test_files/file__munchen_jpg.h"
+#include "../test_files/file__shutuptakemoney_jpg.h"
+#include "../test_files/file__southpark_jpg.h"
+#include "../test_files/file__zombies_jpg.h"
 
 using namespace plzma;
 
@@ -65,6 +79,58 @@ public:
 
 static TestProgressDelegate * _progressDelegate = new TestProgressDelegate();
 
+class MonotonicProgressDelegate : public ProgressDelegate {
+public:
+    double lastProgress = 0.0;
+    plzma_size_t decreases = 0;
+    plzma_size_t reports = 0;
+    
+    virtual void onProgress(void * LIBPLZMA_NULLABLE context, const String & path, const double progress) override final {
+        if (progress < lastProgress) {
+            decreases++;
+        }
+        lastProgress = progress;
+        reports++;
+    }
+    virtual ~MonotonicProgressDelegate() { }
+};
+
+// The content of the items of the test archives by the item index.
+static int itemContentMustMatch(const SharedPtr<Item> & item, const void * content, const uint64_t contentSize) {
+    const uint8_t * expected = nullptr;
+    size_t expectedSize = 0;
+    switch (item->index()) {
+        case 0:
+        case 4:
+            expected = FILE__munchen_jpg_PTR;
+            expectedSize = FILE__munchen_jpg_SIZE;
+            break;
+        case 1:
+            expected = FILE__shutuptakemoney_jpg_PTR;
+            expectedSize = FILE__shutuptakemoney_jpg_SIZE;
+            break;
+        case 2:
+            expected = FILE__southpark_jpg_PTR;
+            expectedSize = FILE__southpark_jpg_SIZE;
+            break;
+        case 3:
+            expected = FILE__zombies_jpg_PTR;
+            expectedSize = FILE__zombies_jpg_SIZE;
+            break;
+        default:
+            break;
+    }
+    PLZMA_TESTS_ASSERT(expected != nullptr)
+    PLZMA_TESTS_ASSERT(item->size() == expectedSize)
+    PLZMA_TESTS_ASSERT(contentSize == expectedSize)
+    PLZMA_TESTS_ASSERT(memcmp(content, expected, expectedSize) == 0)
+    return 0;
+}
+
+static int itemContentMustMatch(const SharedPtr<Item> & item, const RawHeapMemorySize & content) {
+    return itemContentMustMatch(item, static_cast<const void *>(content.first), content.second);
+}
+
 int test_plzma_extract_test1(void) {
 #if !defined(LIBPLZMA_NO_CRYPTO)
     auto stream = makeSharedInStream(FILE__1_7z_PTR, FILE__1_7z_SIZE, &dummy_free_callback);
@@ -229,11 +295,1205 @@ int test_plzma_extract_broken_input_stream2(void) {
     return 0;
 }
 
+int test_plzma_extract_solid_small_items(void) {
+    // The requested items in the reversed order.
+    auto decoder = makeSharedDecoder(makeSharedInStream(FILE__2_7z_PTR, FILE__2_7z_SIZE, &dummy_free_callback), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    auto items = decoder->items();
+    auto requested = makeShared<ItemArray>(items->count());
+    auto itemStreams = makeShared<ItemOutStreamArray>(items->count());
+    for (plzma_size_t i = items->count(); i > 0; i--) {
+        requested->push(items->at(i - 1));
+        itemStreams->push(ItemOutStreamArray::ElementType(items->at(i - 1), makeSharedOutStream()));
+    }
+    MonotonicProgressDelegate progressDelegate;
+    decoder->setProgressDelegate(&progressDelegate);
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    PLZMA_TESTS_ASSERT(progressDelegate.decreases == 0)
+    PLZMA_TESTS_ASSERT(progressDelegate.lastProgress == 1.0)
+    for (plzma_size_t i = 0; i < itemStreams->count(); i++) {
+        const auto & pair = itemStreams->at(i);
+        PLZMA_TESTS_ASSERT(itemContentMustMatch(pair.first, pair.second->copyContent()) == 0)
+    }
+    progressDelegate.lastProgress = 0.0;
+    PLZMA_TESTS_ASSERT(decoder->test(requested) == true)
+    PLZMA_TESTS_ASSERT(progressDelegate.decreases == 0)
+    PLZMA_TESTS_ASSERT(progressDelegate.lastProgress == 1.0)
+    decoder->setProgressDelegate(nullptr);
+    
+    // The small items of a single solid block, the progress is reported by the parts of 256 items.
+    const plzma_size_t itemsCount = 600;
+    const size_t itemSize = 128;
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, plzma_file_type_7z, plzma_method_LZMA2);
+    encoder->setShouldCreateSolidArchive(true);
+    encoder->setCompressionLevel(1);
+    char name[32];
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        snprintf(name, sizeof(name), "%u.jpg", static_cast<unsigned>(i));
+        encoder->add(makeSharedInStream(FILE__zombies_jpg_PTR + (i * itemSize), itemSize, &dummy_free_callback), Path(name));
+    }
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto archiveContent = archiveStream->copyContent();
+    
+    decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, &dummy_free_callback), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == itemsCount)
+    items = decoder->items();
+    itemStreams = makeShared<ItemOutStreamArray>(itemsCount);
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        itemStreams->push(ItemOutStreamArray::ElementType(items->at(i), makeSharedOutStream()));
+    }
+    progressDelegate.lastProgress = 0.0;
+    progressDelegate.reports = 0;
+    decoder->setProgressDelegate(&progressDelegate);
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    PLZMA_TESTS_ASSERT(progressDelegate.decreases == 0)
+    PLZMA_TESTS_ASSERT(progressDelegate.lastProgress == 1.0)
+    PLZMA_TESTS_ASSERT(progressDelegate.reports > 2)
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        const auto & pair = itemStreams->at(i);
+        const auto itemContent = pair.second->copyContent();
+        unsigned index = itemsCount;
+        PLZMA_TESTS_ASSERT(sscanf(pair.first->path().utf8(), "%u", &index) == 1)
+        PLZMA_TESTS_ASSERT(index < itemsCount)
+        PLZMA_TESTS_ASSERT(itemContent.second == itemSize)
+        PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(itemContent.first), FILE__zombies_jpg_PTR + (index * itemSize), itemSize) == 0)
+    }
+    decoder->setProgressDelegate(nullptr);
+    return 0;
+}
+
+int test_plzma_extract_parallel(void) {
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    // Each item of the non-solid archive is the own block.
+    auto decoder = makeSharedDecoder(makeSharedInStream(FILE__1_7z_PTR, FILE__1_7z_SIZE, &dummy_free_callback), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(decoder->shouldExtractInParallel() == false)
+    decoder->setShouldExtractInParallel(true);
+    decoder->setNumberOfThreads(4);
+    PLZMA_TESTS_ASSERT(decoder->shouldExtractInParallel() == true)
+    decoder->setProgressDelegate(_progressDelegate);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    
+    auto items = decoder->items();
+    auto itemStreams = makeShared<ItemOutStreamArray>(items->count());
+    for (plzma_size_t i = 0; i < items->count(); i++) {
+        itemStreams->push(ItemOutStreamArray::ElementType(items->at(i), makeSharedOutStream()));
+    }
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    for (plzma_size_t i = 0; i < itemStreams->count(); i++) {
+        const auto & pair = itemStreams->at(i);
+        PLZMA_TESTS_ASSERT(itemContentMustMatch(pair.first, pair.second->copyContent()) == 0)
+    }
+    
+    Path extractPath = Path::tmpPath();
+    extractPath.appendRandomComponent();
+    PLZMA_TESTS_ASSERT(extractPath.createDir(true) == true);
+    PLZMA_TESTS_ASSERT(decoder->extract(extractPath) == true);
+    for (plzma_size_t i = 0; i < items->count(); i++) {
+        Path itemPath(extractPath);
+        itemPath.append(items->at(i)->path());
+        PLZMA_TESTS_ASSERT(itemPath.exists() == true)
+        PLZMA_TESTS_ASSERT(itemPath.stat().size == items->at(i)->size())
+    }
+    PLZMA_TESTS_ASSERT(extractPath.remove() == true);
+#endif
+    return 0;
+}
+
+static int extract_to_arena(const bool solid, const bool parallel) {
+    auto decoder = solid ? makeSharedDecoder(makeSharedInStream(FILE__2_7z_PTR, FILE__2_7z_SIZE, &dummy_free_callback), plzma_file_type_7z) :
+                           makeSharedDecoder(makeSharedInStream(FILE__1_7z_PTR, FILE__1_7z_SIZE, &dummy_free_callback), plzma_file_type_7z);
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    decoder->setShouldExtractInParallel(parallel);
+#endif
+    PLZMA_TESTS_ASSERT(decoder->arena() == nullptr)
+    PLZMA_TESTS_ASSERT(decoder->arenaViewsCount() == 0)
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    
+    // Every second item in the reversed order: the views follow the array, the regions follow the archive.
+    auto items = makeShared<ItemArray>(3);
+    items->push(decoder->itemAt(4));
+    items->push(decoder->itemAt(2));
+    items->push(decoder->itemAt(0));
+    PLZMA_TESTS_ASSERT(decoder->extractToArena(items) == true)
+    PLZMA_TESTS_ASSERT(decoder->arenaViewsCount() == 3)
+    PLZMA_TESTS_ASSERT(items->at(0)->index() == 4 && items->at(1)->index() == 2 && items->at(2)->index() == 0)
+    
+    const uint64_t expectedOffsets[3] = { items->at(2)->size() + items->at(1)->size(), items->at(2)->size(), 0 };
+    const uint8_t * arena = static_cast<const uint8_t *>(decoder->arena());
+    PLZMA_TESTS_ASSERT(arena != nullptr)
+    for (plzma_size_t i = 0; i < items->count(); i++) {
+        const auto view = decoder->arenaViewAt(i);
+        PLZMA_TESTS_ASSERT(view.offset == expectedOffsets[i])
+        PLZMA_TESTS_ASSERT(view.size == items->at(i)->size())
+        PLZMA_TESTS_ASSERT(itemContentMustMatch(items->at(i), arena + view.offset, view.size) == 0)
+    }
+    PLZMA_TESTS_ASSERT(decoder->arenaSize() == FILE__munchen_jpg_SIZE + FILE__southpark_jpg_SIZE + FILE__munchen_jpg_SIZE)
+    
+    bool outOfBounds = false;
+    try {
+        decoder->arenaViewAt(items->count());
+    } catch (const Exception & exception) {
+        outOfBounds = exception.code() == plzma_error_code_invalid_arguments;
+    }
+    PLZMA_TESTS_ASSERT(outOfBounds == true)
+    
+    // An empty items list releases the arena.
+    PLZMA_TESTS_ASSERT(decoder->extractToArena(makeShared<ItemArray>()) == true)
+    PLZMA_TESTS_ASSERT(decoder->arena() == nullptr)
+    PLZMA_TESTS_ASSERT(decoder->arenaSize() == 0)
+    PLZMA_TESTS_ASSERT(decoder->arenaViewsCount() == 0)
+    return 0;
+}
+
+int test_plzma_extract_to_arena(void) {
+    int ret = 0;
+    if ( (ret = extract_to_arena(true, false)) ) {
+        return ret;
+    }
+    if ( (ret = extract_to_arena(false, false)) ) {
+        return ret;
+    }
+    return extract_to_arena(false, true);
+}
+
+static int extract_item_stream(const plzma_file_type type) {
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    SharedPtr<InStream> archiveStream;
+    switch (type) {
+        case plzma_file_type_7z: archiveStream = makeSharedInStream(FILE__2_7z_PTR, FILE__2_7z_SIZE, &dummy_free_callback); break;
+        case plzma_file_type_xz: archiveStream = makeSharedInStream(FILE__16_tar_xz_PTR, FILE__16_tar_xz_SIZE, &dummy_free_callback); break;
+        default: archiveStream = makeSharedInStream(FILE__15_tar_PTR, FILE__15_tar_SIZE, &dummy_free_callback); break;
+    }
+    auto decoder = makeSharedDecoder(archiveStream, type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    const plzma_size_t itemsCount = decoder->count();
+    PLZMA_TESTS_ASSERT(itemsCount == ((type == plzma_file_type_xz) ? 1 : 5))
+    
+    RawHeapMemory content(FILE__15_tar_SIZE);
+    uint8_t * contentPtr = content;
+    uint8_t buffer[1000];
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        auto item = decoder->itemAt(itemsCount - i - 1);
+        auto stream = decoder->openItemStream(item);
+        PLZMA_TESTS_ASSERT(stream)
+        PLZMA_TESTS_ASSERT(stream->item()->index() == item->index())
+        
+        // The decoder is busy while the stream is not read.
+        PLZMA_TESTS_ASSERT(!decoder->openItemStream(item))
+        PLZMA_TESTS_ASSERT(decoder->test() == false)
+        
+        if (i == 1) {
+            // Close before the end of the content.
+            PLZMA_TESTS_ASSERT(stream->read(buffer, sizeof(buffer)) > 0)
+            stream->close();
+            PLZMA_TESTS_ASSERT(stream->read(buffer, sizeof(buffer)) == 0)
+            PLZMA_TESTS_ASSERT(stream->position() < item->size())
+            continue;
+        }
+        
+        uint64_t position = 0;
+        plzma_size_t readed = 0;
+        while ( (readed = stream->read(buffer, sizeof(buffer))) > 0 ) {
+            PLZMA_TESTS_ASSERT(position + readed <= FILE__15_tar_SIZE)
+            memcpy(contentPtr + position, buffer, readed);
+            position += readed;
+        }
+        PLZMA_TESTS_ASSERT(stream->position() == position)
+        PLZMA_TESTS_ASSERT(stream->read(buffer, sizeof(buffer)) == 0)
+        if (type == plzma_file_type_xz) {
+            PLZMA_TESTS_ASSERT(position == FILE__15_tar_SIZE)
+            PLZMA_TESTS_ASSERT(memcmp(contentPtr, FILE__15_tar_PTR, FILE__15_tar_SIZE) == 0)
+        } else {
+            PLZMA_TESTS_ASSERT(itemContentMustMatch(item, contentPtr, position) == 0)
+        }
+    }
+    
+    // The decoder is not busy after reading or closing.
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    
+    // Released without reading.
+    PLZMA_TESTS_ASSERT(decoder->openItemStream(decoder->itemAt(itemsCount - 1)))
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+    const uint64_t firstItemSize = (type == plzma_file_type_xz) ? FILE__15_tar_SIZE : FILE__munchen_jpg_SIZE;
+    plzma_in_stream cInStream;
+    switch (type) {
+        case plzma_file_type_7z: cInStream = plzma_in_stream_create_with_memory(FILE__2_7z_PTR, FILE__2_7z_SIZE, &dummy_free_callback); break;
+        case plzma_file_type_xz: cInStream = plzma_in_stream_create_with_memory(FILE__16_tar_xz_PTR, FILE__16_tar_xz_SIZE, &dummy_free_callback); break;
+        default: cInStream = plzma_in_stream_create_with_memory(FILE__15_tar_PTR, FILE__15_tar_SIZE, &dummy_free_callback); break;
+    }
+    plzma_decoder cDecoder = plzma_decoder_create(&cInStream, type, plzma_context{nullptr, nullptr});
+    plzma_in_stream_release(&cInStream);
+    PLZMA_TESTS_ASSERT(plzma_decoder_open(&cDecoder) == true)
+    plzma_item cItem = plzma_decoder_item_at(&cDecoder, 0);
+    PLZMA_TESTS_ASSERT(cItem.exception == nullptr)
+    plzma_item_stream cStream = plzma_decoder_open_item_stream(&cDecoder, &cItem);
+    PLZMA_TESTS_ASSERT(cStream.exception == nullptr && cStream.object != nullptr)
+    uint64_t cPosition = 0;
+    plzma_size_t cReaded = 0;
+    while ( (cReaded = plzma_item_stream_read(&cStream, buffer, sizeof(buffer))) > 0 ) {
+        cPosition += cReaded;
+    }
+    PLZMA_TESTS_ASSERT(cStream.exception == nullptr)
+    PLZMA_TESTS_ASSERT(cPosition == firstItemSize)
+    PLZMA_TESTS_ASSERT(plzma_item_stream_position(&cStream) == firstItemSize)
+    plzma_item_stream_release(&cStream);
+    plzma_item_release(&cItem);
+    plzma_decoder_release(&cDecoder);
+#endif
+#endif
+    return 0;
+}
+
+int test_plzma_extract_item_stream(void) {
+    int ret = 0;
+    if ( (ret = extract_item_stream(plzma_file_type_7z)) ) {
+        return ret;
+    }
+    if ( (ret = extract_item_stream(plzma_file_type_xz)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_TAR)
+    return extract_item_stream(plzma_file_type_tar);
+#else
+    return ret;
+#endif
+}
+
+struct SequentialContext final {
+    const uint8_t * data;
+    size_t size;
+    size_t offset;
+};
+
+static bool sequential_open_callback(void * LIBPLZMA_NULLABLE context) {
+    static_cast<SequentialContext *>(context)->offset = 0;
+    return true;
+}
+
+static void sequential_close_callback(void * LIBPLZMA_NULLABLE context) {
+    
+}
+
+static bool sequential_read_callback(void * LIBPLZMA_NULLABLE context, void * LIBPLZMA_NONNULL data, uint32_t size, uint32_t * LIBPLZMA_NONNULL processed_size) {
+    SequentialContext * sequentialContext = static_cast<SequentialContext *>(context);
+    // Short reads, similar to the pipe.
+    size_t available = sequentialContext->size - sequentialContext->offset;
+    available = (available > 4099) ? 4099 : available;
+    const size_t readSize = (size < available) ? size : available;
+    memcpy(data, sequentialContext->data + sequentialContext->offset, readSize);
+    sequentialContext->offset += readSize;
+    *processed_size = static_cast<uint32_t>(readSize);
+    return true;
+}
+
+static int extract_sequential(const plzma_file_type type) {
+    SequentialContext context{FILE__15_tar_PTR, FILE__15_tar_SIZE, 0};
+    if (type == plzma_file_type_xz) {
+        context.data = FILE__16_tar_xz_PTR;
+        context.size = FILE__16_tar_xz_SIZE;
+    }
+    
+    // Testing, the stream is read only once.
+    auto decoder = makeSharedDecoder(makeSharedSequentialInStream(sequential_open_callback,
+                                                                  sequential_close_callback,
+                                                                  sequential_read_callback,
+                                                                  plzma_context{&context, nullptr}), type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == ((type == plzma_file_type_xz) ? 1 : 0))
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    PLZMA_TESTS_ASSERT(context.offset == context.size)
+    try {
+        decoder->test();
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    
+    // Extracting.
+    decoder = makeSharedDecoder(makeSharedSequentialInStream(sequential_open_callback,
+                                                             sequential_close_callback,
+                                                             sequential_read_callback,
+                                                             plzma_context{&context, nullptr}), type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    if (type == plzma_file_type_xz) {
+        auto outStream = makeSharedOutStream();
+        auto itemsStreams = makeShared<ItemOutStreamArray>();
+        itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(0), outStream));
+        PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+        const auto itemContent = outStream->copyContent();
+        PLZMA_TESTS_ASSERT(itemContent.second == FILE__15_tar_SIZE)
+        PLZMA_TESTS_ASSERT(memcmp(itemContent.first, FILE__15_tar_PTR, FILE__15_tar_SIZE) == 0)
+    } else {
+        auto outPath = Path::tmpPath();
+        outPath.appendRandomComponent();
+        PLZMA_TESTS_ASSERT(decoder->extract(outPath) == true)
+        
+        // The extracted files are the items of the same tar opened via the seekable stream.
+        auto itemsDecoder = makeSharedDecoder(makeSharedInStream(FILE__15_tar_PTR, FILE__15_tar_SIZE, &dummy_free_callback), type);
+        PLZMA_TESTS_ASSERT(itemsDecoder->open() == true)
+        PLZMA_TESTS_ASSERT(itemsDecoder->count() == 5)
+        RawHeapMemory itemContent(FILE__zombies_jpg_SIZE);
+        for (plzma_size_t i = 0; i < itemsDecoder->count(); i++) {
+            auto item = itemsDecoder->itemAt(i);
+            FILE * file = outPath.appending(item->path()).openFile("rb");
+            PLZMA_TESTS_ASSERT(file != nullptr)
+            const size_t readed = fread(itemContent, 1, FILE__zombies_jpg_SIZE, file);
+            fclose(file);
+            PLZMA_TESTS_ASSERT(itemContentMustMatch(item, static_cast<const void *>(itemContent), readed) == 0)
+        }
+        PLZMA_TESTS_ASSERT(outPath.remove() == true)
+    }
+    
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+    plzma_in_stream cInStream = plzma_in_stream_create_sequential_with_callbacks(sequential_open_callback,
+                                                                                 sequential_close_callback,
+                                                                                 sequential_read_callback,
+                                                                                 plzma_context{&context, nullptr});
+    PLZMA_TESTS_ASSERT(cInStream.exception == nullptr)
+    plzma_decoder cDecoder = plzma_decoder_create(&cInStream, type, plzma_context{nullptr, nullptr});
+    plzma_in_stream_release(&cInStream);
+    PLZMA_TESTS_ASSERT(cDecoder.exception == nullptr)
+    PLZMA_TESTS_ASSERT(plzma_decoder_open(&cDecoder) == true)
+    PLZMA_TESTS_ASSERT(plzma_decoder_test(&cDecoder) == true)
+    PLZMA_TESTS_ASSERT(cDecoder.exception == nullptr)
+    plzma_decoder_release(&cDecoder);
+#endif
+    return 0;
+}
+
+int test_plzma_extract_sequential(void) {
+    int ret = 0;
+    if ( (ret = extract_sequential(plzma_file_type_xz)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_TAR)
+    if ( (ret = extract_sequential(plzma_file_type_tar)) ) {
+        return ret;
+    }
+#endif
+    SequentialContext context{FILE__2_7z_PTR, FILE__2_7z_SIZE, 0};
+    try {
+        makeSharedDecoder(makeSharedSequentialInStream(sequential_open_callback,
+                                                       sequential_close_callback,
+                                                       sequential_read_callback,
+                                                       plzma_context{&context, nullptr}), plzma_file_type_7z);
+        PLZMA_TESTS_ASSERT(false)
+    } catch (const Exception & exception) {
+        PLZMA_TESTS_ASSERT(exception.code() == plzma_error_code_invalid_arguments)
+    }
+    return ret;
+}
+
+static int extract_lzma_kernel(const plzma_file_type type, const plzma_method method, const plzma_method_properties & properties) {
+    // Literals, short and long distance matches, rep matches, single byte runs and the dictionary wrap.
+    const size_t size = 768 * 1024;
+    RawHeapMemory content(size);
+    uint8_t * contentPtr = content;
+    const char * words[] = { "lzma ", "decoder ", "kernel ", "x86-64 ", "portable ", "range ", "coder ", "\n" };
+    uint32_t seed = static_cast<uint32_t>(type * 16 + method);
+    size_t offset = 0;
+    while (offset < size) {
+        seed = seed * 1103515245 + 12345;
+        const size_t chunk = 1 + ((seed >> 8) % 4096);
+        const size_t length = ((offset + chunk) < size) ? chunk : (size - offset);
+        const unsigned kind = (seed >> 24) % 4;
+        switch (((kind == 2) && (offset <= length)) ? 3 : kind) {
+            case 0:
+                for (size_t i = 0; i < length; i++) {
+                    seed = seed * 1103515245 + 12345;
+                    contentPtr[offset + i] = static_cast<uint8_t>(seed >> 16);
+                }
+                break;
+            case 1:
+                memset(contentPtr + offset, static_cast<int>(seed & 0xFF), length);
+                break;
+            case 2:
+                memcpy(contentPtr + offset, contentPtr + ((seed >> 4) % (offset - length)), length);
+                break;
+            default:
+                for (size_t i = 0; i < length; ) {
+                    seed = seed * 1103515245 + 12345;
+                    const char * word = words[(seed >> 16) % 8];
+                    for (size_t j = 0; word[j] && i < length; j++, i++) {
+                        contentPtr[offset + i] = static_cast<uint8_t>(word[j]);
+                    }
+                }
+                break;
+        }
+        offset += length;
+    }
+    
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, type, method);
+    encoder->setMethodProperties(properties);
+    encoder->add(makeSharedInStream(contentPtr, size, &dummy_free_callback), Path("content.bin"));
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto archiveContent = archiveStream->copyContent();
+    
+    // Once with the optimized kernel and once with the portable C kernel, the outputs are identical.
+    const bool optimized = plzma_lzma_decoder_optimized();
+    RawHeapMemorySize outputs[2];
+    for (int kernel = 0; kernel < 2; kernel++) {
+        plzma_set_lzma_decoder_optimized(kernel == 0);
+        auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, &dummy_free_callback), type);
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        auto outStream = makeSharedOutStream();
+        auto itemsStreams = makeShared<ItemOutStreamArray>();
+        itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(0), outStream));
+        PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+        outputs[kernel] = outStream->copyContent();
+        PLZMA_TESTS_ASSERT(outputs[kernel].second == size)
+        PLZMA_TESTS_ASSERT(memcmp(outputs[kernel].first, contentPtr, size) == 0)
+    }
+    plzma_set_lzma_decoder_optimized(optimized);
+    PLZMA_TESTS_ASSERT(memcmp(outputs[0].first, outputs[1].first, size) == 0)
+    return 0;
+}
+
+static int extract_lzma_kernel_file(const plzma_file_type type, void * archive, const size_t archiveSize) {
+    const bool optimized = plzma_lzma_decoder_optimized();
+    RawHeapMemorySize outputs[2][5];
+    plzma_size_t itemsCount = 0;
+    for (int kernel = 0; kernel < 2; kernel++) {
+        plzma_set_lzma_decoder_optimized(kernel == 0);
+        auto decoder = makeSharedDecoder(makeSharedInStream(archive, archiveSize, &dummy_free_callback), type);
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        itemsCount = decoder->count();
+        PLZMA_TESTS_ASSERT(itemsCount == ((type == plzma_file_type_xz) ? 1 : 5))
+        auto itemsStreams = makeShared<ItemOutStreamArray>(itemsCount);
+        for (plzma_size_t i = 0; i < itemsCount; i++) {
+            itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(i), makeSharedOutStream()));
+        }
+        PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+        for (plzma_size_t i = 0; i < itemsCount; i++) {
+            const auto & pair = itemsStreams->at(i);
+            outputs[kernel][i] = pair.second->copyContent();
+            if (type == plzma_file_type_xz) {
+                PLZMA_TESTS_ASSERT(outputs[kernel][i].second == FILE__15_tar_SIZE)
+                PLZMA_TESTS_ASSERT(memcmp(outputs[kernel][i].first, FILE__15_tar_PTR, FILE__15_tar_SIZE) == 0)
+            } else {
+                PLZMA_TESTS_ASSERT(itemContentMustMatch(pair.first, outputs[kernel][i]) == 0)
+            }
+        }
+    }
+    plzma_set_lzma_decoder_optimized(optimized);
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        PLZMA_TESTS_ASSERT(outputs[0][i].second == outputs[1][i].second)
+        PLZMA_TESTS_ASSERT(memcmp(outputs[0][i].first, outputs[1][i].first, outputs[0][i].second) == 0)
+    }
+    return 0;
+}
+
+int test_plzma_extract_lzma_kernel(void) {
+    const bool optimized = plzma_lzma_decoder_optimized();
+    plzma_set_lzma_decoder_optimized(false);
+    PLZMA_TESTS_ASSERT(plzma_lzma_decoder_optimized() == false)
+    plzma_set_lzma_decoder_optimized(true);
+    PLZMA_TESTS_ASSERT(plzma_lzma_decoder_optimized() == optimized)
+    std::flush(std::cout) << "LZMA decoder kernel: " << (optimized ? "optimized" : "portable") << std::endl;
+    
+    int ret = 0;
+    // The small dictionary is being wrapped, so the matches are also copied across the dictionary's buffer end.
+    plzma_method_properties properties = { 64 * 1024, 0, 0, 0, plzma_match_finder_default, -1, -1, -1 };
+    if ( (ret = extract_lzma_kernel(plzma_file_type_7z, plzma_method_LZMA, properties)) ) {
+        return ret;
+    }
+    properties.literal_context_bits = 8;
+    properties.literal_position_bits = 4;
+    properties.position_bits = 4;
+    if ( (ret = extract_lzma_kernel(plzma_file_type_7z, plzma_method_LZMA, properties)) ) {
+        return ret;
+    }
+    properties.literal_context_bits = 0;
+    properties.literal_position_bits = 0;
+    properties.position_bits = 0;
+    if ( (ret = extract_lzma_kernel(plzma_file_type_7z, plzma_method_LZMA, properties)) ) {
+        return ret;
+    }
+    properties.literal_context_bits = 1;
+    properties.literal_position_bits = 3;
+    properties.position_bits = 1;
+    if ( (ret = extract_lzma_kernel(plzma_file_type_7z, plzma_method_LZMA2, properties)) ) {
+        return ret;
+    }
+    properties = { 0, 0, 0, 0, plzma_match_finder_default, -1, -1, -1 };
+    if ( (ret = extract_lzma_kernel(plzma_file_type_xz, plzma_method_LZMA2, properties)) ) {
+        return ret;
+    }
+    
+    // The Ultra LZMA2 and LZMA archives and the xz archive of the test files.
+    if ( (ret = extract_lzma_kernel_file(plzma_file_type_7z, FILE__3_7z_PTR, FILE__3_7z_SIZE)) ) {
+        return ret;
+    }
+    if ( (ret = extract_lzma_kernel_file(plzma_file_type_7z, FILE__4_7z_PTR, FILE__4_7z_SIZE)) ) {
+        return ret;
+    }
+    return extract_lzma_kernel_file(plzma_file_type_xz, FILE__16_tar_xz_PTR, FILE__16_tar_xz_SIZE);
+}
+
+static int extract_cpu_kernels(const plzma_file_type type, const bool encrypt) {
+    // The sizes around the 16 and 64 bytes folding steps of the carry-less multiplication CRC kernels.
+    const size_t sizes[] = { 1, 15, 16, 17, 63, 64, 65, 79, 127, 128, 129, 1000, 4096 + 7, 65536 + 13 };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const size_t size = sizes[s];
+        RawHeapMemory content(size);
+        uint8_t * contentPtr = content;
+        uint32_t seed = static_cast<uint32_t>(size + type);
+        for (size_t i = 0; i < size; i++) {
+            seed = seed * 1103515245 + 12345;
+            contentPtr[i] = static_cast<uint8_t>(seed >> 16);
+        }
+        
+        auto archiveStream = makeSharedOutStream();
+        auto encoder = makeSharedEncoder(archiveStream, type, plzma_method_LZMA2);
+#if !defined(LIBPLZMA_NO_CRYPTO)
+        if (encrypt) {
+            encoder->setPassword("1234");
+            encoder->setShouldEncryptContent(true);
+        }
+#endif
+        encoder->add(makeSharedInStream(contentPtr, size, &dummy_free_callback), Path("content.bin"));
+        PLZMA_TESTS_ASSERT(encoder->open() == true)
+        PLZMA_TESTS_ASSERT(encoder->compress() == true)
+        const auto archiveContent = archiveStream->copyContent();
+        
+        auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, &dummy_free_callback), type);
+#if !defined(LIBPLZMA_NO_CRYPTO)
+        if (encrypt) {
+            decoder->setPassword("1234");
+        }
+#endif
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        auto outStream = makeSharedOutStream();
+        auto itemsStreams = makeShared<ItemOutStreamArray>();
+        itemsStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(0), outStream));
+        // The decoder verifies the CRC32 of the 7z or CRC64 of the xz content.
+        PLZMA_TESTS_ASSERT(decoder->extract(itemsStreams) == true)
+        const auto itemContent = outStream->copyContent();
+        PLZMA_TESTS_ASSERT(itemContent.second == size)
+        PLZMA_TESTS_ASSERT(memcmp(itemContent.first, contentPtr, size) == 0)
+    }
+    return 0;
+}
+
+int test_plzma_extract_cpu_kernels(void) {
+    const plzma_kernel_t kernels = plzma_kernels();
+    PLZMA_TESTS_ASSERT(((kernels & plzma_kernel_lzma_decoder_optimized) != 0) == plzma_lzma_decoder_optimized())
+    PLZMA_TESTS_ASSERT(((kernels & plzma_kernel_aes_hw_256) == 0) || ((kernels & plzma_kernel_aes_hw) != 0))
+    std::flush(std::cout) << "Kernels:"
+    << ((kernels & plzma_kernel_crc32_clmul) ? " crc32-clmul" : " crc32")
+    << ((kernels & plzma_kernel_crc64_clmul) ? " crc64-clmul" : " crc64")
+    << ((kernels & plzma_kernel_sha256_hw) ? " sha256-hw" : " sha256")
+    << ((kernels & plzma_kernel_aes_hw_256) ? " aes-hw-256" : ((kernels & plzma_kernel_aes_hw) ? " aes-hw" : " aes"))
+    << ((kernels & plzma_kernel_lzma_decoder_optimized) ? " lzma-optimized" : " lzma") << std::endl;
+    
+    int ret = 0;
+    if ( (ret = extract_cpu_kernels(plzma_file_type_7z, false)) ) {
+        return ret;
+    }
+    if ( (ret = extract_cpu_kernels(plzma_file_type_7z, true)) ) {
+        return ret;
+    }
+    if ( (ret = extract_cpu_kernels(plzma_file_type_xz, false)) ) {
+        return ret;
+    }
+    
+#if !defined(LIBPLZMA_NO_CRYPTO)
+    // The encrypted test files: AES content, the SHA-256 key derivation and the CRC32 of the items.
+    void * archives[4] = { FILE__5_7z_PTR, FILE__6_7z_PTR, FILE__7_7z_PTR, FILE__8_7z_PTR };
+    const size_t archivesSizes[4] = { FILE__5_7z_SIZE, FILE__6_7z_SIZE, FILE__7_7z_SIZE, FILE__8_7z_SIZE };
+    for (size_t i = 0; i < 4; i++) {
+        auto decoder = makeSharedDecoder(makeSharedInStream(archives[i], archivesSizes[i], &dummy_free_callback), plzma_file_type_7z);
+        decoder->setPassword("1234");
+        PLZMA_TESTS_ASSERT(decoder->open() == true)
+        PLZMA_TESTS_ASSERT(decoder->count() == 5)
+        PLZMA_TESTS_ASSERT(decoder->test() == true)
+    }
+#endif
+    return ret;
+}
+
+#if !defined(LIBPLZMA_NO_PROGRESS)
+class CountingProgressDelegate : public ProgressDelegate {
+public:
+    String lastPath;
+    double lastProgress = 0.0;
+    size_t count = 0;
+    
+    virtual void onProgress(void * LIBPLZMA_NULLABLE context, const String & path, const double progress) override final {
+        lastPath = path;
+        lastProgress = progress;
+        count++;
+    }
+    virtual ~CountingProgressDelegate() { }
+};
+
+static size_t extract_progress_reports(void * archive, const size_t archiveSize) {
+    CountingProgressDelegate delegate;
+    auto decoder = makeSharedDecoder(makeSharedInStream(archive, archiveSize, &dummy_free_callback), plzma_file_type_7z);
+    decoder->setProgressDelegate(&delegate);
+    if (!decoder->open() || decoder->count() != 5 || !decoder->test()) {
+        return 0;
+    }
+    decoder->setProgressDelegate(nullptr);
+    return (delegate.lastProgress == 1.0 && delegate.lastPath.count() > 0) ? delegate.count : 0;
+}
+
+static int extract_progress_throttling(void * archive, const size_t archiveSize, const bool solid) {
+    // Every item's path and progress change is reported by default.
+    const size_t reports = extract_progress_reports(archive, archiveSize);
+    PLZMA_TESTS_ASSERT(reports > 5)
+    
+    // The path changes are reported, the progress changes only after each quarter and the completion.
+    plzma_set_progress_min_delta(0.25);
+    const size_t deltaReports = extract_progress_reports(archive, archiveSize);
+    PLZMA_TESTS_ASSERT(deltaReports >= 5)
+    // The single solid block of small items reports the progress only per item.
+    PLZMA_TESTS_ASSERT(solid ? (deltaReports <= reports) : (deltaReports < reports))
+    
+    // Only the first report and the completion.
+    plzma_set_progress_min_interval(3600.0);
+    const size_t intervalReports = extract_progress_reports(archive, archiveSize);
+    PLZMA_TESTS_ASSERT(intervalReports > 0)
+    PLZMA_TESTS_ASSERT(intervalReports <= 2)
+    
+    plzma_set_progress_min_interval(0.0);
+    plzma_set_progress_min_delta(0.0);
+    std::flush(std::cout) << "Progress reports: " << reports << ", min delta: " << deltaReports << ", min interval: " << intervalReports << std::endl;
+    return 0;
+}
+#endif
+
+int test_plzma_extract_progress_throttling(void) {
+    int ret = 0;
+#if !defined(LIBPLZMA_NO_PROGRESS)
+    if ( (ret = extract_progress_throttling(FILE__1_7z_PTR, FILE__1_7z_SIZE, false)) ) {
+        return ret;
+    }
+    if ( (ret = extract_progress_throttling(FILE__2_7z_PTR, FILE__2_7z_SIZE, true)) ) {
+        return ret;
+    }
+#endif
+    return ret;
+}
+
+#if !defined(LIBPLZMA_NO_PROGRESS)
+class StatsProgressDelegate : public ProgressDelegate {
+public:
+    Decoder * decoder = nullptr;
+    plzma_stats last{0, 0, 0, 0, 0.0, 0.0};
+    size_t decreases = 0;
+    
+    virtual void onProgress(void * LIBPLZMA_NULLABLE context, const String & path, const double progress) override final {
+        const plzma_stats stats = decoder->stats(); // during the operation
+        if (stats.out_size < last.out_size || stats.items_completed < last.items_completed) {
+            decreases++;
+        }
+        last = stats;
+    }
+    virtual ~StatsProgressDelegate() { }
+};
+#endif
+
+static int extract_stats(void * archive, const size_t archiveSize, const bool solid, const bool parallel) {
+    const uint64_t contentSize = FILE__munchen_jpg_SIZE + FILE__shutuptakemoney_jpg_SIZE + FILE__southpark_jpg_SIZE + FILE__zombies_jpg_SIZE + FILE__munchen_jpg_SIZE;
+    auto decoder = makeSharedDecoder(makeSharedInStream(archive, archiveSize, &dummy_free_callback), plzma_file_type_7z);
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    decoder->setShouldExtractInParallel(parallel);
+#endif
+#if !defined(LIBPLZMA_NO_PROGRESS)
+    StatsProgressDelegate delegate;
+    delegate.decoder = decoder.get();
+    decoder->setProgressDelegate(&delegate);
+#endif
+    plzma_stats stats = decoder->stats();
+    PLZMA_TESTS_ASSERT(stats.in_size == 0 && stats.out_size == 0 && stats.items_count == 0 && stats.elapsed == 0.0)
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    
+    stats = decoder->stats();
+    PLZMA_TESTS_ASSERT(stats.in_size > 0 && stats.in_size < archiveSize)
+    PLZMA_TESTS_ASSERT(stats.out_size == contentSize)
+    PLZMA_TESTS_ASSERT(stats.items_count == 5)
+    PLZMA_TESTS_ASSERT(stats.items_completed == 5)
+    PLZMA_TESTS_ASSERT(solid ? (stats.ratio > 1.0) : (stats.ratio > 0.0))
+    PLZMA_TESTS_ASSERT(stats.elapsed >= 0.0)
+#if !defined(LIBPLZMA_NO_PROGRESS)
+    PLZMA_TESTS_ASSERT(delegate.last.items_count == 5)
+    PLZMA_TESTS_ASSERT(delegate.decreases == 0)
+#endif
+    
+    // The counters are reset by the next operation.
+    auto items = makeShared<ItemArray>(2);
+    items->push(decoder->itemAt(1));
+    items->push(decoder->itemAt(3));
+    PLZMA_TESTS_ASSERT(decoder->extractToArena(items) == true)
+    stats = decoder->stats();
+    PLZMA_TESTS_ASSERT(stats.out_size >= FILE__shutuptakemoney_jpg_SIZE + FILE__zombies_jpg_SIZE)
+    PLZMA_TESTS_ASSERT(stats.out_size <= contentSize)
+    PLZMA_TESTS_ASSERT(stats.items_count == 2)
+    PLZMA_TESTS_ASSERT(stats.items_completed == 2)
+#if !defined(LIBPLZMA_NO_PROGRESS)
+    decoder->setProgressDelegate(nullptr);
+#endif
+    return 0;
+}
+
+static int encode_stats(void) {
+    const uint64_t contentSize = FILE__shutuptakemoney_jpg_SIZE + FILE__southpark_jpg_SIZE + FILE__zombies_jpg_SIZE;
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, plzma_file_type_7z, plzma_method_LZMA2);
+    encoder->setCompressionLevel(1);
+    encoder->add(makeSharedInStream(FILE__shutuptakemoney_jpg_PTR, FILE__shutuptakemoney_jpg_SIZE, &dummy_free_callback), Path("shutuptakemoney.jpg"));
+    encoder->add(makeSharedInStream(FILE__southpark_jpg_PTR, FILE__southpark_jpg_SIZE, &dummy_free_callback), Path("SouthPark.jpg"));
+    encoder->add(makeSharedInStream(FILE__zombies_jpg_PTR, FILE__zombies_jpg_SIZE, &dummy_free_callback), Path("zombies.jpg"));
+    plzma_stats stats = encoder->stats();
+    PLZMA_TESTS_ASSERT(stats.in_size == 0 && stats.out_size == 0 && stats.items_count == 0 && stats.elapsed == 0.0)
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto archiveContent = archiveStream->copyContent();
+    
+    stats = encoder->stats();
+    PLZMA_TESTS_ASSERT(stats.in_size == contentSize)
+    PLZMA_TESTS_ASSERT(stats.out_size > 0 && stats.out_size < archiveContent.second)
+    PLZMA_TESTS_ASSERT(stats.items_count == 3)
+    PLZMA_TESTS_ASSERT(stats.items_completed == 3)
+    PLZMA_TESTS_ASSERT(stats.ratio > 0.0)
+    PLZMA_TESTS_ASSERT(stats.elapsed >= 0.0)
+    const double elapsed = stats.elapsed;
+    PLZMA_TESTS_ASSERT(encoder->stats().elapsed == elapsed) // finished
+    return 0;
+}
+
+int test_plzma_extract_stats(void) {
+    int ret = 0;
+    if ( (ret = extract_stats(FILE__2_7z_PTR, FILE__2_7z_SIZE, true, false)) ) {
+        return ret;
+    }
+    if ( (ret = extract_stats(FILE__1_7z_PTR, FILE__1_7z_SIZE, false, false)) ) {
+        return ret;
+    }
+    if ( (ret = extract_stats(FILE__1_7z_PTR, FILE__1_7z_SIZE, false, true)) ) {
+        return ret;
+    }
+    return encode_stats();
+}
+
+static int extract_item_table(void * archive, const size_t archiveSize, const bool encrypted) {
+    auto decoder = makeSharedDecoder(makeSharedInStream(archive, archiveSize, &dummy_free_callback), plzma_file_type_7z);
+#if !defined(LIBPLZMA_NO_CRYPTO)
+    if (encrypted) {
+        decoder->setPassword("1234");
+    }
+#endif
+    PLZMA_TESTS_ASSERT(!decoder->itemTable()) // not opened
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    auto table = decoder->itemTable();
+    PLZMA_TESTS_ASSERT(table)
+    PLZMA_TESTS_ASSERT(decoder->itemTable().get() == table.get()) // built once
+    PLZMA_TESTS_ASSERT(table->count() == 5)
+    PLZMA_TESTS_ASSERT(table->count() == decoder->count())
+    for (plzma_size_t i = 0; i < table->count(); i++) {
+        auto item = decoder->itemAt(i);
+        PLZMA_TESTS_ASSERT(strcmp(table->pathAt(i), item->path().utf8()) == 0)
+        PLZMA_TESTS_ASSERT(table->sizeAt(i) == item->size())
+        PLZMA_TESTS_ASSERT(table->packSizeAt(i) == item->packSize())
+        PLZMA_TESTS_ASSERT(table->crc32At(i) == item->crc32())
+        PLZMA_TESTS_ASSERT(table->crc32At(i) != 0)
+        const plzma_path_timestamp timestamp = table->timestampAt(i);
+        PLZMA_TESTS_ASSERT(timestamp.creation == item->creationTime())
+        PLZMA_TESTS_ASSERT(timestamp.last_access == item->accessTime())
+        PLZMA_TESTS_ASSERT(timestamp.last_modification == item->modificationTime())
+        PLZMA_TESTS_ASSERT(table->encryptedAt(i) == item->encrypted())
+        PLZMA_TESTS_ASSERT(table->encryptedAt(i) == encrypted)
+        PLZMA_TESTS_ASSERT(table->isDirAt(i) == item->isDir())
+        PLZMA_TESTS_ASSERT(table->isDirAt(i) == false)
+        
+        auto tableItem = table->itemAt(i);
+        PLZMA_TESTS_ASSERT(tableItem.get() != item.get())
+        PLZMA_TESTS_ASSERT(tableItem->index() == i)
+        PLZMA_TESTS_ASSERT(tableItem->path() == item->path())
+        PLZMA_TESTS_ASSERT(tableItem->size() == item->size())
+        PLZMA_TESTS_ASSERT(tableItem->crc32() == item->crc32())
+        PLZMA_TESTS_ASSERT(tableItem->encrypted() == item->encrypted())
+    }
+    PLZMA_TESTS_ASSERT(table->sizeAt(0) == FILE__munchen_jpg_SIZE)
+    PLZMA_TESTS_ASSERT(table->sizeAt(3) == FILE__zombies_jpg_SIZE)
+    PLZMA_TESTS_ASSERT(strcmp(table->pathAt(2), "SouthPark.jpg") == 0)
+    
+    bool outOfBounds = false;
+    try {
+        table->pathAt(table->count());
+    } catch (const Exception & exception) {
+        outOfBounds = exception.code() == plzma_error_code_invalid_arguments;
+    }
+    PLZMA_TESTS_ASSERT(outOfBounds == true)
+    
+    // The table outlives the decoder.
+    decoder.clear();
+    PLZMA_TESTS_ASSERT(table->sizeAt(4) == FILE__munchen_jpg_SIZE)
+    return 0;
+}
+
+int test_plzma_extract_item_table(void) {
+    int ret = 0;
+    if ( (ret = extract_item_table(FILE__1_7z_PTR, FILE__1_7z_SIZE, false)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_CRYPTO)
+    if ( (ret = extract_item_table(FILE__5_7z_PTR, FILE__5_7z_SIZE, true)) ) {
+        return ret;
+    }
+#endif
+    return ret;
+}
+
+int test_plzma_extract_find_items(void) {
+    const plzma_size_t itemsCount = 300;
+    char content[] = "find items content";
+    auto archiveStream = makeSharedOutStream();
+    auto encoder = makeSharedEncoder(archiveStream, plzma_file_type_7z, plzma_method_LZMA);
+    char name[64];
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        snprintf(name, sizeof(name), (i % 3) ? "dir%u/item_%u.txt" : "dir%u/\xd1\x84_%u.bin", static_cast<unsigned>(i % 3), static_cast<unsigned>(i));
+        encoder->add(makeSharedInStream(content, (i % 17) + 1, &dummy_free_callback), Path(name));
+    }
+    PLZMA_TESTS_ASSERT(encoder->open() == true)
+    PLZMA_TESTS_ASSERT(encoder->compress() == true)
+    const auto archiveContent = archiveStream->copyContent();
+    
+    auto decoder = makeSharedDecoder(makeSharedInStream(archiveContent.first, archiveContent.second, &dummy_free_callback), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(!decoder->findItem(Path("dir1/item_1.txt"))) // not opened
+    PLZMA_TESTS_ASSERT(!decoder->findItems(Path("*")))
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        snprintf(name, sizeof(name), (i % 3) ? "dir%u/item_%u.txt" : "dir%u/\xd1\x84_%u.bin", static_cast<unsigned>(i % 3), static_cast<unsigned>(i));
+        auto item = decoder->findItem(Path(name));
+        PLZMA_TESTS_ASSERT(item)
+        PLZMA_TESTS_ASSERT(strcmp(item->path().utf8(), name) == 0)
+        PLZMA_TESTS_ASSERT(item->size() == (i % 17) + 1)
+        PLZMA_TESTS_ASSERT(decoder->itemAt(item->index())->path() == item->path())
+    }
+    PLZMA_TESTS_ASSERT(!decoder->findItem(Path("dir1/item_0.txt")))
+    PLZMA_TESTS_ASSERT(!decoder->findItem(Path("dir1")))
+    PLZMA_TESTS_ASSERT(!decoder->findItem(Path("item_1.txt")))
+    
+    auto items = decoder->findItems(Path("*"));
+    PLZMA_TESTS_ASSERT(items->count() == itemsCount)
+    items = decoder->findItems(Path("dir0/*"));
+    PLZMA_TESTS_ASSERT(items->count() == itemsCount / 3)
+    for (plzma_size_t i = 1; i < items->count(); i++) {
+        PLZMA_TESTS_ASSERT(items->at(i - 1)->index() < items->at(i)->index())
+    }
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("*.bin"))->count() == itemsCount / 3)
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("dir?/\xd1\x84_?.bin"))->count() == 4) // 0, 3, 6, 9
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("dir2/item_2*"))->count() == 1 + 4 + 34) // 2, 2x, 2xx
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("dir1/item_1.txt"))->count() == 1)
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("*.zip"))->count() == 0)
+    
+    decoder = makeSharedDecoder(makeSharedInStream(FILE__1_7z_PTR, FILE__1_7z_SIZE, &dummy_free_callback), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    auto item = decoder->findItem(Path("zombies.jpg"));
+    PLZMA_TESTS_ASSERT(item)
+    PLZMA_TESTS_ASSERT(item->index() == 3)
+    auto itemStreams = makeShared<ItemOutStreamArray>(1);
+    itemStreams->push(ItemOutStreamArray::ElementType(item, makeSharedOutStream()));
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    PLZMA_TESTS_ASSERT(itemContentMustMatch(item, itemStreams->at(0).second->copyContent()) == 0)
+    item = decoder->findItem(Path("\xd0\x9c\xd1\x8e\xd0\xbd\xd1\x85\xd0\xb5\xd0\xbd.jpg")); // Мюнхен.jpg
+    PLZMA_TESTS_ASSERT(item)
+    PLZMA_TESTS_ASSERT(item->index() == 4)
+    PLZMA_TESTS_ASSERT(!decoder->findItem(Path("ZOMBIES.jpg")))
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("*.jpg"))->count() == 5)
+    PLZMA_TESTS_ASSERT(decoder->findItems(Path("S*"))->count() == 1)
+    return 0;
+}
+
+
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+/// @brief Extracts the items via the nested calls from the first progress report, while the decoder is busy.
+class ConcurrentProgressDelegate final : public ProgressDelegate {
+public:
+    SharedPtr<Decoder> decoder;
+    SharedPtr<ItemOutStreamArray> itemsStreams;
+    plzma_stats nestedStats{0, 0, 0, 0, 0.0, 0.0};
+    plzma_size_t extractedCount = 0;
+    plzma_size_t nestedReports = 0;
+    bool armed = false; // the delegate reports the last progress when it's set
+    bool nested = false;
+    bool started = false;
+    
+    virtual void onProgress(void * LIBPLZMA_NULLABLE context, const String & path, const double progress) override final {
+        if (nested) {
+            nestedReports++;
+            return;
+        }
+        if (!armed || started) {
+            return;
+        }
+        started = nested = true;
+        for (plzma_size_t i = 0; i < itemsStreams->count(); i++) {
+            auto itemStreams = makeShared<ItemOutStreamArray>(1);
+            itemStreams->push(ItemOutStreamArray::ElementType(itemsStreams->at(i).first, itemsStreams->at(i).second));
+            if (decoder->extract(itemStreams)) {
+                extractedCount++;
+            }
+        }
+        nestedStats = decoder->stats();
+        nested = false;
+    }
+    
+    virtual ~ConcurrentProgressDelegate() { }
+};
+
+static int concurrentItemMustMatch(const plzma_file_type type, const SharedPtr<Item> & item, const SharedPtr<OutStream> & stream) {
+    const auto content = stream->copyContent();
+    if (type == plzma_file_type_xz) {
+        PLZMA_TESTS_ASSERT(content.second == FILE__15_tar_SIZE)
+        PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(content.first), FILE__15_tar_PTR, FILE__15_tar_SIZE) == 0)
+        return 0;
+    }
+    return itemContentMustMatch(item, content);
+}
+
+static int extract_concurrent(const plzma_file_type type) {
+    SharedPtr<InStream> archiveStream;
+    switch (type) {
+        case plzma_file_type_7z: archiveStream = makeSharedInStream(FILE__2_7z_PTR, FILE__2_7z_SIZE, &dummy_free_callback); break;
+        case plzma_file_type_xz: archiveStream = makeSharedInStream(FILE__16_tar_xz_PTR, FILE__16_tar_xz_SIZE, &dummy_free_callback); break;
+        default: archiveStream = makeSharedInStream(FILE__15_tar_PTR, FILE__15_tar_SIZE, &dummy_free_callback); break;
+    }
+    auto decoder = makeSharedDecoder(archiveStream, type);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    const plzma_size_t itemsCount = decoder->count();
+    PLZMA_TESTS_ASSERT(itemsCount == ((type == plzma_file_type_xz) ? 1 : 5))
+    
+    // Each thread extracts own item while the others are in progress, the busy decoder must not reject the calls.
+    auto items = decoder->items();
+    bool extracted[5];
+    SharedPtr<OutStream> streams[5];
+    std::thread threads[5];
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        extracted[i] = false;
+        streams[i] = makeSharedOutStream();
+        threads[i] = std::thread([&, i]() {
+            try {
+                auto itemStreams = makeShared<ItemOutStreamArray>(1);
+                itemStreams->push(ItemOutStreamArray::ElementType(items->at(i), SharedPtr<OutStream>(streams[i])));
+                extracted[i] = decoder->extract(itemStreams);
+            } catch (...) {
+                extracted[i] = false;
+            }
+        });
+    }
+    const bool tested = decoder->test();
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        threads[i].join();
+    }
+    PLZMA_TESTS_ASSERT(tested == true)
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        PLZMA_TESTS_ASSERT(extracted[i] == true)
+        PLZMA_TESTS_ASSERT(concurrentItemMustMatch(type, items->at(i), streams[i]) == 0)
+    }
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    
+    // The nested calls made while the decoder is testing report the progress and are counted by the stats.
+    ConcurrentProgressDelegate delegate;
+    delegate.decoder = decoder;
+    delegate.itemsStreams = makeShared<ItemOutStreamArray>(itemsCount);
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        delegate.itemsStreams->push(ItemOutStreamArray::ElementType(items->at(i), makeSharedOutStream()));
+    }
+    decoder->setProgressDelegate(&delegate);
+    delegate.armed = true;
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    decoder->setProgressDelegate(nullptr);
+    delegate.decoder.clear();
+    PLZMA_TESTS_ASSERT(delegate.started == true)
+    PLZMA_TESTS_ASSERT(delegate.extractedCount == itemsCount)
+    PLZMA_TESTS_ASSERT(delegate.nestedReports > 0)
+    for (plzma_size_t i = 0; i < itemsCount; i++) {
+        const auto & pair = delegate.itemsStreams->at(i);
+        PLZMA_TESTS_ASSERT(concurrentItemMustMatch(type, pair.first, pair.second) == 0)
+    }
+    PLZMA_TESTS_ASSERT(delegate.nestedStats.items_count >= itemsCount)
+    PLZMA_TESTS_ASSERT(delegate.nestedStats.items_completed >= itemsCount)
+    const plzma_stats stats = decoder->stats();
+    PLZMA_TESTS_ASSERT(stats.items_count == itemsCount * 2)
+    PLZMA_TESTS_ASSERT(stats.items_completed == itemsCount * 2)
+    PLZMA_TESTS_ASSERT(stats.in_size > 0)
+    if (type == plzma_file_type_7z) { // the xz coder reports only the input size
+        PLZMA_TESTS_ASSERT(stats.out_size >= (FILE__munchen_jpg_SIZE + FILE__shutuptakemoney_jpg_SIZE + FILE__southpark_jpg_SIZE + FILE__zombies_jpg_SIZE + FILE__munchen_jpg_SIZE) * 2)
+    }
+    return 0;
+}
+#endif
+
+int test_plzma_extract_concurrent(void) {
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    int ret = 0;
+    if ( (ret = extract_concurrent(plzma_file_type_7z)) ) {
+        return ret;
+    }
+    if ( (ret = extract_concurrent(plzma_file_type_xz)) ) {
+        return ret;
+    }
+#if !defined(LIBPLZMA_NO_TAR)
+    if ( (ret = extract_concurrent(plzma_file_type_tar)) ) {
+        return ret;
+    }
+#endif
+#endif
+    return 0;
+}
+
+static int extract_cached_item(SharedPtr<Decoder> & decoder, const plzma_size_t index) {
+    auto itemStreams = makeShared<ItemOutStreamArray>(1);
+    itemStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(index), makeSharedOutStream()));
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    return itemContentMustMatch(itemStreams->at(0).first, itemStreams->at(0).second->copyContent());
+}
+
+static int extract_block_cache(const bool solid) {
+    uint8_t * archive = solid ? FILE__2_7z_PTR : FILE__1_7z_PTR;
+    const size_t archiveSize = solid ? FILE__2_7z_SIZE : FILE__1_7z_SIZE;
+    
+    // The decoders of the same archive file share the decoded blocks.
+    Path archivePath = Path::tmpPath();
+    archivePath.appendRandomComponent();
+    FILE * archiveFile = archivePath.openFile("wb");
+    PLZMA_TESTS_ASSERT(archiveFile != nullptr)
+    PLZMA_TESTS_ASSERT(fwrite(archive, 1, archiveSize, archiveFile) == archiveSize)
+    fclose(archiveFile);
+    
+    // Solid archive has a single block with all items, each item of non-solid archive is a separate block.
+    const uint64_t contentSize = FILE__munchen_jpg_SIZE + FILE__shutuptakemoney_jpg_SIZE + FILE__southpark_jpg_SIZE + FILE__zombies_jpg_SIZE + FILE__munchen_jpg_SIZE;
+    const uint64_t capacity = solid ? contentSize : (FILE__zombies_jpg_SIZE + FILE__southpark_jpg_SIZE);
+    auto cache = makeSharedBlockCache(capacity);
+    PLZMA_TESTS_ASSERT(cache->capacity() == capacity)
+    PLZMA_TESTS_ASSERT(cache->count() == 0 && cache->size() == 0 && cache->hits() == 0)
+    
+    auto decoder = makeSharedDecoder(makeSharedInStream(archivePath), plzma_file_type_7z);
+    decoder->setBlockCache(cache);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 2) == 0)
+    PLZMA_TESTS_ASSERT(cache->count() == 1 && cache->size() == (solid ? contentSize : FILE__southpark_jpg_SIZE) && cache->hits() == 0)
+    PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 2) == 0)
+    PLZMA_TESTS_ASSERT(cache->hits() == 1)
+    
+    // The item copied from the cached block is counted by the stats.
+    plzma_stats stats = decoder->stats();
+    PLZMA_TESTS_ASSERT(stats.items_count == 1 && stats.items_completed == 1)
+    PLZMA_TESTS_ASSERT(stats.out_size == FILE__southpark_jpg_SIZE)
+    
+    PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 4) == 0)
+    PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 0) == 0)
+    if (solid) {
+        PLZMA_TESTS_ASSERT(cache->count() == 1 && cache->hits() == 3)
+    } else {
+        PLZMA_TESTS_ASSERT(cache->count() == 3 && cache->size() == FILE__southpark_jpg_SIZE + 2 * FILE__munchen_jpg_SIZE && cache->hits() == 1)
+        // The least recently used block of the item 2 is removed.
+        PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 3) == 0)
+        PLZMA_TESTS_ASSERT(cache->count() == 3 && cache->size() == FILE__zombies_jpg_SIZE + 2 * FILE__munchen_jpg_SIZE && cache->hits() == 1)
+        PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 2) == 0)
+        PLZMA_TESTS_ASSERT(cache->count() == 2 && cache->size() == capacity && cache->hits() == 1)
+        PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 3) == 0)
+        PLZMA_TESTS_ASSERT(cache->hits() == 2)
+    }
+    
+    uint64_t hits = cache->hits();
+    auto otherDecoder = makeSharedDecoder(makeSharedInStream(archivePath), plzma_file_type_7z);
+    otherDecoder->setBlockCache(cache);
+    PLZMA_TESTS_ASSERT(otherDecoder->open() == true)
+    PLZMA_TESTS_ASSERT(extract_cached_item(otherDecoder, 3) == 0)
+    PLZMA_TESTS_ASSERT(cache->hits() == hits + 1)
+    
+    // The same content of the other stream is a different source, its blocks are decoded.
+    hits = cache->hits();
+    auto memoryDecoder = makeSharedDecoder(makeSharedInStream(archive, archiveSize, &dummy_free_callback), plzma_file_type_7z);
+    memoryDecoder->setBlockCache(cache);
+    PLZMA_TESTS_ASSERT(memoryDecoder->open() == true)
+    PLZMA_TESTS_ASSERT(extract_cached_item(memoryDecoder, 3) == 0)
+    PLZMA_TESTS_ASSERT(cache->hits() == hits)
+    PLZMA_TESTS_ASSERT(extract_cached_item(memoryDecoder, 3) == 0)
+    PLZMA_TESTS_ASSERT(cache->hits() == hits + 1)
+    
+    // All items together, some of them are cached.
+    auto items = otherDecoder->items();
+    auto itemStreams = makeShared<ItemOutStreamArray>(items->count());
+    for (plzma_size_t i = 0; i < items->count(); i++) {
+        itemStreams->push(ItemOutStreamArray::ElementType(items->at(i), makeSharedOutStream()));
+    }
+    PLZMA_TESTS_ASSERT(otherDecoder->extract(itemStreams) == true)
+    for (plzma_size_t i = 0; i < itemStreams->count(); i++) {
+        const auto & pair = itemStreams->at(i);
+        PLZMA_TESTS_ASSERT(itemContentMustMatch(pair.first, pair.second->copyContent()) == 0)
+    }
+    PLZMA_TESTS_ASSERT(cache->size() <= cache->capacity())
+    stats = otherDecoder->stats();
+    PLZMA_TESTS_ASSERT(stats.items_count >= 5 && stats.items_completed == stats.items_count)
+    
+    // The blocks larger than the capacity are decoded as usual.
+    auto smallCache = makeSharedBlockCache(FILE__munchen_jpg_SIZE - 1);
+    otherDecoder->setBlockCache(smallCache);
+    PLZMA_TESTS_ASSERT(extract_cached_item(otherDecoder, 0) == 0)
+    PLZMA_TESTS_ASSERT(smallCache->count() == 0 && smallCache->size() == 0)
+    otherDecoder->setBlockCache(SharedPtr<BlockCache>());
+    PLZMA_TESTS_ASSERT(extract_cached_item(otherDecoder, 0) == 0)
+    
+    cache->clear();
+    PLZMA_TESTS_ASSERT(cache->count() == 0 && cache->size() == 0)
+    PLZMA_TESTS_ASSERT(extract_cached_item(decoder, 1) == 0)
+    PLZMA_TESTS_ASSERT(cache->count() == 1)
+    
+#if !defined(LIBPLZMA_NO_CRYPTO)
+    // The encrypted blocks are not cached.
+    cache->clear();
+    hits = cache->hits();
+    auto encryptedDecoder = makeSharedDecoder(makeSharedInStream(FILE__5_7z_PTR, FILE__5_7z_SIZE, &dummy_free_callback), plzma_file_type_7z);
+    encryptedDecoder->setPassword("1234");
+    encryptedDecoder->setBlockCache(cache);
+    PLZMA_TESTS_ASSERT(encryptedDecoder->open() == true)
+    PLZMA_TESTS_ASSERT(extract_cached_item(encryptedDecoder, 2) == 0)
+    PLZMA_TESTS_ASSERT(extract_cached_item(encryptedDecoder, 2) == 0)
+    PLZMA_TESTS_ASSERT(cache->count() == 0 && cache->hits() == hits)
+#endif
+    
+    decoder.clear();
+    otherDecoder.clear();
+    PLZMA_TESTS_ASSERT(archivePath.remove() == true)
+    return 0;
+}
+
+int test_plzma_extract_block_cache(void) {
+    int ret = 0;
+    if ( (ret = extract_block_cache(true)) ) {
+        return ret;
+    }
+    return extract_block_cache(false);
+}
+
 int test_plzma_extract_test_settings(void) {
     PLZMA_TESTS_ASSERT(plzma_stream_read_size() > 0)
     PLZMA_TESTS_ASSERT(plzma_stream_write_size() > 0)
     PLZMA_TESTS_ASSERT(plzma_decoder_read_size() > 0)
     PLZMA_TESTS_ASSERT(plzma_decoder_write_size() > 0)
+    PLZMA_TESTS_ASSERT(plzma_progress_min_interval() == 0.0)
+    PLZMA_TESTS_ASSERT(plzma_progress_min_delta() == 0.0)
+    plzma_set_progress_min_delta(-1.0);
+    PLZMA_TESTS_ASSERT(plzma_progress_min_delta() == 0.0)
     return 0;
 }
 
@@ -246,6 +1506,58 @@ int main(int argc, char* argv[]) {
             return ret;
         }
         
+        if ( (ret = test_plzma_extract_lzma_kernel()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_cpu_kernels()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_progress_throttling()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_stats()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_item_table()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_find_items()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_solid_small_items()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_parallel()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_concurrent()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_block_cache()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_to_arena()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_item_stream()) ) {
+            return ret;
+        }
+        
+        if ( (ret = test_plzma_extract_sequential()) ) {
+            return ret;
+        }
+        
         if ( (ret = test_plzma_extract_broken_input_stream1()) ) {
             return ret;
         }
@@ -301,3 +1613,17 @@ int main(int argc, char* argv[]) {
 }
 
 #include "../test_files/file__1_7z.h"
+#include "../test_files/file__2_7z.h"
+#include "../test_files/file__3_7z.h"
+#include "../test_files/file__4_7z.h"
+#include "../test_files/file__5_7z.h"
+#include "../test_files/file__6_7z.h"
+#include "../test_files/file__7_7z.h"
+#include "../test_files/file__8_7z.h"
+#include "../test_files/file__15_tar.h"
+#include "../test_files/file__16_tar_xz.h"
+
+#include "../test_files/file__munchen_jpg.h"
+#include "../test_files/file__shutuptakemoney_jpg.h"
+#include "../test_files/file__southpark_jpg.h"
+#include "../test_files/file__zombies_jpg.h"
@@ -25,8 +25,17 @@
 //
 
 
+#include <thread>
+
 #include "plzma_public_tests.hpp"
 
+#include "../test_files/file__1_7z.h"
+
+#include "../test_files/file__munchen_jpg.h"
+#include "../test_files/file__shutuptakemoney_jpg.h"
+#include "../test_files/file__southpark_jpg.h"
+#include "../test_files/file__zombies_jpg.h"
+
 #if 0
 #include "../src/plzma_out_streams.hpp"
 #endif
@@ -38,6 +47,282 @@ int test_plzma_streams_test1(void) {
     return 0;
 }
 
+static void dummy_free_callback(void * LIBPLZMA_NULLABLE p) {
+    // do nothing
+}
+
+// The content of the items of the test archives by the item index.
+static int itemContentMustMatch(const SharedPtr<Item> & item, const RawHeapMemorySize & content) {
+    const uint8_t * expected = nullptr;
+    size_t expectedSize = 0;
+    switch (item->index()) {
+        case 0:
+        case 4:
+            expected = FILE__munchen_jpg_PTR;
+            expectedSize = FILE__munchen_jpg_SIZE;
+            break;
+        case 1:
+            expected = FILE__shutuptakemoney_jpg_PTR;
+            expectedSize = FILE__shutuptakemoney_jpg_SIZE;
+            break;
+        case 2:
+            expected = FILE__southpark_jpg_PTR;
+            expectedSize = FILE__southpark_jpg_SIZE;
+            break;
+        case 3:
+            expected = FILE__zombies_jpg_PTR;
+            expectedSize = FILE__zombies_jpg_SIZE;
+            break;
+        default:
+            break;
+    }
+    PLZMA_TESTS_ASSERT(expected != nullptr)
+    PLZMA_TESTS_ASSERT(content.second == expectedSize)
+    PLZMA_TESTS_ASSERT(memcmp(static_cast<const void *>(content.first), expected, expectedSize) == 0)
+    return 0;
+}
+
+static int extractedItemsMustMatch(SharedPtr<Decoder> & decoder) {
+    auto items = decoder->items();
+    auto itemStreams = makeShared<ItemOutStreamArray>(items->count());
+    for (plzma_size_t i = 0; i < items->count(); i++) {
+        itemStreams->push(ItemOutStreamArray::ElementType(items->at(i), makeSharedOutStream()));
+    }
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    for (plzma_size_t i = 0; i < itemStreams->count(); i++) {
+        const auto & pair = itemStreams->at(i);
+        PLZMA_TESTS_ASSERT(itemContentMustMatch(pair.first, pair.second->copyContent()) == 0)
+    }
+    return 0;
+}
+
+static Path writeTmpFile(const uint8_t * content, const size_t size) {
+    Path path = Path::tmpPath();
+    path.appendRandomComponent();
+    FILE * file = path.openFile("wb");
+    if (file) {
+        if (size > 0 && fwrite(content, 1, size, file) != size) {
+            path.clear();
+        }
+        fclose(file);
+    } else {
+        path.clear();
+    }
+    return path;
+}
+
+int test_plzma_streams_mapped_in_stream(void) {
+    const uint8_t * content = FILE__1_7z_PTR;
+    const size_t contentSize = FILE__1_7z_SIZE;
+    Path path = writeTmpFile(content, contentSize);
+    PLZMA_TESTS_ASSERT(path.count() > 0)
+    
+    auto stream = makeSharedMappedInStream(path).cast<InStreamBase>();
+    PLZMA_TESTS_ASSERT(stream.get() != nullptr)
+    PLZMA_TESTS_ASSERT(stream->opened() == false)
+    stream->open();
+    PLZMA_TESTS_ASSERT(stream->opened() == true)
+    
+    UInt64 position = 0;
+    PLZMA_TESTS_ASSERT(stream->Seek(0, STREAM_SEEK_END, &position) == S_OK)
+    PLZMA_TESTS_ASSERT(position == contentSize)
+    PLZMA_TESTS_ASSERT(stream->Seek(1, STREAM_SEEK_END, &position) != S_OK)
+    PLZMA_TESTS_ASSERT(stream->Seek(100, STREAM_SEEK_SET, &position) == S_OK && position == 100)
+    
+    uint8_t buffer[4096];
+    UInt32 processed = 0;
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, sizeof(buffer), &processed) == S_OK && processed == sizeof(buffer))
+    PLZMA_TESTS_ASSERT(memcmp(buffer, content + 100, sizeof(buffer)) == 0)
+    PLZMA_TESTS_ASSERT(stream->Seek(-10, STREAM_SEEK_END, &position) == S_OK && position == contentSize - 10)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, sizeof(buffer), &processed) == S_OK && processed == 10)
+    PLZMA_TESTS_ASSERT(memcmp(buffer, content + contentSize - 10, 10) == 0)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, sizeof(buffer), &processed) == S_OK && processed == 0)
+    
+    auto clone = stream->clone();
+    PLZMA_TESTS_ASSERT(clone.get() != nullptr)
+    clone->open();
+    PLZMA_TESTS_ASSERT(clone->Read(buffer, 16, &processed) == S_OK && processed == 16)
+    PLZMA_TESTS_ASSERT(memcmp(buffer, content, 16) == 0)
+    clone->close();
+    
+    PLZMA_TESTS_ASSERT(stream->erase() == false) // opened
+    stream->close();
+    PLZMA_TESTS_ASSERT(stream->opened() == false)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, 16, &processed) != S_OK)
+    
+    // The archive file via the mapped stream.
+    auto decoder = makeSharedDecoder(makeSharedMappedInStream(path), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    PLZMA_TESTS_ASSERT(extractedItemsMustMatch(decoder) == 0)
+    decoder.clear();
+    PLZMA_TESTS_ASSERT(path.remove() == true)
+    
+    // Empty file.
+    path = writeTmpFile(content, 0);
+    PLZMA_TESTS_ASSERT(path.count() > 0)
+    stream = makeSharedMappedInStream(path).cast<InStreamBase>();
+    stream->open();
+    PLZMA_TESTS_ASSERT(stream->Seek(0, STREAM_SEEK_END, &position) == S_OK && position == 0)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, 16, &processed) == S_OK && processed == 0)
+    stream->close();
+    
+    PLZMA_TESTS_ASSERT(path.remove() == true)
+    return 0;
+}
+
+int test_plzma_streams_positional_in_stream(void) {
+    const uint8_t * contentPtr = FILE__1_7z_PTR;
+    const size_t contentSize = FILE__1_7z_SIZE;
+    Path path = writeTmpFile(contentPtr, contentSize);
+    PLZMA_TESTS_ASSERT(path.count() > 0)
+    
+    auto stream = makeSharedPositionalInStream(path).cast<InStreamBase>();
+    PLZMA_TESTS_ASSERT(stream.get() != nullptr)
+    PLZMA_TESTS_ASSERT(stream->opened() == false)
+    stream->open();
+    PLZMA_TESTS_ASSERT(stream->opened() == true)
+    
+    UInt64 position = 0;
+    PLZMA_TESTS_ASSERT(stream->Seek(0, STREAM_SEEK_END, &position) == S_OK)
+    PLZMA_TESTS_ASSERT(position == contentSize)
+    PLZMA_TESTS_ASSERT(stream->Seek(1, STREAM_SEEK_END, &position) != S_OK)
+    PLZMA_TESTS_ASSERT(stream->Seek(100, STREAM_SEEK_SET, &position) == S_OK && position == 100)
+    
+    // The clone shares the opened descriptor and has own reading position.
+    auto clone = stream->clone();
+    PLZMA_TESTS_ASSERT(clone.get() != nullptr)
+    PLZMA_TESTS_ASSERT(clone->opened() == false)
+    clone->open();
+    uint8_t buffer[4096];
+    UInt32 processed = 0;
+    PLZMA_TESTS_ASSERT(clone->Read(buffer, 16, &processed) == S_OK && processed == 16)
+    PLZMA_TESTS_ASSERT(memcmp(buffer, contentPtr, 16) == 0)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, sizeof(buffer), &processed) == S_OK && processed == sizeof(buffer))
+    PLZMA_TESTS_ASSERT(memcmp(buffer, contentPtr + 100, sizeof(buffer)) == 0)
+    PLZMA_TESTS_ASSERT(clone->Read(buffer, 16, &processed) == S_OK && processed == 16)
+    PLZMA_TESTS_ASSERT(memcmp(buffer, contentPtr + 16, 16) == 0)
+    PLZMA_TESTS_ASSERT(stream->Seek(-10, STREAM_SEEK_END, &position) == S_OK && position == contentSize - 10)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, sizeof(buffer), &processed) == S_OK && processed == 10)
+    PLZMA_TESTS_ASSERT(memcmp(buffer, contentPtr + contentSize - 10, 10) == 0)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, sizeof(buffer), &processed) == S_OK && processed == 0)
+    
+    // The descriptor stays opened by the clone.
+    stream->close();
+    PLZMA_TESTS_ASSERT(stream->opened() == false)
+    PLZMA_TESTS_ASSERT(stream->Read(buffer, 16, &processed) != S_OK)
+    PLZMA_TESTS_ASSERT(stream->erase() == false)
+    PLZMA_TESTS_ASSERT(clone->Seek(contentSize - 16, STREAM_SEEK_SET, &position) == S_OK)
+    PLZMA_TESTS_ASSERT(clone->Read(buffer, 16, &processed) == S_OK && processed == 16)
+    PLZMA_TESTS_ASSERT(memcmp(buffer, contentPtr + contentSize - 16, 16) == 0)
+    clone->close();
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    // The clones read the shared descriptor at the same time.
+    const size_t threadsCount = 4;
+    bool identical[threadsCount];
+    std::thread threads[threadsCount];
+    stream->open();
+    for (size_t t = 0; t < threadsCount; t++) {
+        identical[t] = false;
+        threads[t] = std::thread([&, t]() {
+            auto threadStream = stream->clone();
+            threadStream->open();
+            uint8_t threadBuffer[1000];
+            UInt32 threadProcessed = 0;
+            bool equal = true;
+            for (size_t offset = t * 7; equal && offset < contentSize; offset += sizeof(threadBuffer) * threadsCount) {
+                UInt64 newPosition = 0;
+                equal = threadStream->Seek(static_cast<Int64>(offset), STREAM_SEEK_SET, &newPosition) == S_OK &&
+                    threadStream->Read(threadBuffer, sizeof(threadBuffer), &threadProcessed) == S_OK &&
+                    memcmp(threadBuffer, contentPtr + offset, threadProcessed) == 0 &&
+                    threadProcessed == (((contentSize - offset) < sizeof(threadBuffer)) ? (contentSize - offset) : sizeof(threadBuffer));
+            }
+            threadStream->close();
+            identical[t] = equal;
+        });
+    }
+    for (size_t t = 0; t < threadsCount; t++) {
+        threads[t].join();
+        PLZMA_TESTS_ASSERT(identical[t] == true)
+    }
+    stream->close();
+#endif
+    
+    // The archive file via the positional stream, read by the parallel extract workers.
+    auto decoder = makeSharedDecoder(makeSharedPositionalInStream(path), plzma_file_type_7z);
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    decoder->setShouldExtractInParallel(true);
+    decoder->setNumberOfThreads(2);
+#endif
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    PLZMA_TESTS_ASSERT(decoder->count() == 5)
+    PLZMA_TESTS_ASSERT(decoder->test() == true)
+    PLZMA_TESTS_ASSERT(extractedItemsMustMatch(decoder) == 0)
+    decoder.clear();
+    
+    PLZMA_TESTS_ASSERT(stream->erase() == true)
+    PLZMA_TESTS_ASSERT(path.exists() == false)
+    return 0;
+}
+
+static plzma_size_t write_mem_stream_reallocations(const SharedPtr<OutStream> & outStream, const uint8_t * content, const size_t contentSize, const UInt32 chunkSize) {
+    auto stream = outStream.cast<OutStreamBase>();
+    const OutMemStream * memStream = static_cast<const OutMemStream *>(stream.get());
+    plzma_size_t reallocations = 0;
+    uint64_t capacity = memStream->capacity();
+    stream->open();
+    for (size_t offset = 0; offset < contentSize; offset += chunkSize) {
+        const UInt32 size = static_cast<UInt32>(((contentSize - offset) < chunkSize) ? (contentSize - offset) : chunkSize);
+        UInt32 processedSize = 0;
+        if (stream->Write(content + offset, size, &processedSize) != S_OK || processedSize != size) {
+            return PLZMA_SIZE_T_MAX;
+        }
+        if (capacity != memStream->capacity()) {
+            capacity = memStream->capacity();
+            reallocations++;
+        }
+    }
+    stream->close();
+    const auto streamContent = outStream->copyContent();
+    if (streamContent.second != contentSize || memcmp(static_cast<const void *>(streamContent.first), content, contentSize) != 0) {
+        return PLZMA_SIZE_T_MAX;
+    }
+    return reallocations;
+}
+
+int test_plzma_streams_mem_stream_growth(void) {
+    // The exact growth reallocates on each write, the geometric growth is logarithmic.
+    const UInt32 chunkSize = 64;
+    const plzma_size_t reallocations = write_mem_stream_reallocations(makeSharedOutStream(), FILE__1_7z_PTR, FILE__1_7z_SIZE, chunkSize);
+    PLZMA_TESTS_ASSERT(reallocations != PLZMA_SIZE_T_MAX)
+    PLZMA_TESTS_ASSERT(reallocations <= 8)
+    std::flush(std::cout) << "Memory stream: " << FILE__1_7z_SIZE << " bytes in " << chunkSize << " byte writes, reallocations: "
+        << reallocations << " (exact growth: " << ((FILE__1_7z_SIZE + chunkSize - 1) / chunkSize) << ")" << std::endl;
+    
+    PLZMA_TESTS_ASSERT(write_mem_stream_reallocations(makeSharedOutStream(static_cast<uint64_t>(FILE__1_7z_SIZE)), FILE__1_7z_PTR, FILE__1_7z_SIZE, chunkSize) == 0)
+    
+    // Smaller expected size grows as usual.
+    const plzma_size_t smallReallocations = write_mem_stream_reallocations(makeSharedOutStream(static_cast<uint64_t>(1024)), FILE__1_7z_PTR, FILE__1_7z_SIZE, chunkSize);
+    PLZMA_TESTS_ASSERT(smallReallocations > 0 && smallReallocations <= 10)
+    
+    // The decoder reserves the item's size for the memory stream.
+    auto decoder = makeSharedDecoder(makeSharedInStream(FILE__1_7z_PTR, FILE__1_7z_SIZE, &dummy_free_callback), plzma_file_type_7z);
+    PLZMA_TESTS_ASSERT(decoder->open() == true)
+    auto itemStreams = makeShared<ItemOutStreamArray>();
+    auto itemStream = makeSharedOutStream();
+    itemStreams->push(ItemOutStreamArray::ElementType(decoder->itemAt(3), SharedPtr<OutStream>(itemStream)));
+    PLZMA_TESTS_ASSERT(decoder->extract(itemStreams) == true)
+    auto itemBaseStream = itemStream.cast<OutStreamBase>();
+    PLZMA_TESTS_ASSERT(static_cast<const OutMemStream *>(itemBaseStream.get())->capacity() == FILE__zombies_jpg_SIZE)
+    PLZMA_TESTS_ASSERT(itemContentMustMatch(decoder->itemAt(3), itemStream->copyContent()) == 0)
+    
+    PLZMA_TESTS_ASSERT(itemStream->erase(plzma_erase_zero) == true)
+    PLZMA_TESTS_ASSERT(static_cast<const OutMemStream *>(itemBaseStream.get())->capacity() == 0)
+    PLZMA_TESTS_ASSERT(itemStream->copyContent().second == 0)
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     std::flush(std::cout) << plzma_version() << std::endl;
     int ret = 0;
@@ -46,5 +331,24 @@ int main(int argc, char* argv[]) {
         return ret;
     }
     
+    if ( (ret = test_plzma_streams_mapped_in_stream()) ) {
+        return ret;
+    }
+    
+    if ( (ret = test_plzma_streams_positional_in_stream()) ) {
+        return ret;
+    }
+    
+    if ( (ret = test_plzma_streams_mem_stream_growth()) ) {
+        return ret;
+    }
+    
     return ret;
 }
+
+#include "../test_files/file__1_7z.h"
+
+#include "../test_files/file__munchen_jpg.h"
+#include "../test_files/file__shutuptakemoney_jpg.h"
+#include "../test_files/file__southpark_jpg.h"
+#include "../test_files/file__zombies_jpg.h"
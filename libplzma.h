@@ -190,6 +190,108 @@ typedef enum plzma_method {
 } plzma_method;
 
 
+/// @brief Match finder of the LZMA and LZMA2 compression methods.
+typedef enum plzma_match_finder {
+    /// @brief The match finder defined by the compression level.
+    plzma_match_finder_default =    0,
+    
+    /// @brief Binary tree with 2 bytes hashing.
+    plzma_match_finder_bt2 =        1,
+    
+    /// @brief Binary tree with 3 bytes hashing.
+    plzma_match_finder_bt3 =        2,
+    
+    /// @brief Binary tree with 4 bytes hashing.
+    plzma_match_finder_bt4 =        3,
+    
+    /// @brief Binary tree with 5 bytes hashing.
+    plzma_match_finder_bt5 =        4,
+    
+    /// @brief Hash chain with 4 bytes hashing. Faster than binary tree, but with worse compression ratio.
+    plzma_match_finder_hc4 =        5,
+    
+    /// @brief Hash chain with 5 bytes hashing.
+    plzma_match_finder_hc5 =        6
+} plzma_match_finder;
+
+
+/// @brief Filter which preprocesses the content before the compression method to get a better compression ratio.
+///
+/// The branch converters(BCJ, BCJ2, ARM64, etc.) are useful for the executable files of the corresponding architecture,
+/// the Delta filter is useful for the tabular data with the fixed size rows, i.e. sensors data, uncompressed images or audio.
+typedef enum plzma_filter {
+    /// @brief The 7z archive automatically selects the branch converter for the executable files,
+    /// the xz archive doesn't use any filter.
+    plzma_filter_auto =     0,
+    
+    /// @brief Do not use any filter, including the automatic selection.
+    plzma_filter_none =     1,
+    
+    /// @brief Branch converter for the x86 and x86-64 executables.
+    plzma_filter_BCJ =      2,
+    
+    /// @brief Improved branch converter for the x86 and x86-64 executables with separated streams.
+    /// @note Supported only by the 7z archive and requires the library built with \a LIBPLZMA_OPT_MULTITHREAD option.
+    plzma_filter_BCJ2 =     3,
+    
+    /// @brief Branch converter for the ARM64 executables.
+    plzma_filter_ARM64 =    4,
+    
+    /// @brief Branch converter for the ARM(little-endian) executables.
+    plzma_filter_ARM =      5,
+    
+    /// @brief Branch converter for the ARM Thumb executables.
+    plzma_filter_ARMT =     6,
+    
+    /// @brief Branch converter for the PowerPC(big-endian) executables.
+    plzma_filter_PPC =      7,
+    
+    /// @brief Branch converter for the SPARC executables.
+    plzma_filter_SPARC =    8,
+    
+    /// @brief Branch converter for the Itanium executables.
+    plzma_filter_IA64 =     9,
+    
+    /// @brief Branch converter for the RISC-V executables.
+    plzma_filter_RISCV =    10,
+    
+    /// @brief Delta filter with the distance in bytes defined by the encoder's 'filter delta distance'.
+    plzma_filter_Delta =    11
+} plzma_filter;
+
+
+/// @brief The properties of the LZMA and LZMA2 compression methods.
+///
+/// Each property overrides the value defined by the compression level.
+/// The zero value of the unsigned or the negative value of the signed property means the value defined by the compression level.
+typedef struct plzma_method_properties {
+    /// @brief Dictionary size in bytes in a range [4KB; 3840MB].
+    uint64_t dictionary_size;
+    
+    /// @brief LZMA2 block size in bytes, at least 4KB. The maximum \a uint64_t value means a single solid block.
+    /// @note The size of the blocks defines the number of the independent blocks, i.e. decoding parallelism and memory usage.
+    uint64_t block_size;
+    
+    /// @brief Number of fast bytes(word size) in a range [5; 273].
+    uint32_t word_size;
+    
+    /// @brief Number of cycles of the match finder in a range [1; 1073741824].
+    uint32_t match_finder_cycles;
+    
+    /// @brief Match finder.
+    plzma_match_finder match_finder;
+    
+    /// @brief Number of literal context bits in a range [0; 8]. LZMA2 allows up to 4 bits for the sum of literal context and position bits.
+    int8_t literal_context_bits;
+    
+    /// @brief Number of literal position bits in a range [0; 4].
+    int8_t literal_position_bits;
+    
+    /// @brief Number of position bits in a range [0; 4].
+    int8_t position_bits;
+} plzma_method_properties;
+
+
 /// @brief Exception error codes.
 typedef enum plzma_error_code {
     /// @brief The error type cannot be determined.
@@ -226,6 +328,34 @@ typedef enum plzma_open_dir_mode {
 } plzma_open_dir_mode;
 
 
+/// @brief The maximum type for holding all bitmask combinations of the \a plzma_kernel enumeration.
+typedef uint16_t plzma_kernel_t;
+
+
+/// @brief The enumeration with bitmask of the hardware or assembler kernels selected at runtime.
+/// @see Function \a plzma_kernels.
+typedef enum plzma_kernel {
+    /// @brief CRC32 of the 7z archives via the carry-less multiplication(PCLMULQDQ).
+    plzma_kernel_crc32_clmul                = 1 << 0,
+    
+    /// @brief CRC64 of the xz archives via the carry-less multiplication(PCLMULQDQ).
+    plzma_kernel_crc64_clmul                = 1 << 1,
+    
+    /// @brief SHA-256 of the 7z AES key derivation via the SHA extensions(SHA-NI).
+    plzma_kernel_sha256_hw                  = 1 << 2,
+    
+    /// @brief AES of the encrypted 7z archives via the AES instructions(AES-NI).
+    plzma_kernel_aes_hw                     = 1 << 3,
+    
+    /// @brief AES decryption via the 256-bit vector AES instructions(VAES, AVX2).
+    plzma_kernel_aes_hw_256                 = 1 << 4,
+    
+    /// @brief The assembler LZMA/LZMA2 decoder kernel.
+    /// @see Function \a plzma_lzma_decoder_optimized.
+    plzma_kernel_lzma_decoder_optimized     = 1 << 5
+} plzma_kernel;
+
+
 typedef enum plzma_multi_stream_part_name_format {
     /// @brief "File"."Extension"."002". The maximum number of parts is 999.
     plzma_multi_stream_part_name_format_name_ext_00x   = 1
@@ -259,6 +389,39 @@ typedef struct plzma_path_stat {
 } plzma_path_stat;
 
 
+/// @brief The location of the extracted item's content inside the decoder's arena memory.
+typedef struct plzma_arena_view {
+    /// @brief The offset in bytes from the beginning of the arena memory.
+    uint64_t offset;
+    
+    /// @brief The size of the item's content in bytes.
+    uint64_t size;
+} plzma_arena_view;
+
+
+/// @brief The snapshot of the raw counters of the current or last compressing, extracting or testing operation.
+/// @note Each counter is read atomically, but the counters are updated independently of each other.
+typedef struct plzma_stats {
+    /// @brief The number of consumed input bytes, i.e. the packed size during decoding or the content size during encoding.
+    uint64_t in_size;
+    
+    /// @brief The number of produced output bytes, i.e. the content size during decoding or the packed size during encoding.
+    uint64_t out_size;
+    
+    /// @brief The number of processed items.
+    uint64_t items_completed;
+    
+    /// @brief The number of items of the operation or \a 0 if unknown, i.e. the items of the sequential tar archive.
+    uint64_t items_count;
+    
+    /// @brief The ratio of the output to the input size or \a 0 if nothing was consumed.
+    double ratio;
+    
+    /// @brief The time in seconds since the beginning of the operation up to the current moment or to the end of the operation.
+    double elapsed;
+} plzma_stats;
+
+
 /// @brief Callback type for deinitializing user defined context.
 /// @param context The non-null reference to any user defined context.
 typedef void (*plzma_context_deinitializer)(void * LIBPLZMA_NONNULL context);
@@ -363,6 +526,10 @@ typedef plzma_object plzma_item_array;
 typedef plzma_object plzma_item_out_stream_array;
 typedef plzma_object plzma_decoder;
 typedef plzma_object plzma_encoder;
+typedef plzma_object plzma_item_stream;
+typedef plzma_object plzma_encoder_session;
+typedef plzma_object plzma_item_table;
+typedef plzma_object plzma_block_cache;
 
 typedef uint32_t plzma_size_t; // limited to 32 bit unsigned integer.
 #define PLZMA_SIZE_T_MAX UINT32_MAX
@@ -449,6 +616,27 @@ typedef bool (*plzma_in_stream_read_callback)(void * LIBPLZMA_NULLABLE context,
                                               uint32_t * LIBPLZMA_NONNULL processed_size);
 
 
+/// @brief The callback requires to open out-stream.
+/// @param context The user's context pointer provided with stream creation.
+/// @return \a true if stream was successfully opened, otherwice \a false.
+typedef bool (*plzma_out_stream_open_callback)(void * LIBPLZMA_NULLABLE context);
+
+
+/// @brief The callback requires to close out-stream, all the content was written.
+/// @param context The user's context pointer provided with stream creation.
+typedef void (*plzma_out_stream_close_callback)(void * LIBPLZMA_NULLABLE context);
+
+
+/// @brief The callback requires to write all provided \a data of \a size size to the end of the out-stream.
+/// @param context The user's context pointer provided with stream creation.
+/// @param data The data to write.
+/// @param size The size of the data to write.
+/// @return \a true if all the data was successfully written, otherwice \a false.
+typedef bool (*plzma_out_stream_write_callback)(void * LIBPLZMA_NULLABLE context,
+                                                const void * LIBPLZMA_NONNULL data,
+                                                uint32_t size);
+
+
 /// @brief The callback provides current encoding/decoding progress. Similar to a \a plzma_progress_delegate_wide_callback callback.
 /// @param context The user's provided context pointer.
 /// @param utf8_path The UTF8 presentation of the item/archive path if such supported, or empty path string.
@@ -582,6 +770,49 @@ LIBPLZMA_C_API(plzma_size_t) plzma_decoder_write_size(void);
 /// @note The lower value requires less amount of allocated memory, but increases the number of write requests and vice versa.
 LIBPLZMA_C_API(void) plzma_set_decoder_write_size(const plzma_size_t size);
 
+
+/// @brief Receives the minimum interval in seconds between two progress reports of the encoder or decoder.
+/// @return The interval in seconds. Default: 0, i.e. every change of the progress is reported.
+/// @note The completion of the operation is always reported.
+LIBPLZMA_C_API(double) plzma_progress_min_interval(void);
+
+
+/// @brief Changes the minimum interval in seconds between two progress reports of the encoder or decoder.
+/// @see Function \a plzma_progress_min_interval.
+/// @note The higher value decreases the number of progress callbacks of the archives with many small items.
+LIBPLZMA_C_API(void) plzma_set_progress_min_interval(const double seconds);
+
+
+/// @brief Receives the minimum increment of the progress value between two progress reports of the encoder or decoder.
+/// @return The increment in range [0; 1]. Default: 0, i.e. every change of the progress is reported.
+/// @note The path changes and the completion of the operation are not affected by this value.
+LIBPLZMA_C_API(double) plzma_progress_min_delta(void);
+
+
+/// @brief Changes the minimum increment of the progress value between two progress reports of the encoder or decoder.
+/// @see Function \a plzma_progress_min_delta.
+LIBPLZMA_C_API(void) plzma_set_progress_min_delta(const double delta);
+
+
+/// @brief Checks whether the LZMA/LZMA2 decoder uses the optimized assembler kernel.
+/// @return \a true if the library was built with the optimized kernel for the current target, see cmake option 'LIBPLZMA_OPT_LZMA_DEC_ASM',
+/// and the kernel was not disabled via \a plzma_set_lzma_decoder_optimized. Otherwise \a false, the portable C kernel is used.
+LIBPLZMA_C_API(bool) plzma_lzma_decoder_optimized(void);
+
+
+/// @brief Selects the LZMA/LZMA2 decoder kernel: the optimized assembler kernel or the portable C kernel.
+/// @see Function \a plzma_lzma_decoder_optimized.
+/// @note The selection is global. Change it only while there are no active decoders.
+/// @note Has no effect if the library was built without the optimized kernel for the current target.
+LIBPLZMA_C_API(void) plzma_set_lzma_decoder_optimized(const bool optimized);
+
+
+/// @brief Reports the hardware or assembler kernels currently used by the library.
+/// @return The bitmask of the \a plzma_kernel enumeration.
+/// @note The CRC32, CRC64, SHA-256 and AES kernels are selected once via the CPUID during the library initialization,
+/// see cmake option 'LIBPLZMA_OPT_CPU_DISPATCH'. The portable C implementations are used for all unset bits.
+LIBPLZMA_C_API(plzma_kernel_t) plzma_kernels(void);
+
 /// Object
 
 /// @brief Releases optional \a exception of the generic object.
@@ -947,6 +1178,29 @@ LIBPLZMA_C_API(plzma_in_stream) plzma_in_stream_create_with_path(const plzma_pat
 LIBPLZMA_C_API(plzma_in_stream) plzma_in_stream_create_with_pathm(plzma_path * LIBPLZMA_NONNULL path);
 
 
+/// @brief Creates the input file stream object with path, which reads the file content via memory mapping.
+///
+/// The whole file is mapped to the address space during the opening, the reading doesn't require a system call
+/// and the intermediate buffering. If the file can't be mapped, the stream reads the file as a regular file stream.
+/// @param path The non-empty input file path.
+/// @return The input stream or null, if exception was thrown.
+/// @note Call \a plzma_in_stream_release function to release the input file stream.
+/// @note The file should not be truncated while the stream is opened.
+/// @note The stream is ARC object.
+LIBPLZMA_C_API(plzma_in_stream) plzma_in_stream_create_mapped_with_path(const plzma_path * LIBPLZMA_NONNULL path);
+
+
+/// @brief Creates the input file stream object with path, which reads the file content via positional reads of the file descriptor.
+///
+/// The reading doesn't use the file position and the intermediate buffering. The clones of the stream, i.e. used
+/// by the decoder for extracting in parallel, share a single descriptor and read the file at the same time without locking.
+/// @param path The non-empty input file path.
+/// @return The input stream or null, if exception was thrown.
+/// @note Call \a plzma_in_stream_release function to release the input file stream.
+/// @note The stream is ARC object.
+LIBPLZMA_C_API(plzma_in_stream) plzma_in_stream_create_positional_with_path(const plzma_path * LIBPLZMA_NONNULL path);
+
+
 /// @brief Creates the input file stream object with the file memory content.
 /// During the creation, the memory will copyed.
 /// @param memory The file memory content.
@@ -987,6 +1241,23 @@ LIBPLZMA_C_API(plzma_in_stream) plzma_in_stream_create_with_callbacks(plzma_in_s
                                                                       const plzma_context context);
 
 
+/// @brief Creates the sequential input stream with user defined callbacks, i.e. the stream of a pipe or a network response body.
+/// The stream is read only once from the beginning to the end, without seeking.
+/// Only the tar and xz archives can be decoded from the sequential stream, the decoder extracts or tests the items once.
+/// The items of the tar archive are unknown until extracting or testing, the number of the items of the opened decoder is zero.
+/// @param open_callback Opens the stream for reading.
+/// @param close_callback Closes the stream.
+/// @param read_callback Reads the number of bytes into provided byffer. Similar to \a fread C function.
+/// @param context The user defined context provided to all callbacks.
+/// @return The input stream object or null, if exception was thrown.
+/// @note Call \a plzma_in_stream_release function to release the input stream.
+/// @note The stream is ARC object.
+LIBPLZMA_C_API(plzma_in_stream) plzma_in_stream_create_sequential_with_callbacks(plzma_in_stream_open_callback LIBPLZMA_NONNULL open_callback,
+                                                                                 plzma_in_stream_close_callback LIBPLZMA_NONNULL close_callback,
+                                                                                 plzma_in_stream_read_callback LIBPLZMA_NONNULL read_callback,
+                                                                                 const plzma_context context);
+
+
 /// @brief Creates multi input stream with movable array of input streams.
 /// The content of array will be moved to the newly created stream.
 /// The array should not be empty.
@@ -1061,6 +1332,30 @@ LIBPLZMA_C_API(plzma_out_stream) plzma_out_stream_create_with_pathm(plzma_path *
 LIBPLZMA_C_API(plzma_out_stream) plzma_out_stream_create_memory_stream(void);
 
 
+/// @brief Creates the output file stream object for writing to memory with preallocated memory.
+/// @param expected_size The expected size in bytes of the stream's content. The memory grows if the content is larger.
+/// @return The output file stream or null, if exception was thrown.
+/// @note Call \a plzma_out_stream_release function to release the output stream.
+/// @note The stream is ARC object.
+LIBPLZMA_C_API(plzma_out_stream) plzma_out_stream_create_memory_stream_with_expected_size(const uint64_t expected_size);
+
+
+/// @brief Creates the sequential output stream with user defined callbacks, i.e. the stream of a pipe or a network request body.
+/// The content is written only once from the beginning to the end, without seeking.
+/// Only the xz archive and the tar archive with the known sizes of the items can be encoded to the sequential stream.
+/// @param open_callback Opens the stream for writing.
+/// @param close_callback Closes the stream.
+/// @param write_callback Writes the provided bytes to the end of the stream. Similar to \a fwrite C function.
+/// @param context The user defined context provided to all callbacks.
+/// @return The output stream object or null, if exception was thrown.
+/// @note Call \a plzma_out_stream_release function to release the output stream.
+/// @note The stream is ARC object.
+LIBPLZMA_C_API(plzma_out_stream) plzma_out_stream_create_sequential_with_callbacks(plzma_out_stream_open_callback LIBPLZMA_NONNULL open_callback,
+                                                                                   plzma_out_stream_close_callback LIBPLZMA_NONNULL close_callback,
+                                                                                   plzma_out_stream_write_callback LIBPLZMA_NONNULL write_callback,
+                                                                                   const plzma_context context);
+
+
 /// @return Checks the output file stream is opened.
 /// @note Thread-safe.
 LIBPLZMA_C_API(bool) plzma_out_stream_opened(plzma_out_stream * LIBPLZMA_NULLABLE stream);
@@ -1291,6 +1586,53 @@ LIBPLZMA_C_API(void) plzma_decoder_set_password_wide_string(plzma_decoder * LIBP
 LIBPLZMA_C_API(void) plzma_decoder_set_password_utf8_string(plzma_decoder * LIBPLZMA_NONNULL decoder, const char * LIBPLZMA_NULLABLE password);
 
 
+/// @brief Getter for a number of threads used by the extracting or testing process.
+/// @return The number of threads. \a 0 means the number of hardware threads.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint32_t) plzma_decoder_number_of_threads(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @brief Setter for a number of threads used by the extracting or testing process.
+///
+/// Applied to the 7z(LZMA2) and xz archives, the tar archives are always extracted in a single thread.
+/// @param threads The number of threads. \a 0, the default value, means the number of hardware threads.
+/// @note Has no effect if the library was built without \a LIBPLZMA_OPT_MULTITHREAD option.
+/// @note Thread-safe. Must be set before extracting or testing.
+LIBPLZMA_C_API(void) plzma_decoder_set_number_of_threads(plzma_decoder * LIBPLZMA_NONNULL decoder, const uint32_t threads);
+
+
+/// @brief Getter for a parallel extracting or testing of the independent 7z blocks.
+/// @note Disabled by default, the value is \a false.
+/// @note Thread-safe.
+LIBPLZMA_C_API(bool) plzma_decoder_should_extract_in_parallel(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @brief Setter for a parallel extracting or testing of the independent 7z blocks.
+///
+/// The non-solid or multi-block 7z archive consists of the independent blocks(folders), each of them can be decoded separately.
+/// If enabled, the blocks of the requested items are distributed among the worker threads, where each worker
+/// has its own clone of the input stream and its own opened archive. The number of workers is limited by the number of threads value
+/// and by the number of the blocks. The items are extracted to their own paths or output streams, the progress is combined.
+/// Falls back to the single thread processing for the other archive types, archives with one block or
+/// input streams which can't be cloned, i.e. created with the callbacks.
+/// @param parallel Extract or test in parallel.
+/// @note Thread-safe. Must be set before extracting or testing.
+/// @throws \a Exception in case if the library was built with \a LIBPLZMA_OPT_THREAD_UNSAFE option.
+LIBPLZMA_C_API(void) plzma_decoder_set_should_extract_in_parallel(plzma_decoder * LIBPLZMA_NONNULL decoder, const bool parallel);
+
+
+/// @brief Provides the cache of the decoded blocks for extracting the items of the 7z archive to the output streams.
+///
+/// The block of the requested item is decoded once to the memory and kept in the cache, the next requested items
+/// of the same block are copied from the memory. Only the \a plzma_decoder_extract_item_out_stream_array function
+/// uses the cache, the items extracted to the paths or to the arena, tested or read via the item stream are decoded
+/// as usual, so as the encrypted blocks and the blocks larger than the capacity of the cache.
+/// The items copied from the cached blocks are counted by the \a plzma_decoder_stats.
+/// @param cache The cache, possibly shared with the other decoders, or null to disable the caching.
+/// @note Thread-safe.
+LIBPLZMA_C_API(void) plzma_decoder_set_block_cache(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_block_cache * LIBPLZMA_NULLABLE cache);
+
+
 /// @brief Opens the archive.
 ///
 /// During the process, the decoder is self-retained as long as the operation is in progress.
@@ -1331,6 +1673,37 @@ LIBPLZMA_C_API(plzma_item_array) plzma_decoder_items(plzma_decoder * LIBPLZMA_NO
 LIBPLZMA_C_API(plzma_item) plzma_decoder_item_at(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_size_t index);
 
 
+/// @brief Receives the retained table of all archive items.
+///
+/// The table is built once, during the first call after opening, and is shared by the next calls.
+/// The properties of the items are stored by columns, the item objects are created only on demand.
+/// @return Retained item table. The object is null if the decoder is not opened.
+/// @note Use \a plzma_item_table_release to release the item table when it's no longer needed.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_item_table) plzma_decoder_item_table(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @brief Finds the retained archive item with a specific path.
+///
+/// The lookup uses the hash index of the archive paths, built once during the first call after opening.
+/// @param path The path of the item inside the archive, i.e. 'dir/file.txt'.
+/// @return Retained first archive item with exactly the same path. The object is null if there is no such item or the decoder is not opened.
+/// @note Use \a plzma_item_release to release the item when it's no longer needed.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_item) plzma_decoder_find_item(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_path * LIBPLZMA_NONNULL path);
+
+
+/// @brief Finds all archive items with the paths matching the glob pattern.
+///
+/// The '*' matches any sequence of characters including the path separators, the '?' matches any single character.
+/// The prefix lookup is the pattern with a trailing '*', i.e. 'dir/*'.
+/// @param pattern The glob pattern of the paths inside the archive.
+/// @return Retained array with the matching items ordered by index. The object is null if the decoder is not opened.
+/// @note Use \a plzma_item_array_release to release the items array when it's no longer needed.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_item_array) plzma_decoder_find_items(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_path * LIBPLZMA_NONNULL pattern);
+
+
 /// @brief Extracts all archive items to a specific path.
 ///
 /// During the process, the decoder is self-retained as long as the operation is in progress.
@@ -1370,6 +1743,64 @@ LIBPLZMA_C_API(bool) plzma_decoder_extract_item_out_stream_array(plzma_decoder *
                                                                  plzma_item_out_stream_array * LIBPLZMA_NONNULL items);
 
 
+/// @brief Extracts archive items into a single contiguous memory arena owned by the decoder.
+///
+/// The arena is allocated once with the total size of the items, each item is decoded directly to it's own region.
+/// The regions follow the archive order, the views follow the order of the \a items array, which is not modified.
+/// During the process, the decoder is self-retained as long as the operation is in progress.
+/// @param items The array of items to extract.
+/// @note The previous arena content is released only after a successful extraction.
+/// @note Returns false if the decoder is already extracting.
+/// @note The extracting progress might be executed in a separate thread.
+/// @note The extracting progress might be aborted via \a plzma_decoder_abort function.
+/// @note Thread-safe.
+LIBPLZMA_C_API(bool) plzma_decoder_extract_items_to_arena(plzma_decoder * LIBPLZMA_NONNULL decoder,
+                                                          plzma_item_array * LIBPLZMA_NONNULL items);
+
+
+/// @return The arena memory of the last extraction to arena or null if nothing was extracted.
+/// @note The memory is valid until the next extraction to arena or until the decoder is released.
+/// @note Thread-safe.
+LIBPLZMA_C_API(const void * LIBPLZMA_NULLABLE) plzma_decoder_arena(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @return The size in bytes of the arena memory.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_decoder_arena_size(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @return The number of views of the last extraction to arena.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_size_t) plzma_decoder_arena_views_count(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @brief Receives the location of the extracted item's content inside the arena memory.
+/// @param index The index of the item in the extracted items array. Must be less than the number of views.
+/// @return The view of the item's content.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_arena_view) plzma_decoder_arena_view_at(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_size_t index);
+
+
+/// @brief Receives the raw counters of the current or last extracting or testing operation.
+/// @return The snapshot of the counters, read without waiting for the operation.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_stats) plzma_decoder_stats(plzma_decoder * LIBPLZMA_NONNULL decoder);
+
+
+/// @brief Opens the readable stream of the archive item's content.
+///
+/// The item is decoded in a separate thread, as long as the caller reads the stream.
+/// The decoder is busy until the stream is read to the end or closed.
+/// During the process, the decoder is self-retained as long as the stream exists.
+/// @param item The item to read.
+/// @return The item stream object. The object is null if the decoder is not opened or busy, or in case if exception was thrown.
+/// @note The decoding might be aborted via \a plzma_decoder_abort function.
+/// @note Thread-safe.
+/// @note Use \a plzma_item_stream_release to release the item stream.
+LIBPLZMA_C_API(plzma_item_stream) plzma_decoder_open_item_stream(plzma_decoder * LIBPLZMA_NONNULL decoder,
+                                                                 plzma_item * LIBPLZMA_NONNULL item);
+
+
 /// @brief Tests specific archive items.
 ///
 /// During the process, the decoder is self-retained as long as the operation is in progress.
@@ -1393,6 +1824,130 @@ LIBPLZMA_C_API(bool) plzma_decoder_test(plzma_decoder * LIBPLZMA_NONNULL decoder
 /// @brief Relases the decoder object.
 LIBPLZMA_C_API(void) plzma_decoder_release(plzma_decoder * LIBPLZMA_NONNULL decoder);
 
+/// Item stream
+
+/// @return The item of the stream.
+/// @note Thread-safe.
+/// @note Use \a plzma_item_release to release the item.
+LIBPLZMA_C_API(plzma_item) plzma_item_stream_item(plzma_item_stream * LIBPLZMA_NONNULL stream);
+
+
+/// @return The number of bytes read from the stream.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_item_stream_position(plzma_item_stream * LIBPLZMA_NONNULL stream);
+
+
+/// @brief Reads the next portion of the item's content, blocks until the content is decoded.
+/// @param buffer The buffer to read to.
+/// @param size The size in bytes of the buffer.
+/// @return The number of bytes read or 0 if the whole content was read, the stream is closed or in case if exception was thrown.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_size_t) plzma_item_stream_read(plzma_item_stream * LIBPLZMA_NONNULL stream,
+                                                    void * LIBPLZMA_NONNULL buffer,
+                                                    const plzma_size_t size);
+
+
+/// @brief Stops the decoding and closes the stream. The remaining content is skipped.
+/// @note Thread-safe.
+LIBPLZMA_C_API(void) plzma_item_stream_close(plzma_item_stream * LIBPLZMA_NONNULL stream);
+
+
+/// @brief Relases the item stream object. The stream is closed.
+LIBPLZMA_C_API(void) plzma_item_stream_release(plzma_item_stream * LIBPLZMA_NONNULL stream);
+
+/// Item table
+
+/// @return The number of items in the table, i.e. in the archive.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_size_t) plzma_item_table_count(const plzma_item_table * LIBPLZMA_NONNULL table);
+
+
+/// @return The UTF-8 path of the item at index. The string is valid as long as the table exists.
+/// The string is null in case if index is out of bounds, i.e. the exception was thrown.
+/// @note Thread-safe.
+LIBPLZMA_C_API(const char * LIBPLZMA_NULLABLE) plzma_item_table_path_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @return The size in bytes of the item at index.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_item_table_size_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @return The packed size in bytes of the item at index.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_item_table_pack_size_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @return The CRC32 checksum of the item at index.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint32_t) plzma_item_table_crc32_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @return The creation, last access and last modification unix timestamps of the item at index.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_path_timestamp) plzma_item_table_timestamp_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @return Checks the item at index is encrypted.
+/// @note Thread-safe.
+LIBPLZMA_C_API(bool) plzma_item_table_encrypted_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @return Checks the item at index is directory.
+/// @note Thread-safe.
+LIBPLZMA_C_API(bool) plzma_item_table_is_dir_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @brief Creates the retained item with the properties of the table's item at index.
+/// @note Use \a plzma_item_release to release the item.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_item) plzma_item_table_item_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index);
+
+
+/// @brief Relases the item table object.
+LIBPLZMA_C_API(void) plzma_item_table_release(plzma_item_table * LIBPLZMA_NONNULL table);
+
+/// Block cache
+
+/// @brief Creates the size-bounded cache of the decoded archive blocks, i.e. the solid 7z folders.
+///
+/// The least recently used blocks are removed to fit the capacity. The cache might be shared by the decoders
+/// opened on the same archive file or on the clones of the same stream, the blocks are matched by the source stream,
+/// the position of the packed block and the sizes and CRCs of their items. The encrypted blocks are not cached.
+/// @param capacity The maximum size in bytes of the decoded content of all blocks.
+/// @return The empty cache.
+/// @note Use \a plzma_block_cache_release to release the cache when it's no longer needed.
+LIBPLZMA_C_API(plzma_block_cache) plzma_block_cache_create(const uint64_t capacity);
+
+
+/// @return The maximum size in bytes of the decoded content of all blocks.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_block_cache_capacity(const plzma_block_cache * LIBPLZMA_NONNULL cache);
+
+
+/// @return The size in bytes of the decoded content of the cached blocks.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_block_cache_size(plzma_block_cache * LIBPLZMA_NONNULL cache);
+
+
+/// @return The number of the cached blocks.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_size_t) plzma_block_cache_count(plzma_block_cache * LIBPLZMA_NONNULL cache);
+
+
+/// @return The number of times the requested block was found in the cache.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint64_t) plzma_block_cache_hits(plzma_block_cache * LIBPLZMA_NONNULL cache);
+
+
+/// @brief Removes all cached blocks.
+/// @note Thread-safe.
+LIBPLZMA_C_API(void) plzma_block_cache_clear(plzma_block_cache * LIBPLZMA_NONNULL cache);
+
+
+/// @brief Relases the block cache object. The blocks are released by the last decoder using the cache.
+LIBPLZMA_C_API(void) plzma_block_cache_release(plzma_block_cache * LIBPLZMA_NONNULL cache);
+
 /// Encoder
 
 /// @brief Creates the encoder.
@@ -1402,6 +1957,7 @@ LIBPLZMA_C_API(void) plzma_decoder_release(plzma_decoder * LIBPLZMA_NONNULL deco
 /// @param context The user provided context to inform the progress of the operation.
 /// @return The encoder object or null in case if exception was thrown.
 /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if provided stream is empty.
+/// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the 7z archive is provided with the sequential output stream.
 LIBPLZMA_C_API(plzma_encoder) plzma_encoder_create(plzma_out_stream * LIBPLZMA_NONNULL stream,
                                                    const plzma_file_type type,
                                                    const plzma_method method,
@@ -1479,6 +2035,66 @@ LIBPLZMA_C_API(uint8_t) plzma_encoder_compression_level(plzma_encoder * LIBPLZMA
 LIBPLZMA_C_API(void) plzma_encoder_set_compression_level(plzma_encoder * LIBPLZMA_NONNULL encoder, const uint8_t level);
 
 
+/// @brief Getter for a number of threads used by the compressing process.
+/// @return The number of threads. \a 0 means the number of hardware threads.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint32_t) plzma_encoder_number_of_threads(plzma_encoder * LIBPLZMA_NONNULL encoder);
+
+
+/// @brief Setter for a number of threads used by the compressing process.
+///
+/// Applied to the 7z and xz archives, the tar archives are always created in a single thread.
+/// @param threads The number of threads. \a 0, the default value, means the number of hardware threads.
+/// @note Has no effect if the library was built without \a LIBPLZMA_OPT_MULTITHREAD option.
+/// @note Thread-safe. Must be set before opening.
+LIBPLZMA_C_API(void) plzma_encoder_set_number_of_threads(plzma_encoder * LIBPLZMA_NONNULL encoder, const uint32_t threads);
+
+
+/// @brief Getter for the properties of the LZMA and LZMA2 compression methods.
+/// @return The properties, by default, all of them are defined by the compression level.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_method_properties) plzma_encoder_method_properties(plzma_encoder * LIBPLZMA_NONNULL encoder);
+
+
+/// @brief Setter for the properties of the LZMA and LZMA2 compression methods.
+///
+/// Applied to the 7z archives with LZMA or LZMA2 method and to the xz archives.
+/// @param properties The non-null properties to validate and apply.
+/// @note Thread-safe. Must be set before opening.
+/// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if any property is out of range or not supported by the method,
+/// i.e. PPMd method or LZMA block size.
+LIBPLZMA_C_API(void) plzma_encoder_set_method_properties(plzma_encoder * LIBPLZMA_NONNULL encoder, const plzma_method_properties * LIBPLZMA_NONNULL properties);
+
+
+/// @brief Getter for the filter which preprocesses the content before the compression method.
+/// @return The filter, by default, the \a plzma_filter_auto.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_filter) plzma_encoder_filter(plzma_encoder * LIBPLZMA_NONNULL encoder);
+
+
+/// @brief Setter for the filter which preprocesses the content before the compression method.
+///
+/// Applied to the 7z and xz archives, ignored by the tar archives.
+/// @param filter The filter.
+/// @note Thread-safe. Must be set before opening.
+/// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the filter is unknown or not supported by the archive type,
+/// i.e. BCJ2 and xz archive or BCJ2 without \a LIBPLZMA_OPT_MULTITHREAD option.
+LIBPLZMA_C_API(void) plzma_encoder_set_filter(plzma_encoder * LIBPLZMA_NONNULL encoder, const plzma_filter filter);
+
+
+/// @brief Getter for the distance of the Delta filter.
+/// @return The distance in bytes, by default, \a 1.
+/// @note Thread-safe.
+LIBPLZMA_C_API(uint32_t) plzma_encoder_filter_delta_distance(plzma_encoder * LIBPLZMA_NONNULL encoder);
+
+
+/// @brief Setter for the distance of the Delta filter, i.e. the size of the row of the tabular data.
+/// @param distance The distance in bytes in a range [1; 256].
+/// @note Thread-safe. Must be set before opening.
+/// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the distance is out of range.
+LIBPLZMA_C_API(void) plzma_encoder_set_filter_delta_distance(plzma_encoder * LIBPLZMA_NONNULL encoder, const uint32_t distance);
+
+
 /// @brief Should encoder compress the archive header.
 /// @note Enabled by default, the value is \a true.
 /// @note Thread-safe.
@@ -1586,6 +2202,42 @@ LIBPLZMA_C_API(void) plzma_encoder_add_stream(plzma_encoder * LIBPLZMA_NONNULL e
                                               const plzma_path * LIBPLZMA_NONNULL archive_path);
 
 
+/// @brief Provides the existing archive of the same type to update.
+///
+/// The items of the existing archive are copied to the output stream without recompression,
+/// the added paths and streams with the same archive path replace the existing items.
+/// @param stream The seekable input stream of the existing archive. NULL means no update.
+/// @note Supported by the 7z and tar archives. The output stream must not write to the updated archive.
+/// @note Thread-safe. Must be set before opening.
+LIBPLZMA_C_API(void) plzma_encoder_set_update_archive(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                                                      const plzma_in_stream * LIBPLZMA_NULLABLE stream);
+
+
+/// @brief Removes the item of the updated archive.
+///
+/// The content of the remaining items is copied without recompression,
+/// only the solid blocks containing the removed items are recompressed.
+/// The directory path removes all nested items, all items with the duplicated path are removed.
+/// @param archive_path The path of the existing item or directory in archive. Empty path is not allowed.
+/// @note Requires the updated archive, see \a plzma_encoder_set_update_archive.
+/// @note Thread-safe. Must be set before opening.
+LIBPLZMA_C_API(void) plzma_encoder_remove(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                                          const plzma_path * LIBPLZMA_NONNULL archive_path);
+
+
+/// @brief Renames the item of the updated archive without recompression of the content.
+///
+/// The directory path renames all nested items, all items with the duplicated path are renamed.
+/// The opening fails in case if the new path collides with the path of the existing, renamed or added item.
+/// @param archive_path The path of the existing item or directory in archive. Empty path is not allowed.
+/// @param new_archive_path The new path of the item in archive. Empty path is not allowed.
+/// @note Requires the updated archive, see \a plzma_encoder_set_update_archive.
+/// @note Thread-safe. Must be set before opening.
+LIBPLZMA_C_API(void) plzma_encoder_rename(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                                          const plzma_path * LIBPLZMA_NONNULL archive_path,
+                                          const plzma_path * LIBPLZMA_NONNULL new_archive_path);
+
+
 /// @brief Opens the encoder for compressing.
 ///
 /// During the process, the encoder is self-retained as long as the operation is in progress.
@@ -1611,7 +2263,59 @@ LIBPLZMA_C_API(void) plzma_encoder_abort(plzma_encoder * LIBPLZMA_NONNULL encode
 LIBPLZMA_C_API(bool) plzma_encoder_compress(plzma_encoder * LIBPLZMA_NONNULL encoder);
 
 
+/// @brief Receives the raw counters of the current or last compressing operation.
+/// @return The snapshot of the counters, read without waiting for the operation.
+/// @note Thread-safe.
+LIBPLZMA_C_API(plzma_stats) plzma_encoder_stats(plzma_encoder * LIBPLZMA_NONNULL encoder);
+
+
+/// @brief Opens the push session of the xz or tar archive with the items, which content is written by the caller.
+///
+/// The encoder is opened and compresses in a separate thread, which reads the content of the session items in order.
+/// The write call blocks until the written chunk is consumed by the encoder, so the memory usage is bounded.
+/// @param items The array of items with the archive paths. The item's size \a 0 means unknown size,
+/// the tar archive of items with unknown size requires the seekable output stream, not the sequential stream with callbacks.
+/// The xz archive supports exactly one item.
+/// @return The session object. The object is null if the encoder was aborted or in case if exception was thrown.
+/// @note The encoder must not be opened and must not have added paths or streams.
+/// @note Not supported by the thread unsafe build.
+/// @note Thread-safe.
+/// @note Use \a plzma_encoder_session_release to release the session.
+LIBPLZMA_C_API(plzma_encoder_session) plzma_encoder_open_session(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                                                                 plzma_item_array * LIBPLZMA_NONNULL items);
+
+
 /// @brief Releases the encoder object.
 LIBPLZMA_C_API(void) plzma_encoder_release(plzma_encoder * LIBPLZMA_NONNULL encoder);
 
+
+/// @brief Writes the chunk of the current item's content, blocks until the chunk is consumed by the encoder.
+/// @param data The chunk to write.
+/// @param size The size in bytes of the chunk.
+/// @return \a true if the chunk was written, \a false if the compression was aborted or in case if exception was thrown.
+/// @note Thread-safe.
+LIBPLZMA_C_API(bool) plzma_encoder_session_write(plzma_encoder_session * LIBPLZMA_NONNULL session,
+                                                 const void * LIBPLZMA_NONNULL data,
+                                                 const plzma_size_t size);
+
+
+/// @brief Ends the content of the current item, the next writes are related to the next item.
+/// @note Thread-safe.
+LIBPLZMA_C_API(void) plzma_encoder_session_next_item(plzma_encoder_session * LIBPLZMA_NONNULL session);
+
+
+/// @brief Ends the content of the remaining items and waits for the end of the compression.
+/// @return The compression result.
+/// @note Thread-safe.
+LIBPLZMA_C_API(bool) plzma_encoder_session_finish(plzma_encoder_session * LIBPLZMA_NONNULL session);
+
+
+/// @brief Aborts the compression and waits for the end of the compression thread.
+/// @note Thread-safe.
+LIBPLZMA_C_API(void) plzma_encoder_session_abort(plzma_encoder_session * LIBPLZMA_NONNULL session);
+
+
+/// @brief Releases the session object. The unfinished session is aborted.
+LIBPLZMA_C_API(void) plzma_encoder_session_release(plzma_encoder_session * LIBPLZMA_NONNULL session);
+
 #endif // !__LIBPLZMA_H__
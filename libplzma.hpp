@@ -874,6 +874,45 @@ namespace plzma {
     LIBPLZMA_CPP_API(SharedPtr<InStream>) makeSharedInStream(Path && path);
     
     
+    /// @brief Creates the input file stream with path, which reads the file content via memory mapping.
+    ///
+    /// The whole file is mapped to the address space during the opening, the reading doesn't require a system call
+    /// and the intermediate buffering, the clones of the stream share the pages of the file cache.
+    /// If the file can't be mapped, i.e. the size exceeds the address space, the stream reads the file as a regular file stream.
+    /// @param path The non-empty input file path.
+    /// @return The shared pointer with input file stream.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if path is empty.
+    /// @note The file should not be truncated while the stream is opened.
+    LIBPLZMA_CPP_API(SharedPtr<InStream>) makeSharedMappedInStream(const Path & path);
+    
+    
+    /// @brief Creates the input file stream with path, which reads the file content via memory mapping.
+    /// @param path The movable non-empty input file path.
+    /// @return The shared pointer with input file stream.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if path is empty.
+    /// @see \a makeSharedMappedInStream(const Path &) function.
+    LIBPLZMA_CPP_API(SharedPtr<InStream>) makeSharedMappedInStream(Path && path);
+    
+    
+    /// @brief Creates the input file stream with path, which reads the file content via positional reads of the file descriptor.
+    ///
+    /// The reading doesn't use the file position and the intermediate buffering, the clones of the stream share
+    /// a single descriptor and have independent reading positions, so they read the file at the same time without locking,
+    /// i.e. the extracting in parallel or from different threads doesn't reopen the file.
+    /// @param path The non-empty input file path.
+    /// @return The shared pointer with input file stream.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if path is empty.
+    LIBPLZMA_CPP_API(SharedPtr<InStream>) makeSharedPositionalInStream(const Path & path);
+    
+    
+    /// @brief Creates the input file stream with path, which reads the file content via positional reads of the file descriptor.
+    /// @param path The movable non-empty input file path.
+    /// @return The shared pointer with input file stream.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if path is empty.
+    /// @see \a makeSharedPositionalInStream(const Path &) function.
+    LIBPLZMA_CPP_API(SharedPtr<InStream>) makeSharedPositionalInStream(Path && path);
+    
+    
     /// @brief Creates the input file stream with the file memory content.
     /// During the creation, the memory will copyed.
     /// @param memory The file memory content.
@@ -907,6 +946,23 @@ namespace plzma {
                                                              plzma_in_stream_seek_callback LIBPLZMA_NONNULL seekCallback,
                                                              plzma_in_stream_read_callback LIBPLZMA_NONNULL readCallback,
                                                              const plzma_context context = plzma_context{nullptr, nullptr}); // C2059 = { .context = nullptr, .deinitializer = nullptr }
+    
+    
+    /// @brief Creates the sequential input stream with user defined callbacks, i.e. the stream of a pipe or a network response body.
+    ///
+    /// The stream is read only once from the beginning to the end, without seeking and without the intermediate temporary file.
+    /// Only the tar and xz archives can be decoded from the sequential stream, the decoder extracts or tests the items once.
+    /// The items of the tar archive are unknown until extracting or testing, the number of the items of the opened decoder is zero.
+    /// @param openCallback Opens the stream for reading.
+    /// @param closeCallback Closes the stream.
+    /// @param readCallback Reads the number of bytes into provided byffer. Similar to \a fread C function.
+    /// @param context The user defined context provided to all callbacks.
+    /// @return The shared pointer with input stream.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if not all callbacks are provided.
+    LIBPLZMA_CPP_API(SharedPtr<InStream>) makeSharedSequentialInStream(plzma_in_stream_open_callback LIBPLZMA_NONNULL openCallback,
+                                                                       plzma_in_stream_close_callback LIBPLZMA_NONNULL closeCallback,
+                                                                       plzma_in_stream_read_callback LIBPLZMA_NONNULL readCallback,
+                                                                       const plzma_context context = plzma_context{nullptr, nullptr});
 
     template<typename T>
     class Vector;
@@ -975,6 +1031,30 @@ namespace plzma {
     /// @return The output file stream.
     LIBPLZMA_CPP_API(SharedPtr<OutStream>) makeSharedOutStream(void);
     
+    
+    /// @brief Creates the output file stream object for writing to memory with preallocated memory.
+    ///
+    /// The memory of the stream grows geometrically, the expected size avoids the reallocations if the size of the content is known.
+    /// @param expectedSize The expected size in bytes of the stream's content. The memory grows if the content is larger.
+    /// @return The output file stream.
+    LIBPLZMA_CPP_API(SharedPtr<OutStream>) makeSharedOutStream(const uint64_t expectedSize);
+    
+    
+    /// @brief Creates the sequential output stream with user defined callbacks, i.e. the stream of a pipe or a network request body.
+    ///
+    /// The content is written only once from the beginning to the end, without seeking.
+    /// Only the xz archive and the tar archive with the known sizes of the items can be encoded to the sequential stream.
+    /// @param openCallback Opens the stream for writing.
+    /// @param closeCallback Closes the stream.
+    /// @param writeCallback Writes the provided bytes to the end of the stream. Similar to \a fwrite C function.
+    /// @param context The user defined context provided to all callbacks.
+    /// @return The shared pointer with output stream.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if not all callbacks are provided.
+    LIBPLZMA_CPP_API(SharedPtr<OutStream>) makeSharedSequentialOutStream(plzma_out_stream_open_callback LIBPLZMA_NONNULL openCallback,
+                                                                         plzma_out_stream_close_callback LIBPLZMA_NONNULL closeCallback,
+                                                                         plzma_out_stream_write_callback LIBPLZMA_NONNULL writeCallback,
+                                                                         const plzma_context context = plzma_context{nullptr, nullptr});
+    
     typedef Vector<SharedPtr<OutStream> > OutStreamArray;
 
     /// @brief Interface to the output multi volume/part stream.
@@ -1240,7 +1320,181 @@ namespace plzma {
     };
     
     
+    /// @brief The readable stream of the archive item's content.
+    ///
+    /// The content is decoded lazily, only when the caller reads it, via a bounded pipe between the decoding
+    /// and the reading threads, so the memory usage doesn't depend on the item's size.
+    /// @see Method \a Decoder::openItemStream().
+    class ItemStream {
+    private:
+        friend struct SharedPtr<ItemStream>;
+        virtual void retain() = 0;
+        virtual void release() = 0;
+        
+    protected:
+        virtual ~ItemStream() noexcept = default;
+        
+    public:
+        /// @return The item of the stream.
+        /// @note Thread-safe.
+        virtual SharedPtr<Item> item() const = 0;
+        
+        
+        /// @return The number of bytes read from the stream.
+        /// @note Thread-safe.
+        virtual uint64_t position() const = 0;
+        
+        
+        /// @brief Reads the next portion of the item's content, blocks until the content is decoded.
+        /// @param buffer The buffer to read to.
+        /// @param size The size in bytes of the buffer.
+        /// @return The number of bytes read or 0 if the whole content was read or the stream is closed.
+        /// @note Thread-safe.
+        /// @exception The \a Exception in case if the item's content can't be decoded.
+        virtual plzma_size_t read(void * LIBPLZMA_NONNULL buffer, const plzma_size_t size) = 0;
+        
+        
+        /// @brief Stops the decoding and closes the stream. The remaining content is skipped.
+        ///
+        /// The stream is also closed during the destruction.
+        /// @note Thread-safe.
+        virtual void close() = 0;
+    };
+    
+    template struct LIBPLZMA_CPP_CLASS_API SharedPtr<ItemStream>;
+    
+    
+    /// @brief The read-only table of the archive items.
+    ///
+    /// The properties of the items are stored by columns: the UTF-8 paths in a single pool, the sizes, CRCs,
+    /// timestamps and flags in the flat arrays. Listing of the huge archives doesn't allocate the object per item,
+    /// the \a Item objects are created only on demand via \a itemAt() method.
+    /// @see Method \a Decoder::itemTable().
+    class ItemTable {
+    private:
+        friend struct SharedPtr<ItemTable>;
+        virtual void retain() = 0;
+        virtual void release() = 0;
+        
+    protected:
+        virtual ~ItemTable() noexcept = default;
+        
+    public:
+        /// @return The number of items in the table, i.e. in the archive.
+        /// @note Thread-safe.
+        virtual plzma_size_t count() const noexcept = 0;
+        
+        
+        /// @return The UTF-8 path of the item at index. The string is valid as long as the table exists.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual const char * LIBPLZMA_NONNULL pathAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @return The size in bytes of the item at index.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual uint64_t sizeAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @return The packed size in bytes of the item at index.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual uint64_t packSizeAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @return The CRC32 checksum of the item at index.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual uint32_t crc32At(const plzma_size_t index) const = 0;
+        
+        
+        /// @return The creation, last access and last modification unix timestamps of the item at index.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual plzma_path_timestamp timestampAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @return Checks the item at index is encrypted.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual bool encryptedAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @return Checks the item at index is directory.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual bool isDirAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @brief Creates the item object with the properties of the table's item at index.
+        /// @return The new item, the same as \a Decoder::itemAt() method.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual SharedPtr<Item> itemAt(const plzma_size_t index) const = 0;
+    };
+    
+    template struct LIBPLZMA_CPP_CLASS_API SharedPtr<ItemTable>;
+    
+    
+    /// @brief The size-bounded cache of the decoded archive blocks, i.e. the solid 7z folders.
+    ///
+    /// The whole decoded content of the block is kept in memory, so the next items of the same block are copied
+    /// from the memory instead of decoding the block from the beginning. The least recently used blocks are removed
+    /// to fit the capacity. The cache might be shared by the decoders opened on the same archive file or on the clones
+    /// of the same stream, the blocks are matched by the source stream, the position of the packed block and the sizes
+    /// and CRCs of their items. The encrypted blocks are not cached.
+    /// @see Method \a Decoder::setBlockCache().
+    class BlockCache {
+    private:
+        friend struct SharedPtr<BlockCache>;
+        virtual void retain() = 0;
+        virtual void release() = 0;
+        
+    protected:
+        virtual ~BlockCache() noexcept = default;
+        
+    public:
+        /// @return The maximum size in bytes of the decoded content of all blocks. The larger blocks are not cached.
+        /// @note Thread-safe.
+        virtual uint64_t capacity() const noexcept = 0;
+        
+        
+        /// @return The size in bytes of the decoded content of the cached blocks.
+        /// @note Thread-safe.
+        virtual uint64_t size() const = 0;
+        
+        
+        /// @return The number of the cached blocks.
+        /// @note Thread-safe.
+        virtual plzma_size_t count() const = 0;
+        
+        
+        /// @return The number of times the requested block was found in the cache.
+        /// @note Thread-safe.
+        virtual uint64_t hits() const = 0;
+        
+        
+        /// @brief Removes all cached blocks.
+        /// @note Thread-safe.
+        virtual void clear() = 0;
+    };
+    
+    template struct LIBPLZMA_CPP_CLASS_API SharedPtr<BlockCache>;
+    
+    
+    /// @brief Creates the cache of the decoded archive blocks.
+    /// @param capacity The maximum size in bytes of the decoded content of all blocks.
+    /// @return The shared pointer with the empty cache.
+    LIBPLZMA_CPP_API(SharedPtr<BlockCache>) makeSharedBlockCache(const uint64_t capacity);
+    
+    
     /// @brief The \a Decoder for extracting or testing archive items.
+    ///
+    /// The opened decoder might extract or test the items from different threads at the same time.
+    /// The call made while the decoder is busy reads the already opened 7z or tar archive via the own clone of the input stream,
+    /// the other types are opened once more. Such call reports the own progress via the same delegate and is counted by the \a stats().
+    /// The opened item stream still owns the decoder exclusively.
     class Decoder {
     private:
         friend struct SharedPtr<Decoder>;
@@ -1270,6 +1524,53 @@ namespace plzma {
         virtual void setProgressDelegate(ProgressDelegate * LIBPLZMA_NULLABLE delegate) = 0;
         
         
+        /// @brief Getter for a number of threads used by the extracting or testing process.
+        /// @return The number of threads. \a 0 means the number of hardware threads.
+        /// @note Thread-safe.
+        virtual uint32_t numberOfThreads() const = 0;
+        
+        
+        /// @brief Setter for a number of threads used by the extracting or testing process.
+        ///
+        /// Applied to the 7z(LZMA2) and xz archives, the tar archives are always extracted in a single thread.
+        /// @param threads The number of threads. \a 0, the default value, means the number of hardware threads.
+        /// @note Has no effect if the library was built without \a LIBPLZMA_OPT_MULTITHREAD option.
+        /// @note Thread-safe. Must be set before extracting or testing.
+        virtual void setNumberOfThreads(const uint32_t threads) = 0;
+        
+        
+        /// @brief Getter for a parallel extracting or testing of the independent 7z blocks.
+        /// @note Disabled by default, the value is \a false.
+        /// @note Thread-safe.
+        virtual bool shouldExtractInParallel() const = 0;
+        
+        
+        /// @brief Setter for a parallel extracting or testing of the independent 7z blocks.
+        ///
+        /// The non-solid or multi-block 7z archive consists of the independent blocks(folders), each of them can be decoded separately.
+        /// If enabled, the blocks of the requested items are distributed among the worker threads, where each worker
+        /// has its own clone of the input stream and its own opened archive. The number of workers is limited by the \a numberOfThreads() value
+        /// and by the number of the blocks. The items are extracted to their own paths or output streams, the progress is combined.
+        /// Falls back to the single thread processing for the other archive types, archives with one block or
+        /// input streams which can't be cloned, i.e. created with the callbacks.
+        /// @param parallel Extract or test in parallel.
+        /// @note Thread-safe. Must be set before extracting or testing.
+        /// @throws \a Exception in case if the library was built with \a LIBPLZMA_OPT_THREAD_UNSAFE option.
+        virtual void setShouldExtractInParallel(const bool parallel) = 0;
+        
+        
+        /// @brief Provides the cache of the decoded blocks for extracting the items of the 7z archive to the output streams.
+        ///
+        /// The block of the requested item is decoded once to the memory and kept in the cache, the next requested items
+        /// of the same block are copied from the memory. Only the \a extract(const SharedPtr<ItemOutStreamArray> &) method
+        /// uses the cache, the items extracted to the paths or to the arena, tested or read via the item stream are decoded
+        /// as usual, so as the encrypted blocks and the blocks larger than the capacity of the cache.
+        /// The items copied from the cached blocks are counted by the \a stats().
+        /// @param cache The cache, possibly shared with the other decoders, or empty pointer to disable the caching.
+        /// @note Thread-safe.
+        virtual void setBlockCache(const SharedPtr<BlockCache> & cache) = 0;
+        
+        
         /// @brief Opens the archive.
         ///
         /// During the process, the decoder is self-retained as long as the operation is in progress.
@@ -1308,6 +1609,33 @@ namespace plzma {
         virtual SharedPtr<Item> itemAt(const plzma_size_t index) const = 0;
         
         
+        /// @brief Receives the table of all archive items.
+        ///
+        /// The table is built once, during the first call after opening, and is shared by the next calls.
+        /// @return The item table or empty pointer if the decoder is not opened.
+        /// @note Thread-safe.
+        virtual SharedPtr<ItemTable> itemTable() const = 0;
+        
+        
+        /// @brief Finds the archive item with a specific path.
+        ///
+        /// The lookup uses the hash index of the archive paths, built once during the first call after opening.
+        /// @param path The path of the item inside the archive, i.e. 'dir/file.txt'.
+        /// @return The first archive item with exactly the same path or empty pointer if there is no such item or the decoder is not opened.
+        /// @note Thread-safe.
+        virtual SharedPtr<Item> findItem(const Path & path) const = 0;
+        
+        
+        /// @brief Finds all archive items with the paths matching the glob pattern.
+        ///
+        /// The '*' matches any sequence of characters including the path separators, the '?' matches any single character.
+        /// The prefix lookup is the pattern with a trailing '*', i.e. 'dir/*'.
+        /// @param pattern The glob pattern of the paths inside the archive.
+        /// @return The new array instance with the matching items ordered by index or empty pointer if the decoder is not opened.
+        /// @note Thread-safe.
+        virtual SharedPtr<ItemArray> findItems(const Path & pattern) const = 0;
+        
+        
         /// @brief Extracts all archive items to a specific path.
         ///
         /// During the process, the decoder is self-retained as long as the operation is in progress.
@@ -1335,6 +1663,7 @@ namespace plzma {
         
         /// @brief Extracts each archive item to a separate out-stream.
         ///
+        /// The memory of the memory out-streams is preallocated with the size of the item.
         /// During the process, the decoder is self-retained as long as the operation is in progress.
         /// @param items The array with item/out-stream pairs.
         /// @note The extracting progress might be executed in a separate thread.
@@ -1343,6 +1672,67 @@ namespace plzma {
         virtual bool extract(const SharedPtr<ItemOutStreamArray> & items) = 0;
         
         
+        /// @brief Extracts archive items into a single contiguous memory arena owned by the decoder.
+        ///
+        /// The arena is allocated once with the total size of the items, known from the \a Item::size(),
+        /// and each item is decoded directly to it's own region, without intermediate out-streams or copying.
+        /// The regions follow the archive order, the views follow the order of the \a items array, which is not modified.
+        /// During the process, the decoder is self-retained as long as the operation is in progress.
+        /// @param items The array of items to extract.
+        /// @note The previous arena content is released only after a successful extraction.
+        /// @note Returns \a false if the decoder is already extracting.
+        /// @note The extracting progress might be executed in a separate thread.
+        /// @note The extracting progress might be aborted via \a abort() method.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_not_enough_memory code in case if the arena can't be allocated.
+        virtual bool extractToArena(const SharedPtr<ItemArray> & items) = 0;
+        
+        
+        /// @return The arena memory of the last extraction to arena or \a nullptr if nothing was extracted.
+        /// @note The memory is valid until the next extraction to arena or until the decoder exists.
+        /// @note Thread-safe.
+        virtual const void * LIBPLZMA_NULLABLE arena() const = 0;
+        
+        
+        /// @return The size in bytes of the arena memory.
+        /// @note Thread-safe.
+        virtual uint64_t arenaSize() const = 0;
+        
+        
+        /// @return The number of views of the last extraction to arena, i.e. the number of extracted items.
+        /// @note Thread-safe.
+        virtual plzma_size_t arenaViewsCount() const = 0;
+        
+        
+        /// @brief Receives the location of the extracted item's content inside the arena memory.
+        /// @param index The index of the item in the extracted items array. Must be less than the \a arenaViewsCount() value.
+        /// @return The view of the item's content.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if index is out of bounds.
+        virtual plzma_arena_view arenaViewAt(const plzma_size_t index) const = 0;
+        
+        
+        /// @brief Receives the raw counters of the current or last extracting or testing operation.
+        /// @return The snapshot of the counters, read without waiting for the operation.
+        /// @note Thread-safe.
+        virtual plzma_stats stats() const = 0;
+        
+        
+        /// @brief Opens the readable stream of the archive item's content.
+        ///
+        /// The item is decoded in a separate thread, as long as the caller reads the stream.
+        /// The decoder is busy until the stream is read to the end or closed, i.e. the other extracting or
+        /// testing operations return \a false during this time.
+        /// During the process, the decoder is self-retained as long as the stream exists.
+        /// @param item The item to read.
+        /// @return The item stream or empty pointer if the decoder is not opened or busy.
+        /// @note The decoding might be aborted via \a abort() method.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the item is empty
+        ///            or in case of thread unsafe build.
+        virtual SharedPtr<ItemStream> openItemStream(const SharedPtr<Item> & item) = 0;
+        
+        
         /// @brief Tests specific archive items.
         ///
         /// During the process, the decoder is self-retained as long as the operation is in progress.
@@ -1372,11 +1762,59 @@ namespace plzma {
     /// @param type The type of the arhive file content.
     /// @param context The user provided context.
     /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if provided stream is empty.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the 7z archive is provided with the sequential input stream.
     LIBPLZMA_CPP_API(SharedPtr<Decoder>) makeSharedDecoder(const SharedPtr<InStream> & stream,
                                                            const plzma_file_type type,
                                                            const plzma_context context = plzma_context{nullptr, nullptr}); // C2059 = { .context = nullptr, .deinitializer = nullptr }
     
     
+    /// @brief The push session of the \a Encoder, the content of the items is written by the caller during the compression.
+    ///
+    /// The items are compressed in a separate thread, each written chunk is passed to the encoder via a pipe
+    /// without the intermediate buffering, so the writing blocks until the encoder consumes the chunk.
+    /// @see Method \a Encoder::openSession().
+    class EncoderSession {
+    private:
+        friend struct SharedPtr<EncoderSession>;
+        virtual void retain() = 0;
+        virtual void release() = 0;
+        
+    protected:
+        virtual ~EncoderSession() noexcept = default;
+        
+    public:
+        /// @brief Writes the next chunk of the current item's content, blocks until the encoder consumes the chunk.
+        /// @param data The chunk of the content.
+        /// @param size The size in bytes of the chunk.
+        /// @return \a true if the chunk was consumed, \a false if the compression was aborted.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if all items are written.
+        /// @exception The \a Exception in case if the items can't be compressed.
+        virtual bool write(const void * LIBPLZMA_NONNULL data, const plzma_size_t size) = 0;
+        
+        
+        /// @brief Ends the content of the current item, the next writes provide the content of the next item.
+        /// @note Thread-safe.
+        virtual void nextItem() = 0;
+        
+        
+        /// @brief Ends the content of all remaining items and waits for the end of the compression.
+        /// @return \a true if the items were compressed, \a false if the compression was aborted.
+        /// @note Thread-safe.
+        /// @exception The \a Exception in case if the items can't be compressed.
+        virtual bool finish() = 0;
+        
+        
+        /// @brief Aborts the compression and waits for its end. The encoder is no longer valid.
+        ///
+        /// The unfinished session is also aborted during the destruction.
+        /// @note Thread-safe.
+        virtual void abort() = 0;
+    };
+    
+    template struct LIBPLZMA_CPP_CLASS_API SharedPtr<EncoderSession>;
+    
+    
     /// @brief The \a Encoder for compressing archive items.
     class Encoder {
     private:
@@ -1430,6 +1868,45 @@ namespace plzma {
         virtual void add(const SharedPtr<InStream> & stream, const Path & archivePath) = 0;
         
         
+        /// @brief Provides the existing archive of the same type to update.
+        ///
+        /// The items of the existing archive are copied to the output stream without recompression,
+        /// the added paths and streams with the same archive path replace the existing items.
+        /// The archive is opened with the encoder's password during the opening of the encoder.
+        /// @param stream The seekable input stream of the existing archive. Empty stream means no update.
+        /// @note Supported by the 7z and tar archives. The output stream must not write to the updated archive.
+        /// @note Thread-safe. Must be set before opening.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the archive type
+        ///            can't be updated or the stream is sequential.
+        virtual void setUpdateArchive(const SharedPtr<InStream> & stream) = 0;
+        
+        
+        /// @brief Removes the item of the updated archive.
+        ///
+        /// The content of the remaining items is copied without recompression,
+        /// only the solid blocks containing the removed items are recompressed.
+        /// The directory path removes all nested items, all items with the duplicated path are removed.
+        /// @param archivePath The path of the existing item or directory in archive. Empty path is not allowed.
+        /// @note Requires the updated archive, see \a setUpdateArchive.
+        /// @note Thread-safe. Must be set before opening.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the path is empty
+        ///            or during the opening, in case if the updated archive doesn't contain the item.
+        virtual void remove(const Path & archivePath) = 0;
+        
+        
+        /// @brief Renames the item of the updated archive without recompression of the content.
+        ///
+        /// The directory path renames all nested items, all items with the duplicated path are renamed.
+        /// @param archivePath The path of the existing item or directory in archive. Empty path is not allowed.
+        /// @param newArchivePath The new path of the item in archive. Empty path is not allowed.
+        /// @note Requires the updated archive, see \a setUpdateArchive.
+        /// @note Thread-safe. Must be set before opening.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the paths are empty
+        ///            or during the opening, in case if the updated archive doesn't contain the item
+        ///            or the new path collides with the path of the existing, renamed or added item.
+        virtual void rename(const Path & archivePath, const Path & newArchivePath) = 0;
+        
+        
         /// @brief Opens the encoder for compressing.
         ///
         /// During the process, the encoder is self-retained as long as the operation is in progress.
@@ -1456,6 +1933,31 @@ namespace plzma {
         virtual bool compress() = 0;
         
         
+        /// @brief Receives the raw counters of the current or last compressing operation.
+        /// @return The snapshot of the counters, read without waiting for the operation.
+        /// @note Thread-safe.
+        virtual plzma_stats stats() const = 0;
+        
+        
+        /// @brief Opens the push session with the items, which content is unknown before the compression.
+        ///
+        /// The session opens the encoder and compresses the items in a separate thread, the caller writes the content
+        /// of each item in the provided order via \a EncoderSession::write() and \a EncoderSession::nextItem() methods.
+        /// The item's path is the archive path. The item's size is optional: \a 0 means the unknown size.
+        /// The tar item of unknown size requires the seekable output stream, i.e. the file or memory stream,
+        /// the header is rewritten after the content. The sequential output stream, i.e. \a makeSharedSequentialOutStream(),
+        /// receives the archive content as it's compressed, the tar items of such session must have the known sizes.
+        /// @param items The non-empty array of items. Only one item for the xz archive.
+        /// @return The session or empty pointer if the encoder was aborted.
+        /// @note Supported by the xz and tar archives. The encoder must not have added paths or streams.
+        /// @note Thread-safe.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the arguments are invalid,
+        ///            the encoder is already opened or in case of thread unsafe build.
+        /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the tar item of unknown size
+        ///            is provided with the sequential output stream.
+        virtual SharedPtr<EncoderSession> openSession(const SharedPtr<ItemArray> & items) = 0;
+        
+        
         /// @brief Getter for a 'solid' archive property.
         /// @note Enabled by default, the value is \a true.
         /// @note Thread-safe.
@@ -1479,6 +1981,66 @@ namespace plzma {
         virtual void setCompressionLevel(const uint8_t level) = 0;
         
         
+        /// @brief Getter for a number of threads used by the compressing process.
+        /// @return The number of threads. \a 0 means the number of hardware threads.
+        /// @note Thread-safe.
+        virtual uint32_t numberOfThreads() const = 0;
+        
+        
+        /// @brief Setter for a number of threads used by the compressing process.
+        ///
+        /// Applied to the 7z and xz archives, the tar archives are always created in a single thread.
+        /// @param threads The number of threads. \a 0, the default value, means the number of hardware threads.
+        /// @note Has no effect if the library was built without \a LIBPLZMA_OPT_MULTITHREAD option.
+        /// @note Thread-safe. Must be set before opening.
+        virtual void setNumberOfThreads(const uint32_t threads) = 0;
+        
+        
+        /// @brief Getter for the properties of the LZMA and LZMA2 compression methods.
+        /// @return The properties, by default, all of them are defined by the compression level.
+        /// @note Thread-safe.
+        virtual plzma_method_properties methodProperties() const = 0;
+        
+        
+        /// @brief Setter for the properties of the LZMA and LZMA2 compression methods.
+        ///
+        /// Applied to the 7z archives with LZMA or LZMA2 method and to the xz archives.
+        /// @param properties The properties to validate and apply.
+        /// @note Thread-safe. Must be set before opening.
+        /// @throws \a Exception with \a plzma_error_code_invalid_arguments code if any property is out of range or not supported by the method,
+        /// i.e. PPMd method or LZMA block size.
+        virtual void setMethodProperties(const plzma_method_properties & properties) = 0;
+        
+        
+        /// @brief Getter for the filter which preprocesses the content before the compression method.
+        /// @return The filter, by default, the \a plzma_filter_auto.
+        /// @note Thread-safe.
+        virtual plzma_filter filter() const = 0;
+        
+        
+        /// @brief Setter for the filter which preprocesses the content before the compression method.
+        ///
+        /// Applied to the 7z and xz archives, ignored by the tar archives.
+        /// @param filter The filter.
+        /// @note Thread-safe. Must be set before opening.
+        /// @throws \a Exception with \a plzma_error_code_invalid_arguments code if the filter is unknown or not supported by the archive type,
+        /// i.e. BCJ2 and xz archive or BCJ2 without \a LIBPLZMA_OPT_MULTITHREAD option.
+        virtual void setFilter(const plzma_filter filter) = 0;
+        
+        
+        /// @brief Getter for the distance of the Delta filter.
+        /// @return The distance in bytes, by default, \a 1.
+        /// @note Thread-safe.
+        virtual uint32_t filterDeltaDistance() const = 0;
+        
+        
+        /// @brief Setter for the distance of the Delta filter, i.e. the size of the row of the tabular data.
+        /// @param distance The distance in bytes in a range [1; 256].
+        /// @note Thread-safe. Must be set before opening.
+        /// @throws \a Exception with \a plzma_error_code_invalid_arguments code if the distance is out of range.
+        virtual void setFilterDeltaDistance(const uint32_t distance) = 0;
+        
+        
         /// @brief Should encoder compress the archive header.
         /// @note Enabled by default, the value is \a true.
         /// @note Thread-safe.
@@ -1573,6 +2135,7 @@ namespace plzma {
     /// @param method The compresion method.
     /// @param context The user provided context to inform the progress of the operation.
     /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if provided stream is empty.
+    /// @exception The \a Exception with \a plzma_error_code_invalid_arguments code in case if the 7z archive is provided with the sequential output stream.
     LIBPLZMA_CPP_API(SharedPtr<Encoder>) makeSharedEncoder(const SharedPtr<OutStream> & stream,
                                                            const plzma_file_type type,
                                                            const plzma_method method,
@@ -158,6 +158,7 @@ if (VALUE->IsString()) { \
 namespace nplzma {
     
     class PathIterator;
+    class ItemStream;
     class Item;
     template<class T>
     class OutStream;
@@ -289,6 +290,20 @@ namespace nplzma {
         static void Init(Local<Object> exports);
     };
     
+    class ItemStream final : public node::ObjectWrap {
+    private:
+        friend class Decoder;
+        plzma::SharedPtr<plzma::ItemStream> _stream;
+    public:
+        ItemStream(plzma::SharedPtr<plzma::ItemStream> && stream) : node::ObjectWrap(),
+            _stream(std::move(stream)) { }
+        virtual ~ItemStream() { }
+        
+        static void Read(const FunctionCallbackInfo<Value> & args);
+        static void Close(const FunctionCallbackInfo<Value> & args);
+        static void Position(Local<String> property, const PropertyCallbackInfo<Value> & info);
+    };
+    
     template<class T>
     class OutStream final : public TypedObjectWrap<OutStream<T> > {
     private:
@@ -353,6 +368,14 @@ namespace nplzma {
         static void SetShouldCreateSolidArchive(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
         static void CompressionLevel(Local<String> property, const PropertyCallbackInfo<Value> & info);
         static void SetCompressionLevel(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
+        static void NumberOfThreads(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void SetNumberOfThreads(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
+        static void MethodProperties(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void SetMethodProperties(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
+        static void Filter(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void SetFilter(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
+        static void FilterDeltaDistance(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void SetFilterDeltaDistance(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
         static void ShouldCompressHeader(Local<String> property, const PropertyCallbackInfo<Value> & info);
         static void SetShouldCompressHeader(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
         static void ShouldCompressHeaderFull(Local<String> property, const PropertyCallbackInfo<Value> & info);
@@ -390,9 +413,15 @@ namespace nplzma {
         static void Abort(const FunctionCallbackInfo<Value> & args);
         static void ItemAt(const FunctionCallbackInfo<Value> & args);
         static void Extract(const FunctionCallbackInfo<Value> & args);
+        static void ExtractToArena(const FunctionCallbackInfo<Value> & args);
+        static void OpenItemStream(const FunctionCallbackInfo<Value> & args);
         static void Test(const FunctionCallbackInfo<Value> & args);
         static void Count(Local<String> property, const PropertyCallbackInfo<Value> & info);
         static void Items(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void NumberOfThreads(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void SetNumberOfThreads(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
+        static void ShouldExtractInParallel(Local<String> property, const PropertyCallbackInfo<Value> & info);
+        static void SetShouldExtractInParallel(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info);
         static void New(const FunctionCallbackInfo<Value> & args);
     public:
         Decoder(plzma::SharedPtr<plzma::Decoder> && decoder) : node::ObjectWrap(),
@@ -835,6 +864,169 @@ namespace nplzma {
         }
     }
     
+    void Encoder::NumberOfThreads(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        info.GetReturnValue().Set(Uint32::NewFromUnsigned(isolate, encoder->_encoder->numberOfThreads()));
+    }
+    
+    void Encoder::SetNumberOfThreads(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        Local<Context> context = isolate->GetCurrentContext();
+        uint32_t numberOfThreadsValue = 0;
+        bool numberOfThreadsValueDefined = false;
+        NPLZMA_GET_UINT32_FROM_VALUE(context, value, numberOfThreadsValue, numberOfThreadsValueDefined)
+        if (numberOfThreadsValueDefined) {
+            encoder->_encoder->setNumberOfThreads(numberOfThreadsValue);
+        } else {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "numberOfThreads")
+        }
+    }
+    
+    void Encoder::MethodProperties(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Local<Context> context = isolate->GetCurrentContext();
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        plzma_method_properties properties;
+        NPLZMA_TRY
+        properties = encoder->_encoder->methodProperties();
+        NPLZMA_CATCH_RET(isolate)
+        // Only the properties which are not defined by the compression level.
+        Local<Object> propertiesObject = Object::New(isolate);
+        if (properties.dictionary_size > 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "dictionarySize").ToLocalChecked(), BigInt::NewFromUnsigned(isolate, properties.dictionary_size)).FromJust();
+        }
+        if (properties.block_size > 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "blockSize").ToLocalChecked(), BigInt::NewFromUnsigned(isolate, properties.block_size)).FromJust();
+        }
+        if (properties.word_size > 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "wordSize").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, properties.word_size)).FromJust();
+        }
+        if (properties.match_finder_cycles > 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "matchFinderCycles").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, properties.match_finder_cycles)).FromJust();
+        }
+        if (properties.match_finder != plzma_match_finder_default) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "matchFinder").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, properties.match_finder)).FromJust();
+        }
+        if (properties.literal_context_bits >= 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "literalContextBits").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, static_cast<uint32_t>(properties.literal_context_bits))).FromJust();
+        }
+        if (properties.literal_position_bits >= 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "literalPositionBits").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, static_cast<uint32_t>(properties.literal_position_bits))).FromJust();
+        }
+        if (properties.position_bits >= 0) {
+            propertiesObject->Set(context, String::NewFromUtf8(isolate, "positionBits").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, static_cast<uint32_t>(properties.position_bits))).FromJust();
+        }
+        info.GetReturnValue().Set(propertiesObject);
+    }
+    
+    void Encoder::SetMethodProperties(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Local<Context> context = isolate->GetCurrentContext();
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        if (!value->IsObject()) {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "methodProperties")
+        }
+        Local<Object> propertiesObject = value->ToObject(context).ToLocalChecked();
+        plzma_method_properties properties = { 0, 0, 0, 0, plzma_match_finder_default, -1, -1, -1 };
+        static const char * keys[8] = {
+            "dictionarySize", "blockSize", "wordSize", "matchFinderCycles",
+            "matchFinder", "literalContextBits", "literalPositionBits", "positionBits"
+        };
+        for (int i = 0; i < 8; i++) {
+            Local<Value> propertyValue = propertiesObject->Get(context, String::NewFromUtf8(isolate, keys[i]).ToLocalChecked()).ToLocalChecked();
+            if (propertyValue->IsUndefined() || propertyValue->IsNull()) {
+                continue; // defined by the compression level
+            }
+            bool propertyValueDefined = false;
+            if (i < 2) {
+                uint64_t sizeValue = 0;
+                NPLZMA_GET_UINT64_FROM_VALUE(context, propertyValue, sizeValue, propertyValueDefined)
+                if (i == 0) {
+                    properties.dictionary_size = sizeValue;
+                } else {
+                    properties.block_size = sizeValue;
+                }
+            } else {
+                uint32_t uint32Value = 0;
+                NPLZMA_GET_UINT32_FROM_VALUE(context, propertyValue, uint32Value, propertyValueDefined)
+                switch (i) {
+                    case 2: properties.word_size = uint32Value; break;
+                    case 3: properties.match_finder_cycles = uint32Value; break;
+                    case 4: properties.match_finder = static_cast<plzma_match_finder>(uint32Value); break;
+                    default:
+                        if (uint32Value > INT8_MAX) {
+                            propertyValueDefined = false;
+                        } else if (i == 5) {
+                            properties.literal_context_bits = static_cast<int8_t>(uint32Value);
+                        } else if (i == 6) {
+                            properties.literal_position_bits = static_cast<int8_t>(uint32Value);
+                        } else {
+                            properties.position_bits = static_cast<int8_t>(uint32Value);
+                        }
+                        break;
+                }
+            }
+            if (!propertyValueDefined) {
+                NPLZMA_THROW_ARG1_TYPE_ERROR_RET(isolate, "methodProperties.%s", keys[i])
+            }
+        }
+        NPLZMA_TRY
+        encoder->_encoder->setMethodProperties(properties);
+        NPLZMA_CATCH_RET(isolate)
+    }
+    
+    void Encoder::Filter(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        info.GetReturnValue().Set(Uint32::NewFromUnsigned(isolate, encoder->_encoder->filter()));
+    }
+    
+    void Encoder::SetFilter(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        Local<Context> context = isolate->GetCurrentContext();
+        uint32_t filterValue = 0;
+        bool filterValueDefined = false;
+        NPLZMA_GET_UINT32_FROM_VALUE(context, value, filterValue, filterValueDefined)
+        if (!filterValueDefined) {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "filter")
+        }
+        NPLZMA_TRY
+        encoder->_encoder->setFilter(static_cast<plzma_filter>(filterValue));
+        NPLZMA_CATCH_RET(isolate)
+    }
+    
+    void Encoder::FilterDeltaDistance(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        info.GetReturnValue().Set(Uint32::NewFromUnsigned(isolate, encoder->_encoder->filterDeltaDistance()));
+    }
+    
+    void Encoder::SetFilterDeltaDistance(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Encoder * encoder = ObjectWrap::Unwrap<Encoder>(info.Holder());
+        Local<Context> context = isolate->GetCurrentContext();
+        uint32_t distanceValue = 0;
+        bool distanceValueDefined = false;
+        NPLZMA_GET_UINT32_FROM_VALUE(context, value, distanceValue, distanceValueDefined)
+        if (!distanceValueDefined) {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "filterDeltaDistance")
+        }
+        NPLZMA_TRY
+        encoder->_encoder->setFilterDeltaDistance(distanceValue);
+        NPLZMA_CATCH_RET(isolate)
+    }
+    
     void Encoder::ShouldCompressHeader(Local<String> property, const PropertyCallbackInfo<Value> & info) {
         Isolate * isolate = info.GetIsolate();
         HandleScope handleScope(isolate);
@@ -962,6 +1154,10 @@ namespace nplzma {
         // (new Encoder(...)).<prop>
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "shouldCreateSolidArchive").ToLocalChecked(), Encoder::ShouldCreateSolidArchive, Encoder::SetShouldCreateSolidArchive, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "compressionLevel").ToLocalChecked(), Encoder::CompressionLevel, Encoder::SetCompressionLevel, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
+        ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "numberOfThreads").ToLocalChecked(), Encoder::NumberOfThreads, Encoder::SetNumberOfThreads, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
+        ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "methodProperties").ToLocalChecked(), Encoder::MethodProperties, Encoder::SetMethodProperties, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
+        ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "filter").ToLocalChecked(), Encoder::Filter, Encoder::SetFilter, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
+        ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "filterDeltaDistance").ToLocalChecked(), Encoder::FilterDeltaDistance, Encoder::SetFilterDeltaDistance, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "shouldCompressHeader").ToLocalChecked(), Encoder::ShouldCompressHeader, Encoder::SetShouldCompressHeader, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "shouldCompressHeaderFull").ToLocalChecked(), Encoder::ShouldCompressHeaderFull, Encoder::SetShouldCompressHeaderFull, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "shouldEncryptContent").ToLocalChecked(), Encoder::ShouldEncryptContent, Encoder::SetShouldEncryptContent, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
@@ -1381,6 +1577,153 @@ namespace nplzma {
         }
     }
         
+    void Decoder::ExtractToArena(const FunctionCallbackInfo<Value> & args) {
+        Isolate * isolate = args.GetIsolate();
+        HandleScope handleScope(isolate);
+        Local<Context> context = isolate->GetCurrentContext();
+        Decoder * decoder = ObjectWrap::Unwrap<Decoder>(args.Holder());
+        if (decoder->_asyncData) {
+            isolate->ThrowException(Exception::Error(String::NewFromUtf8(isolate, "Previous asynchronous operation is not completed.").ToLocalChecked()));
+            return;
+        }
+        if (args.Length() < 1 || !args[0]->IsArray()) {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "extractToArena(?)")
+        }
+        Local<Array> arr = Local<Array>::Cast(args[0]);
+        plzma::SharedPtr<plzma::ItemArray> itemsArray;
+        NPLZMA_TRY
+        itemsArray = plzma::makeShared<plzma::ItemArray>(static_cast<plzma_size_t>(arr->Length()));
+        NPLZMA_CATCH_RET(isolate)
+        for (uint32_t i = 0, n = arr->Length(); i < n; i++) {
+            Local<Value> itemValue = arr->Get(context, i).ToLocalChecked();
+            bool invalidArg1 = true;
+            if (itemValue->IsObject()) {
+                Local<Object> itemObj = itemValue->ToObject(context).ToLocalChecked();
+                Item * item = Item::TypedUnwrap(itemObj);
+                if (item) {
+                    NPLZMA_TRY
+                    itemsArray->push(item->_item);
+                    invalidArg1 = false;
+                    NPLZMA_CATCH_RET(isolate)
+                }
+            }
+            if (invalidArg1) {
+                NPLZMA_THROW_ARG1_TYPE_ERROR_RET(isolate, "extractToArena(items<Item>[%llu?])", static_cast<unsigned long long>(i))
+            }
+        }
+        bool extracted = false;
+        uint64_t arenaSize = 0;
+        NPLZMA_TRY
+        extracted = decoder->_decoder->extractToArena(itemsArray);
+        arenaSize = decoder->_decoder->arenaSize();
+        NPLZMA_CATCH_RET(isolate)
+        if (!extracted) {
+            args.GetReturnValue().Set(Null(isolate));
+            return;
+        }
+        // The decoder-owned arena is copied once to a single JS buffer, the items are the views of this buffer.
+        Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, static_cast<size_t>(arenaSize));
+        if (arenaSize > 0) {
+            memcpy(buffer->GetBackingStore()->Data(), decoder->_decoder->arena(), static_cast<size_t>(arenaSize));
+        }
+        Local<Array> views = Array::New(isolate, static_cast<int>(itemsArray->count()));
+        for (plzma_size_t i = 0; i < itemsArray->count(); i++) {
+            // The views follow the order of the provided items.
+            plzma_arena_view view{0, 0};
+            NPLZMA_TRY
+            view = decoder->_decoder->arenaViewAt(i);
+            NPLZMA_CATCH_RET(isolate)
+            views->Set(context, i, Uint8Array::New(buffer, static_cast<size_t>(view.offset), static_cast<size_t>(view.size))).Check();
+        }
+        args.GetReturnValue().Set(views);
+    }
+    
+    void Decoder::OpenItemStream(const FunctionCallbackInfo<Value> & args) {
+        Isolate * isolate = args.GetIsolate();
+        HandleScope handleScope(isolate);
+        Local<Context> context = isolate->GetCurrentContext();
+        Decoder * decoder = ObjectWrap::Unwrap<Decoder>(args.Holder());
+        if (decoder->_asyncData) {
+            isolate->ThrowException(Exception::Error(String::NewFromUtf8(isolate, "Previous asynchronous operation is not completed.").ToLocalChecked()));
+            return;
+        }
+        Item * item = nullptr;
+        if (args.Length() > 0 && args[0]->IsObject()) {
+            item = Item::TypedUnwrap(args[0]->ToObject(context).ToLocalChecked());
+        }
+        if (!item) {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "openItemStream(?)")
+        }
+        plzma::SharedPtr<plzma::ItemStream> stream;
+        NPLZMA_TRY
+        stream = decoder->_decoder->openItemStream(item->_item);
+        NPLZMA_CATCH_RET(isolate)
+        if (!stream) {
+            args.GetReturnValue().Set(Null(isolate));
+            return;
+        }
+        
+        Local<ObjectTemplate> tpl = ObjectTemplate::New(isolate);
+        tpl->SetInternalFieldCount(1);
+        
+        tpl->Set(String::NewFromUtf8(isolate, "read").ToLocalChecked(), FunctionTemplate::New(isolate, ItemStream::Read), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
+        tpl->Set(String::NewFromUtf8(isolate, "close").ToLocalChecked(), FunctionTemplate::New(isolate, ItemStream::Close), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
+        
+        tpl->SetAccessor(String::NewFromUtf8(isolate, "position").ToLocalChecked(), ItemStream::Position, nullptr, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
+        
+        Local<Object> streamObject = tpl->NewInstance(context).ToLocalChecked();
+        ItemStream * itemStream = nullptr;
+        NPLZMA_TRY
+        itemStream = new ItemStream(std::move(stream));
+        NPLZMA_CATCH_RET(isolate)
+        
+        itemStream->Wrap(streamObject);
+        args.GetReturnValue().Set(streamObject);
+    }
+    
+    void ItemStream::Read(const FunctionCallbackInfo<Value> & args) {
+        Isolate * isolate = args.GetIsolate();
+        HandleScope handleScope(isolate);
+        Local<Context> context = isolate->GetCurrentContext();
+        ItemStream * itemStream = ObjectWrap::Unwrap<ItemStream>(args.Holder());
+        uint32_t size = 64 * 1024;
+        if (args.Length() > 0) {
+            bool sizeDefined = false;
+            NPLZMA_GET_UINT32_FROM_VALUE(context, args[0], size, sizeDefined)
+            if (!sizeDefined) {
+                NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "read(?)")
+            }
+        }
+        Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, static_cast<size_t>(size));
+        plzma_size_t readSize = 0;
+        NPLZMA_TRY
+        if (size > 0) {
+            readSize = itemStream->_stream->read(buffer->GetBackingStore()->Data(), static_cast<plzma_size_t>(size));
+        }
+        NPLZMA_CATCH_RET(isolate)
+        args.GetReturnValue().Set(Uint8Array::New(buffer, 0, static_cast<size_t>(readSize)));
+    }
+    
+    void ItemStream::Close(const FunctionCallbackInfo<Value> & args) {
+        Isolate * isolate = args.GetIsolate();
+        HandleScope handleScope(isolate);
+        ItemStream * itemStream = ObjectWrap::Unwrap<ItemStream>(args.Holder());
+        NPLZMA_TRY
+        itemStream->_stream->close();
+        NPLZMA_CATCH_RET(isolate)
+    }
+    
+    void ItemStream::Position(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        ItemStream * itemStream = ObjectWrap::Unwrap<ItemStream>(info.Holder());
+        uint64_t position = 0;
+        NPLZMA_TRY
+        position = itemStream->_stream->position();
+        NPLZMA_CATCH_RET(isolate)
+        info.GetReturnValue().Set(BigInt::NewFromUnsigned(isolate, position));
+    }
+    
     void Decoder::Test(const FunctionCallbackInfo<Value> & args) {
         Isolate * isolate = args.GetIsolate();
         HandleScope handleScope(isolate);
@@ -1457,6 +1800,42 @@ namespace nplzma {
         info.GetReturnValue().Set(Uint32::NewFromUnsigned(isolate, count));
     }
     
+    void Decoder::NumberOfThreads(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Decoder * decoder = ObjectWrap::Unwrap<Decoder>(info.Holder());
+        info.GetReturnValue().Set(Uint32::NewFromUnsigned(isolate, decoder->_decoder->numberOfThreads()));
+    }
+    
+    void Decoder::SetNumberOfThreads(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Decoder * decoder = ObjectWrap::Unwrap<Decoder>(info.Holder());
+        Local<Context> context = isolate->GetCurrentContext();
+        uint32_t numberOfThreadsValue = 0;
+        bool numberOfThreadsValueDefined = false;
+        NPLZMA_GET_UINT32_FROM_VALUE(context, value, numberOfThreadsValue, numberOfThreadsValueDefined)
+        if (numberOfThreadsValueDefined) {
+            decoder->_decoder->setNumberOfThreads(numberOfThreadsValue);
+        } else {
+            NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "numberOfThreads")
+        }
+    }
+    
+    void Decoder::ShouldExtractInParallel(Local<String> property, const PropertyCallbackInfo<Value> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Decoder * decoder = ObjectWrap::Unwrap<Decoder>(info.Holder());
+        info.GetReturnValue().Set(Boolean::New(isolate, decoder->_decoder->shouldExtractInParallel()));
+    }
+    
+    void Decoder::SetShouldExtractInParallel(Local<String> property, Local<Value> value, const PropertyCallbackInfo<void> & info) {
+        Isolate * isolate = info.GetIsolate();
+        HandleScope handleScope(isolate);
+        Decoder * decoder = ObjectWrap::Unwrap<Decoder>(info.Holder());
+        decoder->_decoder->setShouldExtractInParallel(value->BooleanValue(isolate));
+    }
+    
     void Decoder::Items(Local<String> property, const PropertyCallbackInfo<Value> & info) {
         Isolate * isolate = info.GetIsolate();
         HandleScope handleScope(isolate);
@@ -1519,12 +1898,16 @@ namespace nplzma {
         ctorProtoTpl->Set(String::NewFromUtf8(isolate, "itemAt").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::ItemAt), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
         ctorProtoTpl->Set(String::NewFromUtf8(isolate, "extract").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::Extract, Boolean::New(isolate, false)), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
         ctorProtoTpl->Set(String::NewFromUtf8(isolate, "extractAsync").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::Extract, Boolean::New(isolate, true)), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
+        ctorProtoTpl->Set(String::NewFromUtf8(isolate, "extractToArena").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::ExtractToArena), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
+        ctorProtoTpl->Set(String::NewFromUtf8(isolate, "openItemStream").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::OpenItemStream), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
         ctorProtoTpl->Set(String::NewFromUtf8(isolate, "test").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::Test, Boolean::New(isolate, false)), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
         ctorProtoTpl->Set(String::NewFromUtf8(isolate, "testAsync").ToLocalChecked(), FunctionTemplate::New(isolate, Decoder::Test, Boolean::New(isolate, true)), static_cast<PropertyAttribute>(ReadOnly | DontEnum | DontDelete));
         
         // (new Decoder(...)).<prop>
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "count").ToLocalChecked(), Decoder::Count, nullptr, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
         ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "items").ToLocalChecked(), Decoder::Items, nullptr, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
+        ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "numberOfThreads").ToLocalChecked(), Decoder::NumberOfThreads, Decoder::SetNumberOfThreads, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
+        ctorInstTpl->SetAccessor(String::NewFromUtf8(isolate, "shouldExtractInParallel").ToLocalChecked(), Decoder::ShouldExtractInParallel, Decoder::SetShouldExtractInParallel, Local<Value>(), DEFAULT, static_cast<PropertyAttribute>(DontDelete | DontEnum));
         
         Local<Function> constructor = ctorTpl->GetFunction(context).ToLocalChecked();
         dataObject->SetInternalField(0, constructor);
@@ -1664,7 +2047,7 @@ namespace nplzma {
             std::shared_ptr<BackingStore> backingStore;
             plzma::Path path;
             plzma::InStreamArray multiStreams;
-            int method = 0; // 0 - data, 1 - path, 2 - multi volume streams
+            int method = 0; // 0 - data, 1 - path, 2 - multi volume streams, 3 - mapped path
             bool unsupportedArg = true;
             if (args.Length() > 0) {
                 if (args[0]->IsString()) {
@@ -1718,6 +2101,9 @@ namespace nplzma {
             if (unsupportedArg) {
                 NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "InStream(?)")
             }
+            if (method == 1 && args.Length() > 1 && args[1]->BooleanValue(isolate)) {
+                method = 3;
+            }
             InStream * obj = nullptr;
             NPLZMA_TRY
             plzma::SharedPtr<plzma::InStream> stream;
@@ -1731,6 +2117,9 @@ namespace nplzma {
                 case 2: // multi volume streams
                     stream = plzma::makeSharedInStream(std::move(multiStreams));
                     break;
+                case 3: // mapped path
+                    stream = plzma::makeSharedMappedInStream(std::move(path));
+                    break;
                 default:
                     break;
             }
@@ -1903,12 +2292,16 @@ namespace nplzma {
         Local<Context> context = isolate->GetCurrentContext();
         if (args.IsConstructCall()) {
             plzma::Path path;
-            bool instantiateWithoutNativeStream = false;
+            uint64_t expectedSize = 0;
+            bool instantiateWithoutNativeStream = false, withExpectedSize = false;
             if (args.Length() > 0) {
                 bool valueDefined = false;
                 NPLZMA_GET_PATH_FROM_VALUE(isolate, context, args[0], path, valueDefined)
                 if (!valueDefined) {
-                    if (args[0]->StrictEquals(_instantiateWithoutNativeStream.Get(isolate))) {
+                    NPLZMA_GET_UINT64_FROM_VALUE(context, args[0], expectedSize, withExpectedSize)
+                    if (withExpectedSize) {
+                        // memory stream with expected size
+                    } else if (args[0]->StrictEquals(_instantiateWithoutNativeStream.Get(isolate))) {
                         instantiateWithoutNativeStream = true;
                     } else {
                         NPLZMA_THROW_ARG_TYPE_ERROR_RET(isolate, "OutStream(?)")
@@ -1919,6 +2312,8 @@ namespace nplzma {
             NPLZMA_TRY
             if (instantiateWithoutNativeStream) {
                 obj = new OutStream<plzma::OutStream>();
+            } else if (withExpectedSize) {
+                obj = new OutStream<plzma::OutStream>(plzma::makeSharedOutStream(expectedSize));
             } else {
                 auto stream = (args.Length() > 0) ? plzma::makeSharedOutStream(std::move(path)) : plzma::makeSharedOutStream();
                 obj = new OutStream<plzma::OutStream>(std::move(stream));
@@ -3043,6 +3438,33 @@ namespace nplzma {
         methodObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "PPMd").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_method_PPMd), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
         exports->Set(context, String::NewFromUtf8(isolate, "Method").ToLocalChecked(), methodObject).FromJust();
         
+        // plzma_match_finder
+        Local<Object> matchFinderObject = Object::New(isolate);
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "default").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_default), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "bt2").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_bt2), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "bt3").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_bt3), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "bt4").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_bt4), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "bt5").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_bt5), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "hc4").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_hc4), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        matchFinderObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "hc5").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_match_finder_hc5), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        exports->Set(context, String::NewFromUtf8(isolate, "MatchFinder").ToLocalChecked(), matchFinderObject).FromJust();
+        
+        // plzma_filter
+        Local<Object> filterObject = Object::New(isolate);
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "auto").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_auto), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "none").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_none), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "BCJ").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_BCJ), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "BCJ2").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_BCJ2), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "ARM64").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_ARM64), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "ARM").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_ARM), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "ARMT").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_ARMT), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "PPC").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_PPC), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "SPARC").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_SPARC), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "IA64").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_IA64), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "RISCV").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_RISCV), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        filterObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "Delta").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_filter_Delta), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
+        exports->Set(context, String::NewFromUtf8(isolate, "Filter").ToLocalChecked(), filterObject).FromJust();
+        
         // plzma_open_dir_mode
         Local<Object> openDirModeObject = Object::New(isolate);
         openDirModeObject->DefineOwnProperty(context, String::NewFromUtf8(isolate, "followSymlinks").ToLocalChecked(), Uint32::NewFromUnsigned(isolate, plzma_open_dir_mode_follow_symlinks), static_cast<PropertyAttribute>(ReadOnly | DontDelete)).Check();
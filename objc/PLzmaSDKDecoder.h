@@ -63,6 +63,28 @@
 @property (nonatomic, strong, readonly, nonnull) NSArray<PLzmaSDKItem *> * items;
 
 
+/// Getter/setter for a number of threads used by the extracting or testing process.
+///
+/// Applied to the 7z(LZMA2) and xz archives, the tar archives are always extracted in a single thread.
+/// - Parameter threads: The number of threads. `0`, the default value, means the number of hardware threads.
+/// - Returns: The number of threads. `0` means the number of hardware threads.
+/// - Note: Has no effect if the library was built without `LIBPLZMA_OPT_MULTITHREAD` option.
+/// - Note: Thread-safe. Must be set before extracting or testing.
+/// - Throws: `Exception`.
+@property (nonatomic, assign) uint32_t numberOfThreads;
+
+
+/// Parallel extracting or testing of the independent 7z blocks.
+///
+/// The blocks of the requested items are distributed among the worker threads, where each worker has its own clone of the input stream.
+/// The number of workers is limited by the number of threads value and by the number of the blocks.
+/// Falls back to the single thread processing for the other archive types, archives with one block or input streams which can't be cloned.
+/// - Note: Disabled by default, the value is `NO`.
+/// - Note: Thread-safe. Must be set before extracting or testing.
+/// - Throws: `Exception`.
+@property (nonatomic, assign) BOOL shouldExtractInParallel;
+
+
 /// Opens the archive.
 ///
 /// During the process, the decoder is self-retained as long the operation is in progress.
@@ -123,6 +145,19 @@
 - (BOOL) extractItemsToStreams:(nonnull NSDictionary<PLzmaSDKItem *, PLzmaSDKOutStream *> *) items;
 
 
+/// Extracts archive items into a single contiguous memory arena owned by the decoder.
+///
+/// The arena is allocated once with the total size of the items and each item is decoded directly to it's own region.
+/// - Parameter items: The array of items to extract.
+/// - Returns: The array with the content of each item, in the same order as the provided items, referencing the arena memory without copying.
+/// The data is valid until the next extraction to arena or until the decoder exists. Or nil if the items were not extracted.
+/// - Note: The extracting progress might be executed in a separate thread.
+/// - Note: The extracting progress might be aborted via `abort()` method.
+/// - Note: Thread-safe.
+/// - Throws: `Exception`.
+- (nullable NSArray<NSData *> *) extractItemsToArena:(nonnull NSArray<PLzmaSDKItem *> *) items;
+
+
 /// Tests specific archive items.
 /// - Parameter items: The array with items to test.
 /// - Note: The testing progress might be executed in a separate thread.
@@ -66,6 +66,32 @@
     return [NSArray array];
 }
 
+- (uint32_t) numberOfThreads {
+    PLZMASDKOBJC_TRY
+    return _decoder->numberOfThreads();
+    PLZMASDKOBJC_CATCH_RETHROW
+    return 0;
+}
+
+- (void) setNumberOfThreads:(uint32_t) val {
+    PLZMASDKOBJC_TRY
+    _decoder->setNumberOfThreads(val);
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
+- (BOOL) shouldExtractInParallel {
+    PLZMASDKOBJC_TRY
+    return _decoder->shouldExtractInParallel();
+    PLZMASDKOBJC_CATCH_RETHROW
+    return NO;
+}
+
+- (void) setShouldExtractInParallel:(BOOL) val {
+    PLZMASDKOBJC_TRY
+    _decoder->setShouldExtractInParallel(val);
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
 - (BOOL) open {
     PLZMASDKOBJC_TRY
     return _decoder->open();
@@ -123,6 +149,34 @@
     return NO;
 }
 
+- (nullable NSArray<NSData *> *) extractItemsToArena:(nonnull NSArray<PLzmaSDKItem *> *) items {
+    PLZMASDKOBJC_TRY
+    auto itemsArray = plzma::makeShared<plzma::ItemArray>(static_cast<plzma_size_t>(items.count));
+    for (PLzmaSDKItem * nsItem in items) {
+        auto item = *nsItem.itemSPtr;
+        itemsArray->push(std::move(item));
+    }
+    if (!_decoder->extractToArena(itemsArray)) {
+        return nil;
+    }
+    const uint8_t * arena = static_cast<const uint8_t *>(_decoder->arena());
+    NSMutableArray<NSData *> * datas = [NSMutableArray arrayWithCapacity:items.count];
+    for (plzma_size_t i = 0, n = itemsArray->count(); i < n; i++) {
+        // The views follow the order of the provided items.
+        const plzma_arena_view view = _decoder->arenaViewAt(i);
+        if (view.size > 0) {
+            [datas addObject:[NSData dataWithBytesNoCopy:const_cast<uint8_t *>(arena + view.offset)
+                                                  length:static_cast<NSUInteger>(view.size)
+                                            freeWhenDone:NO]];
+        } else {
+            [datas addObject:[NSData data]];
+        }
+    }
+    return datas;
+    PLZMASDKOBJC_CATCH_RETHROW
+    return nil;
+}
+
 - (BOOL) testItems:(nonnull NSArray<PLzmaSDKItem *> *) items {
     PLZMASDKOBJC_TRY
     auto itemsArray = plzma::makeShared<plzma::ItemArray>(static_cast<plzma_size_t>(items.count));
@@ -63,6 +63,42 @@
 @property (nonatomic, assign) uint8_t compressionLevel;
 
 
+/// Getter/setter for a number of threads used by the compressing process.
+///
+/// Applied to the 7z and xz archives, the tar archives are always created in a single thread.
+/// - Parameter threads: The number of threads. `0`, the default value, means the number of hardware threads.
+/// - Returns: The number of threads. `0` means the number of hardware threads.
+/// - Note: Has no effect if the library was built without `LIBPLZMA_OPT_MULTITHREAD` option.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception`.
+@property (nonatomic, assign) uint32_t numberOfThreads;
+
+
+/// Getter/setter for the properties of the `LZMA` and `LZMA2` compression methods.
+///
+/// Applied to the 7z archives with `LZMA` or `LZMA2` method and to the xz archives.
+/// By default, all of them are defined by the compression level.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception` if any property is out of range or not supported by the method, i.e. `PPMd` method or `LZMA` block size.
+@property (nonatomic, assign) PLzmaSDKMethodProperties methodProperties;
+
+
+/// Getter/setter for the filter which preprocesses the content before the compression method.
+///
+/// Applied to the 7z and xz archives, ignored by the tar archives. By default, the `PLzmaSDKFilterAuto`.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception` if the filter is not supported by the archive type, i.e. `BCJ2` and xz archive.
+@property (nonatomic, assign) PLzmaSDKFilter filter;
+
+
+/// Getter/setter for the distance of the `Delta` filter, i.e. the size of the row of the tabular data.
+///
+/// The distance in bytes in a range [1; 256], by default, `1`.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception` if the distance is out of range.
+@property (nonatomic, assign) uint32_t filterDeltaDistance;
+
+
 /// Should encoder compress the archive header.
 /// - Note: Thread-safe. Must be set before opening.
 /// - Note: Enabled by default, the value is `true`.
@@ -177,6 +213,37 @@
 - (void) addStream:(nonnull PLzmaSDKInStream *) stream withArchivePath:(nonnull NSString *) archivePath;
 
 
+/// Provides the existing archive of the same type to update.
+///
+/// The items of the existing archive are copied to the output stream without recompression,
+/// the added paths and streams with the same archive path replace the existing items.
+/// - Parameter stream: The seekable input stream of the existing archive. nil means no update.
+/// - Note: Supported by the 7z and tar archives. The output stream must not write to the updated archive.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception`.
+- (void) setUpdateArchiveStream:(nullable PLzmaSDKInStream *) stream;
+
+
+/// Removes the item of the updated archive.
+///
+/// The content of the remaining items is copied without recompression,
+/// only the solid blocks containing the removed items are recompressed.
+/// - Parameter archivePath: The path of the existing item in archive. Empty path is not allowed.
+/// - Note: Requires the updated archive, see `setUpdateArchiveStream`.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception`.
+- (void) removeArchivePath:(nonnull NSString *) archivePath;
+
+
+/// Renames the item of the updated archive without recompression of the content.
+/// - Parameter archivePath: The path of the existing item in archive. Empty path is not allowed.
+/// - Parameter newArchivePath: The new path of the item in archive. Empty path is not allowed.
+/// - Note: Requires the updated archive, see `setUpdateArchiveStream`.
+/// - Note: Thread-safe. Must be set before opening.
+/// - Throws: `Exception`.
+- (void) renameArchivePath:(nonnull NSString *) archivePath toArchivePath:(nonnull NSString *) newArchivePath;
+
+
 /// Provides the password for archive.
 ///
 /// This password will be used for encrypting header and the content if such options are enabled
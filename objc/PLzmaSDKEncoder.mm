@@ -69,6 +69,76 @@
     PLZMASDKOBJC_CATCH_RETHROW
 }
 
+- (uint32_t) numberOfThreads {
+    PLZMASDKOBJC_TRY
+    return _encoder->numberOfThreads();
+    PLZMASDKOBJC_CATCH_RETHROW
+    return 0;
+}
+
+- (void) setNumberOfThreads:(uint32_t) val {
+    PLZMASDKOBJC_TRY
+    _encoder->setNumberOfThreads(val);
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
+- (PLzmaSDKMethodProperties) methodProperties {
+    PLzmaSDKMethodProperties properties = { 0, 0, 0, 0, PLzmaSDKMatchFinderDefault, -1, -1, -1 };
+    PLZMASDKOBJC_TRY
+    const plzma_method_properties methodProperties = _encoder->methodProperties();
+    properties.dictionarySize = methodProperties.dictionary_size;
+    properties.blockSize = methodProperties.block_size;
+    properties.wordSize = methodProperties.word_size;
+    properties.matchFinderCycles = methodProperties.match_finder_cycles;
+    properties.matchFinder = static_cast<PLzmaSDKMatchFinder>(methodProperties.match_finder);
+    properties.literalContextBits = methodProperties.literal_context_bits;
+    properties.literalPositionBits = methodProperties.literal_position_bits;
+    properties.positionBits = methodProperties.position_bits;
+    PLZMASDKOBJC_CATCH_RETHROW
+    return properties;
+}
+
+- (void) setMethodProperties:(PLzmaSDKMethodProperties) val {
+    PLZMASDKOBJC_TRY
+    plzma_method_properties methodProperties;
+    methodProperties.dictionary_size = val.dictionarySize;
+    methodProperties.block_size = val.blockSize;
+    methodProperties.word_size = val.wordSize;
+    methodProperties.match_finder_cycles = val.matchFinderCycles;
+    methodProperties.match_finder = static_cast<plzma_match_finder>(val.matchFinder);
+    methodProperties.literal_context_bits = val.literalContextBits;
+    methodProperties.literal_position_bits = val.literalPositionBits;
+    methodProperties.position_bits = val.positionBits;
+    _encoder->setMethodProperties(methodProperties);
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
+- (PLzmaSDKFilter) filter {
+    PLZMASDKOBJC_TRY
+    return static_cast<PLzmaSDKFilter>(_encoder->filter());
+    PLZMASDKOBJC_CATCH_RETHROW
+    return PLzmaSDKFilterAuto;
+}
+
+- (void) setFilter:(PLzmaSDKFilter) val {
+    PLZMASDKOBJC_TRY
+    _encoder->setFilter(static_cast<plzma_filter>(val));
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
+- (uint32_t) filterDeltaDistance {
+    PLZMASDKOBJC_TRY
+    return _encoder->filterDeltaDistance();
+    PLZMASDKOBJC_CATCH_RETHROW
+    return 0;
+}
+
+- (void) setFilterDeltaDistance:(uint32_t) val {
+    PLZMASDKOBJC_TRY
+    _encoder->setFilterDeltaDistance(val);
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
 - (BOOL) shouldCompressHeader {
     PLZMASDKOBJC_TRY
     return _encoder->shouldCompressHeader();
@@ -201,6 +271,24 @@
     PLZMASDKOBJC_CATCH_RETHROW
 }
 
+- (void) setUpdateArchiveStream:(nullable PLzmaSDKInStream *) stream {
+    PLZMASDKOBJC_TRY
+    _encoder->setUpdateArchive(stream ? *stream.inStreamSPtr : plzma::SharedPtr<plzma::InStream>());
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
+- (void) removeArchivePath:(nonnull NSString *) archivePath {
+    PLZMASDKOBJC_TRY
+    _encoder->remove(plzma::Path(archivePath.UTF8String));
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
+- (void) renameArchivePath:(nonnull NSString *) archivePath toArchivePath:(nonnull NSString *) newArchivePath {
+    PLZMASDKOBJC_TRY
+    _encoder->rename(plzma::Path(archivePath.UTF8String), plzma::Path(newArchivePath.UTF8String));
+    PLZMASDKOBJC_CATCH_RETHROW
+}
+
 - (void) setPassword:(nonnull NSString *) password {
     PLZMASDKOBJC_TRY
     _encoder->setPassword(password.UTF8String);
@@ -120,6 +120,109 @@ typedef NS_ENUM(uint8_t, PLzmaSDKMethod) {
 };
 
 
+/// Match finder of the `LZMA` and `LZMA2` compression methods.
+typedef NS_ENUM(uint8_t, PLzmaSDKMatchFinder) {
+    
+    /// The match finder defined by the compression level.
+    PLzmaSDKMatchFinderDefault = 0,
+    
+    /// Binary tree with 2 bytes hashing.
+    PLzmaSDKMatchFinderBT2 = 1,
+    
+    /// Binary tree with 3 bytes hashing.
+    PLzmaSDKMatchFinderBT3 = 2,
+    
+    /// Binary tree with 4 bytes hashing.
+    PLzmaSDKMatchFinderBT4 = 3,
+    
+    /// Binary tree with 5 bytes hashing.
+    PLzmaSDKMatchFinderBT5 = 4,
+    
+    /// Hash chain with 4 bytes hashing. Faster than binary tree, but with worse compression ratio.
+    PLzmaSDKMatchFinderHC4 = 5,
+    
+    /// Hash chain with 5 bytes hashing.
+    PLzmaSDKMatchFinderHC5 = 6
+};
+
+
+/// Filter which preprocesses the content before the compression method to get a better compression ratio.
+///
+/// The branch converters(`BCJ`, `BCJ2`, `ARM64`, etc.) are useful for the executable files of the corresponding architecture,
+/// the `Delta` filter is useful for the tabular data with the fixed size rows, i.e. sensors data, uncompressed images or audio.
+typedef NS_ENUM(uint8_t, PLzmaSDKFilter) {
+    
+    /// The 7z archive automatically selects the branch converter for the executable files,
+    /// the xz archive doesn't use any filter.
+    PLzmaSDKFilterAuto = 0,
+    
+    /// Do not use any filter, including the automatic selection.
+    PLzmaSDKFilterNone = 1,
+    
+    /// Branch converter for the x86 and x86-64 executables.
+    PLzmaSDKFilterBCJ = 2,
+    
+    /// Improved branch converter for the x86 and x86-64 executables with separated streams.
+    /// - Note: Supported only by the 7z archive and requires the library built with `LIBPLZMA_OPT_MULTITHREAD` option.
+    PLzmaSDKFilterBCJ2 = 3,
+    
+    /// Branch converter for the ARM64 executables.
+    PLzmaSDKFilterARM64 = 4,
+    
+    /// Branch converter for the ARM(little-endian) executables.
+    PLzmaSDKFilterARM = 5,
+    
+    /// Branch converter for the ARM Thumb executables.
+    PLzmaSDKFilterARMT = 6,
+    
+    /// Branch converter for the PowerPC(big-endian) executables.
+    PLzmaSDKFilterPPC = 7,
+    
+    /// Branch converter for the SPARC executables.
+    PLzmaSDKFilterSPARC = 8,
+    
+    /// Branch converter for the Itanium executables.
+    PLzmaSDKFilterIA64 = 9,
+    
+    /// Branch converter for the RISC-V executables.
+    PLzmaSDKFilterRISCV = 10,
+    
+    /// Delta filter with the distance in bytes defined by the encoder's `filterDeltaDistance`.
+    PLzmaSDKFilterDelta = 11
+};
+
+
+/// The properties of the `LZMA` and `LZMA2` compression methods.
+///
+/// Each property overrides the value defined by the compression level.
+/// The zero value of the unsigned or the negative value of the signed property means the value defined by the compression level.
+typedef struct PLzmaSDKMethodProperties {
+    /// Dictionary size in bytes in a range [4KB; 3840MB].
+    uint64_t dictionarySize;
+    
+    /// `LZMA2` block size in bytes, at least 4KB. The `UINT64_MAX` means a single solid block.
+    uint64_t blockSize;
+    
+    /// Number of fast bytes(word size) in a range [5; 273].
+    uint32_t wordSize;
+    
+    /// Number of cycles of the match finder in a range [1; 1073741824].
+    uint32_t matchFinderCycles;
+    
+    /// Match finder.
+    PLzmaSDKMatchFinder matchFinder;
+    
+    /// Number of literal context bits in a range [0; 8]. `LZMA2` allows up to 4 bits for the sum of literal context and position bits.
+    int8_t literalContextBits;
+    
+    /// Number of literal position bits in a range [0; 4].
+    int8_t literalPositionBits;
+    
+    /// Number of position bits in a range [0; 4].
+    int8_t positionBits;
+} PLzmaSDKMethodProperties;
+
+
 /// The enumeration with bitmask options for opening directory path.
 /// Currently uses for defining behavior of directory iteration.
 typedef NS_OPTIONS(uint8_t, PLzmaSDKOpenDirMode) {
@@ -53,6 +53,25 @@
 - (nonnull instancetype) initWithPath:(nonnull NSString *) path;
 
 
+/// Initializes the input file stream with path, which reads the file content via memory mapping.
+///
+/// The whole file is mapped to the address space during the opening, the reading doesn't require a system call
+/// and the intermediate buffering. If the file can't be mapped, the stream reads the file as a regular file stream.
+/// - Parameter path: The non-empty input file path.
+/// - Note: The file should not be truncated while the stream is opened.
+/// - Throws: `Exception` with `.invalidArguments` code in case if path is empty.
+- (nonnull instancetype) initWithMappedPath:(nonnull NSString *) path;
+
+
+/// Initializes the input file stream with path, which reads the file content via positional reads of the file descriptor.
+///
+/// The reading doesn't use the file position and the intermediate buffering. The clones of the stream, i.e. used
+/// by the decoder for extracting in parallel, share a single descriptor and read the file at the same time without locking.
+/// - Parameter path: The non-empty input file path.
+/// - Throws: `Exception` with `.invalidArguments` code in case if path is empty.
+- (nonnull instancetype) initWithPositionalPath:(nonnull NSString *) path;
+
+
 /// Initializes the input file stream with the file data.
 /// During the creation, the data will copyed.
 /// - Parameter dataCopy: The file data.
@@ -148,6 +148,26 @@ static bool PLzmaSDKInStreamDataNoCopyRead(void * LIBPLZMA_NULLABLE context,
     return self;
 }
 
+- (nonnull instancetype) initWithMappedPath:(nonnull NSString *) path {
+    self = [super init];
+    if (self) {
+        PLZMASDKOBJC_TRY
+        _inStream = plzma::makeSharedMappedInStream(plzma::Path(path.UTF8String));
+        PLZMASDKOBJC_CATCH_RETHROW
+    }
+    return self;
+}
+
+- (nonnull instancetype) initWithPositionalPath:(nonnull NSString *) path {
+    self = [super init];
+    if (self) {
+        PLZMASDKOBJC_TRY
+        _inStream = plzma::makeSharedPositionalInStream(plzma::Path(path.UTF8String));
+        PLZMASDKOBJC_CATCH_RETHROW
+    }
+    return self;
+}
+
 - (nonnull instancetype) initWithDataCopy:(nonnull NSData *) dataCopy {
     self = [super init];
     if (self) {
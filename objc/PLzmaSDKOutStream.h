@@ -61,6 +61,12 @@
 /// - Throws: `Exception`.
 - (nonnull instancetype) init;
 
+
+/// Initializes the output file stream object for writing to memory with preallocated memory.
+/// - Parameter expectedSize: The expected size in bytes of the stream's content. The memory grows if the content is larger.
+/// - Throws: `Exception`.
+- (nonnull instancetype) initWithExpectedSize:(const uint64_t) expectedSize;
+
 + (nonnull instancetype) new NS_UNAVAILABLE;
 
 @end
@@ -106,6 +106,16 @@
     return self;
 }
 
+- (nonnull instancetype) initWithExpectedSize:(const uint64_t) expectedSize {
+    self = [super init];
+    if (self) {
+        PLZMASDKOBJC_TRY
+        _outStream = plzma::makeSharedOutStream(expectedSize);
+        PLZMASDKOBJC_CATCH_RETHROW
+    }
+    return self;
+}
+
 - (void) dealloc {
     PLZMASDKOBJC_TRY
     _outStream.clear();
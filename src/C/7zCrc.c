@@ -88,6 +88,12 @@ static UInt32 Z7_FASTCALL Z7_CRC_UPDATE_T1_FUNC_NAME(UInt32 v, const void *data,
 #endif
 #endif
 
+#if defined(LIBPLZMA_CRC_CLMUL) && defined(MY_CPU_LE) && (Z7_CRC_NUM_TABLES_USE != 1)
+  #define Z7_CRC_CLMUL_USE
+  UInt32 Z7_FASTCALL CrcUpdateClmul(UInt32 v, const void *data, size_t size, const UInt32 *table);
+  static BoolInt g_Crc_Clmul;
+#endif
+
 #endif // Z7_CRC_HW_FORCE
 
 /* ---------- hardware CRC ---------- */
@@ -298,6 +304,10 @@ Z7_NO_INLINE
 #endif
 
 #ifdef MY_CPU_LE
+#ifdef Z7_CRC_CLMUL_USE
+  if (g_Crc_Clmul)
+    return CrcUpdateClmul(crc, data, size, g_CrcTable);
+#endif
     return FUNC_NAME_LE(crc, data, size, g_CrcTable);
 #elif defined(MY_CPU_BE)
     return FUNC_NAME_BE(crc, data, size, g_CrcTable);
@@ -331,6 +341,16 @@ UInt32 Z7_FASTCALL CrcCalc(const void *data, size_t size)
 }
 
 
+BoolInt Crc_IsOptimized(void)
+{
+#ifdef Z7_CRC_CLMUL_USE
+  return g_Crc_Clmul;
+#else
+  return False;
+#endif
+}
+
+
 MY_ALIGN(64)
 UInt32 g_CrcTable[256 * Z7_CRC_NUM_TABLES_TOTAL];
 
@@ -402,6 +422,10 @@ void Z7_FASTCALL CrcGenerateTable(void)
 
 #endif // Z7_CRC_NUM_TABLES_USE <= 1
 #endif // g_Crc_Algo was declared
+
+#ifdef Z7_CRC_CLMUL_USE
+  g_Crc_Clmul = CPU_IsSupported_PCLMUL();
+#endif
 }
 
 Z7_CRC_UPDATE_FUNC z7_GetFunc_CrcUpdate(unsigned algo)
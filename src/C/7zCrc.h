@@ -23,6 +23,11 @@ UInt32 Z7_FASTCALL CrcCalc(const void *data, size_t size);
 typedef UInt32 (Z7_FASTCALL *Z7_CRC_UPDATE_FUNC)(UInt32 v, const void *data, size_t size);
 Z7_CRC_UPDATE_FUNC z7_GetFunc_CrcUpdate(unsigned algo);
 
+/* Crc_IsOptimized
+  Returns True, if CrcGenerateTable() selected the carry-less multiplication (PCLMULQDQ) version of CrcUpdate().
+*/
+BoolInt Crc_IsOptimized(void);
+
 EXTERN_C_END
 
 #endif
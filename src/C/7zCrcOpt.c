@@ -108,6 +108,70 @@ CRC_FUNC_PRE_LE(Z7_CRC_NUM_TABLES_USE)
 #endif
 
 
+#if defined(LIBPLZMA_CRC_CLMUL) && defined(MY_CPU_LE)
+
+/* CrcUpdateClmul -- CRC32 via the carry-less multiplication (PCLMULQDQ).
+   The data is folded by 4 * 128 bits and then by 128 bits to one 128-bit remainder.
+   The remainder and the tail bytes are finished with the tables.
+   CrcGenerateTable() selects this function at runtime, if the CPU supports PCLMULQDQ. */
+
+#include <wmmintrin.h>
+
+#if defined(__clang__) || defined(__GNUC__)
+  #define ATTRIB_CLMUL __attribute__((__target__("pclmul")))
+#else
+  #define ATTRIB_CLMUL
+#endif
+
+#define CRC_FUNC_NAME_LE2(step)  CrcUpdateT ## step
+#define CRC_FUNC_NAME_LE(step)   CRC_FUNC_NAME_LE2(step)
+
+#define LOAD_128(i)  _mm_loadu_si128((const __m128i *)(const void *)p + (i))
+#define FOLD_128(x, k) \
+    _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11))
+
+UInt32 Z7_FASTCALL CrcUpdateClmul(UInt32 v, const void *data, size_t size, const UInt32 *table);
+ATTRIB_CLMUL
+UInt32 Z7_FASTCALL CrcUpdateClmul(UInt32 v, const void *data, size_t size, const UInt32 *table)
+{
+  const Byte *p = (const Byte *)data;
+  if (size >= 64)
+  {
+    // bit-reflected (x^(N+32) mod P) << 1 and (x^(N-32) mod P) << 1, N = 512 and N = 128
+    const __m128i k4 = _mm_set_epi64x((Int64)0x1c6e41596, (Int64)0x154442bd4);
+    const __m128i k1 = _mm_set_epi64x((Int64)0x0ccaa009e, (Int64)0x1751997d0);
+    MY_ALIGN(16) Byte rem[16];
+    __m128i x0 = _mm_xor_si128(LOAD_128(0), _mm_cvtsi32_si128((int)v));
+    __m128i x1 = LOAD_128(1);
+    __m128i x2 = LOAD_128(2);
+    __m128i x3 = LOAD_128(3);
+    for (p += 64, size -= 64; size >= 64; p += 64, size -= 64)
+    {
+      x0 = _mm_xor_si128(FOLD_128(x0, k4), LOAD_128(0));
+      x1 = _mm_xor_si128(FOLD_128(x1, k4), LOAD_128(1));
+      x2 = _mm_xor_si128(FOLD_128(x2, k4), LOAD_128(2));
+      x3 = _mm_xor_si128(FOLD_128(x3, k4), LOAD_128(3));
+    }
+    x0 = _mm_xor_si128(FOLD_128(x0, k1), x1);
+    x0 = _mm_xor_si128(FOLD_128(x0, k1), x2);
+    x0 = _mm_xor_si128(FOLD_128(x0, k1), x3);
+    for (; size >= 16; p += 16, size -= 16)
+      x0 = _mm_xor_si128(FOLD_128(x0, k1), LOAD_128(0));
+    _mm_store_si128((__m128i *)(void *)rem, x0);
+    v = CRC_FUNC_NAME_LE(Z7_CRC_NUM_TABLES_USE)(0, rem, 16, table);
+  }
+  return CRC_FUNC_NAME_LE(Z7_CRC_NUM_TABLES_USE)(v, p, size, table);
+}
+
+#undef LOAD_128
+#undef FOLD_128
+#undef CRC_FUNC_NAME_LE
+#undef CRC_FUNC_NAME_LE2
+#undef ATTRIB_CLMUL
+
+#endif // LIBPLZMA_CRC_CLMUL
+
+
 
 
 #ifndef MY_CPU_LE
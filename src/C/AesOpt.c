@@ -19,9 +19,9 @@ Igor Pavlov : Public domain */
 #  if defined(__ARM_ARCH)
 #    undef __ARM_ARCH
 #  endif // __ARM_ARCH
-#  if defined(MY_CPU_X86_OR_AMD64)
+#  if defined(MY_CPU_X86_OR_AMD64) && !defined(LIBPLZMA_CPU_DISPATCH_X86)
 #    undef MY_CPU_X86_OR_AMD64
-#  endif // MY_CPU_X86_OR_AMD64
+#  endif // MY_CPU_X86_OR_AMD64 && !LIBPLZMA_CPU_DISPATCH_X86
 #  if defined(MY_CPU_ARM_OR_ARM64)
 #    undef MY_CPU_ARM_OR_ARM64
 #  endif // MY_CPU_ARM_OR_ARM64
@@ -461,6 +461,11 @@ BoolInt CPU_IsSupported_AES(void)
   return (BoolInt)(x86cpuid_Func_1_ECX() >> 25) & 1;
 }
 
+BoolInt CPU_IsSupported_PCLMUL(void)
+{
+  return (BoolInt)(x86cpuid_Func_1_ECX() >> 1) & 1;
+}
+
 BoolInt CPU_IsSupported_SSSE3(void)
 {
   return (BoolInt)(x86cpuid_Func_1_ECX() >> 9) & 1;
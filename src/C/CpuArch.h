@@ -662,6 +662,7 @@ UInt32 Z7_FASTCALL z7_x86_cpuid_GetMaxFunc(void);
 #endif
 
 BoolInt CPU_IsSupported_AES(void);
+BoolInt CPU_IsSupported_PCLMUL(void);
 BoolInt CPU_IsSupported_AVX(void);
 BoolInt CPU_IsSupported_AVX2(void);
 BoolInt CPU_IsSupported_AVX512F_AVX512VL(void);
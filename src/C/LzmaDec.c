@@ -16,8 +16,6 @@
 
 #define RC_INIT_SIZE 5
 
-#ifndef Z7_LZMA_DEC_OPT
-
 #define kNumMoveBits 5
 #define NORMALIZE if (range < kTopValue) { range <<= 8; code = (code << 8) | (*buf++); }
 
@@ -64,8 +62,6 @@
   probLit = prob + (offs + bit + symbol); \
   GET_BIT2(probLit, symbol, offs ^= bit; , ;)
 
-#endif // Z7_LZMA_DEC_OPT
-
 
 #define NORMALIZE_CHECK if (range < kTopValue) { if (buf >= bufLimit) return DUMMY_INPUT_EOF; range <<= 8; code = (code << 8) | (*buf++); }
 
@@ -228,10 +224,40 @@ Out:
 
 int Z7_FASTCALL LZMA_DECODE_REAL(CLzmaDec *p, SizeT limit, const Byte *bufLimit);
 
+/*
+The portable C version is always compiled and can be selected at runtime
+with LzmaDec_SetOptimized(False), e.g. for comparison or as a fallback.
+*/
+#define LZMA_DECODE_PORTABLE LzmaDec_DecodeReal_Portable
+
+static BoolInt g_LzmaDec_Optimized = True;
+
 #else
 
+#define LZMA_DECODE_PORTABLE LZMA_DECODE_REAL
+
+#endif
+
+BoolInt LzmaDec_IsOptimized(void)
+{
+  #ifdef Z7_LZMA_DEC_OPT
+  return g_LzmaDec_Optimized;
+  #else
+  return False;
+  #endif
+}
+
+void LzmaDec_SetOptimized(BoolInt optimized)
+{
+  #ifdef Z7_LZMA_DEC_OPT
+  g_LzmaDec_Optimized = optimized;
+  #else
+  UNUSED_VAR(optimized)
+  #endif
+}
+
 static
-int Z7_FASTCALL LZMA_DECODE_REAL(CLzmaDec *p, SizeT limit, const Byte *bufLimit)
+int Z7_FASTCALL LZMA_DECODE_PORTABLE(CLzmaDec *p, SizeT limit, const Byte *bufLimit)
 {
   CLzmaProb *probs = GET_PROBS;
   unsigned state = (unsigned)p->state;
@@ -609,7 +635,6 @@ int Z7_FASTCALL LZMA_DECODE_REAL(CLzmaDec *p, SizeT limit, const Byte *bufLimit)
     return SZ_ERROR_DATA;
   return SZ_OK;
 }
-#endif
 
 
 
@@ -692,7 +717,13 @@ static int Z7_FASTCALL LzmaDec_DecodeReal2(CLzmaDec *p, SizeT limit, const Byte
       limit = p->dicPos + rem;
   }
   {
+    #ifdef Z7_LZMA_DEC_OPT
+    int res = g_LzmaDec_Optimized ?
+        LZMA_DECODE_REAL(p, limit, bufLimit) :
+        LZMA_DECODE_PORTABLE(p, limit, bufLimit);
+    #else
     int res = LZMA_DECODE_REAL(p, limit, bufLimit);
+    #endif
     if (p->checkDicSize == 0 && p->processedPos >= p->prop.dicSize)
       p->checkDicSize = p->prop.dicSize;
     return res;
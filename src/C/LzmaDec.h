@@ -232,6 +232,20 @@ SRes LzmaDecode(Byte *dest, SizeT *destLen, const Byte *src, SizeT *srcLen,
     const Byte *propData, unsigned propSize, ELzmaFinishMode finishMode,
     ELzmaStatus *status, ISzAllocPtr alloc);
 
+/* ---------- Decoder Kernel ---------- */
+
+/* LzmaDec_IsOptimized / LzmaDec_SetOptimized
+
+  The main decoding loop can be provided by the external ASM file (Z7_LZMA_DEC_OPT).
+  In that case the portable C version is also compiled and can be selected at runtime.
+  LzmaDec_IsOptimized() returns True only if the ASM version exists and is selected.
+  LzmaDec_SetOptimized() does nothing without the ASM version.
+  The selection is global and must not be changed while decoding.
+*/
+
+BoolInt LzmaDec_IsOptimized(void);
+void LzmaDec_SetOptimized(BoolInt optimized);
+
 EXTERN_C_END
 
 #endif
@@ -56,6 +56,12 @@
 MY_ALIGN(64)
 static UInt64 g_Crc64Table[256 * Z7_CRC64_NUM_TABLES_USE];
 
+#if defined(LIBPLZMA_CRC_CLMUL) && defined(MY_CPU_LE) && (Z7_CRC64_NUM_TABLES_USE != 1)
+  #define Z7_CRC64_CLMUL_USE
+  UInt64 Z7_FASTCALL XzCrc64UpdateClmul(UInt64 v, const void *data, size_t size, const UInt64 *table);
+  static BoolInt g_Crc64_Clmul;
+#endif
+
 
 UInt64 Z7_FASTCALL Crc64Update(UInt64 v, const void *data, size_t size)
 {
@@ -69,11 +75,25 @@ UInt64 Z7_FASTCALL Crc64Update(UInt64 v, const void *data, size_t size)
   return v;
   #undef CRC64_UPDATE_BYTE_2
 #else
+#ifdef Z7_CRC64_CLMUL_USE
+  if (g_Crc64_Clmul)
+    return XzCrc64UpdateClmul(v, data, size, g_Crc64Table);
+#endif
   return FUNC_REF (v, data, size, g_Crc64Table);
 #endif
 }
 
 
+BoolInt Crc64_IsOptimized(void)
+{
+#ifdef Z7_CRC64_CLMUL_USE
+  return g_Crc64_Clmul;
+#else
+  return False;
+#endif
+}
+
+
 Z7_NO_INLINE
 void Z7_FASTCALL Crc64GenerateTable(void)
 {
@@ -127,6 +147,10 @@ void Z7_FASTCALL Crc64GenerateTable(void)
   }
 #endif // ndef MY_CPU_LE
 #endif // Z7_CRC64_NUM_TABLES_USE != 1
+
+#ifdef Z7_CRC64_CLMUL_USE
+  g_Crc64_Clmul = CPU_IsSupported_PCLMUL();
+#endif
 }
 
 #undef kCrc64Poly
@@ -21,6 +21,11 @@ void Z7_FASTCALL Crc64GenerateTable(void);
 UInt64 Z7_FASTCALL Crc64Update(UInt64 crc, const void *data, size_t size);
 // UInt64 Z7_FASTCALL Crc64Calc(const void *data, size_t size);
 
+/* Crc64_IsOptimized
+  Returns True, if Crc64GenerateTable() selected the carry-less multiplication (PCLMULQDQ) version of Crc64Update().
+*/
+BoolInt Crc64_IsOptimized(void);
+
 EXTERN_C_END
 
 #endif
@@ -228,6 +228,13 @@ Z7_COM7F_IMF(CFolderOutStream::GetSubStreamSize(UInt64 subStream, UInt64 *value)
 
 Z7_COM7F_IMF(CHandler::Extract(const UInt32 *indices, UInt32 numItems,
     Int32 testModeSpec, IArchiveExtractCallback *extractCallbackSpec))
+{
+  return ExtractStream(_inStream, indices, numItems, testModeSpec, extractCallbackSpec);
+}
+
+
+Z7_COM7F_IMF(CHandler::ExtractStream(IInStream *inStream, const UInt32 *indices, UInt32 numItems,
+    Int32 testModeSpec, IArchiveExtractCallback *extractCallbackSpec))
 {
   // for GCC
   // CFolderOutStream *folderOutStream = new CFolderOutStream;
@@ -378,7 +385,7 @@ Z7_COM7F_IMF(CHandler::Extract(const UInt32 *indices, UInt32 numItems,
 
       const HRESULT result = decoder.Decode(
           EXTERNAL_CODECS_VARS
-          _inStream,
+          inStream,
           _db.ArcInfo.DataStartPosition,
           _db, folderIndex,
           &curUnpacked,
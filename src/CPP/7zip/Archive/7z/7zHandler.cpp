@@ -607,6 +607,14 @@ Z7_COM7F_IMF(CHandler::GetProperty(UInt32 index, PROPID propID, PROPVARIANT *val
       }
       break;
     }
+    case kpidOffset:
+    {
+      // the position of the packed folder, reported by the first file of the folder like kpidPackSize
+      const CNum folderIndex = _db.FileIndexToFolderIndexMap[index2];
+      if (folderIndex != kNumNoIndex && _db.FolderStartFileIndex[folderIndex] == (CNum)index2)
+        PropVarEm_Set_UInt64(value, _db.GetFolderStreamPos(folderIndex, 0));
+      break;
+    }
     // case kpidIsAux: prop = _db.IsItemAux(index2); break;
     case kpidPosition:  { UInt64 v; if (_db.StartPos.GetItem(index2, v)) PropVarEm_Set_UInt64(value, v); break; }
     case kpidCTime:  SetFileTimeProp_From_UInt64Def(value, _db.CTime, index2); break;
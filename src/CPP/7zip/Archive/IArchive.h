@@ -381,6 +381,17 @@ Z7_IFACE_CONSTR_ARCHIVE(IArchiveGetRootProps, 0x71)
 
 Z7_IFACE_CONSTR_ARCHIVE(IArchiveOpenSeq, 0x61)
 
+/*
+  IInArchiveExtractStream::ExtractStream()
+    extracts the items of the opened archive, the content is read from the provided stream
+    instead of the opened one, i.e. from the independent clone of the opened stream.
+    The opened database is not modified, so the calls with own streams can run at the same time.
+*/
+#define Z7_IFACEM_IInArchiveExtractStream(x) \
+  x(ExtractStream(IInStream *stream, const UInt32 *indices, UInt32 numItems, Int32 testMode, IArchiveExtractCallback *extractCallback)) \
+
+Z7_IFACE_CONSTR_ARCHIVE(IInArchiveExtractStream, 0x63)
+
 /*
   OpenForSize
   Result:
@@ -720,17 +720,34 @@ Z7_COM7F_IMF(CHandler::GetProperty(UInt32 index, PROPID propID, PROPVARIANT *val
 
 Z7_COM7F_IMF(CHandler::Extract(const UInt32 *indices, UInt32 numItems,
     Int32 testMode, IArchiveExtractCallback *extractCallback))
+{
+  return Extract2(_stream, indices, numItems, testMode, extractCallback);
+}
+
+
+Z7_COM7F_IMF(CHandler::ExtractStream(IInStream *stream, const UInt32 *indices, UInt32 numItems,
+    Int32 testMode, IArchiveExtractCallback *extractCallback))
+{
+  // the sequential archive can be read only once
+  if (!stream || !_stream)
+    return E_NOTIMPL;
+  return Extract2(stream, indices, numItems, testMode, extractCallback);
+}
+
+
+HRESULT CHandler::Extract2(IInStream *seekStream, const UInt32 *indices, UInt32 numItems,
+    Int32 testMode, IArchiveExtractCallback *extractCallback)
 {
   COM_TRY_BEGIN
   ISequentialInStream *stream = _seqStream;
-  const bool seqMode = (_stream == NULL);
+  const bool seqMode = (seekStream == NULL);
   if (!seqMode)
-    stream = _stream;
+    stream = seekStream;
 
   const bool allFilesMode = (numItems == (UInt32)(Int32)-1);
   if (allFilesMode)
     numItems = _items.Size();
-  if (_stream && numItems == 0)
+  if (seekStream && numItems == 0)
     return S_OK;
   UInt64 totalSize = 0;
   UInt32 i;
@@ -746,6 +763,10 @@ Z7_COM7F_IMF(CHandler::Extract(const UInt32 *indices, UInt32 numItems,
   CMyComPtr2_Create<ISequentialInStream, CLimitedSequentialInStream> inStream;
   inStream->SetStream(stream);
   CMyComPtr2_Create<ISequentialOutStream, CLimitedSequentialOutStream> outStreamSpec;
+  // the copy coder of the handler is not shared with the calls reading own streams
+  CMyComPtr<ICompressCoder> coder = copyCoder.Interface();
+  if (seekStream != _stream)
+    coder = new NCompress::CCopyCoder;
 
   for (i = 0; ; i++)
   {
@@ -814,7 +835,8 @@ Z7_COM7F_IMF(CHandler::Extract(const UInt32 *indices, UInt32 numItems,
       inStream2 = inStream;
     else
     {
-      GetStream(index, &inStream2);
+      // the stream is released before the return, the handler is not referenced outside of the owner's lock
+      GetStream2(seekStream, index, &inStream2, false);
       if (!inStream2)
         return E_FAIL;
     }
@@ -828,10 +850,10 @@ Z7_COM7F_IMF(CHandler::Extract(const UInt32 *indices, UInt32 numItems,
       {
         if (!seqMode)
         {
-          RINOK(InStream_SeekSet(_stream, item->Get_DataPos()))
+          RINOK(InStream_SeekSet(seekStream, item->Get_DataPos()))
         }
         inStream->Init(item->Get_PackSize_Aligned());
-        RINOK(copyCoder.Interface()->Code(inStream2, outStreamSpec, NULL, NULL, lps))
+        RINOK(coder->Code(inStream2, outStreamSpec, NULL, NULL, lps))
       }
       if (outStreamSpec->GetRem() != 0)
         opRes = NExtract::NOperationResult::kDataError;
@@ -859,6 +881,7 @@ Z7_CLASS_IMP_IInStream(
 public:
   CHandler *Handler;
   CMyComPtr<IUnknown> HandlerRef;
+  CMyComPtr<IInStream> Stream;
   unsigned ItemIndex;
   CRecordVector<UInt64> PhyOffsets;
 
@@ -915,11 +938,11 @@ Z7_COM7F_IMF(CSparseStream::Read(void *data, UInt32 size, UInt32 *processedSize)
       UInt64 phyPos = PhyOffsets[left] + relat;
       if (_needStartSeek || _phyPos != phyPos)
       {
-        RINOK(InStream_SeekSet(Handler->_stream, (item.Get_DataPos() + phyPos)))
+        RINOK(InStream_SeekSet(Stream, (item.Get_DataPos() + phyPos)))
         _needStartSeek = false;
         _phyPos = phyPos;
       }
-      res = Handler->_stream->Read(data, size, &size);
+      res = Stream->Read(data, size, &size);
       _phyPos += size;
     }
     else
@@ -960,6 +983,12 @@ Z7_COM7F_IMF(CSparseStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 *newPos
 }
 
 Z7_COM7F_IMF(CHandler::GetStream(UInt32 index, ISequentialInStream **stream))
+{
+  return GetStream2(_stream, index, stream, true);
+}
+
+
+HRESULT CHandler::GetStream2(IInStream *seekStream, UInt32 index, ISequentialInStream **stream, bool handlerRef)
 {
   COM_TRY_BEGIN
   
@@ -971,7 +1000,10 @@ Z7_COM7F_IMF(CHandler::GetStream(UInt32 index, ISequentialInStream **stream))
     CMyComPtr<IInStream> streamTemp = streamSpec;
     streamSpec->Init();
     streamSpec->Handler = this;
-    streamSpec->HandlerRef = (IInArchive *)this;
+    // the reference counter is not atomic, the stream of the extraction is used only while the handler is busy
+    if (handlerRef)
+      streamSpec->HandlerRef = (IInArchive *)this;
+    streamSpec->Stream = seekStream;
     streamSpec->ItemIndex = index;
     streamSpec->PhyOffsets.Reserve(item.SparseBlocks.Size());
     UInt64 offs = 0;
@@ -991,7 +1023,7 @@ Z7_COM7F_IMF(CHandler::GetStream(UInt32 index, ISequentialInStream **stream))
     return S_OK;
   }
   
-  return CreateLimitedInStream(_stream, item.Get_DataPos(), item.PackSize, stream);
+  return CreateLimitedInStream(seekStream, item.Get_DataPos(), item.PackSize, stream);
   
   COM_TRY_END
 }
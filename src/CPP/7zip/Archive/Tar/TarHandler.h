@@ -14,8 +14,9 @@
 namespace NArchive {
 namespace NTar {
 
-Z7_CLASS_IMP_CHandler_IInArchive_4(
+Z7_CLASS_IMP_CHandler_IInArchive_5(
     IArchiveOpenSeq
+  , IInArchiveExtractStream
   , IInArchiveGetStream
   , ISetProperties
   , IOutArchive
@@ -46,6 +47,9 @@ private:
 
   HRESULT Open2(IInStream *stream, IArchiveOpenCallback *callback);
   HRESULT SkipTo(UInt32 index);
+  HRESULT Extract2(IInStream *seekStream, const UInt32 *indices, UInt32 numItems,
+      Int32 testMode, IArchiveExtractCallback *extractCallback);
+  HRESULT GetStream2(IInStream *seekStream, UInt32 index, ISequentialInStream **stream, bool handlerRef);
   void TarStringToUnicode(const AString &s, NWindows::NCOM::CPropVariant &prop, bool toOs = false) const;
 public:
   void Init();
@@ -199,6 +199,8 @@ char * LIBPLZMA_NULLABLE plzma_cstring_append(char * LIBPLZMA_NULLABLE source, c
 #include "C/7zCrc.h"
 #include "C/Aes.h"
 #include "C/XzCrc64.h"
+#include "C/LzmaDec.h"
+#include "C/Sha256.h"
 
 #if __has_include(<TargetConditionals.h>)
 #  include <TargetConditionals.h>
@@ -242,6 +244,10 @@ const char * LIBPLZMA_NONNULL plzma_version(void) {
     " : std"
 #endif
 
+#if defined(LIBPLZMA_MULTITHREAD)
+    " : multithread"
+#endif
+
 #if defined(RTTI_ENABLED)
     " : rtti"
 #elif defined(LIBPLZMA_NO_CPP_RTTI)
@@ -514,6 +520,8 @@ plzma_size_t kStreamWriteSize = static_cast<unsigned int>(1) << 20;
 plzma_size_t kDecoderReadSize = static_cast<unsigned int>(1) << 20;
 plzma_size_t kDecoderWriteSize = static_cast<unsigned int>(1) << 22;
 #endif // LIBPLZMA_PLATFORM_MOBILE
+double kProgressMinInterval = 0.0;
+double kProgressMinDelta = 0.0;
 
     void initialize(void) noexcept {
         static bool notInitalized = true;
@@ -557,6 +565,9 @@ plzma_size_t kDecoderWriteSize = static_cast<unsigned int>(1) << 22;
             CrcGenerateTable();
             AesGenTables();
             Crc64GenerateTable();
+#if defined(LIBPLZMA_CPU_DISPATCH_X86)
+            Sha256Prepare();
+#endif
         }
     }
     
@@ -596,6 +607,55 @@ void plzma_set_decoder_write_size(const plzma_size_t size) {
     plzma::kDecoderWriteSize = size;
 }
 
+double plzma_progress_min_interval(void) {
+    return plzma::kProgressMinInterval;
+}
+
+void plzma_set_progress_min_interval(const double seconds) {
+    plzma::kProgressMinInterval = (seconds > 0.0) ? seconds : 0.0;
+}
+
+double plzma_progress_min_delta(void) {
+    return plzma::kProgressMinDelta;
+}
+
+void plzma_set_progress_min_delta(const double delta) {
+    plzma::kProgressMinDelta = (delta > 0.0) ? delta : 0.0;
+}
+
+bool plzma_lzma_decoder_optimized(void) {
+    return LzmaDec_IsOptimized() ? true : false;
+}
+
+void plzma_set_lzma_decoder_optimized(const bool optimized) {
+    LzmaDec_SetOptimized(optimized ? True : False);
+}
+
+plzma_kernel_t plzma_kernels(void) {
+    plzma::initialize();
+    plzma_kernel_t kernels = 0;
+    if (Crc_IsOptimized()) {
+        kernels |= plzma_kernel_crc32_clmul;
+    }
+    if (Crc64_IsOptimized()) {
+        kernels |= plzma_kernel_crc64_clmul;
+    }
+    CSha256 sha;
+    if (Sha256_SetFunction(&sha, SHA256_ALGO_HW)) {
+        kernels |= plzma_kernel_sha256_hw;
+    }
+    if (g_Aes_SupportedFunctions_Flags & k_Aes_SupportedFunctions_HW) {
+        kernels |= plzma_kernel_aes_hw;
+    }
+    if (g_Aes_SupportedFunctions_Flags & k_Aes_SupportedFunctions_HW_256) {
+        kernels |= plzma_kernel_aes_hw_256;
+    }
+    if (LzmaDec_IsOptimized()) {
+        kernels |= plzma_kernel_lzma_decoder_optimized;
+    }
+    return kernels;
+}
+
 #include "plzma_c_bindings_private.hpp"
 
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
@@ -68,6 +68,30 @@ namespace plzma {
         return S_OK;
     }
     
+    HRESULT BaseCallback::setRatioInfo(const UInt64 * inSize, const UInt64 * outSize) noexcept {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        const HRESULT result = _result;
+#else
+        const FailableLockGuard lock(_mutex);
+        RINOK(lock.res())
+        const HRESULT result = _result;
+#endif
+        // The sizes are the totals of this callback, the stats might be shared by a few callbacks, i.e. by the extracting workers.
+        uint64_t inDelta = 0, outDelta = 0;
+        if (inSize && *inSize > _ratioInSize) {
+            inDelta = *inSize - _ratioInSize;
+            _ratioInSize = *inSize;
+        }
+        if (outSize && *outSize > _ratioOutSize) {
+            outDelta = *outSize - _ratioOutSize;
+            _ratioOutSize = *outSize;
+        }
+        if (_stats) {
+            _stats->addSizes(inDelta, outDelta);
+        }
+        return result;
+    }
+    
 #if !defined(LIBPLZMA_NO_PROGRESS)
     HRESULT BaseCallback::setProgressTotal(const uint64_t total) noexcept {
         try {
@@ -34,6 +34,7 @@
 #include "plzma_private.hpp"
 #include "plzma_mutex.hpp"
 #include "plzma_progress.hpp"
+#include "plzma_stats.hpp"
 
 #include "CPP/Common/Common.h"
 #include "CPP/Common/MyWindows.h"
@@ -53,10 +54,14 @@ namespace plzma {
 #if !defined(LIBPLZMA_NO_CRYPTO)
         String _password;
 #endif
+        SharedPtr<Stats> _stats;
+        UInt64 _ratioInSize = 0;            // the last reported sizes of this callback
+        UInt64 _ratioOutSize = 0;
         Exception * _exception = nullptr;   // execution thread only
         HRESULT _result = S_OK;             // shared between threads
         
         HRESULT getTextPassword(Int32 * passwordIsDefined, BSTR * password) noexcept;
+        HRESULT setRatioInfo(const UInt64 * inSize, const UInt64 * outSize) noexcept;
 #if !defined(LIBPLZMA_NO_PROGRESS)
         HRESULT setProgressTotal(const uint64_t total) noexcept;
         HRESULT setProgressCompleted(const uint64_t completed) noexcept;
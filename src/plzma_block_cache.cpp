@@ -0,0 +1,250 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <cstddef>
+
+#include "plzma_block_cache.hpp"
+#include "plzma_common.hpp"
+#include "plzma_c_bindings_private.hpp"
+
+namespace plzma {
+    
+    void CachedBlock::retain() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RETAIN_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void CachedBlock::release() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RELEASE_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    bool CachedBlock::matches(const uint64_t otherKey, const Source & otherSource, const Vector<Item> & otherItems) const noexcept {
+        if (key != otherKey || items.count() != otherItems.count()) {
+            return false;
+        }
+        if (source.identity != otherSource.identity || source.packOffset != otherSource.packOffset || source.packSize != otherSource.packSize) {
+            return false;
+        }
+        for (plzma_size_t i = 0; i < items.count(); i++) {
+            const Item & item = items.at(i), & otherItem = otherItems.at(i);
+            if (item.size != otherItem.size || item.crc32 != otherItem.crc32) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    static uint64_t hashValues(uint64_t hash, const uint64_t * values, const size_t count) noexcept {
+        for (size_t v = 0; v < count; v++) {
+            for (size_t b = 0; b < 8; b++) {
+                hash = (hash ^ ((values[v] >> (b * 8)) & 0xFF)) * 0x100000001b3ULL;
+            }
+        }
+        return hash;
+    }
+    
+    uint64_t CachedBlock::makeKey(const Source & source, const Vector<Item> & items) noexcept {
+        const uint64_t sourceValues[3] = { source.identity, source.packOffset, source.packSize };
+        uint64_t hash = hashValues(0xcbf29ce484222325ULL, sourceValues, 3); // FNV-1a
+        for (plzma_size_t i = 0; i < items.count(); i++) {
+            const Item & item = items.at(i);
+            const uint64_t values[2] = { item.size, item.crc32 };
+            hash = hashValues(hash, values, 2);
+        }
+        return hash;
+    }
+    
+    CachedBlock::CachedBlock(const Source & blockSource, Vector<Item> && blockItems) :
+        source(blockSource),
+        items(static_cast<Vector<Item> &&>(blockItems)) {
+            for (plzma_size_t i = 0; i < items.count(); i++) {
+                Item & item = items.at(i);
+                item.offset = size;
+                size += item.size;
+            }
+            if (size > SIZE_MAX) {
+                throw Exception(plzma_error_code_not_enough_memory, "Can't allocate the decoded block.", __FILE__, __LINE__);
+            }
+            content.resize(static_cast<size_t>(size));
+            key = makeKey(source, items);
+    }
+    
+    void BlockCacheImpl::retain() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RETAIN_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void BlockCacheImpl::release() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RELEASE_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void BlockCacheImpl::removeAt(const plzma_size_t index) noexcept {
+        // The block might be still used by the extracting decoder, it's deallocated by the last reference.
+        _size -= _entries.at(index).block->size;
+        const plzma_size_t last = _entries.count() - 1;
+        if (index != last) {
+            _entries.at(index) = static_cast<Entry &&>(_entries.at(last));
+        }
+        _entries.pop();
+    }
+    
+    uint64_t BlockCacheImpl::capacity() const noexcept {
+        return _capacity;
+    }
+    
+    uint64_t BlockCacheImpl::size() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _size;
+    }
+    
+    plzma_size_t BlockCacheImpl::count() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _entries.count();
+    }
+    
+    uint64_t BlockCacheImpl::hits() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _hits;
+    }
+    
+    void BlockCacheImpl::clear() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _entries.clear();
+        _size = 0;
+    }
+    
+    SharedPtr<CachedBlock> BlockCacheImpl::find(const uint64_t key, const CachedBlock::Source & source, const Vector<CachedBlock::Item> & items) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        for (plzma_size_t i = 0; i < _entries.count(); i++) {
+            Entry & entry = _entries.at(i);
+            if (entry.block->matches(key, source, items)) {
+                entry.lastUse = ++_uses;
+                _hits++;
+                return entry.block;
+            }
+        }
+        return SharedPtr<CachedBlock>();
+    }
+    
+    void BlockCacheImpl::insert(const SharedPtr<CachedBlock> & block) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (block->size > _capacity) {
+            return;
+        }
+        for (plzma_size_t i = 0; i < _entries.count(); i++) {
+            if (_entries.at(i).block->matches(block->key, block->source, block->items)) {
+                return; // decoded by another decoder at the same time
+            }
+        }
+        while (_entries.count() > 0 && (_capacity - _size) < block->size) {
+            plzma_size_t leastRecent = 0;
+            for (plzma_size_t i = 1; i < _entries.count(); i++) {
+                if (_entries.at(i).lastUse < _entries.at(leastRecent).lastUse) {
+                    leastRecent = i;
+                }
+            }
+            removeAt(leastRecent);
+        }
+        Entry entry;
+        entry.block = block;
+        entry.lastUse = ++_uses;
+        _entries.push(static_cast<Entry &&>(entry));
+        _size += block->size;
+    }
+    
+    BlockCacheImpl::BlockCacheImpl(const uint64_t capacity) : BlockCache(),
+        _capacity(capacity) {
+        
+    }
+    
+    SharedPtr<BlockCache> makeSharedBlockCache(const uint64_t capacity) {
+        return SharedPtr<BlockCache>(new BlockCacheImpl(capacity));
+    }
+    
+} // namespace plzma
+
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+
+using namespace plzma;
+
+plzma_block_cache plzma_block_cache_create(const uint64_t capacity) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_TRY(plzma_block_cache)
+    auto cache = makeSharedBlockCache(capacity);
+    createdCObject.object = static_cast<void *>(cache.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+uint64_t plzma_block_cache_capacity(const plzma_block_cache * LIBPLZMA_NONNULL cache) {
+    return cache->exception ? 0 : static_cast<const BlockCache *>(cache->object)->capacity();
+}
+
+uint64_t plzma_block_cache_size(plzma_block_cache * LIBPLZMA_NONNULL cache) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(cache, 0)
+    return static_cast<const BlockCache *>(cache->object)->size();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(cache, 0)
+}
+
+plzma_size_t plzma_block_cache_count(plzma_block_cache * LIBPLZMA_NONNULL cache) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(cache, 0)
+    return static_cast<const BlockCache *>(cache->object)->count();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(cache, 0)
+}
+
+uint64_t plzma_block_cache_hits(plzma_block_cache * LIBPLZMA_NONNULL cache) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(cache, 0)
+    return static_cast<const BlockCache *>(cache->object)->hits();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(cache, 0)
+}
+
+void plzma_block_cache_clear(plzma_block_cache * LIBPLZMA_NONNULL cache) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(cache)
+    static_cast<BlockCache *>(cache->object)->clear();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(cache)
+}
+
+void plzma_block_cache_release(plzma_block_cache * LIBPLZMA_NONNULL cache) {
+    plzma_object_exception_release(cache);
+    SharedPtr<BlockCache> cachePtr;
+    cachePtr.assign(static_cast<BlockCache *>(cache->object));
+    cache->object = nullptr;
+}
+
+#endif // !LIBPLZMA_NO_C_BINDINGS
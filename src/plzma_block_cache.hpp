@@ -0,0 +1,126 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef __PLZMA_BLOCK_CACHE_HPP__
+#define __PLZMA_BLOCK_CACHE_HPP__ 1
+
+#include <cstddef>
+
+#include "../libplzma.hpp"
+#include "plzma_private.hpp"
+#include "plzma_mutex.hpp"
+
+namespace plzma {
+    
+    /// @brief The decoded content of the archive block, i.e. the 7z folder, the content of the block's items one by one.
+    class CachedBlock final {
+    private:
+        friend struct SharedPtr<CachedBlock>;
+        LIBPLZMA_MUTEX(_mutex)
+        plzma_size_t _referenceCounter = 0;
+        
+        void retain();
+        void release();
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(CachedBlock)
+        
+    public:
+        /// @brief The packed block in the archive stream, the blocks of the different archives never match.
+        struct Source final {
+            uint64_t identity = 0; // the identity of the input stream, see InStreamBase::identity()
+            uint64_t packOffset = 0;
+            uint64_t packSize = 0;
+        };
+        
+        /// @brief The item of the block, the blocks of the different decoders are compared by the sizes and CRCs of the items.
+        struct Item final {
+            uint64_t size = 0;
+            uint64_t offset = 0; // the offset of the item's content in the block
+            uint32_t crc32 = 0;
+        };
+        
+        Source source;
+        Vector<Item> items;
+        RawHeapMemory content;
+        uint64_t key = 0;
+        uint64_t size = 0;
+        
+        /// @brief Checks the block has the same source and items.
+        bool matches(const uint64_t key, const Source & source, const Vector<Item> & items) const noexcept;
+        
+        /// @return The hash of the source and the sizes and CRCs of the items.
+        static uint64_t makeKey(const Source & source, const Vector<Item> & items) noexcept;
+        
+        /// @brief Calculates the offsets of the items and allocates the content.
+        CachedBlock(const Source & source, Vector<Item> && items);
+    };
+    
+    class BlockCacheImpl final : public BlockCache {
+    private:
+        friend struct SharedPtr<BlockCacheImpl>;
+        struct Entry final {
+            SharedPtr<CachedBlock> block;
+            uint64_t lastUse = 0;
+        };
+        
+        LIBPLZMA_MUTEX(mutable _mutex)
+        Vector<Entry> _entries;
+        uint64_t _capacity = 0;
+        uint64_t _size = 0;
+        uint64_t _uses = 0;
+        uint64_t _hits = 0;
+        plzma_size_t _referenceCounter = 0;
+        
+        virtual void retain() override final;
+        virtual void release() override final;
+        
+        void removeAt(const plzma_size_t index) noexcept;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(BlockCacheImpl)
+        
+    public:
+        virtual uint64_t capacity() const noexcept override final;
+        virtual uint64_t size() const override final;
+        virtual plzma_size_t count() const override final;
+        virtual uint64_t hits() const override final;
+        virtual void clear() override final;
+        
+        /// @brief Finds the block with the same source and items and marks it as the most recently used.
+        SharedPtr<CachedBlock> find(const uint64_t key, const CachedBlock::Source & source, const Vector<CachedBlock::Item> & items);
+        
+        /// @brief Inserts the decoded block, the least recently used blocks are removed to fit the capacity.
+        void insert(const SharedPtr<CachedBlock> & block);
+        
+        BlockCacheImpl(const uint64_t capacity);
+        virtual ~BlockCacheImpl() noexcept = default;
+    };
+    
+} // namespace plzma
+
+#endif // !__PLZMA_BLOCK_CACHE_HPP__
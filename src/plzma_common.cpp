@@ -31,6 +31,12 @@
 
 #include <stdlib.h>
 
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
 namespace plzma {
     
     uint64_t PROPVARIANTGetUInt64(const PROPVARIANT & prop) noexcept {
@@ -76,4 +82,16 @@ namespace plzma {
         FT.dwHighDateTime = static_cast<DWORD>(ll >> 32);
         return FT;
     }
+    
+    double MonotonicTime() noexcept {
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+        return static_cast<double>(GetTickCount64()) / 1000.0;
+#else
+        struct timespec ts;
+        if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+            return static_cast<double>(ts.tv_sec) + (static_cast<double>(ts.tv_nsec) / 1000000000.0);
+        }
+        return static_cast<double>(time(nullptr));
+#endif
+    }
 }
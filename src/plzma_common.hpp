@@ -49,6 +49,14 @@ namespace plzma {
 
     LIBPLZMA_CPP_API_PRIVATE(FILETIME) UnixTimeToFILETIME(const time_t t) noexcept;
     
+    /// @return The time in seconds of the monotonic clock, i.e. only for measuring the intervals.
+    LIBPLZMA_CPP_API_PRIVATE(double) MonotonicTime() noexcept;
+    
+    /// @brief Converts the wide characters to the null-terminated UTF-8 string without the intermediate allocations.
+    /// @param dst The buffer of at least 4 bytes per wide character plus the null-terminator.
+    /// @return The length of the UTF-8 string.
+    LIBPLZMA_CPP_API_PRIVATE(size_t) WideToUTF8(const wchar_t * src, const size_t length, char * dst, const size_t dstSize);
+    
 } // namespace plzma
 
 #endif // !__PLZMA_COMMON_HPP__
@@ -29,6 +29,10 @@
 
 #include "plzma_decoder_impl.hpp"
 
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+#include "CPP/Windows/System.h"
+#endif
+
 namespace plzma {
     
     void DecoderImpl::retain() {
@@ -73,6 +77,455 @@ namespace plzma {
 #endif
     }
     
+    void DecoderImpl::applySettings(IInArchive * archive, const plzma_file_type type, const uint32_t numberOfThreads) {
+        if (type != plzma_file_type_7z && type != plzma_file_type_xz) {
+            return; // tar
+        }
+        
+        using namespace NWindows::NCOM;
+        
+        ISetProperties * setPropertiesRaw = nullptr;
+        const HRESULT res = archive->QueryInterface(IID_ISetProperties, reinterpret_cast<void**>(&setPropertiesRaw));
+        CMyComPtr<ISetProperties> setProperties;
+        setProperties.Attach(setPropertiesRaw);
+        if (res != S_OK || !setPropertiesRaw) {
+            throw Exception(plzma_error_code_internal, "Can't initialize archive properties.", __FILE__, __LINE__);
+        }
+        
+        static const UInt32 settingsCount = 1;
+        static const wchar_t * names[settingsCount] = {
+            L"mt"   // number of threads
+        };
+        
+        CPropVariant values[settingsCount] = {
+            (numberOfThreads > 0) ? CPropVariant(static_cast<UInt32>(numberOfThreads)) : CPropVariant(true) // number of threads, 'true' - hardware threads
+        };
+        
+        if (setProperties->SetProperties(names, values, settingsCount) != S_OK) {
+            throw Exception(plzma_error_code_internal, "Can't apply archive properties.", __FILE__, __LINE__);
+        }
+    }
+    
+    CMyComPtr<ExtractCallback> DecoderImpl::createExtractCallback() {
+        _stats->start();
+#if defined(LIBPLZMA_NO_PROGRESS)
+#  if defined(LIBPLZMA_NO_CRYPTO)
+        return CMyComPtr<ExtractCallback>(new ExtractCallback(_openCallback->archive(), _stats, _type));
+#  else
+        return CMyComPtr<ExtractCallback>(new ExtractCallback(_openCallback->archive(), _password, _stats, _type));
+#  endif
+#else
+        _progress->reset();
+#  if defined(LIBPLZMA_NO_CRYPTO)
+        return CMyComPtr<ExtractCallback>(new ExtractCallback(_openCallback->archive(), _progress, _stats, _type));
+#  else
+        return CMyComPtr<ExtractCallback>(new ExtractCallback(_openCallback->archive(), _password, _progress, _stats, _type));
+#  endif
+#endif
+    }
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    void DecoderImpl::finishItemStream() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        CMyComPtr<ExtractCallback> tmpExtractCallback(static_cast<CMyComPtr<ExtractCallback> &&>(_extractCallback));
+        tmpExtractCallback.Release();
+        _itemStreamOpened = false;
+        _stats->finish();
+        
+        if (_aborted) {
+            _stream->close();
+        }
+    }
+#endif
+    
+    uint32_t DecoderImpl::numberOfThreads() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _numberOfThreads;
+    }
+    
+    void DecoderImpl::setNumberOfThreads(const uint32_t threads) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _numberOfThreads = threads;
+    }
+    
+    bool DecoderImpl::shouldExtractInParallel() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _extractInParallel;
+    }
+    
+    void DecoderImpl::setShouldExtractInParallel(const bool parallel) {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        if (parallel) {
+            throw Exception(plzma_error_code_invalid_arguments, "The parallel extraction is not supported by the thread unsafe build.", __FILE__, __LINE__);
+        }
+#else
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _extractInParallel = parallel;
+#endif
+    }
+    
+    void DecoderImpl::setBlockCache(const SharedPtr<BlockCache> & cache) {
+        SharedPtr<BlockCache> sharedCache(cache);
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _blockCache = SharedPtr<BlockCacheImpl>(static_cast<BlockCacheImpl *>(sharedCache.get()));
+    }
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    void DecoderImpl::ExtractWorker::run() noexcept {
+        try {
+            stream->open();
+            if (!openCallback || openCallback->open()) {
+                if (openCallback) {
+                    applySettings(openCallback->archive(), type, numberOfThreads);
+                }
+                if (itemsStreams) {
+                    extractCallback->process(mode, itemsStreams);
+                } else if (mode == NArchive::NExtract::NAskMode::kExtract) {
+                    extractCallback->process(mode, items, path, itemsFullPath);
+                } else {
+                    extractCallback->process(mode, items);
+                }
+            }
+        } catch (const Exception & e) {
+            exception = e.moveToHeapCopy();
+        }
+#if defined(LIBPLZMA_HAVE_STD)
+        catch (const std::exception & e) {
+            exception = Exception::create(plzma_error_code_internal, e.what(), __FILE__, __LINE__);
+        }
+#endif
+        catch (...) {
+            exception = Exception::create(plzma_error_code_unknown, "Can't extract archive items in parallel.", __FILE__, __LINE__);
+        }
+    }
+    
+    IInArchive * DecoderImpl::prepareWorkerArchive(ExtractWorker & worker) {
+        // The opened archive is shared if it reads the content from the worker's stream, otherwise the worker opens it once more.
+        // The shared archive is referenced only by the decoder's open callback, the workers get the raw pointer.
+        // The reference counter of the archive handler is not atomic, so it's never modified by the workers' threads.
+        IInArchive * archive = _openCallback->archive();
+        CMyComPtr<IInArchiveExtractStream> extractStream; // under the lock
+        if (archive->QueryInterface(IID_IInArchiveExtractStream, reinterpret_cast<void **>(&extractStream)) == S_OK) {
+            return archive;
+        }
+#if defined(LIBPLZMA_NO_CRYPTO)
+        worker.openCallback = CMyComPtr<OpenCallback>(new OpenCallback(worker.stream, _type));
+#else
+        worker.openCallback = CMyComPtr<OpenCallback>(new OpenCallback(worker.stream, _password, _type));
+#endif
+        return worker.openCallback->archive();
+    }
+    
+    THREAD_FUNC_DECL DecoderImpl::extractWorkerThread(void * worker) {
+        static_cast<ExtractWorker *>(worker)->run();
+        return THREAD_FUNC_RET_ZERO;
+    }
+    
+    bool DecoderImpl::prepareParallel(const Int32 mode,
+                                      const SharedPtr<ItemArray> & items,
+                                      const SharedPtr<ItemOutStreamArray> & itemsStreams,
+                                      const Path * path,
+                                      const bool itemsFullPath) {
+        if (_type != plzma_file_type_7z) {
+            return false;
+        }
+        
+        const uint32_t threads = (_numberOfThreads > 0) ? _numberOfThreads : static_cast<uint32_t>(NWindows::NSystem::GetNumberOfProcessors());
+        if (threads < 2) {
+            return false;
+        }
+        
+        IInArchive * archive = _openCallback->archive();
+        UInt32 itemsCount = 0;
+        if (itemsStreams) {
+            itemsCount = itemsStreams->count();
+        } else if (items) {
+            itemsCount = items->count();
+        } else if (archive->GetNumberOfItems(&itemsCount) != S_OK) {
+            throw Exception(plzma_error_code_internal, "Can't get number of archive items.", __FILE__, __LINE__);
+        }
+        
+        NWindows::NCOM::CPropVariant numBlocksProp;
+        if (archive->GetArchiveProperty(kpidNumBlocks, &numBlocksProp) != S_OK || numBlocksProp.vt != VT_UI4 || numBlocksProp.ulVal < 2) {
+            return false;
+        }
+        
+        // The items are grouped by the independent blocks(7z folders), each block is decoded by only one worker.
+        // The block index of the item is a dense folder index, so the block's position is found by the index.
+        struct Block final {
+            UInt64 size = 0;
+            uint32_t worker = 0;
+        };
+        Vector<Block> blocks;
+        const UInt32 numBlocks = numBlocksProp.ulVal;
+        RawHeapMemory blocksPositionsMemory(sizeof(plzma_size_t) * numBlocks);
+        plzma_size_t * blocksPositions = blocksPositionsMemory;
+        for (UInt32 b = 0; b < numBlocks; b++) {
+            blocksPositions[b] = PLZMA_SIZE_T_MAX; // not requested
+        }
+        RawHeapMemory itemsBlocksMemory(sizeof(plzma_size_t) * itemsCount);
+        plzma_size_t * itemsBlocks = itemsBlocksMemory; // the position of the item's block, PLZMA_SIZE_T_MAX - the item has no data
+        for (UInt32 i = 0; i < itemsCount; i++) {
+            const UInt32 index = itemsStreams ? itemsStreams->at(i).first->index() : (items ? items->at(i)->index() : i);
+            NWindows::NCOM::CPropVariant blockProp, sizeProp;
+            if (archive->GetProperty(index, kpidBlock, &blockProp) != S_OK ||
+                archive->GetProperty(index, kpidSize, &sizeProp) != S_OK) {
+                throw Exception(plzma_error_code_internal, "Can't read item property.", __FILE__, __LINE__);
+            }
+            if (blockProp.vt != VT_UI4) {
+                itemsBlocks[i] = PLZMA_SIZE_T_MAX;
+                continue;
+            }
+            if (blockProp.ulVal >= numBlocks) {
+                throw Exception(plzma_error_code_internal, "Item's block index is out of bounds.", __FILE__, __LINE__);
+            }
+            plzma_size_t & position = blocksPositions[blockProp.ulVal];
+            if (position == PLZMA_SIZE_T_MAX) {
+                position = blocks.count();
+                blocks.push(Block());
+            }
+            itemsBlocks[i] = position;
+            blocks.at(position).size += (sizeProp.vt == VT_UI8) ? sizeProp.uhVal.QuadPart : 0;
+        }
+        if (blocks.count() < 2) {
+            return false;
+        }
+        
+        const uint32_t workersCount = (blocks.count() < threads) ? static_cast<uint32_t>(blocks.count()) : threads;
+        Vector<ExtractWorker> workers(workersCount);
+        for (uint32_t w = 0; w < workersCount; w++) {
+            ExtractWorker worker;
+            worker.stream = CMyComPtr<InStreamBase>(_stream->clone().get());
+            if (!worker.stream) {
+                return false;
+            }
+            worker.type = _type;
+            worker.mode = mode;
+            worker.itemsFullPath = itemsFullPath;
+            worker.numberOfThreads = (threads / workersCount > 1) ? (threads / workersCount) : 1;
+            if (path) {
+                worker.path.set(*path);
+            }
+            if (itemsStreams) {
+                worker.itemsStreams = makeShared<ItemOutStreamArray>();
+            } else {
+                worker.items = makeShared<ItemArray>();
+            }
+            workers.push(static_cast<ExtractWorker &&>(worker));
+        }
+        
+        // The blocks from the largest one, each goes to the least loaded worker.
+        struct BlockOrder final {
+            UInt64 size;
+            plzma_size_t position;
+            
+            static int compare(const void * a, const void * b) noexcept {
+                const BlockOrder * orderA = static_cast<const BlockOrder *>(a);
+                const BlockOrder * orderB = static_cast<const BlockOrder *>(b);
+                if (orderA->size != orderB->size) {
+                    return (orderA->size > orderB->size) ? -1 : 1;
+                }
+                return (orderA->position < orderB->position) ? -1 : ((orderA->position > orderB->position) ? 1 : 0);
+            }
+        };
+        RawHeapMemory blocksOrderMemory(sizeof(BlockOrder) * blocks.count());
+        BlockOrder * blocksOrder = blocksOrderMemory;
+        for (plzma_size_t b = 0; b < blocks.count(); b++) {
+            blocksOrder[b].size = blocks.at(b).size;
+            blocksOrder[b].position = b;
+        }
+        ::qsort(blocksOrder, blocks.count(), sizeof(BlockOrder), BlockOrder::compare);
+        RawHeapMemory workersSizesMemory(sizeof(UInt64) * workersCount);
+        UInt64 * workersSizes = workersSizesMemory;
+        for (uint32_t w = 0; w < workersCount; w++) {
+            workersSizes[w] = 0;
+        }
+        for (plzma_size_t b = 0; b < blocks.count(); b++) {
+            uint32_t leastLoaded = 0;
+            for (uint32_t w = 1; w < workersCount; w++) {
+                if (workersSizes[w] < workersSizes[leastLoaded]) {
+                    leastLoaded = w;
+                }
+            }
+            workersSizes[leastLoaded] += blocksOrder[b].size;
+            blocks.at(blocksOrder[b].position).worker = leastLoaded + 1; // 0 - not assigned
+        }
+        
+        SharedPtr<ItemArray> allItems;
+        for (UInt32 i = 0; i < itemsCount; i++) {
+            // The items without data go to the first worker.
+            ExtractWorker & worker = workers.at((itemsBlocks[i] == PLZMA_SIZE_T_MAX) ? 0 : (blocks.at(itemsBlocks[i]).worker - 1));
+            if (itemsStreams) {
+                const auto & pair = itemsStreams->at(i);
+                worker.itemsStreams->push(Pair<SharedPtr<Item>, SharedPtr<OutStream> >(pair.first, pair.second));
+            } else if (items) {
+                worker.items->push(items->at(i));
+            } else {
+                if (!allItems) {
+                    allItems = _openCallback->allItems();
+                }
+                worker.items->push(allItems->at(i));
+            }
+        }
+        
+        for (uint32_t w = 0; w < workersCount; w++) {
+            ExtractWorker & worker = workers.at(w);
+            IInArchive * archive = prepareWorkerArchive(worker);
+#if defined(LIBPLZMA_NO_PROGRESS)
+#  if defined(LIBPLZMA_NO_CRYPTO)
+            worker.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, _stats, _type));
+#  else
+            worker.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, _password, _stats, _type));
+#  endif
+#else
+#  if defined(LIBPLZMA_NO_CRYPTO)
+            worker.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, makeShared<Progress>(_progress), _stats, _type));
+#  else
+            worker.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, _password, makeShared<Progress>(_progress), _stats, _type));
+#  endif
+#endif
+            if (!worker.openCallback) {
+                worker.extractCallback->setStream(worker.stream);
+            }
+        }
+        
+        // The shared archive decodes the blocks of all workers, the threads are divided between them.
+        if (!workers.at(0).openCallback && _concurrentCalls.count() == 0) {
+            applySettings(_openCallback->archive(), _type, workers.at(0).numberOfThreads);
+        }
+        
+#if !defined(LIBPLZMA_NO_PROGRESS)
+        _progress->reset();
+        _progress->setPartsCount(1);
+        _progress->startPart();
+#endif
+        _stats->start(workersCount);
+        _extractWorkers = static_cast<Vector<ExtractWorker> &&>(workers);
+        return true;
+    }
+    
+    bool DecoderImpl::prepareParallel(const Int32 mode, const SharedPtr<ItemArray> & items, const Path & path, const bool itemsFullPath) {
+        return prepareParallel(mode, items, SharedPtr<ItemOutStreamArray>(), &path, itemsFullPath);
+    }
+    
+    bool DecoderImpl::prepareParallel(const Int32 mode, const Path & path, const bool itemsFullPath) {
+        return prepareParallel(mode, SharedPtr<ItemArray>(), SharedPtr<ItemOutStreamArray>(), &path, itemsFullPath);
+    }
+    
+    bool DecoderImpl::prepareParallel(const Int32 mode, const SharedPtr<ItemOutStreamArray> & items) {
+        return prepareParallel(mode, SharedPtr<ItemArray>(), items, nullptr, true);
+    }
+    
+    bool DecoderImpl::prepareParallel(const Int32 mode, const SharedPtr<ItemArray> & items) {
+        return prepareParallel(mode, items, SharedPtr<ItemOutStreamArray>(), nullptr, true);
+    }
+    
+    bool DecoderImpl::prepareParallel(const Int32 mode) {
+        return prepareParallel(mode, SharedPtr<ItemArray>(), SharedPtr<ItemOutStreamArray>(), nullptr, true);
+    }
+    
+    void DecoderImpl::processParallel() {
+        // The workers are not modified by other threads until they finish, only aborted.
+        const plzma_size_t workersCount = _extractWorkers.count();
+        NWindows::CThread * threads = new NWindows::CThread[workersCount];
+        for (plzma_size_t w = 1; w < workersCount; w++) {
+            if (threads[w].Create(DecoderImpl::extractWorkerThread, &_extractWorkers.at(w)) != 0) {
+                _extractWorkers.at(w).run();
+            }
+        }
+        _extractWorkers.at(0).run();
+        for (plzma_size_t w = 1; w < workersCount; w++) {
+            if (threads[w].IsCreated()) {
+                threads[w].Wait_Close();
+            }
+        }
+        delete [] threads;
+        _stats->finish();
+        
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        Vector<ExtractWorker> workers(static_cast<Vector<ExtractWorker> &&>(_extractWorkers));
+        for (plzma_size_t w = 0; w < workers.count(); w++) {
+            workers.at(w).extractCallback.Release();
+            workers.at(w).openCallback.Release();
+        }
+        if (_aborted) {
+            _stream->close();
+        }
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        
+        Exception * exception = nullptr;
+        for (plzma_size_t w = 0; w < workers.count(); w++) {
+            ExtractWorker & worker = workers.at(w);
+            worker.stream->close();
+            if (worker.exception) {
+                if (exception) {
+                    delete worker.exception;
+                } else {
+                    exception = worker.exception;
+                }
+                worker.exception = nullptr;
+            }
+        }
+        
+        if (exception) {
+            Exception localException(static_cast<Exception &&>(*exception));
+            delete exception;
+            throw localException;
+        }
+#if !defined(LIBPLZMA_NO_PROGRESS)
+        _progress->finish();
+#endif
+    }
+    
+    bool DecoderImpl::prepareConcurrent(ExtractWorker & call) {
+        // The sequential stream can't be read more than once, the other streams are cloned, i.e. opened independently.
+        if (_sequentialStreamRead || _stream->sequential()) {
+            return false;
+        }
+        
+        call.stream = CMyComPtr<InStreamBase>(_stream->clone().get());
+        if (!call.stream) {
+            return false;
+        }
+        call.type = _type;
+        call.numberOfThreads = _numberOfThreads;
+        
+        // The call is counted by the decoder's stats and reports own progress via the decoder's delegate.
+        IInArchive * archive = prepareWorkerArchive(call);
+#if defined(LIBPLZMA_NO_PROGRESS)
+#  if defined(LIBPLZMA_NO_CRYPTO)
+        call.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, _stats, _type));
+#  else
+        call.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, _password, _stats, _type));
+#  endif
+#else
+#  if defined(LIBPLZMA_NO_CRYPTO)
+        call.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, Progress::makeConcurrent(_progress), _stats, _type));
+#  else
+        call.extractCallback = CMyComPtr<ExtractCallback>(new ExtractCallback(archive, _password, Progress::makeConcurrent(_progress), _stats, _type));
+#  endif
+#endif
+        if (!call.openCallback) {
+            call.extractCallback->setStream(call.stream);
+        }
+        return true;
+    }
+    
+    void DecoderImpl::finishConcurrent(ExtractWorker & call) {
+        // Under the lock, the reference counter of the decoder is not atomic.
+        for (plzma_size_t i = 0; i < _concurrentCalls.count(); i++) {
+            if (_concurrentCalls.at(i) == &call) {
+                _concurrentCalls.at(i) = _concurrentCalls.at(_concurrentCalls.count() - 1);
+                _concurrentCalls.pop();
+                break;
+            }
+        }
+        call.extractCallback.Release();
+        call.openCallback.Release();
+        call.stream->close();
+    }
+#endif
+    
     bool DecoderImpl::open() {
         LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
         if (_opened || _opening) {
@@ -116,9 +569,396 @@ namespace plzma {
         if (_type == plzma_file_type_xz && items->count() > 1) {
             throw Exception(plzma_error_code_invalid_arguments, "Xz type supports only one item.", __FILE__, __LINE__);
         }
+        if (_type == plzma_file_type_7z) {
+            LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+            const bool cached = _blockCache && !_stream->sequential();
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            if (cached) {
+                return extractCached(items);
+            }
+        }
         return process(NArchive::NExtract::NAskMode::kExtract, items);
     }
     
+    void DecoderImpl::readBlocks() {
+        IInArchive * archive = _openCallback->archive();
+        const UInt32 itemsCount = _openCallback->itemsCount();
+        RawHeapMemory itemsBlocksMemory(sizeof(UInt32) * itemsCount);
+        UInt32 * itemsBlocks = itemsBlocksMemory;
+        Vector<BlockRange> blocks;
+        for (UInt32 i = 0; i < itemsCount; i++) {
+            NWindows::NCOM::CPropVariant blockProp, sizeProp;
+            if (archive->GetProperty(i, kpidBlock, &blockProp) != S_OK ||
+                archive->GetProperty(i, kpidSize, &sizeProp) != S_OK) {
+                throw Exception(plzma_error_code_internal, "Can't read item property.", __FILE__, __LINE__);
+            }
+            // Each 7z block contains at least one item, so the larger indices are not expected.
+            if (blockProp.vt != VT_UI4 || blockProp.ulVal >= itemsCount) {
+                itemsBlocks[i] = UINT32_MAX;
+                continue;
+            }
+            itemsBlocks[i] = blockProp.ulVal;
+            while (blocks.count() <= blockProp.ulVal) {
+                blocks.push(BlockRange());
+            }
+            BlockRange & range = blocks.at(blockProp.ulVal);
+            if (range.count == 0) {
+                // The first item of the block reports the packed block, the encrypted content is never shared.
+                NWindows::NCOM::CPropVariant offsetProp, packSizeProp, encryptedProp;
+                if (archive->GetProperty(i, kpidOffset, &offsetProp) != S_OK ||
+                    archive->GetProperty(i, kpidPackSize, &packSizeProp) != S_OK ||
+                    archive->GetProperty(i, kpidEncrypted, &encryptedProp) != S_OK) {
+                    throw Exception(plzma_error_code_internal, "Can't read item property.", __FILE__, __LINE__);
+                }
+                range.source.identity = _stream->identity();
+                range.source.packOffset = (offsetProp.vt == VT_UI8) ? offsetProp.uhVal.QuadPart : 0;
+                range.source.packSize = (packSizeProp.vt == VT_UI8) ? packSizeProp.uhVal.QuadPart : 0;
+                range.first = i;
+                range.cacheable = offsetProp.vt == VT_UI8 && packSizeProp.vt == VT_UI8 && !PROPVARIANTGetBool(encryptedProp);
+            } else if (range.first + range.count != i) {
+                range.cacheable = false;
+            }
+            range.count++;
+            range.size += (sizeProp.vt == VT_UI8) ? sizeProp.uhVal.QuadPart : 0;
+        }
+        _blocks = static_cast<Vector<BlockRange> &&>(blocks);
+        _itemsBlocks = static_cast<RawHeapMemory &&>(itemsBlocksMemory);
+        _blocksRead = true;
+    }
+    
+    Vector<CachedBlock::Item> DecoderImpl::blockItems(const BlockRange & range) {
+        IInArchive * archive = _openCallback->archive();
+        Vector<CachedBlock::Item> items(range.count);
+        for (UInt32 i = 0; i < range.count; i++) {
+            NWindows::NCOM::CPropVariant sizeProp, crcProp;
+            if (archive->GetProperty(range.first + i, kpidSize, &sizeProp) != S_OK ||
+                archive->GetProperty(range.first + i, kpidCRC, &crcProp) != S_OK) {
+                throw Exception(plzma_error_code_internal, "Can't read item property.", __FILE__, __LINE__);
+            }
+            CachedBlock::Item item;
+            item.size = (sizeProp.vt == VT_UI8) ? sizeProp.uhVal.QuadPart : 0;
+            item.crc32 = (crcProp.vt == VT_UI4) ? crcProp.ulVal : 0;
+            items.push(item);
+        }
+        return items;
+    }
+    
+    void DecoderImpl::writeCachedItem(const CachedBlock & block, const UInt32 itemIndex, const SharedPtr<Item> & item, const SharedPtr<OutStream> & stream) {
+        const CachedBlock::Item & blockItem = block.items.at(itemIndex);
+        const uint8_t * data = block.content;
+        data += blockItem.offset;
+        uint64_t remaining = blockItem.size;
+        auto base = stream.cast<OutStreamBase>();
+        base->setTimestamp(item->timestamp());
+        base->reserve(blockItem.size);
+        base->open();
+        HRESULT result = S_OK;
+        while (remaining > 0 && result == S_OK) {
+            const UInt32 size = (remaining > kDecoderWriteSize) ? kDecoderWriteSize : static_cast<UInt32>(remaining);
+            UInt32 processedSize = 0;
+            result = base->Write(data, size, &processedSize);
+            if (result == S_OK && processedSize == 0) {
+                result = E_FAIL;
+            }
+            data += processedSize;
+            remaining -= processedSize;
+        }
+        base->close();
+        Exception * exception = base->takeException();
+        if (exception) {
+            Exception localException(static_cast<Exception &&>(*exception));
+            delete exception;
+            throw localException;
+        }
+        if (result != S_OK) {
+            throw Exception(plzma_error_code_io, "Can't write the content of the cached item.", __FILE__, __LINE__);
+        }
+    }
+    
+    bool DecoderImpl::extractCached(const SharedPtr<ItemOutStreamArray> & items) {
+        // The requested items of the cacheable blocks are copied from the decoded blocks, the others are extracted as usual.
+        const plzma_size_t itemsCount = items->count();
+        RawHeapMemory requestedBlocksMemory(sizeof(plzma_size_t) * itemsCount);
+        plzma_size_t * requestedBlocks = requestedBlocksMemory; // the index in the 'ranges' or PLZMA_SIZE_T_MAX
+        Vector<BlockRange> ranges;
+        Vector<UInt32> rangesBlocks;
+        Vector<Vector<CachedBlock::Item> > rangesItems;
+        SharedPtr<BlockCacheImpl> cache;
+        SharedPtr<ItemOutStreamArray> streams(makeShared<ItemOutStreamArray>());
+        {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            if (!_opened) {
+                return false;
+            }
+            if (!_blocksRead) {
+                readBlocks();
+            }
+            cache = _blockCache;
+            const UInt32 archiveItemsCount = _openCallback->itemsCount();
+            const UInt32 * itemsBlocks = _itemsBlocks;
+            for (plzma_size_t i = 0; i < itemsCount; i++) {
+                const auto & pair = items->at(i);
+                const UInt32 index = pair.first->index();
+                requestedBlocks[i] = PLZMA_SIZE_T_MAX;
+                if (cache && index < archiveItemsCount && itemsBlocks[index] != UINT32_MAX) {
+                    const BlockRange & range = _blocks.at(itemsBlocks[index]);
+                    if (range.cacheable && range.size <= cache->capacity()) {
+                        plzma_size_t r = 0;
+                        while (r < rangesBlocks.count() && rangesBlocks.at(r) != itemsBlocks[index]) {
+                            r++;
+                        }
+                        if (r == rangesBlocks.count()) {
+                            ranges.push(range);
+                            rangesBlocks.push(itemsBlocks[index]);
+                            rangesItems.push(blockItems(range));
+                        }
+                        requestedBlocks[i] = r;
+                        continue;
+                    }
+                }
+                streams->push(ItemOutStreamArray::ElementType(pair.first, pair.second));
+            }
+        }
+        
+        // The missing blocks are decoded together with the other requested items via a single pass.
+        struct DecodedItem final {
+            OutArenaStream * stream = nullptr;
+            uint64_t size = 0;
+        };
+        Vector<DecodedItem> decodedItems;
+        Vector<SharedPtr<CachedBlock> > blocks(ranges.count());
+        Vector<SharedPtr<CachedBlock> > decodedBlocks;
+        Vector<bool> blocksHits(ranges.count());
+        for (plzma_size_t r = 0; r < ranges.count(); r++) {
+            const BlockRange & range = ranges.at(r);
+            Vector<CachedBlock::Item> & blockItems = rangesItems.at(r);
+            SharedPtr<CachedBlock> block(cache->find(CachedBlock::makeKey(range.source, blockItems), range.source, blockItems));
+            blocksHits.push(block ? true : false);
+            if (!block) {
+                block = SharedPtr<CachedBlock>(new CachedBlock(range.source, static_cast<Vector<CachedBlock::Item> &&>(blockItems)));
+                uint8_t * memory = block->content;
+                for (UInt32 i = 0; i < range.count; i++) {
+                    const CachedBlock::Item & blockItem = block->items.at(i);
+                    DecodedItem decodedItem;
+                    decodedItem.stream = new OutArenaStream(memory ? memory + blockItem.offset : nullptr, blockItem.size);
+                    decodedItem.size = blockItem.size;
+                    SharedPtr<OutStream> stream(decodedItem.stream);
+                    streams->push(ItemOutStreamArray::ElementType(itemAt(range.first + i), static_cast<SharedPtr<OutStream> &&>(stream)));
+                    decodedItems.push(decodedItem);
+                }
+                decodedBlocks.push(block);
+            }
+            blocks.push(static_cast<SharedPtr<CachedBlock> &&>(block));
+        }
+        
+        if (streams->count() > 0 && !process(NArchive::NExtract::NAskMode::kExtract, streams)) {
+            return false;
+        }
+        
+        {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            if (_aborted) {
+                return true; // the decoded blocks might be incomplete
+            }
+        }
+        for (plzma_size_t i = 0; i < decodedItems.count(); i++) {
+            const DecodedItem & decodedItem = decodedItems.at(i);
+            if (decodedItem.stream->size() != decodedItem.size) {
+                throw Exception(plzma_error_code_internal, "Can't decode the archive block.", __FILE__, __LINE__);
+            }
+        }
+        for (plzma_size_t b = 0; b < decodedBlocks.count(); b++) {
+            cache->insert(decodedBlocks.at(b));
+        }
+        
+        uint64_t hitItemsCount = 0;
+        for (plzma_size_t i = 0; i < itemsCount; i++) {
+            if (requestedBlocks[i] != PLZMA_SIZE_T_MAX && blocksHits.at(requestedBlocks[i])) {
+                hitItemsCount++;
+            }
+        }
+        {
+            // The items of the decoded blocks are counted by the extraction above, the items of the cache hits are
+            // counted as the part of it or of the operation in progress, otherwise as the own operation.
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            if (streams->count() > 0 || _extractCallback) {
+                _stats->join();
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+            } else if (_extractWorkers.count() > 0) {
+                _stats->join();
+#endif
+            } else {
+                _stats->start();
+            }
+            _stats->addItemsCount(hitItemsCount);
+        }
+        try {
+            for (plzma_size_t i = 0; i < itemsCount; i++) {
+                if (requestedBlocks[i] != PLZMA_SIZE_T_MAX) {
+                    const auto & pair = items->at(i);
+                    const BlockRange & range = ranges.at(requestedBlocks[i]);
+                    const CachedBlock & block = *blocks.at(requestedBlocks[i]).get();
+                    const UInt32 blockItemIndex = pair.first->index() - range.first;
+                    writeCachedItem(block, blockItemIndex, pair.first, pair.second);
+                    if (blocksHits.at(requestedBlocks[i])) {
+                        _stats->addSizes(0, block.items.at(blockItemIndex).size);
+                        _stats->completeItem();
+                    }
+                }
+            }
+        } catch (...) {
+            _stats->finishPart();
+            throw;
+        }
+        _stats->finishPart();
+        return true;
+    }
+    
+    bool DecoderImpl::extractToArena(const SharedPtr<ItemArray> & items) {
+        if (_type == plzma_file_type_xz && items->count() > 1) {
+            throw Exception(plzma_error_code_invalid_arguments, "Xz type supports only one item.", __FILE__, __LINE__);
+        }
+        
+        {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            if (!_opened || _extractCallback || _arenaExtracting) {
+                return false;
+            }
+#else
+            if (!_opened || _extractCallback || _extractWorkers.count() > 0 || _concurrentCalls.count() > 0 || _itemStreamOpened || _arenaExtracting) {
+                return false;
+            }
+#endif
+            _arenaExtracting = true;
+        }
+        
+        // The arena and views are published only after the extraction, the previous arena stays valid till that.
+        const plzma_size_t itemsCount = items->count();
+        RawHeapMemory arena;
+        Vector<plzma_arena_view> views(itemsCount);
+        Vector<plzma_size_t> streamsIndices(itemsCount);
+        SharedPtr<ItemOutStreamArray> itemsStreams;
+        uint64_t arenaSize = 0;
+        bool result = false;
+        try {
+            itemsStreams = makeShared<ItemOutStreamArray>(itemsCount);
+            for (plzma_size_t i = 0; i < itemsCount; i++) {
+                const SharedPtr<Item> & item = items->at(i);
+                const uint64_t itemSize = item->size();
+                if (itemSize >= plzma_max_size() || arenaSize >= (plzma_max_size() - itemSize)) {
+                    throw Exception(plzma_error_code_not_enough_memory, "Can't allocate the arena for the extracting items.", __FILE__, __LINE__);
+                }
+                arenaSize += itemSize;
+                itemsStreams->push(Pair<SharedPtr<Item>, SharedPtr<OutStream> >(SharedPtr<Item>(item), SharedPtr<OutStream>()));
+            }
+            
+            // The regions follow the archive order, so the solid blocks are written to the arena sequentially.
+            // The caller's items array is not modified, the views follow it's order.
+            itemsStreams->sort();
+            arena.resize(static_cast<size_t>(arenaSize));
+            uint8_t * memory = arena;
+            Vector<uint64_t> offsets(itemsCount);
+            uint64_t offset = 0;
+            for (plzma_size_t i = 0; i < itemsCount; i++) {
+                auto & pair = itemsStreams->at(i);
+                const uint64_t itemSize = pair.first->size();
+                pair.second = SharedPtr<OutStream>(new OutArenaStream(memory ? memory + offset : nullptr, itemSize));
+                offsets.push(offset);
+                offset += itemSize;
+            }
+            for (plzma_size_t i = 0; i < itemsCount; i++) {
+                const SharedPtr<Item> & item = items->at(i);
+                const auto * pair = itemsStreams->bsearch<plzma_size_t>(item->index());
+                const plzma_size_t streamIndex = static_cast<plzma_size_t>(pair - &itemsStreams->at(0));
+                streamsIndices.push(streamIndex);
+                views.push(plzma_arena_view{offsets.at(streamIndex), item->size()});
+            }
+            result = process(NArchive::NExtract::NAskMode::kExtract, itemsStreams);
+            if (result) {
+                for (plzma_size_t i = 0; i < itemsCount; i++) {
+                    auto stream = itemsStreams->at(streamsIndices.at(i)).second.cast<OutStreamBase>();
+                    views.at(i).size = static_cast<OutArenaStream *>(stream.get())->size();
+                }
+            }
+        } catch (...) {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            _arenaExtracting = false;
+            throw;
+        }
+        
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _arenaExtracting = false;
+        if (result) {
+            _arena = static_cast<RawHeapMemory &&>(arena);
+            _arenaViews = static_cast<Vector<plzma_arena_view> &&>(views);
+            _arenaSize = arenaSize;
+        }
+        return result;
+    }
+    
+    const void * LIBPLZMA_NULLABLE DecoderImpl::arena() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return static_cast<const void *>(_arena);
+    }
+    
+    uint64_t DecoderImpl::arenaSize() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _arenaSize;
+    }
+    
+    plzma_size_t DecoderImpl::arenaViewsCount() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _arenaViews.count();
+    }
+    
+    plzma_arena_view DecoderImpl::arenaViewAt(const plzma_size_t index) const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (index < _arenaViews.count()) {
+            return _arenaViews.at(index);
+        }
+        throw Exception(plzma_error_code_invalid_arguments, "Arena view index out of bounds.", __FILE__, __LINE__);
+    }
+    
+    plzma_stats DecoderImpl::stats() const {
+        return _stats->snapshot(); // without locking, the counters are atomic
+    }
+    
+    SharedPtr<ItemStream> DecoderImpl::openItemStream(const SharedPtr<Item> & item) {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        throw Exception(plzma_error_code_invalid_arguments, "The item stream is not supported by the thread unsafe build.", __FILE__, __LINE__);
+#else
+        if (!item) {
+            throw Exception(plzma_error_code_invalid_arguments, "No item.", __FILE__, __LINE__);
+        }
+        
+        ItemStreamImpl * streamImpl = new ItemStreamImpl(SharedPtr<DecoderImpl>(this), item);
+        SharedPtr<ItemStream> stream(streamImpl);
+        
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (!_opened || _extractCallback || _extractWorkers.count() > 0) {
+            return SharedPtr<ItemStream>();
+        }
+        if (item->index() >= _openCallback->itemsCount()) {
+            throw Exception(plzma_error_code_invalid_arguments, "Item index out of bounds.", __FILE__, __LINE__);
+        }
+        if (_sequentialStreamRead) {
+            throw Exception(plzma_error_code_invalid_arguments, "The sequential input stream has already been read.", __FILE__, __LINE__);
+        }
+        
+        if (_concurrentCalls.count() == 0) { // the settings of the shared archive are not modified during the concurrent calls
+            applySettings(_openCallback->archive(), _type, _numberOfThreads);
+        }
+        _sequentialStreamRead = _stream->sequential();
+        
+        CMyComPtr<ExtractCallback> extractCallback(createExtractCallback());
+        streamImpl->start(extractCallback); // the decoding thread waits for the lock to finish
+        _extractCallback = extractCallback;
+        _itemStreamOpened = true;
+        return stream;
+#endif
+    }
+    
     bool DecoderImpl::test(const SharedPtr<ItemArray> & items) {
         if (_type == plzma_file_type_xz && items->count() > 1) {
             throw Exception(plzma_error_code_invalid_arguments, "Xz type supports only one item.", __FILE__, __LINE__);
@@ -140,7 +980,25 @@ namespace plzma {
         if (extractCallback) {
             extractCallback->abort();
         }
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+        for (plzma_size_t w = 0; w < _extractWorkers.count(); w++) {
+            ExtractWorker & worker = _extractWorkers.at(w);
+            if (worker.openCallback) {
+                worker.openCallback->abort();
+            }
+            worker.extractCallback->abort();
+        }
+        for (plzma_size_t i = 0; i < _concurrentCalls.count(); i++) {
+            ExtractWorker * call = _concurrentCalls.at(i);
+            if (call->openCallback) {
+                call->openCallback->abort();
+            }
+            call->extractCallback->abort();
+        }
+        if ( !(_opening || extractCallback || _extractWorkers.count() > 0) ) {
+#else
         if ( !(_opening || extractCallback) ) {
+#endif
             _stream->close();
         }
     }
@@ -160,6 +1018,31 @@ namespace plzma {
         return _opened ? _openCallback->itemAt(index) : SharedPtr<Item>();
     }
     
+    SharedPtr<ItemTable> DecoderImpl::itemTable() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (!_opened) {
+            return SharedPtr<ItemTable>();
+        }
+        if (!_itemTable) {
+            _itemTable = SharedPtr<ItemTable>(new ItemTableImpl(_openCallback->archive(), _openCallback->itemsCount()));
+        }
+        return _itemTable;
+    }
+    
+    SharedPtr<Item> DecoderImpl::findItem(const Path & path) const {
+        auto table = itemTable();
+        plzma_size_t index = 0;
+        if (table && static_cast<const ItemTableImpl *>(table.get())->findIndex(path.utf8(), index)) {
+            return table->itemAt(index);
+        }
+        return SharedPtr<Item>();
+    }
+    
+    SharedPtr<ItemArray> DecoderImpl::findItems(const Path & pattern) const {
+        auto table = itemTable();
+        return table ? static_cast<const ItemTableImpl *>(table.get())->findItems(pattern.utf8()) : SharedPtr<ItemArray>();
+    }
+    
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
     void DecoderImpl::setUtf8Callback(plzma_progress_delegate_utf8_callback LIBPLZMA_NULLABLE callback) {
 #if !defined(LIBPLZMA_NO_PROGRESS)
@@ -181,6 +1064,7 @@ namespace plzma {
 #if !defined(LIBPLZMA_NO_PROGRESS)
         _progress(makeShared<Progress>(context)),
 #endif
+        _stats(makeShared<Stats>()),
         _type(type) {
             plzma::initialize();
     }
@@ -192,11 +1076,156 @@ namespace plzma {
         _stream->close();
     }
     
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    void ItemStreamImpl::retain() {
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+    
+    void ItemStreamImpl::release() {
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+    
+    void ItemStreamImpl::run() noexcept {
+        Exception * exception = nullptr;
+        try {
+            auto itemsStreams = makeShared<ItemOutStreamArray>(1);
+            itemsStreams->push(Pair<SharedPtr<Item>, SharedPtr<OutStream> >(_item, _pipe));
+            _extractCallback->process(NArchive::NExtract::NAskMode::kExtract, itemsStreams);
+        } catch (const Exception & e) {
+            exception = e.moveToHeapCopy();
+        }
+#if defined(LIBPLZMA_HAVE_STD)
+        catch (const std::exception & e) {
+            exception = Exception::create(plzma_error_code_internal, e.what(), __FILE__, __LINE__);
+        }
+#endif
+        catch (...) {
+            exception = Exception::create(plzma_error_code_unknown, "Can't decode the item stream.", __FILE__, __LINE__);
+        }
+        
+        // The reader receives the end of the content in any case, even if the item wasn't decoded.
+        _pipe.cast<OutStreamBase>()->close();
+        
+        try {
+            _decoder->finishItemStream();
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            _exception = exception;
+        } catch (...) {
+            delete exception;
+        }
+    }
+    
+    THREAD_FUNC_DECL ItemStreamImpl::decodeThread(void * stream) {
+        static_cast<ItemStreamImpl *>(stream)->run();
+        return THREAD_FUNC_RET_ZERO;
+    }
+    
+    void ItemStreamImpl::start(const CMyComPtr<ExtractCallback> & extractCallback) {
+        CMyComPtr<ISequentialOutStream> writer;
+        if (_binder.Create_ReInit() != S_OK) {
+            throw Exception(plzma_error_code_internal, "Can't create the item stream pipe.", __FILE__, __LINE__);
+        }
+        _binder.CreateStreams2(_reader, writer);
+        _pipe = SharedPtr<OutStream>(new OutPipeStream(writer));
+        _extractCallback = extractCallback;
+        if (_thread.Create(ItemStreamImpl::decodeThread, this) != 0) {
+            throw Exception(plzma_error_code_internal, "Can't create the item stream decoding thread.", __FILE__, __LINE__);
+        }
+    }
+    
+    void ItemStreamImpl::finish() {
+        _reader.Release(); // closes the reading side, the decoding is stopped if not finished
+        if (_thread.IsCreated()) {
+            _thread.Wait_Close();
+        }
+    }
+    
+    SharedPtr<Item> ItemStreamImpl::item() const {
+        return _item;
+    }
+    
+    uint64_t ItemStreamImpl::position() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _position;
+    }
+    
+    plzma_size_t ItemStreamImpl::read(void * LIBPLZMA_NONNULL buffer, const plzma_size_t size) {
+        LIBPLZMA_LOCKGUARD(readLock, _readMutex)
+        if (size == 0 || !_reader) {
+            return 0;
+        }
+        
+        UInt32 processedSize = 0;
+        const HRESULT res = _reader->Read(buffer, size, &processedSize);
+        if (res == S_OK && processedSize > 0) {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            _position += processedSize;
+            return processedSize;
+        }
+        
+        finish(); // the end of the content, the decoding result is known after the thread is finished
+        
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        Exception * exception = _exception;
+        _exception = nullptr;
+        if (_closed) {
+            delete exception;
+            return 0;
+        }
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        
+        if (exception) {
+            Exception localException(static_cast<Exception &&>(*exception));
+            delete exception;
+            throw localException;
+        } else if (res != S_OK) {
+            throw Exception(plzma_error_code_internal, "Can't read the item stream.", __FILE__, __LINE__);
+        }
+        return 0;
+    }
+    
+    void ItemStreamImpl::close() {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        if (_closed) {
+            return;
+        }
+        _closed = true;
+        CMyComPtr<ExtractCallback> extractCallback(_extractCallback);
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        
+        if (extractCallback) {
+            extractCallback->abort(); // interrupts the decoding of the solid block before the item, if any
+        }
+        
+        LIBPLZMA_LOCKGUARD(readLock, _readMutex)
+        finish();
+    }
+    
+    ItemStreamImpl::ItemStreamImpl(SharedPtr<DecoderImpl> && decoder, const SharedPtr<Item> & item) :
+        _decoder(static_cast<SharedPtr<DecoderImpl> &&>(decoder)),
+        _item(item) {
+        
+    }
+    
+    ItemStreamImpl::~ItemStreamImpl() noexcept {
+        try {
+            close();
+        } catch (...) {
+            // do nothing
+        }
+        delete _exception;
+        _exception = nullptr;
+    }
+#endif
+    
     SharedPtr<Decoder> makeSharedDecoder(const SharedPtr<InStream> & stream,
                                          const plzma_file_type type,
                                          const plzma_context context) {
         auto baseStream = stream.cast<InStreamBase>();
         if (baseStream) {
+            if (type == plzma_file_type_7z && baseStream->sequential()) {
+                throw Exception(plzma_error_code_invalid_arguments, "The 7z archive can't be decoded from the sequential input stream.", __FILE__, __LINE__);
+            }
             return SharedPtr<Decoder>(new DecoderImpl(CMyComPtr<InStreamBase>(baseStream.get()), type, context));
         }
         throw Exception(plzma_error_code_invalid_arguments, "No input stream.", __FILE__, __LINE__);
@@ -251,6 +1280,36 @@ void plzma_decoder_set_password_utf8_string(plzma_decoder * LIBPLZMA_NONNULL dec
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(decoder)
 }
 
+uint32_t plzma_decoder_number_of_threads(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, 0)
+    return static_cast<DecoderImpl *>(decoder->object)->numberOfThreads();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, 0)
+}
+
+void plzma_decoder_set_block_cache(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_block_cache * LIBPLZMA_NULLABLE cache) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(decoder)
+    static_cast<DecoderImpl *>(decoder->object)->setBlockCache(SharedPtr<BlockCache>((cache && !cache->exception) ? static_cast<BlockCache *>(cache->object) : nullptr));
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(decoder)
+}
+
+void plzma_decoder_set_number_of_threads(plzma_decoder * LIBPLZMA_NONNULL decoder, const uint32_t threads) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(decoder)
+    static_cast<DecoderImpl *>(decoder->object)->setNumberOfThreads(threads);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(decoder)
+}
+
+bool plzma_decoder_should_extract_in_parallel(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, false)
+    return static_cast<DecoderImpl *>(decoder->object)->shouldExtractInParallel();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, false)
+}
+
+void plzma_decoder_set_should_extract_in_parallel(plzma_decoder * LIBPLZMA_NONNULL decoder, const bool parallel) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(decoder)
+    static_cast<DecoderImpl *>(decoder->object)->setShouldExtractInParallel(parallel);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(decoder)
+}
+
 bool plzma_decoder_open(plzma_decoder * LIBPLZMA_NONNULL decoder) {
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, false)
     return static_cast<DecoderImpl *>(decoder->object)->open();
@@ -283,6 +1342,27 @@ plzma_item plzma_decoder_item_at(plzma_decoder * LIBPLZMA_NONNULL decoder, const
     LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
 }
 
+plzma_item_table plzma_decoder_item_table(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_item_table, decoder)
+    auto table = static_cast<DecoderImpl *>(decoder->object)->itemTable();
+    createdCObject.object = static_cast<void *>(table.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+plzma_item plzma_decoder_find_item(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_path * LIBPLZMA_NONNULL path) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_item, decoder)
+    auto item = static_cast<DecoderImpl *>(decoder->object)->findItem(*static_cast<const Path *>(path->object));
+    createdCObject.object = static_cast<void *>(item.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+plzma_item_array plzma_decoder_find_items(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_path * LIBPLZMA_NONNULL pattern) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_item_array, decoder)
+    auto items = static_cast<DecoderImpl *>(decoder->object)->findItems(*static_cast<const Path *>(pattern->object));
+    createdCObject.object = static_cast<void *>(items.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
 bool plzma_decoder_extract_all_items_to_path(plzma_decoder * LIBPLZMA_NONNULL decoder,
                                              const plzma_path * LIBPLZMA_NONNULL path,
                                              const bool items_full_path) {
@@ -311,6 +1391,53 @@ bool plzma_decoder_extract_item_out_stream_array(plzma_decoder * LIBPLZMA_NONNUL
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, false)
 }
 
+bool plzma_decoder_extract_items_to_arena(plzma_decoder * LIBPLZMA_NONNULL decoder,
+                                          plzma_item_array * LIBPLZMA_NONNULL items) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN_WITH_ARG1(decoder, items, false)
+    SharedPtr<ItemArray> itemsSPtr(static_cast<ItemArray *>(items->object));
+    return static_cast<DecoderImpl *>(decoder->object)->extractToArena(itemsSPtr);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, false)
+}
+
+const void * LIBPLZMA_NULLABLE plzma_decoder_arena(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, nullptr)
+    return static_cast<DecoderImpl *>(decoder->object)->arena();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, nullptr)
+}
+
+uint64_t plzma_decoder_arena_size(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, 0)
+    return static_cast<DecoderImpl *>(decoder->object)->arenaSize();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, 0)
+}
+
+plzma_size_t plzma_decoder_arena_views_count(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, 0)
+    return static_cast<DecoderImpl *>(decoder->object)->arenaViewsCount();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, 0)
+}
+
+plzma_arena_view plzma_decoder_arena_view_at(plzma_decoder * LIBPLZMA_NONNULL decoder, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, (plzma_arena_view{0, 0}))
+    return static_cast<DecoderImpl *>(decoder->object)->arenaViewAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, (plzma_arena_view{0, 0}))
+}
+
+plzma_stats plzma_decoder_stats(plzma_decoder * LIBPLZMA_NONNULL decoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(decoder, (plzma_stats{0, 0, 0, 0, 0.0, 0.0}))
+    return static_cast<DecoderImpl *>(decoder->object)->stats();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(decoder, (plzma_stats{0, 0, 0, 0, 0.0, 0.0}))
+}
+
+plzma_item_stream plzma_decoder_open_item_stream(plzma_decoder * LIBPLZMA_NONNULL decoder,
+                                                 plzma_item * LIBPLZMA_NONNULL item) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_item_stream, decoder)
+    SharedPtr<Item> itemSPtr(static_cast<Item *>(item->object));
+    auto stream = static_cast<DecoderImpl *>(decoder->object)->openItemStream(itemSPtr);
+    createdCObject.object = static_cast<void *>(stream.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
 bool plzma_decoder_test_items(plzma_decoder * LIBPLZMA_NONNULL decoder,
                               plzma_item_array * LIBPLZMA_NONNULL items) {
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN_WITH_ARG1(decoder, items, false)
@@ -332,4 +1459,38 @@ void plzma_decoder_release(plzma_decoder * LIBPLZMA_NONNULL decoder) {
     decoder->object = nullptr;
 }
 
+plzma_item plzma_item_stream_item(plzma_item_stream * LIBPLZMA_NONNULL stream) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_item, stream)
+    auto item = static_cast<ItemStream *>(stream->object)->item();
+    createdCObject.object = static_cast<void *>(item.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+uint64_t plzma_item_stream_position(plzma_item_stream * LIBPLZMA_NONNULL stream) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(stream, 0)
+    return static_cast<ItemStream *>(stream->object)->position();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(stream, 0)
+}
+
+plzma_size_t plzma_item_stream_read(plzma_item_stream * LIBPLZMA_NONNULL stream,
+                                    void * LIBPLZMA_NONNULL buffer,
+                                    const plzma_size_t size) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(stream, 0)
+    return static_cast<ItemStream *>(stream->object)->read(buffer, size);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(stream, 0)
+}
+
+void plzma_item_stream_close(plzma_item_stream * LIBPLZMA_NONNULL stream) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(stream)
+    static_cast<ItemStream *>(stream->object)->close();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(stream)
+}
+
+void plzma_item_stream_release(plzma_item_stream * LIBPLZMA_NONNULL stream) {
+    plzma_object_exception_release(stream);
+    SharedPtr<ItemStream> streamSPtr;
+    streamSPtr.assign(static_cast<ItemStream *>(stream->object));
+    stream->object = nullptr;
+}
+
 #endif // !LIBPLZMA_NO_C_BINDINGS
@@ -39,6 +39,9 @@
 #include "plzma_common.hpp"
 #include "plzma_c_bindings_private.hpp"
 #include "plzma_progress.hpp"
+#include "plzma_stats.hpp"
+#include "plzma_item_table.hpp"
+#include "plzma_block_cache.hpp"
 #include "plzma_mutex.hpp"
 
 #include "CPP/Common/Common.h"
@@ -52,11 +55,38 @@
 #include "CPP/7zip/ICoder.h"
 #include "CPP/Windows/PropVariant.h"
 
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+#include "CPP/Windows/Thread.h"
+#include "CPP/7zip/Common/StreamBinder.h"
+#endif
+
 namespace plzma {
     
+    class ItemStreamImpl;
+    
     class DecoderImpl final : public CMyUnknownImp, public Decoder {
     private:
         friend struct SharedPtr<DecoderImpl>;
+        friend class ItemStreamImpl;
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+        struct ExtractWorker final {
+            CMyComPtr<InStreamBase> stream;
+            CMyComPtr<OpenCallback> openCallback;
+            CMyComPtr<ExtractCallback> extractCallback;
+            SharedPtr<ItemArray> items;
+            SharedPtr<ItemOutStreamArray> itemsStreams;
+            Path path;
+            Exception * exception = nullptr;
+            plzma_file_type type = plzma_file_type_7z;
+            uint32_t numberOfThreads = 1;
+            Int32 mode = 0;
+            bool itemsFullPath = true;
+            
+            void run() noexcept;
+        };
+        Vector<ExtractWorker> _extractWorkers;
+        Vector<ExtractWorker *> _concurrentCalls; // the calls made while the decoder is busy
+#endif
         LIBPLZMA_MUTEX(mutable _mutex)
 #if !defined(LIBPLZMA_NO_CRYPTO)
         String _password;
@@ -67,37 +97,131 @@ namespace plzma {
 #if !defined(LIBPLZMA_NO_PROGRESS)
         SharedPtr<Progress> _progress;
 #endif
+        SharedPtr<Stats> _stats;
+        mutable SharedPtr<ItemTable> _itemTable;
+        SharedPtr<BlockCacheImpl> _blockCache;
+        struct BlockRange final {
+            CachedBlock::Source source;
+            UInt32 first = 0;  // the items of the 7z block follow one by one
+            UInt32 count = 0;
+            uint64_t size = 0;
+            bool cacheable = false; // the items follow one by one and the block is not encrypted
+        };
+        Vector<BlockRange> _blocks;  // by the block index, read once for the block cache
+        RawHeapMemory _itemsBlocks;  // UInt32, the block index of the item or UINT32_MAX if the item has no content
+        bool _blocksRead = false;
+        RawHeapMemory _arena;
+        Vector<plzma_arena_view> _arenaViews;
+        uint64_t _arenaSize = 0;
         plzma_file_type _type = plzma_file_type_7z;
+        uint32_t _numberOfThreads = 0;
+        bool _extractInParallel = false;
         bool _opened = false;
         bool _opening = false;
         bool _aborted = false;
+        bool _sequentialStreamRead = false;
+        bool _itemStreamOpened = false;
+        bool _arenaExtracting = false;
         
         virtual void retain() override final;
         virtual void release() override final;
         
+        static void applySettings(IInArchive * archive, const plzma_file_type type, const uint32_t numberOfThreads);
+        CMyComPtr<ExtractCallback> createExtractCallback();
+        void readBlocks();
+        Vector<CachedBlock::Item> blockItems(const BlockRange & range);
+        bool extractCached(const SharedPtr<ItemOutStreamArray> & items);
+        static void writeCachedItem(const CachedBlock & block, const UInt32 itemIndex, const SharedPtr<Item> & item, const SharedPtr<OutStream> & stream);
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+        void finishItemStream();
+#endif
+        
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+        bool prepareParallel(const Int32 mode,
+                             const SharedPtr<ItemArray> & items,
+                             const SharedPtr<ItemOutStreamArray> & itemsStreams,
+                             const Path * path,
+                             const bool itemsFullPath);
+        bool prepareParallel(const Int32 mode, const SharedPtr<ItemArray> & items, const Path & path, const bool itemsFullPath);
+        bool prepareParallel(const Int32 mode, const Path & path, const bool itemsFullPath);
+        bool prepareParallel(const Int32 mode, const SharedPtr<ItemOutStreamArray> & items);
+        bool prepareParallel(const Int32 mode, const SharedPtr<ItemArray> & items);
+        bool prepareParallel(const Int32 mode);
+        void processParallel();
+        static THREAD_FUNC_DECL extractWorkerThread(void * worker);
+        IInArchive * prepareWorkerArchive(ExtractWorker & worker);
+        bool prepareConcurrent(ExtractWorker & call);
+        void finishConcurrent(ExtractWorker & call);
+#endif
+        
         template<typename ... ARGS>
         bool process(ARGS&&... args) {
             LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+#if defined(LIBPLZMA_THREAD_UNSAFE)
             if (!_opened || _extractCallback) {
                 return false;
             }
+#else
+            if (!_opened || _itemStreamOpened) {
+                return false;
+            }
+            
+            if (_extractCallback || _extractWorkers.count() > 0) {
+                // The archive is in use, so the call reads the shared opened archive via the own view of the input stream.
+                ExtractWorker call;
+                if (!prepareConcurrent(call)) {
+                    return false;
+                }
+                
+                CMyComPtr<DecoderImpl> selfPtr(this);
+                _concurrentCalls.push(&call);
+                
+                LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+                bool opened = false;
+                try {
+                    call.stream->open();
+                    if ((opened = (!call.openCallback || call.openCallback->open()))) {
+                        if (call.openCallback) {
+                            applySettings(call.openCallback->archive(), call.type, call.numberOfThreads);
+                        }
+                        _stats->join();
+                        call.extractCallback->process(static_cast<ARGS &&>(args)...);
+                    }
+                } catch (...) {
+                    LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
+                    finishConcurrent(call);
+                    throw;
+                }
+                LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
+                finishConcurrent(call);
+                return opened;
+            }
+#endif
+            
+            if (_sequentialStreamRead) {
+                throw Exception(plzma_error_code_invalid_arguments, "The sequential input stream has already been read.", __FILE__, __LINE__);
+            }
             
             CMyComPtr<DecoderImpl> selfPtr(this);
             
-#if defined(LIBPLZMA_NO_PROGRESS)
-#  if defined(LIBPLZMA_NO_CRYPTO)
-            CMyComPtr<ExtractCallback> extractCallback(new ExtractCallback(_openCallback->archive(), _type));
-#  else
-            CMyComPtr<ExtractCallback> extractCallback(new ExtractCallback(_openCallback->archive(), _password, _type));
-#  endif
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            applySettings(_openCallback->archive(), _type, _numberOfThreads);
 #else
-            _progress->reset();
-#  if defined(LIBPLZMA_NO_CRYPTO)
-            CMyComPtr<ExtractCallback> extractCallback(new ExtractCallback(_openCallback->archive(), _progress, _type));
-#  else
-            CMyComPtr<ExtractCallback> extractCallback(new ExtractCallback(_openCallback->archive(), _password, _progress, _type));
-#  endif
+            if (_concurrentCalls.count() == 0) { // the settings of the shared archive are not modified during the concurrent calls
+                applySettings(_openCallback->archive(), _type, _numberOfThreads);
+            }
+#endif
+            _sequentialStreamRead = _stream->sequential();
+            
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+            if (_extractInParallel && prepareParallel(args...)) {
+                LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+                processParallel();
+                return true;
+            }
 #endif
+            
+            CMyComPtr<ExtractCallback> extractCallback(createExtractCallback());
             _extractCallback = extractCallback;
             
             LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
@@ -125,16 +249,31 @@ namespace plzma {
         virtual void setPassword(const wchar_t * LIBPLZMA_NULLABLE password) override final;
         virtual void setPassword(const char * LIBPLZMA_NULLABLE password) override final;
         virtual void setProgressDelegate(ProgressDelegate * LIBPLZMA_NULLABLE delegate) override final;
+        virtual uint32_t numberOfThreads() const override final;
+        virtual void setNumberOfThreads(const uint32_t threads) override final;
+        virtual bool shouldExtractInParallel() const override final;
+        virtual void setShouldExtractInParallel(const bool parallel) override final;
+        virtual void setBlockCache(const SharedPtr<BlockCache> & cache) override final;
         virtual bool open() override final;
         virtual void abort() override final;
         virtual plzma_size_t count() const override final;
         virtual SharedPtr<ItemArray> items() const override final;
         virtual SharedPtr<Item> itemAt(const plzma_size_t index) const override final;
+        virtual SharedPtr<ItemTable> itemTable() const override final;
+        virtual SharedPtr<Item> findItem(const Path & path) const override final;
+        virtual SharedPtr<ItemArray> findItems(const Path & pattern) const override final;
         virtual bool extract(const Path & path, const bool usingItemsFullPath = true) override final;
         virtual bool extract(const SharedPtr<ItemArray> & items,
                              const Path & path,
                              const bool usingItemsFullPath = true) override final;
         virtual bool extract(const SharedPtr<ItemOutStreamArray> & items) override final;
+        virtual bool extractToArena(const SharedPtr<ItemArray> & items) override final;
+        virtual const void * LIBPLZMA_NULLABLE arena() const override final;
+        virtual uint64_t arenaSize() const override final;
+        virtual plzma_size_t arenaViewsCount() const override final;
+        virtual plzma_arena_view arenaViewAt(const plzma_size_t index) const override final;
+        virtual plzma_stats stats() const override final;
+        virtual SharedPtr<ItemStream> openItemStream(const SharedPtr<Item> & item) override final;
         virtual bool test(const SharedPtr<ItemArray> & items) override final;
         virtual bool test() override final;
         
@@ -149,6 +288,48 @@ namespace plzma {
         virtual ~DecoderImpl();
     };
     
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    class ItemStreamImpl final : public ItemStream {
+    private:
+        friend struct SharedPtr<ItemStreamImpl>;
+        LIBPLZMA_MUTEX(mutable _mutex)
+        LIBPLZMA_MUTEX(_readMutex) // serializes reading and closing
+        CStreamBinder _binder;
+        CMyComPtr<ISequentialInStream> _reader;
+        SharedPtr<DecoderImpl> _decoder;
+        CMyComPtr<ExtractCallback> _extractCallback;
+        SharedPtr<Item> _item;
+        SharedPtr<OutStream> _pipe;
+        NWindows::CThread _thread;
+        Exception * _exception = nullptr;
+        uint64_t _position = 0;
+        plzma_size_t _referenceCounter = 0;
+        bool _closed = false;
+        
+        virtual void retain() override final;
+        virtual void release() override final;
+        
+        void run() noexcept;
+        void finish();
+        static THREAD_FUNC_DECL decodeThread(void * stream);
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(ItemStreamImpl)
+        
+    public:
+        virtual SharedPtr<Item> item() const override final;
+        virtual uint64_t position() const override final;
+        virtual plzma_size_t read(void * LIBPLZMA_NONNULL buffer, const plzma_size_t size) override final;
+        virtual void close() override final;
+        
+        /// @brief Starts the decoding thread of the item with the extract callback of the decoder.
+        void start(const CMyComPtr<ExtractCallback> & extractCallback);
+        
+        ItemStreamImpl(SharedPtr<DecoderImpl> && decoder, const SharedPtr<Item> & item);
+        virtual ~ItemStreamImpl() noexcept;
+    };
+#endif
+    
 } // namespace plzma
 
 #endif // !__PLZMA_DECODER_IMPL_HPP__
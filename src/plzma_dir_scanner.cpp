@@ -0,0 +1,245 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#include <cstddef>
+
+#include "plzma_dir_scanner.hpp"
+
+#if defined(LIBPLZMA_HAVE_DIR_SCANNER)
+
+#include "plzma_path_utils.hpp"
+
+#include <fcntl.h>
+
+namespace plzma {
+    
+    using namespace pathUtils;
+    
+    void DirScanner::enqueue(Node * node) {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        _queue.push(node);
+        try {
+            _nodes.push(node); // owns from now
+        } catch (...) {
+            _queue.pop();
+            throw;
+        }
+        _unfinished++;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        _queued.Release();
+    }
+    
+    void DirScanner::read(Node * node) {
+        const int fd = ::openat(_rootFd, (node->path.count() > 0) ? node->path.utf8() : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd == -1) {
+            return; // not readable, skipped as via the iterator
+        }
+        RAIIDIR dir;
+        if ( !(dir.dir = ::fdopendir(fd)) ) {
+            ::close(fd);
+            return;
+        }
+        
+        struct dirent * d;
+        struct stat statbuf;
+        while ((d = ::readdir(dir.dir))) {
+            if ((::strcmp(d->d_name, ".") == 0) || (::strcmp(d->d_name, "..") == 0)) { continue; }
+            bool isDir = false, isFile = false, hasStat = false;
+            switch (d->d_type) {
+                case DT_DIR: isDir = true; break;
+                case DT_REG: isFile = true; break;
+                case DT_LNK: isDir = (_mode & plzma_open_dir_mode_follow_symlinks) != 0; break; // the links to files are skipped via the iterator
+                case DT_UNKNOWN:
+                    if (::fstatat(fd, d->d_name, &statbuf, 0) == 0) {
+                        hasStat = true;
+                        isDir = S_ISDIR(statbuf.st_mode);
+                        isFile = S_ISREG(statbuf.st_mode);
+                    }
+                    break;
+                default: break;
+            }
+            if (!isDir && !isFile) { continue; }
+            
+            Entry entry;
+            if (node->path.count() > 0) {
+                entry.file.path = node->path;
+                entry.file.path.append(d->d_name);
+            } else {
+                entry.file.path.set(d->d_name);
+            }
+            if (isFile) {
+                if (hasStat || ::fstatat(fd, d->d_name, &statbuf, 0) == 0) {
+                    entry.file.stat.timestamp.creation = statbuf.st_ctime;
+                    entry.file.stat.timestamp.last_access = statbuf.st_atime;
+                    entry.file.stat.timestamp.last_modification = statbuf.st_mtime;
+                    entry.file.stat.size = static_cast<uint64_t>(statbuf.st_size);
+                }
+            } else {
+                Node * subNode = new Node();
+                subNode->path = static_cast<Path &&>(entry.file.path);
+                entry.dir = subNode;
+                try {
+                    enqueue(subNode);
+                } catch (...) {
+                    delete subNode;
+                    throw;
+                }
+            }
+            node->entries.push(static_cast<Entry &&>(entry));
+        }
+    }
+    
+    void DirScanner::finish(Exception * exception) noexcept {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        if (_done) {
+            delete exception;
+            return;
+        }
+        _done = true;
+        _exception = exception;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        _queued.Release(_workersCount); // wake up the waiting workers
+    }
+    
+    void DirScanner::run() noexcept {
+        while (_queued.Lock() == 0) {
+            LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+            if (_done) {
+                return;
+            }
+            Node * node = _queue.at(_queue.count() - 1); // depth-first
+            _queue.pop();
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            
+            try {
+                read(node);
+            } catch (const Exception & e) {
+                finish(e.moveToHeapCopy());
+                return;
+            }
+#if defined(LIBPLZMA_HAVE_STD)
+            catch (const std::exception & e) {
+                finish(Exception::create(plzma_error_code_internal, e.what(), __FILE__, __LINE__));
+                return;
+            }
+#endif
+            catch (...) {
+                finish(Exception::create(plzma_error_code_unknown, "Can't read the directory.", __FILE__, __LINE__));
+                return;
+            }
+            
+            LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
+            if (--_unfinished == 0) {
+                LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+                finish();
+                return;
+            }
+        }
+        finish(Exception::create(plzma_error_code_internal, "Can't wait for the directory.", __FILE__, __LINE__));
+    }
+    
+    THREAD_FUNC_DECL DirScanner::workerThread(void * scanner) {
+        static_cast<DirScanner *>(scanner)->run();
+        return THREAD_FUNC_RET_ZERO;
+    }
+    
+    void DirScanner::collect(Node * node, Vector<File> & files) {
+        for (plzma_size_t i = 0, n = node->entries.count(); i < n; i++) {
+            Entry & entry = node->entries.at(i);
+            if (entry.dir) {
+                collect(entry.dir, files);
+            } else {
+                files.push(static_cast<File &&>(entry.file));
+            }
+        }
+    }
+    
+    Vector<DirScanner::File> DirScanner::scan(const uint32_t workersCount) {
+        const char * rootUtf8 = (_root.count() > 0) ? _root.utf8() : ".";
+        if ((_rootFd = ::open(rootUtf8, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) == -1) {
+            Exception exception(plzma_error_code_io, nullptr, __FILE__, __LINE__);
+            exception.setWhat("Can't open and iterate path: ", _root.utf8(), nullptr);
+            exception.setReason("Path not found or not a directory.", nullptr);
+            throw exception;
+        }
+        if (_queued.Create(0, 0x7FFFFFFF) != 0) {
+            throw Exception(plzma_error_code_internal, "Can't create the semaphore.", __FILE__, __LINE__);
+        }
+        _workersCount = (workersCount > 0) ? workersCount : 1;
+        
+        Node * root = new Node();
+        try {
+            enqueue(root);
+        } catch (...) {
+            delete root;
+            throw;
+        }
+        
+        NWindows::CThread * threads = new NWindows::CThread[_workersCount];
+        for (uint32_t w = 1; w < _workersCount; w++) {
+            threads[w].Create(DirScanner::workerThread, this); // the failed worker's nodes are read by others
+        }
+        run();
+        for (uint32_t w = 1; w < _workersCount; w++) {
+            if (threads[w].IsCreated()) {
+                threads[w].Wait_Close();
+            }
+        }
+        delete [] threads;
+        
+        if (_exception) {
+            Exception localException(static_cast<Exception &&>(*_exception));
+            delete _exception;
+            _exception = nullptr;
+            throw localException;
+        }
+        
+        Vector<File> files;
+        collect(root, files);
+        return files;
+    }
+    
+    DirScanner::DirScanner(const Path & root, const plzma_open_dir_mode_t mode) :
+        _root(root),
+        _mode(mode) {
+        
+    }
+    
+    DirScanner::~DirScanner() noexcept {
+        for (plzma_size_t i = 0, n = _nodes.count(); i < n; i++) {
+            delete _nodes.at(i);
+        }
+        delete _exception;
+        if (_rootFd != -1) {
+            ::close(_rootFd);
+        }
+    }
+    
+} // namespace plzma
+
+#endif // LIBPLZMA_HAVE_DIR_SCANNER
@@ -0,0 +1,109 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef __PLZMA_DIR_SCANNER_HPP__
+#define __PLZMA_DIR_SCANNER_HPP__ 1
+
+#include <cstddef>
+
+#include "../libplzma.hpp"
+#include "plzma_private.hpp"
+#include "plzma_mutex.hpp"
+
+#if defined(LIBPLZMA_POSIX) && !defined(LIBPLZMA_MINGW) && !defined(LIBPLZMA_THREAD_UNSAFE)
+#  define LIBPLZMA_HAVE_DIR_SCANNER 1
+#endif
+
+#if defined(LIBPLZMA_HAVE_DIR_SCANNER)
+
+#include "CPP/Common/Common.h"
+#include "CPP/Windows/Thread.h"
+#include "CPP/Windows/Synchronization.h"
+
+namespace plzma {
+    
+    /// @brief Collects the files of the directory tree via a few workers.
+    ///
+    /// Each directory is read by a single worker via the file descriptor relative to the root directory,
+    /// the type and stat info of the entries are received via the single 'fstatat' per entry relative to the directory.
+    /// The files are collected in the same order as via the directory iterator.
+    class DirScanner final {
+    public:
+        struct File final {
+            Path path; // relative to the root
+            plzma_path_stat stat{0, {0, 0, 0}};
+        };
+        
+    private:
+        struct Node;
+        struct Entry final {
+            File file;
+            Node * dir = nullptr; // the sub-directory or nullptr for the file
+        };
+        struct Node final {
+            Path path; // relative to the root, empty for the root
+            Vector<Entry> entries; // in the reading order
+        };
+        
+        LIBPLZMA_MUTEX(_mutex)
+        NWindows::NSynchronization::CSemaphore _queued; // the number of queued nodes
+        Vector<Node *> _nodes;
+        Vector<Node *> _queue;
+        Path _root;
+        Exception * _exception = nullptr;
+        size_t _unfinished = 0; // queued or reading nodes
+        uint32_t _workersCount = 0;
+        int _rootFd = -1;
+        plzma_open_dir_mode_t _mode = 0;
+        bool _done = false;
+        
+        void enqueue(Node * node);
+        void read(Node * node);
+        void finish(Exception * exception = nullptr) noexcept;
+        void run() noexcept;
+        static THREAD_FUNC_DECL workerThread(void * scanner);
+        static void collect(Node * node, Vector<File> & files);
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(DirScanner)
+        
+    public:
+        /// @brief Reads the directory tree.
+        /// @param workersCount The number of workers, at least 1.
+        /// @return The files of the tree.
+        /// @exception The \a Exception with \a plzma_error_code_io code in case if the root directory can't be opened.
+        Vector<File> scan(const uint32_t workersCount);
+        
+        DirScanner(const Path & root, const plzma_open_dir_mode_t mode);
+        ~DirScanner() noexcept;
+    };
+    
+} // namespace plzma
+
+#endif // LIBPLZMA_HAVE_DIR_SCANNER
+
+#endif // !__PLZMA_DIR_SCANNER_HPP__
@@ -32,13 +32,50 @@
 #include "plzma_in_streams.hpp"
 #include "plzma_common.hpp"
 #include "plzma_open_callback.hpp"
+#include "plzma_dir_scanner.hpp"
+#include "plzma_path_utils.hpp"
 #include "plzma_c_bindings_private.hpp"
 
+#include "CPP/Windows/System.h"
+
 #include <stdint.h>
 #include <limits.h>
 
 namespace plzma {
     
+    /// @brief The final archive path of the item of the updated archive or the added item.
+    struct UpdatedPath final {
+        const char * path;
+        bool renamed;
+    };
+    
+    template<>
+    struct SortComparator<UpdatedPath> {
+        static int comparator(const void * LIBPLZMA_NONNULL elementA, const void * LIBPLZMA_NONNULL elementB) noexcept {
+            return strcmp(static_cast<const UpdatedPath *>(elementA)->path, static_cast<const UpdatedPath *>(elementB)->path);
+        }
+    };
+    
+    template<>
+    struct BSearchComparator<UpdatedPath, const char *> {
+        static int comparator(const void * LIBPLZMA_NONNULL keyPtr, const void * LIBPLZMA_NONNULL element) noexcept {
+            return strcmp(*static_cast<const char * const *>(keyPtr), static_cast<const UpdatedPath *>(element)->path);
+        }
+    };
+    
+    /// @return The length of the removed or renamed path if the item's path is the same or the path is the item's directory, otherwise zero.
+    static size_t matchedUpdatePathLength(const char * LIBPLZMA_NONNULL itemPath, const Path & archivePath) {
+        const char * path = archivePath.utf8();
+        size_t length = strlen(path);
+        while (length > 1 && path[length - 1] == CLZMA_SEP_CSTR[0]) {
+            length--; // 'dir/' -> 'dir'
+        }
+        if (strncmp(itemPath, path, length) == 0 && (itemPath[length] == 0 || itemPath[length] == CLZMA_SEP_CSTR[0])) {
+            return length;
+        }
+        return 0;
+    }
+    
     void EncoderImpl::retain() {
 #if defined(LIBPLZMA_THREAD_UNSAFE)
         LIBPLZMA_RETAIN_IMPL(_m_RefCount)
@@ -79,6 +116,13 @@ namespace plzma {
             if (_result != S_OK) {
                 return _result;
             }
+            if (index < _updateItems.count()) { // copied item of the updated archive
+                const auto & item = _updateItems.at(index);
+                LIBPLZMA_SET_VALUE_TO_PTR(newData, BoolToInt(false))
+                LIBPLZMA_SET_VALUE_TO_PTR(newProperties, BoolToInt(item.archivePath.count() > 0))
+                LIBPLZMA_SET_VALUE_TO_PTR(indexInArchive, item.index)
+                return S_OK;
+            }
             LIBPLZMA_SET_VALUE_TO_PTR(newData, BoolToInt(true))
             LIBPLZMA_SET_VALUE_TO_PTR(newProperties, BoolToInt(true))
             if (indexInArchive) {
@@ -111,11 +155,26 @@ namespace plzma {
                 return _result;
             }
             NWindows::NCOM::CPropVariant prop;
+            if (index < _updateItems.count()) { // the properties of the renamed item
+                const auto & item = _updateItems.at(index);
+                if (propID != kpidPath) {
+                    return _updateCallback->archive()->GetProperty(item.index, propID, value);
+                }
+                prop = item.archivePath.wide();
+                prop.Detach(value);
+                return S_OK;
+            }
             switch (propID) {
                 case kpidIsAnti: prop = false; break;
                 case kpidPath: prop = _source.archivePath.wide(); break;
                 case kpidIsDir: prop = false; break;
-                case kpidSize: prop = _source.stat.size; break;
+                case kpidSize:
+                    if (_source.stat.size == 0 && _type == plzma_file_type_xz && _source.stream && _source.stream->sequential()) {
+                        prop = static_cast<UInt64>(static_cast<Int64>(-1)); // unknown size of the pushed content
+                    } else {
+                        prop = _source.stat.size; // the tar header of unknown size is rewritten after the content
+                    }
+                    break;
                 //case kpidAttrib: prop = dirItem.Attrib; break; // 9
                 case kpidCTime: prop = UnixTimeToFILETIME(_source.stat.timestamp.creation); break;
                 case kpidATime: prop = UnixTimeToFILETIME(_source.stat.timestamp.last_access); break;
@@ -201,6 +260,7 @@ namespace plzma {
                 _source.close();
                 switch (operationResult) {
                     case NArchive::NUpdate::NOperationResult::kOK:
+                        _stats->completeItem();
                         return S_OK;
                     default:
                         _exception = Exception::create(plzma_error_code_internal, "Item compressed with error.", __FILE__, __LINE__);
@@ -234,6 +294,11 @@ namespace plzma {
         return S_OK; // unused
     }
     
+    // ICompressProgressInfo
+    STDMETHODIMP EncoderImpl::SetRatioInfo(const UInt64 * inSize, const UInt64 * outSize) throw() {
+        return setRatioInfo(inSize, outSize);
+    }
+    
     // ICryptoGetTextPassword
     STDMETHODIMP EncoderImpl::CryptoGetTextPassword(BSTR * password) throw() {
         if (hasOption(OptionRequirePassword)) {
@@ -339,14 +404,198 @@ namespace plzma {
         }
     }
     
+    void EncoderImpl::setUpdateArchive(const SharedPtr<InStream> & stream) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_archive || _opening || _result == E_ABORT) {
+            return;
+        }
+        if (_type != plzma_file_type_7z && _type != plzma_file_type_tar) {
+            throw Exception(plzma_error_code_invalid_arguments, "Only the 7z and tar archives can be updated.", __FILE__, __LINE__);
+        }
+        auto baseStream = stream.cast<InStreamBase>();
+        if (baseStream && baseStream->sequential()) {
+            throw Exception(plzma_error_code_invalid_arguments, "The archive can't be updated from the sequential input stream.", __FILE__, __LINE__);
+        }
+        _updateStream = static_cast<SharedPtr<InStreamBase> &&>(baseStream);
+    }
+    
+    void EncoderImpl::remove(const Path & archivePath) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_archive || _opening || _result == E_ABORT) {
+            return;
+        }
+        if (archivePath.count() == 0) {
+            throw Exception(plzma_error_code_invalid_arguments, "Can't remove item with empty archive path.", __FILE__, __LINE__);
+        }
+        _removedPaths.push(archivePath);
+    }
+    
+    void EncoderImpl::rename(const Path & archivePath, const Path & newArchivePath) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_archive || _opening || _result == E_ABORT) {
+            return;
+        }
+        if (archivePath.count() == 0 || newArchivePath.count() == 0) {
+            throw Exception(plzma_error_code_invalid_arguments, "Can't rename item with empty archive path.", __FILE__, __LINE__);
+        }
+        RenamedPath renamedPath;
+        renamedPath.archivePath = archivePath;
+        renamedPath.newArchivePath = newArchivePath;
+        _renamedPaths.push(static_cast<RenamedPath &&>(renamedPath));
+    }
+    
+    bool EncoderImpl::openUpdateArchive() {
+        CMyComPtr<InStreamBase> stream(_updateStream.get());
+#if defined(LIBPLZMA_NO_CRYPTO)
+        _updateCallback = CMyComPtr<OpenCallback>(new OpenCallback(stream, _type));
+#else
+        _updateCallback = CMyComPtr<OpenCallback>(new OpenCallback(stream, _password, _type));
+#endif
+        stream->open();
+        if (!_updateCallback->open()) {
+            return false;
+        }
+        
+        // The action of the existing item: 0 - copy, PLZMA_SIZE_T_MAX - remove, otherwise the rename index + 1.
+        // The directory operations are applied to all items with the directory's path prefix, the duplicated paths are all matched.
+        const plzma_size_t count = _updateCallback->itemsCount();
+        RawHeapMemory actionsMemory(sizeof(plzma_size_t) * (count > 0 ? count : 1));
+        plzma_size_t * actions = actionsMemory;
+        memset(actions, 0, sizeof(plzma_size_t) * count);
+        ItemTableImpl table(_updateCallback->archive(), count);
+        for (plzma_size_t i = 0, n = _removedPaths.count(); i < n; i++) {
+            bool found = false;
+            for (plzma_size_t index = 0; index < count; index++) {
+                if (matchedUpdatePathLength(table.pathAt(index), _removedPaths.at(i)) > 0) {
+                    actions[index] = PLZMA_SIZE_T_MAX;
+                    found = true;
+                }
+            }
+            if (!found) {
+                throwUpdateItemNotFound(_removedPaths.at(i));
+            }
+        }
+        for (plzma_size_t i = 0, n = _renamedPaths.count(); i < n; i++) {
+            bool found = false;
+            for (plzma_size_t index = 0; index < count; index++) {
+                if (matchedUpdatePathLength(table.pathAt(index), _renamedPaths.at(i).archivePath) > 0) {
+                    if (actions[index] == 0) {
+                        actions[index] = i + 1;
+                    }
+                    found = true;
+                }
+            }
+            if (!found) {
+                throwUpdateItemNotFound(_renamedPaths.at(i).archivePath);
+            }
+        }
+        
+        // The not renamed existing items with the archive paths of the added items are replaced.
+        Vector<UpdatedPath> addedPaths(static_cast<plzma_size_t>(_files.count() + _streams.count()));
+        for (plzma_size_t i = 0, n = _subDirs.count(); i < n; i++) {
+            const auto & files = _subDirs.at(i).files;
+            for (plzma_size_t f = 0, fn = files.count(); f < fn; f++) {
+                addedPaths.push(UpdatedPath{files.at(f).archivePath.utf8(), false});
+            }
+        }
+        for (plzma_size_t i = 0, n = _files.count(); i < n; i++) {
+            addedPaths.push(UpdatedPath{_files.at(i).archivePath.utf8(), false});
+        }
+        for (plzma_size_t i = 0, n = _streams.count(); i < n; i++) {
+            addedPaths.push(UpdatedPath{_streams.at(i).archivePath.utf8(), false});
+        }
+        addedPaths.sort();
+        for (plzma_size_t index = 0; index < count; index++) {
+            if (actions[index] == 0 && addedPaths.bsearch<const char *>(table.pathAt(index))) {
+                actions[index] = PLZMA_SIZE_T_MAX;
+            }
+        }
+        
+        _updateItems = Vector<UpdatedItem>(count);
+        for (plzma_size_t i = 0; i < count; i++) {
+            if (actions[i] != PLZMA_SIZE_T_MAX) {
+                UpdatedItem item;
+                if (actions[i] > 0) {
+                    // The item itself or the item of the renamed directory: the new directory path + the rest of the item's path.
+                    const RenamedPath & renamedPath = _renamedPaths.at(actions[i] - 1);
+                    const char * itemPath = table.pathAt(i);
+                    const char * rest = itemPath + matchedUpdatePathLength(itemPath, renamedPath.archivePath);
+                    item.archivePath = renamedPath.newArchivePath;
+                    while (*rest == CLZMA_SEP_CSTR[0]) {
+                        rest++;
+                    }
+                    if (*rest) {
+                        item.archivePath.append(rest);
+                    }
+                }
+                item.index = i;
+                _updateItems.push(static_cast<UpdatedItem &&>(item));
+            }
+        }
+        
+        // The renamed items can't collide with the copied or added items, or with each other.
+        Vector<UpdatedPath> paths(static_cast<plzma_size_t>(_updateItems.count() + addedPaths.count()));
+        bool hasRenamed = false;
+        for (plzma_size_t i = 0, n = _updateItems.count(); i < n; i++) {
+            const auto & item = _updateItems.at(i);
+            const bool renamed = item.archivePath.count() > 0;
+            paths.push(UpdatedPath{renamed ? item.archivePath.utf8() : table.pathAt(item.index), renamed});
+            hasRenamed |= renamed;
+        }
+        if (hasRenamed) {
+            for (plzma_size_t i = 0, n = addedPaths.count(); i < n; i++) {
+                paths.push(UpdatedPath{addedPaths.at(i).path, false});
+            }
+            paths.sort();
+            for (plzma_size_t i = 1, n = paths.count(); i < n; i++) {
+                const auto & prev = paths.at(i - 1);
+                const auto & path = paths.at(i);
+                if ((prev.renamed || path.renamed) && strcmp(prev.path, path.path) == 0) {
+                    Exception exception(plzma_error_code_invalid_arguments, nullptr, __FILE__, __LINE__);
+                    exception.setWhat("Can't rename the updated archive item to the existing path: ", path.path, nullptr);
+                    throw exception;
+                }
+            }
+        }
+        return true;
+    }
+    
+    void EncoderImpl::throwUpdateItemNotFound(const Path & archivePath) {
+        Exception exception(plzma_error_code_invalid_arguments, nullptr, __FILE__, __LINE__);
+        exception.setWhat("Can't find the updated archive item: ", archivePath.utf8(), nullptr);
+        throw exception;
+    }
+    
+    void EncoderImpl::closeUpdateArchive() {
+        if (_updateStream) {
+            _updateStream->close();
+        }
+    }
+    
     uint64_t EncoderImpl::processAddedPaths() {
         uint64_t itemsCount = 0;
         for (plzma_size_t i = 0, n = _paths.count(); i < n; i++) {
             AddedPath addedPath(static_cast<AddedPath &&>(_paths.at(i))); // move -> no longer needed
             Path rootArchivePath = addedPath.archivePath.count() > 0 ? addedPath.archivePath : static_cast<Path &&>(addedPath.path.lastComponent());
             if (addedPath.isDir) {
-                auto it = addedPath.path.openDir(addedPath.openDirMode);
                 AddedSubDir subDir;
+#if defined(LIBPLZMA_HAVE_DIR_SCANNER)
+                const uint32_t workersCount = (_numberOfThreads > 0) ? _numberOfThreads : static_cast<uint32_t>(NWindows::NSystem::GetNumberOfProcessors());
+                DirScanner scanner(addedPath.path, addedPath.openDirMode);
+                Vector<DirScanner::File> files(scanner.scan(workersCount));
+                subDir.files = Vector<AddedFile>(files.count());
+                for (plzma_size_t f = 0, fn = files.count(); f < fn; f++) {
+                    DirScanner::File & file = files.at(f);
+                    AddedFile item;
+                    item.path = static_cast<Path &&>(file.path);
+                    item.archivePath = rootArchivePath;
+                    item.archivePath.append(item.path);
+                    item.stat = file.stat;
+                    subDir.files.push(static_cast<AddedFile &&>(item));
+                    itemsCount++;
+                }
+#else
+                auto it = addedPath.path.openDir(addedPath.openDirMode);
                 while (it->next()) {
                     if (!it->isDir()) { // sub-file -> root + iterator path
                         AddedFile item;
@@ -358,6 +607,7 @@ namespace plzma {
                         itemsCount++;
                     }
                 }
+#endif
                 if (subDir.files.count() > 0) {
                     subDir.path = static_cast<Path &&>(addedPath.path);
                     _subDirs.push(static_cast<AddedSubDir &&>(subDir));
@@ -382,6 +632,12 @@ namespace plzma {
         _source.close();
         _source.itemIndex = index;
         
+        const UInt32 updateCount = _updateItems.count();
+        if (index < updateCount) {
+            return S_OK; // copied item of the updated archive, without source
+        }
+        index -= updateCount;
+        
         for (plzma_size_t i = 0, n = _subDirs.count(); i < n; i++) {
             const auto & subDir = _subDirs.at(i);
             const UInt32 count = subDir.files.count();
@@ -413,7 +669,7 @@ namespace plzma {
             HRESULT res = S_OK;
             _source.stream = stream.stream;
             _source.archivePath = stream.archivePath;
-            if (stream.stat.size == 0) {
+            if (stream.stat.size == 0 && !stream.stream->sequential()) {
                 stream.stream->open();
                 UInt64 pos = 0;
                 res = stream.stream->Seek(0, SZ_SEEK_END, &pos);
@@ -430,11 +686,94 @@ namespace plzma {
         return E_FAIL;
     }
 
+    static void asciiToPropVariant(const char * string, NWindows::NCOM::CPropVariant & prop) {
+        wchar_t wideString[32];
+        size_t i = 0;
+        do {
+            wideString[i] = static_cast<wchar_t>(string[i]);
+        } while (string[i++]);
+        prop = wideString;
+    }
+    
+    static void sizeToPropVariant(const uint64_t size, NWindows::NCOM::CPropVariant & prop) {
+        // The size properties are parsed as strings, the numeric value is a power of two.
+        char sizeString[32];
+        snprintf(sizeString, 32, "%llub", static_cast<unsigned long long>(size));
+        asciiToPropVariant(sizeString, prop);
+    }
+    
+    static const UInt32 kMethodSettingsMaxCount = 8;
+    
+    UInt32 EncoderImpl::methodSettings(const wchar_t ** names, NWindows::NCOM::CPropVariant * values) const {
+        static const wchar_t * matchFinders[7] = { nullptr, L"bt2", L"bt3", L"bt4", L"bt5", L"hc4", L"hc5" };
+        UInt32 count = 0;
+        if (_methodProperties.dictionary_size > 0) {
+            names[count] = L"d";
+            sizeToPropVariant(_methodProperties.dictionary_size, values[count++]);
+        }
+        if (_methodProperties.block_size > 0) {
+            names[count] = L"c";
+            sizeToPropVariant(_methodProperties.block_size, values[count++]);
+        }
+        if (_methodProperties.word_size > 0) {
+            names[count] = L"fb";
+            values[count++] = static_cast<UInt32>(_methodProperties.word_size);
+        }
+        if (_methodProperties.match_finder_cycles > 0) {
+            names[count] = L"mc";
+            values[count++] = static_cast<UInt32>(_methodProperties.match_finder_cycles);
+        }
+        if (_methodProperties.match_finder != plzma_match_finder_default) {
+            names[count] = L"mf";
+            values[count++] = matchFinders[_methodProperties.match_finder];
+        }
+        if (_methodProperties.literal_context_bits >= 0) {
+            names[count] = L"lc";
+            values[count++] = static_cast<UInt32>(_methodProperties.literal_context_bits);
+        }
+        if (_methodProperties.literal_position_bits >= 0) {
+            names[count] = L"lp";
+            values[count++] = static_cast<UInt32>(_methodProperties.literal_position_bits);
+        }
+        if (_methodProperties.position_bits >= 0) {
+            names[count] = L"pb";
+            values[count++] = static_cast<UInt32>(_methodProperties.position_bits);
+        }
+        return count;
+    }
+    
+    static const UInt32 kFilterSettingsMaxCount = 1;
+    
+    UInt32 EncoderImpl::filterSettings(const wchar_t ** names, NWindows::NCOM::CPropVariant * values) const {
+        static const wchar_t * filters[12] = {
+            nullptr, nullptr, L"BCJ", L"BCJ2", L"ARM64", L"ARM", L"ARMT", L"PPC", L"SPARC", L"IA64", L"RISCV", L"Delta"
+        };
+        switch (_filter) {
+            case plzma_filter_auto:
+                return 0;
+            case plzma_filter_none:
+                names[0] = L"f";
+                values[0] = false; // disable automatic selection
+                return 1;
+            case plzma_filter_Delta: {
+                char delta[16];
+                snprintf(delta, 16, "Delta:%u", static_cast<unsigned int>(_filterDeltaDistance));
+                names[0] = L"f";
+                asciiToPropVariant(delta, values[0]);
+                return 1;
+            }
+            default:
+                names[0] = L"f";
+                values[0] = filters[_filter];
+                return 1;
+        }
+    }
+    
     void EncoderImpl::applySettings7z(ISetProperties * properties) {
         using namespace NWindows::NCOM;
         
-        static const UInt32 settingsCount = 9;
-        static const wchar_t * names[settingsCount] = {
+        static const UInt32 settingsCount = 10;
+        const wchar_t * names[settingsCount + kMethodSettingsMaxCount + kFilterSettingsMaxCount] = {
             L"0",   // method
             L"s",   // solid
             L"x",   // compression level
@@ -443,6 +782,7 @@ namespace plzma {
             L"tc",  // write creation time
             L"ta",  // write access time
             L"tm",  // write modification time
+            L"mt",  // number of threads
             
             L"hcf"  // compress header full, true - add, false - don't add/ignore
         };
@@ -460,7 +800,7 @@ namespace plzma {
         }
 #endif
         
-        CPropVariant values[settingsCount] = {
+        CPropVariant values[settingsCount + kMethodSettingsMaxCount + kFilterSettingsMaxCount] = {
             CPropVariant(static_cast<UInt32>(0)),                           // method dummy value
             
             CPropVariant((_options & OptionSolid) ? true : false),          // solid mode ON
@@ -470,6 +810,7 @@ namespace plzma {
             CPropVariant((_options & OptionStoreCTime) ? true : false),     // write creation time
             CPropVariant((_options & OptionStoreATime) ? true : false),     // write access time
             CPropVariant((_options & OptionStoreMTime) ? true : false),     // write modification time
+            (_numberOfThreads > 0) ? CPropVariant(static_cast<UInt32>(_numberOfThreads)) : CPropVariant(true), // number of threads, 'true' - hardware threads
             
             CPropVariant(true)                                              // compress header full, true - add, false - don't add/ignore
         };
@@ -481,9 +822,13 @@ namespace plzma {
             default: break;
         }
         
-        const HRESULT res = properties->SetProperties(names,
-                                                      values,
-                                                      (_options & OptionCompressHeaderFull) ? settingsCount : (settingsCount - 1));
+        UInt32 count = (_options & OptionCompressHeaderFull) ? settingsCount : (settingsCount - 1);
+        if (_method != plzma_method_PPMd) {
+            count += methodSettings(names + count, values + count);
+        }
+        count += filterSettings(names + count, values + count);
+        
+        const HRESULT res = properties->SetProperties(names, values, count);
         if (res != S_OK) {
             throw Exception(plzma_error_code_internal, "Can't apply 7z archive properties.", __FILE__, __LINE__);
         }
@@ -492,20 +837,24 @@ namespace plzma {
     void EncoderImpl::applySettingsXz(ISetProperties * properties) {
         using namespace NWindows::NCOM;
         
-        static const UInt32 settingsCount = 3;
-        static const wchar_t * names[settingsCount] = {
+        static const UInt32 settingsCount = 4;
+        const wchar_t * names[settingsCount + kMethodSettingsMaxCount + kFilterSettingsMaxCount] = {
             L"0",   // method
             L"s",   // solid
-            L"x"    // compression level
+            L"x",   // compression level
+            L"mt"   // number of threads
         };
         
-        CPropVariant values[settingsCount] = {
+        CPropVariant values[settingsCount + kMethodSettingsMaxCount + kFilterSettingsMaxCount] = {
             CPropVariant(L"LZMA2"),                                         // method
             CPropVariant((_options & OptionSolid) ? true : false),          // solid mode ON
             CPropVariant(static_cast<UInt32>(_compressionLevel)),           // compression level = 9 - ultra
+            (_numberOfThreads > 0) ? CPropVariant(static_cast<UInt32>(_numberOfThreads)) : CPropVariant(true) // number of threads, 'true' - hardware threads
         };
         
-        const HRESULT res = properties->SetProperties(names, values, settingsCount);
+        UInt32 count = settingsCount + methodSettings(names + settingsCount, values + settingsCount);
+        count += filterSettings(names + count, values + count);
+        const HRESULT res = properties->SetProperties(names, values, count);
         if (res != S_OK) {
             throw Exception(plzma_error_code_internal, "Can't apply xz archive properties.", __FILE__, __LINE__);
         }
@@ -566,6 +915,16 @@ namespace plzma {
 
         itemsCount += _streams.count();
         
+        if (!_updateStream && (_removedPaths.count() > 0 || _renamedPaths.count() > 0)) {
+            throw Exception(plzma_error_code_invalid_arguments, "The removed or renamed items require the updated archive.", __FILE__, __LINE__);
+        }
+        if (_updateStream && _result != E_ABORT) {
+            if (!openUpdateArchive()) {
+                return false;
+            }
+            itemsCount += _updateItems.count();
+        }
+        
         if (_result == E_ABORT || itemsCount == 0) {
             return false;
         }
@@ -587,7 +946,14 @@ namespace plzma {
         
         _itemsCount = static_cast<UInt32>(itemsCount);
         _stream->open();
-        _archive = OpenCallback::createArchive<IOutArchive>(_type);
+        if (_updateCallback) {
+            CMyComPtr<IInArchive> updateArchive(_updateCallback->archive());
+            if (updateArchive.QueryInterface(IID_IOutArchive, &_archive) != S_OK || !_archive) {
+                throw Exception(plzma_error_code_internal, "Can't update the archive.", __FILE__, __LINE__);
+            }
+        } else {
+            _archive = OpenCallback::createArchive<IOutArchive>(_type);
+        }
         
         applySettings();
         
@@ -613,13 +979,21 @@ namespace plzma {
         _progress->setPartsCount(1);
         _progress->startPart();
 #endif
+        _stats->start();
+        _stats->addItemsCount(_itemsCount);
+        _ratioInSize = _ratioOutSize = 0;
         LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
         result = _archive->UpdateItems(_stream, _itemsCount, this);
         LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
         
         _compressing = false;
+        if (result == S_OK && _result == S_OK) {
+            _stats->completeAllItems(); // the directories and empty items are written without the content
+        }
+        _stats->finishPart();
         _stream->close();
         _source.close();
+        closeUpdateArchive();
         
         if (result != S_OK || _result != S_OK) {
             if (result == E_ABORT || _result == E_ABORT) {
@@ -636,18 +1010,90 @@ namespace plzma {
                 delete exception;
                 throw localException;
             }
+            if (result == E_NOTIMPL && _updateCallback) {
+                throw Exception(plzma_error_code_invalid_arguments, "The archive can't be updated.", __FILE__, __LINE__);
+            }
             throw Exception(plzma_error_code_internal, "Unknown compress error.", __FILE__, __LINE__);
         }
         
         return true;
     }
     
+    plzma_stats EncoderImpl::stats() const {
+        return _stats->snapshot(); // without locking, the counters are atomic
+    }
+    
+    SharedPtr<EncoderSession> EncoderImpl::openSession(const SharedPtr<ItemArray> & items) {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        throw Exception(plzma_error_code_invalid_arguments, "The encoder session is not supported by the thread unsafe build.", __FILE__, __LINE__);
+#else
+        if (!items || items->count() == 0) {
+            throw Exception(plzma_error_code_invalid_arguments, "No items.", __FILE__, __LINE__);
+        }
+        if (_type != plzma_file_type_xz && _type != plzma_file_type_tar) {
+            throw Exception(plzma_error_code_invalid_arguments, "The encoder session is supported only by the xz and tar archives.", __FILE__, __LINE__);
+        }
+        if (_type == plzma_file_type_xz && items->count() > 1) {
+            throw Exception(plzma_error_code_invalid_arguments, "The 'xz' type supports only one item.", __FILE__, __LINE__);
+        }
+        
+        EncoderSessionImpl * sessionImpl = new EncoderSessionImpl(SharedPtr<EncoderImpl>(this));
+        SharedPtr<EncoderSession> session(sessionImpl);
+        
+        Vector<AddedStream> streams(items->count());
+        for (plzma_size_t i = 0, n = items->count(); i < n; i++) {
+            const auto & item = items->at(i);
+            if (!item || item->path().count() == 0) {
+                throw Exception(plzma_error_code_invalid_arguments, "Can't add stream without archive path.", __FILE__, __LINE__);
+            }
+            if (_type == plzma_file_type_tar && item->size() == 0 && _stream->sequential()) {
+                Exception exception(plzma_error_code_invalid_arguments, "The tar item of unknown size requires the seekable output stream.", __FILE__, __LINE__);
+                exception.setReason("The item path: ", item->path().utf8(), nullptr);
+                throw exception;
+            }
+            CMyComPtr<ISequentialOutStream> writer;
+            SharedPtr<InStreamBase> stream(new InPipeStream(writer));
+            sessionImpl->addPipe(stream, writer);
+            AddedStream addedStream;
+            addedStream.stream = static_cast<SharedPtr<InStreamBase> &&>(stream);
+            addedStream.archivePath = item->path();
+            addedStream.stat.size = item->size();
+            addedStream.stat.timestamp = item->timestamp();
+            if (addedStream.stat.timestamp.last_modification == 0) {
+                addedStream.stat.timestamp = plzma_path_timestamp_now();
+            }
+            streams.push(static_cast<AddedStream &&>(addedStream));
+        }
+        
+        {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            if (_archive || _opening || _compressing) {
+                throw Exception(plzma_error_code_invalid_arguments, "The encoder is already opened.", __FILE__, __LINE__);
+            }
+            if (_result == E_ABORT) {
+                return SharedPtr<EncoderSession>();
+            }
+            if (_paths.count() > 0 || _streams.count() > 0) {
+                throw Exception(plzma_error_code_invalid_arguments, "The encoder of the session must not have added paths or streams.", __FILE__, __LINE__);
+            }
+            _streams = static_cast<Vector<AddedStream> &&>(streams);
+        }
+        
+        if (!open()) {
+            return SharedPtr<EncoderSession>();
+        }
+        sessionImpl->start();
+        return session;
+#endif
+    }
+    
     void EncoderImpl::abort() {
         LIBPLZMA_LOCKGUARD(lock, _mutex)
         _result = E_ABORT;
         if (!_compressing) {
             _stream->close();
             _source.close();
+            closeUpdateArchive();
         }
     }
     
@@ -692,6 +1138,107 @@ namespace plzma {
         _compressionLevel = level > 9 ? 9 : level;
     }
     
+    uint32_t EncoderImpl::numberOfThreads() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _numberOfThreads;
+    }
+    
+    void EncoderImpl::setNumberOfThreads(const uint32_t threads) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _numberOfThreads = threads;
+    }
+    
+    plzma_method_properties EncoderImpl::methodProperties() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _methodProperties;
+    }
+    
+    void EncoderImpl::setMethodProperties(const plzma_method_properties & properties) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        const plzma_method method = (_type == plzma_file_type_xz) ? plzma_method_LZMA2 : _method;
+        const int lc = (properties.literal_context_bits >= 0) ? properties.literal_context_bits : 3; // default lc3
+        const int lp = (properties.literal_position_bits >= 0) ? properties.literal_position_bits : 0; // default lp0
+        const char * reason = nullptr;
+        if (method == plzma_method_PPMd) {
+            if (properties.dictionary_size > 0 || properties.block_size > 0 || properties.word_size > 0 ||
+                properties.match_finder_cycles > 0 || properties.match_finder != plzma_match_finder_default ||
+                properties.literal_context_bits >= 0 || properties.literal_position_bits >= 0 || properties.position_bits >= 0) {
+                reason = "The PPMd method doesn't support the properties.";
+            }
+        } else if (properties.dictionary_size > 0 &&
+                   (properties.dictionary_size < (1 << 12) || properties.dictionary_size > (static_cast<uint64_t>(15) << 28))) {
+            reason = "The dictionary size is out of range [4KB; 3840MB].";
+        } else if (properties.block_size > 0 && method != plzma_method_LZMA2) {
+            reason = "The block size is supported only by the LZMA2 method.";
+        } else if (properties.block_size > 0 && properties.block_size < (1 << 12)) {
+            reason = "The block size is less than 4KB.";
+        } else if (properties.word_size > 0 && (properties.word_size < 5 || properties.word_size > 273)) {
+            reason = "The word size is out of range [5; 273].";
+        } else if (properties.match_finder_cycles > (static_cast<uint32_t>(1) << 30)) {
+            reason = "The number of match finder cycles is out of range [1; 1073741824].";
+        } else if (properties.match_finder < plzma_match_finder_default || properties.match_finder > plzma_match_finder_hc5) {
+            reason = "Unknown match finder.";
+        } else if (lc > 8 || lp > 4 || properties.position_bits > 4) {
+            reason = "The number of literal context bits is out of range [0; 8], literal position or position bits [0; 4].";
+        } else if (method == plzma_method_LZMA2 && (lc + lp) > 4) {
+            reason = "The sum of LZMA2 literal context and literal position bits is greater than 4.";
+        }
+        if (reason) {
+            Exception exception(plzma_error_code_invalid_arguments, "Can't set method properties.", __FILE__, __LINE__);
+            exception.setReason(reason, nullptr);
+            throw exception;
+        }
+        _methodProperties = properties;
+    }
+    
+    plzma_filter EncoderImpl::filter() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _filter;
+    }
+    
+    void EncoderImpl::setFilter(const plzma_filter filter) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        const char * reason = nullptr;
+        if (filter < plzma_filter_auto || filter > plzma_filter_Delta) {
+            reason = "Unknown filter.";
+        } else if (filter == plzma_filter_BCJ2 && _type == plzma_file_type_xz) {
+            reason = "The BCJ2 filter is supported only by the 7z archive.";
+        }
+#if !defined(LIBPLZMA_MULTITHREAD)
+        else if (filter == plzma_filter_BCJ2) {
+            // The single-threaded coders mixer can't encode to the multiple streams.
+            reason = "The BCJ2 filter requires the multithreaded build.";
+        }
+#endif
+        if (reason) {
+            Exception exception(plzma_error_code_invalid_arguments, "Can't set filter.", __FILE__, __LINE__);
+            exception.setReason(reason, nullptr);
+            throw exception;
+        }
+        _filter = filter;
+    }
+    
+    uint32_t EncoderImpl::filterDeltaDistance() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _filterDeltaDistance;
+    }
+    
+    void EncoderImpl::setFilterDeltaDistance(const uint32_t distance) {
+        if (distance < 1 || distance > 256) {
+            Exception exception(plzma_error_code_invalid_arguments, "Can't set filter delta distance.", __FILE__, __LINE__);
+            exception.setReason("The distance is out of range [1; 256].", nullptr);
+            throw exception;
+        }
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _filterDeltaDistance = distance;
+    }
+    
+    plzma_method_properties EncoderImpl::defaultMethodProperties() noexcept {
+        // All properties are defined by the compression level.
+        const plzma_method_properties properties = { 0, 0, 0, 0, plzma_match_finder_default, -1, -1, -1 };
+        return properties;
+    }
+    
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
     void EncoderImpl::setUtf8Callback(plzma_progress_delegate_utf8_callback LIBPLZMA_NULLABLE callback) {
 #if !defined(LIBPLZMA_NO_PROGRESS)
@@ -717,6 +1264,7 @@ namespace plzma {
 #if !defined(LIBPLZMA_NO_PROGRESS)
             _progress = makeShared<Progress>(context);
 #endif
+            _stats = makeShared<Stats>();
             // docs
             _options |= (OptionSolid | OptionCompressHeader | OptionCompressHeaderFull);
             _options |= (OptionStoreCTime | OptionStoreMTime | OptionStoreATime);
@@ -725,7 +1273,168 @@ namespace plzma {
     EncoderImpl::~EncoderImpl() {
         _stream->close();
         _source.close();
+        closeUpdateArchive();
+    }
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    void EncoderSessionImpl::retain() {
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+    
+    void EncoderSessionImpl::release() {
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+    
+    void EncoderSessionImpl::run() noexcept {
+        bool compressed = false;
+        Exception * exception = nullptr;
+        try {
+            compressed = _encoder->compress();
+        } catch (const Exception & e) {
+            exception = e.moveToHeapCopy();
+        }
+#if defined(LIBPLZMA_HAVE_STD)
+        catch (const std::exception & e) {
+            exception = Exception::create(plzma_error_code_internal, e.what(), __FILE__, __LINE__);
+        }
+#endif
+        catch (...) {
+            exception = Exception::create(plzma_error_code_unknown, "Can't compress the session items.", __FILE__, __LINE__);
+        }
+        
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        // The pending and next writes are cut, even if the items weren't read.
+        for (plzma_size_t i = 0, n = _pipes.count(); i < n; i++) {
+            static_cast<InPipeStream *>(_pipes.at(i).stream.get())->closeReader();
+        }
+        _compressed = compressed;
+        _exception = exception;
+    }
+    
+    THREAD_FUNC_DECL EncoderSessionImpl::compressThread(void * session) {
+        static_cast<EncoderSessionImpl *>(session)->run();
+        return THREAD_FUNC_RET_ZERO;
+    }
+    
+    void EncoderSessionImpl::addPipe(const SharedPtr<InStreamBase> & stream, const CMyComPtr<ISequentialOutStream> & writer) {
+        Pipe pipe;
+        pipe.stream = stream;
+        pipe.writer = writer;
+        _pipes.push(static_cast<Pipe &&>(pipe));
+    }
+    
+    void EncoderSessionImpl::start() {
+        if (_thread.Create(EncoderSessionImpl::compressThread, this) != 0) {
+            throw Exception(plzma_error_code_internal, "Can't create the encoder session thread.", __FILE__, __LINE__);
+        }
+    }
+    
+    void EncoderSessionImpl::endItems(const plzma_size_t count) noexcept {
+        Vector<CMyComPtr<ISequentialOutStream> > writers;
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        for (; _itemIndex < count && _itemIndex < _pipes.count(); _itemIndex++) {
+            CMyComPtr<ISequentialOutStream> & writer = _pipes.at(_itemIndex).writer;
+            writers.push(writer);
+            writer.Release(); // the vector's assignment copies the pointer
+        }
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        writers.clear(); // the last reference closes the writing side, the reader receives the end of the content
+    }
+    
+    bool EncoderSessionImpl::waitCompression() {
+        LIBPLZMA_LOCKGUARD(finishLock, _finishMutex)
+        if (_thread.IsCreated()) {
+            _thread.Wait_Close();
+        }
+        
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        _finished = true;
+        Exception * exception = _exception;
+        _exception = nullptr;
+        const bool compressed = _compressed;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        
+        if (exception) {
+            Exception localException(static_cast<Exception &&>(*exception));
+            delete exception;
+            throw localException;
+        }
+        return compressed;
+    }
+    
+    bool EncoderSessionImpl::write(const void * LIBPLZMA_NONNULL data, const plzma_size_t size) {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        if (_finished || _itemIndex >= _pipes.count()) {
+            throw Exception(plzma_error_code_invalid_arguments, "No item to write.", __FILE__, __LINE__);
+        }
+        CMyComPtr<ISequentialOutStream> writer(_pipes.at(_itemIndex).writer);
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        
+        const Byte * chunk = static_cast<const Byte *>(data);
+        plzma_size_t remaining = size;
+        HRESULT res = S_OK;
+        while (remaining > 0 && res == S_OK) {
+            UInt32 processedSize = 0;
+            res = writer->Write(chunk, static_cast<UInt32>(remaining), &processedSize);
+            chunk += processedSize;
+            remaining -= processedSize;
+        }
+        if (res == S_OK) {
+            return true;
+        }
+        
+        // The writing was cut, the compression is finished or aborted, the result is known after the thread is finished.
+        writer.Release();
+        endItems(_pipes.count());
+        if (waitCompression()) {
+            throw Exception(plzma_error_code_internal, "The encoder didn't read the whole item content.", __FILE__, __LINE__);
+        }
+        return false;
+    }
+    
+    void EncoderSessionImpl::nextItem() {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        const plzma_size_t count = _itemIndex + 1;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        endItems(count);
+    }
+    
+    bool EncoderSessionImpl::finish() {
+        endItems(_pipes.count());
+        return waitCompression();
+    }
+    
+    void EncoderSessionImpl::abort() {
+        _encoder->abort();
+        endItems(_pipes.count());
+        try {
+            waitCompression();
+        } catch (...) {
+            // aborted, the compression result is no longer needed
+        }
+    }
+    
+    EncoderSessionImpl::EncoderSessionImpl(SharedPtr<EncoderImpl> && encoder) :
+        _encoder(static_cast<SharedPtr<EncoderImpl> &&>(encoder)) {
+        
+    }
+    
+    EncoderSessionImpl::~EncoderSessionImpl() noexcept {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        const bool finished = _finished;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        if (!finished && _thread.IsCreated()) {
+            abort();
+        }
+        delete _exception;
+        _exception = nullptr;
+        
+        // The writers are released before the pipes.
+        for (plzma_size_t i = 0, n = _pipes.count(); i < n; i++) {
+            _pipes.at(i).writer.Release();
+        }
     }
+#endif
     
     SharedPtr<Encoder> makeSharedEncoder(const SharedPtr<OutStream> & stream,
                                          const plzma_file_type type,
@@ -733,6 +1442,9 @@ namespace plzma {
                                          const plzma_context context) {
         auto baseStream = stream.cast<OutStreamBase>();
         if (baseStream) {
+            if (type == plzma_file_type_7z && baseStream->sequential()) {
+                throw Exception(plzma_error_code_invalid_arguments, "The 7z archive requires the seekable output stream.", __FILE__, __LINE__);
+            }
             return SharedPtr<Encoder>(new EncoderImpl(CMyComPtr<OutStreamBase>(baseStream.get()), type, method, context));
         }
         throw Exception(plzma_error_code_invalid_arguments, "No output stream.", __FILE__, __LINE__);
@@ -842,6 +1554,54 @@ void plzma_encoder_set_compression_level(plzma_encoder * LIBPLZMA_NONNULL encode
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
 }
 
+uint32_t plzma_encoder_number_of_threads(plzma_encoder * LIBPLZMA_NONNULL encoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, 0)
+    return static_cast<EncoderImpl *>(encoder->object)->numberOfThreads();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(encoder, 0)
+}
+
+void plzma_encoder_set_number_of_threads(plzma_encoder * LIBPLZMA_NONNULL encoder, const uint32_t threads) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(encoder)
+    static_cast<EncoderImpl *>(encoder->object)->setNumberOfThreads(threads);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
+plzma_method_properties plzma_encoder_method_properties(plzma_encoder * LIBPLZMA_NONNULL encoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, EncoderImpl::defaultMethodProperties())
+    return static_cast<EncoderImpl *>(encoder->object)->methodProperties();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(encoder, EncoderImpl::defaultMethodProperties())
+}
+
+void plzma_encoder_set_method_properties(plzma_encoder * LIBPLZMA_NONNULL encoder, const plzma_method_properties * LIBPLZMA_NONNULL properties) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(encoder)
+    static_cast<EncoderImpl *>(encoder->object)->setMethodProperties(*properties);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
+plzma_filter plzma_encoder_filter(plzma_encoder * LIBPLZMA_NONNULL encoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, plzma_filter_auto)
+    return static_cast<EncoderImpl *>(encoder->object)->filter();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(encoder, plzma_filter_auto)
+}
+
+void plzma_encoder_set_filter(plzma_encoder * LIBPLZMA_NONNULL encoder, const plzma_filter filter) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(encoder)
+    static_cast<EncoderImpl *>(encoder->object)->setFilter(filter);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
+uint32_t plzma_encoder_filter_delta_distance(plzma_encoder * LIBPLZMA_NONNULL encoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, 0)
+    return static_cast<EncoderImpl *>(encoder->object)->filterDeltaDistance();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(encoder, 0)
+}
+
+void plzma_encoder_set_filter_delta_distance(plzma_encoder * LIBPLZMA_NONNULL encoder, const uint32_t distance) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(encoder)
+    static_cast<EncoderImpl *>(encoder->object)->setFilterDeltaDistance(distance);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
 bool plzma_encoder_should_compress_header(plzma_encoder * LIBPLZMA_NONNULL encoder) {
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, false)
     return static_cast<EncoderImpl *>(encoder->object)->shouldCompressHeader();
@@ -952,6 +1712,33 @@ void plzma_encoder_add_stream(plzma_encoder * LIBPLZMA_NONNULL encoder,
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
 }
 
+void plzma_encoder_set_update_archive(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                                      const plzma_in_stream * LIBPLZMA_NULLABLE stream) {
+    if (encoder->exception || (stream && stream->exception)) return;
+    try {
+        SharedPtr<InStream> streamSPtr(stream ? static_cast<InStream *>(stream->object) : nullptr);
+        static_cast<EncoderImpl *>(encoder->object)->setUpdateArchive(streamSPtr);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
+void plzma_encoder_remove(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                          const plzma_path * LIBPLZMA_NONNULL archive_path) {
+    if (encoder->exception || archive_path->exception) return;
+    try {
+        static_cast<EncoderImpl *>(encoder->object)->remove(*static_cast<const Path *>(archive_path->object));
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
+void plzma_encoder_rename(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                          const plzma_path * LIBPLZMA_NONNULL archive_path,
+                          const plzma_path * LIBPLZMA_NONNULL new_archive_path) {
+    if (encoder->exception || archive_path->exception || new_archive_path->exception) return;
+    try {
+        static_cast<EncoderImpl *>(encoder->object)->rename(*static_cast<const Path *>(archive_path->object),
+                                                            *static_cast<const Path *>(new_archive_path->object));
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(encoder)
+}
+
 bool plzma_encoder_open(plzma_encoder * LIBPLZMA_NONNULL encoder) {
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, false)
     return static_cast<EncoderImpl *>(encoder->object)->open();
@@ -970,6 +1757,12 @@ bool plzma_encoder_compress(plzma_encoder * LIBPLZMA_NONNULL encoder) {
     LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(encoder, false)
 }
 
+plzma_stats plzma_encoder_stats(plzma_encoder * LIBPLZMA_NONNULL encoder) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(encoder, (plzma_stats{0, 0, 0, 0, 0.0, 0.0}))
+    return static_cast<EncoderImpl *>(encoder->object)->stats();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(encoder, (plzma_stats{0, 0, 0, 0, 0.0, 0.0}))
+}
+
 void plzma_encoder_release(plzma_encoder * LIBPLZMA_NONNULL encoder) {
     plzma_object_exception_release(encoder);
     SharedPtr<EncoderImpl> encoderSPtr;
@@ -977,4 +1770,46 @@ void plzma_encoder_release(plzma_encoder * LIBPLZMA_NONNULL encoder) {
     encoder->object = nullptr;
 }
 
+plzma_encoder_session plzma_encoder_open_session(plzma_encoder * LIBPLZMA_NONNULL encoder,
+                                                 plzma_item_array * LIBPLZMA_NONNULL items) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_encoder_session, encoder)
+    SharedPtr<ItemArray> itemsSPtr(static_cast<ItemArray *>(items->object));
+    auto session = static_cast<EncoderImpl *>(encoder->object)->openSession(itemsSPtr);
+    createdCObject.object = static_cast<void *>(session.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+bool plzma_encoder_session_write(plzma_encoder_session * LIBPLZMA_NONNULL session,
+                                 const void * LIBPLZMA_NONNULL data,
+                                 const plzma_size_t size) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(session, false)
+    return static_cast<EncoderSession *>(session->object)->write(data, size);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(session, false)
+}
+
+void plzma_encoder_session_next_item(plzma_encoder_session * LIBPLZMA_NONNULL session) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(session)
+    static_cast<EncoderSession *>(session->object)->nextItem();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(session)
+}
+
+bool plzma_encoder_session_finish(plzma_encoder_session * LIBPLZMA_NONNULL session) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(session, false)
+    return static_cast<EncoderSession *>(session->object)->finish();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(session, false)
+}
+
+void plzma_encoder_session_abort(plzma_encoder_session * LIBPLZMA_NONNULL session) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY(session)
+    static_cast<EncoderSession *>(session->object)->abort();
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH(session)
+}
+
+void plzma_encoder_session_release(plzma_encoder_session * LIBPLZMA_NONNULL session) {
+    plzma_object_exception_release(session);
+    SharedPtr<EncoderSession> sessionSPtr;
+    sessionSPtr.assign(static_cast<EncoderSession *>(session->object));
+    session->object = nullptr;
+}
+
 #endif // !LIBPLZMA_NO_C_BINDINGS
@@ -35,6 +35,7 @@
 #include "plzma_in_streams.hpp"
 #include "plzma_out_streams.hpp"
 #include "plzma_open_callback.hpp"
+#include "plzma_item_table.hpp"
 #include "plzma_extract_callback.hpp"
 #include "plzma_common.hpp"
 
@@ -48,10 +49,15 @@
 #include "CPP/7zip/ICoder.h"
 #include "CPP/Windows/PropVariant.h"
 
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+#include "CPP/Windows/Thread.h"
+#endif
+
 namespace plzma {
     
     class EncoderImpl final :
         public IArchiveUpdateCallback2,
+        public ICompressProgressInfo,
         public ICryptoGetTextPassword,
         public ICryptoGetTextPassword2,
         public Encoder,
@@ -97,6 +103,19 @@ namespace plzma {
         Vector<AddedSubDir> _subDirs;
         Vector<AddedFile> _files;
         Vector<AddedStream> _streams;
+        struct RenamedPath final {
+            Path archivePath;
+            Path newArchivePath;
+        };
+        struct UpdatedItem final {
+            Path archivePath; // the new path of the renamed item, otherwise empty
+            UInt32 index;
+        };
+        SharedPtr<InStreamBase> _updateStream;
+        CMyComPtr<OpenCallback> _updateCallback;
+        Vector<Path> _removedPaths;
+        Vector<RenamedPath> _renamedPaths;
+        Vector<UpdatedItem> _updateItems; // the copied items of the updated archive
         struct Source final {
             Path path;
             Path archivePath;
@@ -116,6 +135,10 @@ namespace plzma {
         plzma_method _method = plzma_method_LZMA;
         UInt32 _itemsCount = 0;
         uint16_t _options = 0;
+        plzma_method_properties _methodProperties = defaultMethodProperties();
+        uint32_t _numberOfThreads = 0;
+        uint32_t _filterDeltaDistance = 1;
+        plzma_filter _filter = plzma_filter_auto;
         uint8_t _compressionLevel = 7;
         bool _opening = false;
         bool _compressing = false;
@@ -124,7 +147,12 @@ namespace plzma {
         virtual void release() override final;
         
         uint64_t processAddedPaths();
+        bool openUpdateArchive();
+        static void throwUpdateItemNotFound(const Path & archivePath);
+        void closeUpdateArchive();
         HRESULT setupSource(UInt32 index);
+        UInt32 methodSettings(const wchar_t ** names, NWindows::NCOM::CPropVariant * values) const;
+        UInt32 filterSettings(const wchar_t ** names, NWindows::NCOM::CPropVariant * values) const;
         void applySettings7z(ISetProperties * properties);
         void applySettingsXz(ISetProperties * properties);
         void applySettingsTar(ISetProperties * properties);
@@ -136,7 +164,7 @@ namespace plzma {
         LIBPLZMA_NON_COPYABLE_NON_MOVABLE(EncoderImpl)
         
     public:
-        Z7_COM_UNKNOWN_IMP_3(IArchiveUpdateCallback2, ICryptoGetTextPassword, ICryptoGetTextPassword2)
+        Z7_COM_UNKNOWN_IMP_4(IArchiveUpdateCallback2, ICompressProgressInfo, ICryptoGetTextPassword, ICryptoGetTextPassword2)
         
     public:
         // IProgress
@@ -151,6 +179,9 @@ namespace plzma {
         STDMETHOD(GetVolumeSize)(UInt32 index, UInt64 * size) throw() override final;
         STDMETHOD(GetVolumeStream)(UInt32 index, ISequentialOutStream ** volumeStream) throw() override final;
         
+        // ICompressProgressInfo
+        STDMETHOD(SetRatioInfo)(const UInt64 * inSize, const UInt64 * outSize) throw() override final;
+        
         // ICryptoGetTextPassword
         STDMETHOD(CryptoGetTextPassword)(BSTR * password) throw() override final;
         
@@ -162,13 +193,26 @@ namespace plzma {
         virtual void setProgressDelegate(ProgressDelegate * delegate) override final;
         virtual void add(const Path & path, const plzma_open_dir_mode_t openDirMode = 0, const Path & archivePath = Path()) override final;
         virtual void add(const SharedPtr<InStream> & stream, const Path & archivePath) override final;
+        virtual void setUpdateArchive(const SharedPtr<InStream> & stream) override final;
+        virtual void remove(const Path & archivePath) override final;
+        virtual void rename(const Path & archivePath, const Path & newArchivePath) override final;
         virtual bool open() override final;
         virtual void abort() override final;
         virtual bool compress() override final;
+        virtual plzma_stats stats() const override final;
+        virtual SharedPtr<EncoderSession> openSession(const SharedPtr<ItemArray> & items) override final;
         virtual bool shouldCreateSolidArchive() const override final;
         virtual void setShouldCreateSolidArchive(const bool solid) override final;
         virtual uint8_t compressionLevel() const override final;
         virtual void setCompressionLevel(const uint8_t level) override final;
+        virtual uint32_t numberOfThreads() const override final;
+        virtual void setNumberOfThreads(const uint32_t threads) override final;
+        virtual plzma_method_properties methodProperties() const override final;
+        virtual void setMethodProperties(const plzma_method_properties & properties) override final;
+        virtual plzma_filter filter() const override final;
+        virtual void setFilter(const plzma_filter filter) override final;
+        virtual uint32_t filterDeltaDistance() const override final;
+        virtual void setFilterDeltaDistance(const uint32_t distance) override final;
         virtual bool shouldCompressHeader() const override final;
         virtual void setShouldCompressHeader(const bool compress) override final;
         virtual bool shouldCompressHeaderFull() const override final;
@@ -184,6 +228,8 @@ namespace plzma {
         virtual bool shouldStoreModificationTime() const override final;
         virtual void setShouldStoreModificationTime(const bool store) override final;
         
+        static plzma_method_properties defaultMethodProperties() noexcept;
+        
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
         void setUtf8Callback(plzma_progress_delegate_utf8_callback callback);
         void setWideCallback(plzma_progress_delegate_wide_callback callback);
@@ -196,6 +242,53 @@ namespace plzma {
         virtual ~EncoderImpl();
     };
     
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    class EncoderSessionImpl final : public EncoderSession {
+    private:
+        friend struct SharedPtr<EncoderSessionImpl>;
+        struct Pipe final {
+            SharedPtr<InStreamBase> stream;
+            CMyComPtr<ISequentialOutStream> writer;
+        };
+        LIBPLZMA_MUTEX(mutable _mutex)
+        LIBPLZMA_MUTEX(_finishMutex) // serializes waiting for the compression thread
+        SharedPtr<EncoderImpl> _encoder;
+        Vector<Pipe> _pipes;
+        NWindows::CThread _thread;
+        Exception * _exception = nullptr;
+        plzma_size_t _itemIndex = 0;
+        plzma_size_t _referenceCounter = 0;
+        bool _compressed = false;
+        bool _finished = false;
+        
+        virtual void retain() override final;
+        virtual void release() override final;
+        
+        void run() noexcept;
+        void endItems(const plzma_size_t count) noexcept;
+        bool waitCompression();
+        static THREAD_FUNC_DECL compressThread(void * session);
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(EncoderSessionImpl)
+        
+    public:
+        virtual bool write(const void * LIBPLZMA_NONNULL data, const plzma_size_t size) override final;
+        virtual void nextItem() override final;
+        virtual bool finish() override final;
+        virtual void abort() override final;
+        
+        /// @brief Adds the pipe of the next item, the stream is the reading side of the pipe.
+        void addPipe(const SharedPtr<InStreamBase> & stream, const CMyComPtr<ISequentialOutStream> & writer);
+        
+        /// @brief Starts the compression thread of the opened encoder.
+        void start();
+        
+        EncoderSessionImpl(SharedPtr<EncoderImpl> && encoder);
+        virtual ~EncoderSessionImpl() noexcept;
+    };
+#endif
+    
 } // namespace plzma
 
 #endif // !__PLZMA_ENCODER_IMPL_HPP__
@@ -39,6 +39,10 @@ namespace plzma {
     
     using namespace NArchive::NExtract;
     
+#if !defined(LIBPLZMA_NO_PROGRESS)
+    static const UInt32 kProgressPartItemsCount = 256;
+#endif
+    
     STDMETHODIMP ExtractCallback::ReportExtractResult(UInt32 indexType, UInt32 index, Int32 opRes) throw() {
 #if defined(LIBPLZMA_THREAD_UNSAFE)
         return _result;
@@ -50,20 +54,23 @@ namespace plzma {
     }
     
     STDMETHODIMP ExtractCallback::SetRatioInfo(const UInt64 * inSize, const UInt64 * outSize) throw() {
-#if defined(LIBPLZMA_THREAD_UNSAFE)
-        return _result;
-#else
-        const FailableLockGuard lock(_mutex);
-        RINOK(lock.res())
-        return _result;
-#endif
+        return setRatioInfo(inSize, outSize);
     }
     
     STDMETHODIMP ExtractCallback::SetTotal(UInt64 size) throw() {
 #if defined(LIBPLZMA_NO_PROGRESS)
         return S_OK;
 #else
-        return setProgressTotal(size);
+        UInt64 partTotal = 0;
+        {
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+            const FailableLockGuard lock(_mutex);
+            RINOK(lock.res())
+#endif
+            _progressTotal = size;
+            partTotal = progressPartTotal();
+        }
+        return setProgressTotal(partTotal);
 #endif
     }
     
@@ -71,10 +78,39 @@ namespace plzma {
 #if defined(LIBPLZMA_NO_PROGRESS)
         return S_OK;
 #else
-        return completeValue ? setProgressCompleted(*completeValue) : S_OK;
+        if (!completeValue) {
+            return S_OK;
+        }
+        UInt64 partCompleted = 0;
+        {
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+            const FailableLockGuard lock(_mutex);
+            RINOK(lock.res())
+#endif
+            _progressCompleted = *completeValue;
+            partCompleted = (_progressCompleted > _progressPartOffset) ? (_progressCompleted - _progressPartOffset) : 0;
+        }
+        return setProgressCompleted(partCompleted);
 #endif
     }
     
+#if !defined(LIBPLZMA_NO_PROGRESS)
+    UInt64 ExtractCallback::progressPartTotal() const noexcept {
+        const UInt32 partNumber = _progressItems / kProgressPartItemsCount;
+        const UInt32 remainingParts = (_progressPartsCount > partNumber) ? (_progressPartsCount - partNumber) : 1;
+        return (_progressTotal > _progressPartOffset) ? ((_progressTotal - _progressPartOffset) / remainingParts) : 0;
+    }
+    
+    void ExtractCallback::startProgressItem() {
+        if (_progressItems > 0 && (_progressItems % kProgressPartItemsCount) == 0 && (_progressItems / kProgressPartItemsCount) < _progressPartsCount) {
+            _progress->startPart();
+            _progressPartOffset = _progressCompleted;
+            _progress->setTotal(progressPartTotal());
+        }
+        _progressItems++;
+    }
+#endif
+    
     STDMETHODIMP ExtractCallback::CryptoGetTextPassword(BSTR * password) throw() {
         return getTextPassword(nullptr, password);
     }
@@ -83,6 +119,17 @@ namespace plzma {
         return getTextPassword(passwordIsDefined, password);
     }
     
+    void ExtractCallback::takeOutStreamException() noexcept {
+        Exception * exception = _currentOutStream->takeException();
+        if (exception) {
+            if (_exception) {
+                delete exception;
+            } else {
+                _exception = exception;
+            }
+        }
+    }
+    
     void ExtractCallback::getTestStream(const UInt32 index, ISequentialOutStream ** outStream) {
 #if !defined(LIBPLZMA_NO_PROGRESS)
         Path itemPath;
@@ -115,6 +162,7 @@ namespace plzma {
                     auto base = pair->second.cast<OutStreamBase>();
                     OutStreamBase * stream = base.get();
                     stream->setTimestamp(item->timestamp());
+                    stream->reserve(item->size());
                     _currentOutStream = stream;
 #if !defined(LIBPLZMA_NO_PROGRESS)
                     _progress->setPath(pair->first->path());
@@ -218,6 +266,7 @@ namespace plzma {
         *outStream = nullptr;
         try {
             LIBPLZMA_LOCKGUARD(lock, _mutex)
+            _countingItem = false;
             if (_result != S_OK) {
                 return _result;
             } else if (_solidArchive && (index < _extractingFirstIndex || index > _extractingLastIndex)) {
@@ -229,12 +278,17 @@ namespace plzma {
             }
             
             switch (askExtractMode) {
-                case NAskMode::kExtract: getExtractStream(index, outStream); break;
-                case NAskMode::kTest: getTestStream(index, outStream); break;
+                case NAskMode::kExtract: getExtractStream(index, outStream); _countingItem = true; break;
+                case NAskMode::kTest: getTestStream(index, outStream); _countingItem = true; break;
                 case NAskMode::kSkip: break;
                 default: _result = E_INVALIDARG; break;
             }
             currentOutStream.Release();
+#if !defined(LIBPLZMA_NO_PROGRESS)
+            if (_countingItem) {
+                startProgressItem();
+            }
+#endif
             return _result;
         } catch (const Exception & exception) {
             _exception = exception.moveToHeapCopy();
@@ -282,14 +336,21 @@ namespace plzma {
             LIBPLZMA_LOCKGUARD(lock, _mutex)
             if (_currentOutStream) {
                 _currentOutStream->close();
+                takeOutStreamException();
                 _currentOutStream.Release();
             }
             if (_result == S_OK) {
                 switch (operationResult) {
                     case NOperationResult::kOK:
+                        if (_countingItem) {
+                            _countingItem = false;
+                            _stats->completeItem();
+                        }
                         return S_OK;
                     default:
-                        _exception = Exception::create(plzma_error_code_internal, "Item extracted with error.", __FILE__, __LINE__);
+                        if (!_exception) {
+                            _exception = Exception::create(plzma_error_code_internal, "Item extracted with error.", __FILE__, __LINE__);
+                        }
                         _result = E_FAIL;
                         break;
                 }
@@ -322,7 +383,13 @@ namespace plzma {
         }
         _solidArchive = PROPVARIANTGetBool(prop);
         
-        UInt32 itemsCount = 0, itemIndex = 0;
+        UInt32 itemsCount = 0;
+        if (_itemsArray || _itemsMap) {
+            // The sequential tar archive doesn't know the number of the items and supports only a single pass through all of them.
+            if (_archive->GetNumberOfItems(&itemsCount) == S_OK && itemsCount == static_cast<UInt32>(static_cast<Int32>(-1))) {
+                throw Exception(plzma_error_code_invalid_arguments, "The items of the sequential archive can be extracted or tested only all together.", __FILE__, __LINE__);
+            }
+        }
         if (_itemsArray) {
             _itemsArray->sort();
             itemsCount = _itemsArray->count();
@@ -337,67 +404,75 @@ namespace plzma {
             itemsCount = numItems;
         }
         
-        const UInt32 maxIndicies = 256;
+        // All requested indices are passed to a single 'Extract' call, so each solid block is decoded only once.
+        RawHeapMemory indicesMemory;
+        const UInt32 * indices = nullptr;
+        UInt32 indicesCount = itemsCount;
+        if (_itemsArray || _itemsMap) {
+            indicesMemory.resize(sizeof(UInt32) * itemsCount);
+            UInt32 * itemsIndices = indicesMemory;
+            for (UInt32 itemIndex = 0; itemIndex < itemsCount; itemIndex++) {
+                itemsIndices[itemIndex] = _itemsArray ? _itemsArray->at(itemIndex)->index() : _itemsMap->at(itemIndex).first->index();
+            }
+            indices = itemsIndices;
+            if (itemsCount > 0) {
+                _extractingFirstIndex = indices[0];
+                _extractingLastIndex = indices[itemsCount - 1];
+            }
+        } else {
+            indicesCount = static_cast<UInt32>(static_cast<Int32>(-1)); // all items
+            _extractingFirstIndex = 0;
+            _extractingLastIndex = (itemsCount > 0) ? (itemsCount - 1) : 0;
+        }
+        
+        // The sequential tar archive reports the maximum number of items, i.e. unknown.
+        _stats->addItemsCount((itemsCount == static_cast<UInt32>(static_cast<Int32>(-1))) ? 0 : itemsCount);
+        _ratioInSize = _ratioOutSize = 0;
 #if !defined(LIBPLZMA_NO_PROGRESS)
+        // The progress is divided by the number of the items, a part per each 'kProgressPartItemsCount' items.
+        const UInt32 progressItemsCount = (itemsCount == static_cast<UInt32>(static_cast<Int32>(-1))) ? 0 : itemsCount;
+        _progressPartsCount = MyMax<UInt32>(1, (progressItemsCount + kProgressPartItemsCount - 1) / kProgressPartItemsCount);
+        _progressTotal = _progressCompleted = _progressPartOffset = 0;
+        _progressItems = 0;
         _progress->reset();
-        UInt32 partsCount = itemsCount / maxIndicies;
-        partsCount = MyMax<UInt32>(1, partsCount);
-        if (itemsCount > partsCount * maxIndicies) {
-            partsCount++;
-        }
-        _progress->setPartsCount(partsCount);
+        _progress->setPartsCount(_progressPartsCount);
+        _progress->startPart();
 #endif
+        _extracting = true;
         
-        do {
-            UInt32 indicies[maxIndicies];
-            UInt32 fromIndex = 0, toIndex = 0, indicesCount = 0;
-            if (_itemsArray) {
-                while (indicesCount < maxIndicies && itemIndex < itemsCount) {
-                    indicies[indicesCount] = toIndex = _itemsArray->at(itemIndex)->index();
-                    if (indicesCount == 0) { fromIndex = toIndex; }
-                    itemIndex++; indicesCount++;
-                }
-            } else if (_itemsMap) {
-                while (indicesCount < maxIndicies && itemIndex < itemsCount) {
-                    indicies[indicesCount] = toIndex = _itemsMap->at(itemIndex).first->index();
-                    if (indicesCount == 0) { fromIndex = toIndex; }
-                    itemIndex++; indicesCount++;
-                }
+        CMyComPtr<InStreamBase> stream(_stream);
+        IInArchiveExtractStream * extractStream = _extractStream; // the shared archive is referenced only by the owner
+        
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        HRESULT result = S_OK;
+        if (itemsCount > 0) {
+            if (stream) {
+                result = extractStream->ExtractStream(stream, indices, indicesCount, _mode, this);
             } else {
-                fromIndex = itemIndex;
-                while (indicesCount < maxIndicies && itemIndex < itemsCount) {
-                    indicies[indicesCount++] = toIndex = itemIndex++;         // +1
-                }
+                result = _archive->Extract(indices, indicesCount, _mode, this);
             }
-            _extractingFirstIndex = fromIndex;
-            _extractingLastIndex = toIndex;
-#if !defined(LIBPLZMA_NO_PROGRESS)
-            _progress->startPart();
-#endif
-            _extracting = true;
-            
-            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
-            const HRESULT result = (indicesCount > 0) ? _archive->Extract(indicies, indicesCount, _mode, this) : S_OK;
-            LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
-            
-            _extracting = false;
-            if (_currentOutStream) {
-                _currentOutStream->close();
-                _currentOutStream.Release();
-            }
-            
-            if (result != S_OK || _result != S_OK) {
-                if (result == E_ABORT || _result == E_ABORT) {
-                    return; // aborted -> without exception
-                } else if (_exception) {
-                    Exception localException(static_cast<Exception &&>(*_exception));
-                    delete _exception;
-                    _exception = nullptr;
-                    throw localException;
-                }
-                throw Exception(plzma_error_code_internal, "Unknown extract error.", __FILE__, __LINE__);
+        }
+        LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
+        _stats->finishPart();
+        
+        _extracting = false;
+        if (_currentOutStream) {
+            _currentOutStream->close();
+            takeOutStreamException();
+            _currentOutStream.Release();
+        }
+        
+        if (result != S_OK || _result != S_OK) {
+            if (result == E_ABORT || _result == E_ABORT) {
+                return; // aborted -> without exception
+            } else if (_exception) {
+                Exception localException(static_cast<Exception &&>(*_exception));
+                delete _exception;
+                _exception = nullptr;
+                throw localException;
             }
-        } while (itemIndex < itemsCount);
+            throw Exception(plzma_error_code_internal, "Unknown extract error.", __FILE__, __LINE__);
+        }
         
 #if !defined(LIBPLZMA_NO_PROGRESS)
         _progress->finish();
@@ -445,16 +520,28 @@ namespace plzma {
         }
     }
     
-    ExtractCallback::ExtractCallback(const CMyComPtr<IInArchive> & archive,
+    void ExtractCallback::setStream(const CMyComPtr<InStreamBase> & stream) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        CMyComPtr<IInArchiveExtractStream> extractStream;
+        if (_archive->QueryInterface(IID_IInArchiveExtractStream, reinterpret_cast<void **>(&extractStream)) != S_OK) {
+            throw Exception(plzma_error_code_internal, "The archive can't be read via the provided stream.", __FILE__, __LINE__);
+        }
+        _extractStream = extractStream; // the interface lives as long as the archive
+        _stream = stream;
+    }
+    
+    ExtractCallback::ExtractCallback(IInArchive * LIBPLZMA_NONNULL archive,
 #if !defined(LIBPLZMA_NO_CRYPTO)
                                      const String & passwd,
 #endif
 #if !defined(LIBPLZMA_NO_PROGRESS)
                                      const SharedPtr<Progress> & progress,
 #endif
+                                     const SharedPtr<Stats> & stats,
                                      const plzma_file_type type) : CMyUnknownImp(),
         _archive(archive),
         _type(type) {
+            _stats = stats;
 #if !defined(LIBPLZMA_NO_CRYPTO)
             _password = passwd;
 #endif
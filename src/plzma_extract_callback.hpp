@@ -59,9 +59,10 @@ namespace plzma {
         public CMyUnknownImp {
     private:
         Path _path;
-        CMyComPtr<InStreamBase> _stream;
+        CMyComPtr<InStreamBase> _stream; // the own stream of the worker, read via the shared opened archive
+        IInArchiveExtractStream * _extractStream = nullptr; // the interface of the archive, not referenced
         CMyComPtr<OutStreamBase> _currentOutStream;
-        CMyComPtr<IInArchive> _archive;
+        IInArchive * _archive = nullptr; // owned by the open callback, which outlives the extract callback
         SharedPtr<ItemOutStreamArray> _itemsMap;
         SharedPtr<ItemArray> _itemsArray;
         UInt32 _extractingFirstIndex = 0;
@@ -71,7 +72,20 @@ namespace plzma {
         bool _itemsFullPath = true;
         bool _solidArchive = false;
         bool _extracting = false;
+        bool _countingItem = false; // the current item is counted by the stats after the operation result
+#if !defined(LIBPLZMA_NO_PROGRESS)
+        // The progress part of each 256 items, the size of the single 'Extract' call is shared between the remaining parts.
+        UInt64 _progressTotal = 0;
+        UInt64 _progressCompleted = 0;
+        UInt64 _progressPartOffset = 0;
+        UInt32 _progressPartsCount = 1;
+        UInt32 _progressItems = 0;
+        
+        UInt64 progressPartTotal() const noexcept;
+        void startProgressItem();
+#endif
         
+        void takeOutStreamException() noexcept;
         void getTestStream(const UInt32 index, ISequentialOutStream ** outStream);
         void getExtractStream(const UInt32 index, ISequentialOutStream ** outStream);
         
@@ -111,13 +125,19 @@ namespace plzma {
         void process(const Int32 mode);
         void abort();
         
-        ExtractCallback(const CMyComPtr<IInArchive> & archive,
+        /// @brief Reads the content of the shared opened archive from the provided stream instead of the opened one.
+        /// @note The archive must support the \a IInArchiveExtractStream interface.
+        /// @note The archive might be shared by a few callbacks and it's reference counter is not atomic, so call it under the owner's lock.
+        void setStream(const CMyComPtr<InStreamBase> & stream);
+        
+        ExtractCallback(IInArchive * LIBPLZMA_NONNULL archive,
 #if !defined(LIBPLZMA_NO_CRYPTO)
                         const String & passwd,
 #endif
 #if !defined(LIBPLZMA_NO_PROGRESS)
                         const SharedPtr<Progress> & progress,
 #endif
+                        const SharedPtr<Stats> & stats,
                         const plzma_file_type type);
         virtual ~ExtractCallback() { }
     };
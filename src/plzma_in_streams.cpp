@@ -29,10 +29,23 @@
 
 #include "plzma_in_streams.hpp"
 #include "plzma_common.hpp"
+#include "plzma_stats.hpp"
 #include "plzma_file_utils.hpp"
 
 #include "CPP/Common/MyString.h"
 
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+#  include <io.h>
+#  include <windows.h>
+#elif defined(LIBPLZMA_POSIX)
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <errno.h>
+#  include <unistd.h>
+#endif
+
 namespace plzma {
     
     using namespace fileUtils;
@@ -53,8 +66,21 @@ namespace plzma {
 #endif
     }
     
+    SharedPtr<InStreamBase> InStreamBase::clone() {
+        return SharedPtr<InStreamBase>();
+    }
+    
+    uint64_t InStreamBase::pathIdentity(const Path & path) {
+        uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a
+        for (const char * p = path.utf8(); *p; p++) {
+            hash = (hash ^ static_cast<uint8_t>(*p)) * 0x100000001b3ULL;
+        }
+        return hash | 0x8000000000000000ULL; // never equal to the counted identity of the other streams
+    }
+    
     InStreamBase::InStreamBase() : CMyUnknownImp() {
-
+        static AtomicUInt64 identities;
+        _identity = identities.increment();
     }
     
     /// InFileStream
@@ -121,6 +147,10 @@ namespace plzma {
         return true;
     }
     
+    SharedPtr<InStreamBase> InFileStream::clone() {
+        return SharedPtr<InStreamBase>(new InFileStream(_path));
+    }
+    
     const Path & InFileStream::path() const noexcept {
         return _path;
     }
@@ -132,6 +162,7 @@ namespace plzma {
                 exception.setReason("The path is empty.", nullptr);
                 throw exception;
             }
+            _identity = pathIdentity(_path);
     }
     
     InFileStream::InFileStream(Path && path) : InStreamBase(),
@@ -141,6 +172,7 @@ namespace plzma {
                 exception.setReason("The path is empty.", nullptr);
                 throw exception;
             }
+            _identity = pathIdentity(_path);
     }
     
     InFileStream::~InFileStream() noexcept {
@@ -149,6 +181,463 @@ namespace plzma {
         }
     }
     
+    /// InMappedFileStream
+    
+    // The size of the region ahead of the reading position which is going to be accessed after seeking.
+    static const UInt64 kMappedWillNeedSize = 1 << 22;
+    
+    STDMETHODIMP InMappedFileStream::Read(void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_memory) {
+            const UInt64 available = _size - _offset;
+            size_t sizeToRead = 0;
+            if (available > 0) {
+                sizeToRead = (size <= available) ? size : static_cast<size_t>(available);
+                const uint8_t * m = static_cast<const uint8_t *>(_memory) + _offset;
+                ::memcpy(data, m, sizeToRead);
+                _offset += sizeToRead;
+            }
+            LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, sizeToRead)
+            return S_OK;
+        } else if (_file) {
+            const size_t processed = (size > 0) ? ::fread(data, 1, size, _file) : 0;
+            LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, processed)
+            return S_OK;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return _opened ? S_OK : S_FALSE; // opened empty file
+    }
+    
+    STDMETHODIMP InMappedFileStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        if (_file) {
+            if (fileSeek(_file, offset, seekOrigin) == 0) {
+                LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, fileTell(_file))
+                return S_OK;
+            }
+        } else if (_opened) {
+            Int64 finalOffset;
+            switch (seekOrigin) {
+                case STREAM_SEEK_SET:
+                    finalOffset = offset;
+                    break;
+                case STREAM_SEEK_CUR:
+                    finalOffset = _offset;
+                    finalOffset += offset;
+                    break;
+                case STREAM_SEEK_END:
+                    finalOffset = _size;
+                    finalOffset += offset;
+                    break;
+                default:
+                    finalOffset = -1;
+                    break;
+            }
+            if (finalOffset >= 0 && static_cast<UInt64>(finalOffset) <= _size) {
+                if (_offset != static_cast<UInt64>(finalOffset)) {
+                    _offset = finalOffset;
+                    adviseWillNeed();
+                }
+                LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, _offset)
+                return S_OK;
+            }
+            _offset = 0;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0)
+        return S_FALSE;
+    }
+    
+    void InMappedFileStream::map(FILE * file) {
+        UInt64 size = 0;
+        void * memory = nullptr;
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+        HANDLE fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+        LARGE_INTEGER fileSize;
+        if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize) || GetFileType(fileHandle) != FILE_TYPE_DISK) {
+            _file = file;
+            return;
+        }
+        size = static_cast<UInt64>(fileSize.QuadPart);
+        if (size > 0 && size <= SIZE_MAX) {
+            HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping); // the view holds the reference to the mapping.
+            }
+        }
+#elif defined(LIBPLZMA_POSIX)
+        struct stat fileStat;
+        const int fd = fileno(file);
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+            _file = file;
+            return;
+        }
+        size = static_cast<UInt64>(fileStat.st_size);
+        if (size > 0 && size <= SIZE_MAX) {
+            memory = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (memory == MAP_FAILED) {
+                memory = nullptr;
+            } else {
+                posix_madvise(memory, static_cast<size_t>(size), POSIX_MADV_SEQUENTIAL);
+            }
+        }
+#else
+#error "Not implemented."
+#endif
+        if (memory || size == 0) {
+            ::fclose(file); // the mapping doesn't require the opened file.
+            _memory = memory;
+            _size = size;
+        } else {
+            _file = file; // can't map, i.e. the size exceeds the address space.
+        }
+    }
+    
+    void InMappedFileStream::unmap() noexcept {
+        if (_memory) {
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+            UnmapViewOfFile(_memory);
+#elif defined(LIBPLZMA_POSIX)
+            munmap(_memory, static_cast<size_t>(_size));
+#endif
+            _memory = nullptr;
+        }
+        if (_file) {
+            ::fclose(_file);
+            _file = nullptr;
+        }
+        _size = _offset = 0;
+    }
+    
+    void InMappedFileStream::adviseWillNeed() noexcept {
+#if defined(LIBPLZMA_POSIX) && !defined(LIBPLZMA_MINGW)
+        static const UInt64 pageSize = static_cast<UInt64>(sysconf(_SC_PAGESIZE));
+        if (_memory && pageSize > 0 && _offset < _size) {
+            const UInt64 begin = _offset - (_offset % pageSize);
+            const UInt64 end = ((_size - begin) > kMappedWillNeedSize) ? (begin + kMappedWillNeedSize) : _size;
+            posix_madvise(static_cast<uint8_t *>(_memory) + begin, static_cast<size_t>(end - begin), POSIX_MADV_WILLNEED);
+        }
+#endif
+    }
+    
+    bool InMappedFileStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    void InMappedFileStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            return;
+        }
+        FILE * f = _path.openFile("rb");
+        if (!f) {
+            Exception exception(plzma_error_code_io, nullptr, __FILE__, __LINE__);
+            exception.setWhat("Can't open in-stream for reading from file in binary mode with path: ", _path.utf8(), nullptr);
+            exception.setReason("File doesn't exist or is not readable.", nullptr);
+            throw exception;
+        }
+        map(f);
+        _offset = 0;
+        _opened = true;
+    }
+    
+    void InMappedFileStream::close() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        unmap();
+        _opened = false;
+    }
+    
+    bool InMappedFileStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            return false; // opened -> false
+        }
+        bool isDir = true;
+        if (_path.exists(&isDir)) {
+            if (!isDir && !fileErase(_path, eraseType)) {
+                return false;
+            }
+            return _path.remove(false);
+        }
+        return true;
+    }
+    
+    SharedPtr<InStreamBase> InMappedFileStream::clone() {
+        // The mappings of the same file share the pages of the file cache.
+        return SharedPtr<InStreamBase>(new InMappedFileStream(_path));
+    }
+    
+    const Path & InMappedFileStream::path() const noexcept {
+        return _path;
+    }
+    
+    InMappedFileStream::InMappedFileStream(const Path & path) : InStreamBase(),
+        _path(path) {
+            if (_path.count() == 0) {
+                Exception exception(plzma_error_code_invalid_arguments, "Can't instantiate in-stream without path.", __FILE__, __LINE__);
+                exception.setReason("The path is empty.", nullptr);
+                throw exception;
+            }
+            _identity = pathIdentity(_path);
+    }
+    
+    InMappedFileStream::InMappedFileStream(Path && path) : InStreamBase(),
+        _path(static_cast<Path &&>(path)) {
+            if (_path.count() == 0) {
+                Exception exception(plzma_error_code_invalid_arguments, "Can't instantiate in-stream without path.", __FILE__, __LINE__);
+                exception.setReason("The path is empty.", nullptr);
+                throw exception;
+            }
+            _identity = pathIdentity(_path);
+    }
+    
+    InMappedFileStream::~InMappedFileStream() noexcept {
+        unmap();
+    }
+    
+    /// PositionalFile
+    void PositionalFile::retain() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RETAIN_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void PositionalFile::release() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RELEASE_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void PositionalFile::closeDescriptor() noexcept {
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+        if (_file) {
+            ::fclose(_file);
+            _file = nullptr;
+        }
+        _handle = nullptr;
+#else
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+#endif
+        _size = 0;
+    }
+    
+    void PositionalFile::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_openedCount > 0) {
+            _openedCount++;
+            return;
+        }
+        bool opened = false;
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+        _file = _path.openFile("rb");
+        if (_file) {
+            HANDLE fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(_file)));
+            LARGE_INTEGER fileSize;
+            if (fileHandle != INVALID_HANDLE_VALUE && GetFileSizeEx(fileHandle, &fileSize)) {
+                _handle = fileHandle;
+                _size = static_cast<UInt64>(fileSize.QuadPart);
+                opened = true;
+            }
+        }
+#elif defined(LIBPLZMA_POSIX)
+        _fd = ::open(_path.utf8(), O_RDONLY | O_CLOEXEC);
+        struct stat fileStat;
+        if (_fd >= 0 && fstat(_fd, &fileStat) == 0 && !S_ISDIR(fileStat.st_mode)) {
+            _size = static_cast<UInt64>(fileStat.st_size);
+            opened = true;
+        }
+#else
+#error "Not implemented."
+#endif
+        if (!opened) {
+            closeDescriptor();
+            Exception exception(plzma_error_code_io, nullptr, __FILE__, __LINE__);
+            exception.setWhat("Can't open in-stream for reading from file in binary mode with path: ", _path.utf8(), nullptr);
+            exception.setReason("File doesn't exist or is not readable.", nullptr);
+            throw exception;
+        }
+        _openedCount = 1;
+    }
+    
+    void PositionalFile::close() noexcept {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_openedCount > 0 && --_openedCount == 0) {
+            closeDescriptor();
+        }
+    }
+    
+    bool PositionalFile::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _openedCount > 0;
+    }
+    
+    bool PositionalFile::read(void * data, const UInt32 size, const UInt64 offset, UInt32 & processedSize) const noexcept {
+        uint8_t * buffer = static_cast<uint8_t *>(data);
+        UInt32 processed = 0;
+        while (processed < size) {
+            const UInt64 position = offset + processed;
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+            OVERLAPPED overlapped;
+            ::memset(&overlapped, 0, sizeof(OVERLAPPED));
+            overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+            overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+            DWORD chunk = 0;
+            if (!ReadFile(static_cast<HANDLE>(_handle), buffer + processed, size - processed, &chunk, &overlapped)) {
+                if (GetLastError() == ERROR_HANDLE_EOF) {
+                    break;
+                }
+                processedSize = processed;
+                return false;
+            }
+#else
+            const ssize_t chunk = ::pread(_fd, buffer + processed, size - processed, static_cast<off_t>(position));
+            if (chunk < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                processedSize = processed;
+                return false;
+            }
+#endif
+            if (chunk == 0) {
+                break; // end of file
+            }
+            processed += static_cast<UInt32>(chunk);
+        }
+        processedSize = processed;
+        return true;
+    }
+    
+    PositionalFile::PositionalFile(const Path & path) :
+        _path(path) {
+            if (_path.count() == 0) {
+                Exception exception(plzma_error_code_invalid_arguments, "Can't instantiate in-stream without path.", __FILE__, __LINE__);
+                exception.setReason("The path is empty.", nullptr);
+                throw exception;
+            }
+    }
+    
+    PositionalFile::PositionalFile(Path && path) :
+        _path(static_cast<Path &&>(path)) {
+            if (_path.count() == 0) {
+                Exception exception(plzma_error_code_invalid_arguments, "Can't instantiate in-stream without path.", __FILE__, __LINE__);
+                exception.setReason("The path is empty.", nullptr);
+                throw exception;
+            }
+    }
+    
+    PositionalFile::~PositionalFile() noexcept {
+        closeDescriptor();
+    }
+    
+    /// InPositionalFileStream
+    STDMETHODIMP InPositionalFileStream::Read(void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_opened) {
+            UInt32 processed = 0;
+            const bool succeeded = (size > 0) ? _file->read(data, size, _offset, processed) : true;
+            _offset += processed;
+            LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, processed)
+            return succeeded ? S_OK : E_FAIL;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return S_FALSE;
+    }
+    
+    STDMETHODIMP InPositionalFileStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        if (_opened) {
+            Int64 finalOffset;
+            switch (seekOrigin) {
+                case STREAM_SEEK_SET:
+                    finalOffset = offset;
+                    break;
+                case STREAM_SEEK_CUR:
+                    finalOffset = _offset;
+                    finalOffset += offset;
+                    break;
+                case STREAM_SEEK_END:
+                    finalOffset = _file->size();
+                    finalOffset += offset;
+                    break;
+                default:
+                    finalOffset = -1;
+                    break;
+            }
+            if (finalOffset >= 0 && static_cast<UInt64>(finalOffset) <= _file->size()) {
+                _offset = finalOffset;
+                LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, _offset)
+                return S_OK;
+            }
+            _offset = 0;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0)
+        return S_FALSE;
+    }
+    
+    bool InPositionalFileStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    void InPositionalFileStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            return;
+        }
+        _file->open();
+        _offset = 0;
+        _opened = true;
+    }
+    
+    void InPositionalFileStream::close() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            _file->close();
+            _opened = false;
+        }
+    }
+    
+    bool InPositionalFileStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_file->opened()) {
+            return false; // opened by this stream or any clone -> false
+        }
+        const Path & path = _file->path();
+        bool isDir = true;
+        if (path.exists(&isDir)) {
+            if (!isDir && !fileErase(path, eraseType)) {
+                return false;
+            }
+            return path.remove(false);
+        }
+        return true;
+    }
+    
+    SharedPtr<InStreamBase> InPositionalFileStream::clone() {
+        // The clones share the descriptor, each of them has own reading position.
+        return SharedPtr<InStreamBase>(new InPositionalFileStream(_file));
+    }
+    
+    const Path & InPositionalFileStream::path() const noexcept {
+        return _file->path();
+    }
+    
+    InPositionalFileStream::InPositionalFileStream(const SharedPtr<PositionalFile> & file) : InStreamBase(),
+        _file(file) {
+        _identity = pathIdentity(_file->path());
+    }
+    
+    InPositionalFileStream::~InPositionalFileStream() noexcept {
+        if (_opened) {
+            _file->close();
+        }
+    }
+    
     /// InMemStream
     STDMETHODIMP InMemStream::Read(void * data, UInt32 size, UInt32 * processedSize) throw() {
         if (_opened) {
@@ -216,8 +705,8 @@ namespace plzma {
     
     bool InMemStream::erase(const plzma_erase eraseType) {
         LIBPLZMA_LOCKGUARD(lock, _mutex)
-        if (_opened) {
-            return false;
+        if (_opened || _source) {
+            return false; // opened or cloned -> false
         }
         if (_memory && _size > 0) {
             switch (eraseType) {
@@ -231,6 +720,17 @@ namespace plzma {
         return true;
     }
         
+    SharedPtr<InStreamBase> InMemStream::clone() {
+        return SharedPtr<InStreamBase>(new InMemStream(_source ? _source : SharedPtr<InStreamBase>(this), _memory, _size));
+    }
+    
+    InMemStream::InMemStream(const SharedPtr<InStreamBase> & source, void * memory, const UInt64 size) : InStreamBase(),
+        _source(source),
+        _memory(memory),
+        _size(size) {
+        _identity = _source->identity();
+    }
+    
     InMemStream::InMemStream(const void * memory, const size_t size) : InStreamBase() {
         if (memory && size > 0) {
             void * m = plzma_malloc(size);
@@ -267,7 +767,9 @@ namespace plzma {
     }
     
     InMemStream::~InMemStream() noexcept {
-        if (_freeCallback) {
+        if (_source) {
+            return; // the memory is owned by the source stream
+        } else if (_freeCallback) {
             _freeCallback(_memory);
         } else {
             plzma_free(_memory);
@@ -355,6 +857,130 @@ namespace plzma {
         }
     }
 
+    /// InSequentialCallbackStream
+    
+    STDMETHODIMP InSequentialCallbackStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0);
+        return E_NOTIMPL;
+    }
+    
+    STDMETHODIMP InSequentialCallbackStream::Read(void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_opened) {
+            UInt32 procSize = 0;
+            if (_readCallback(_context.context, data, size, &procSize)) {
+                LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, procSize)
+                return S_OK;
+            }
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return S_FALSE;
+    }
+    
+    void InSequentialCallbackStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (!_opened && !(_opened = _openCallback(_context.context)) ) {
+            throw Exception(plzma_error_code_io, "Can't open in-stream using open callback.", __FILE__, __LINE__);
+        }
+    }
+    
+    void InSequentialCallbackStream::close() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            _opened = false;
+            _closeCallback(_context.context);
+        }
+    }
+    
+    bool InSequentialCallbackStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    bool InSequentialCallbackStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        // no erase functionality for a stream with user-defined callbacks.
+        return !_opened; // opened -> false
+    }
+    
+    InSequentialCallbackStream::InSequentialCallbackStream(plzma_in_stream_open_callback openCallback,
+                                                           plzma_in_stream_close_callback closeCallback,
+                                                           plzma_in_stream_read_callback readCallback,
+                                                           const plzma_context context) : InStreamBase(),
+        _context(context),
+        _openCallback(openCallback),
+        _closeCallback(closeCallback),
+        _readCallback(readCallback) {
+            if (!_openCallback || !_closeCallback || !_readCallback) {
+                Exception exception(plzma_error_code_invalid_arguments, "Can't instantiate in-stream without required callback.", __FILE__, __LINE__);
+                if (!_openCallback) { exception.setReason("The open callback is null.", nullptr); }
+                else if (!_closeCallback) { exception.setReason("The close callback is null.", nullptr); }
+                else if (!_readCallback) { exception.setReason("The read callback is null.", nullptr); }
+                throw exception;
+            }
+    }
+    
+    InSequentialCallbackStream::~InSequentialCallbackStream() noexcept {
+        if (_opened) {
+            _closeCallback(_context.context);
+        }
+        if (_context.context && _context.deinitializer) {
+            _context.deinitializer(_context.context);
+        }
+    }
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    /// InPipeStream
+    
+    STDMETHODIMP InPipeStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0)
+        return E_NOTIMPL; // sequential
+    }
+    
+    STDMETHODIMP InPipeStream::Read(void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_opened && _reader) {
+            return _reader->Read(data, size, processedSize);
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return S_FALSE;
+    }
+    
+    void InPipeStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _opened = (_reader != nullptr);
+    }
+    
+    void InPipeStream::close() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _opened = false; // the content is still readable after the reopening.
+    }
+    
+    void InPipeStream::closeReader() noexcept {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        CMyComPtr<ISequentialInStream> reader(static_cast<CMyComPtr<ISequentialInStream> &&>(_reader));
+        _opened = false;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        reader.Release(); // the last reference closes the reading side
+    }
+    
+    bool InPipeStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    bool InPipeStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        // nothing to erase, the content is not stored
+        return !_opened; // opened -> false
+    }
+    
+    InPipeStream::InPipeStream(CMyComPtr<ISequentialOutStream> & writer) : InStreamBase() {
+        if (_binder.Create_ReInit() != S_OK) {
+            throw Exception(plzma_error_code_internal, "Can't create the pipe.", __FILE__, __LINE__);
+        }
+        _binder.CreateStreams2(_reader, writer);
+    }
+#endif
+    
     /// InMultiStream
 
     STDMETHODIMP InMultiStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
@@ -421,6 +1047,18 @@ namespace plzma {
         return true;
     }
     
+    SharedPtr<InStreamBase> InMultiStream::clone() {
+        InStreamArray streams(_streams.count());
+        for (plzma_size_t i = 0, n = _streams.count(); i < n; i++) {
+            auto stream = _streams.at(i)->clone();
+            if (!stream) {
+                return SharedPtr<InStreamBase>();
+            }
+            streams.push(SharedPtr<InStream>(stream.get()));
+        }
+        return SharedPtr<InStreamBase>(new InMultiStream(static_cast<InStreamArray &&>(streams)));
+    }
+    
     InMultiStream::InMultiStream(InStreamArray && streams) {
         auto inStreams = static_cast<InStreamArray &&>(streams);
         if (inStreams.count() == 0) {
@@ -455,6 +1093,22 @@ namespace plzma {
         return SharedPtr<InStream>(new InFileStream(static_cast<Path &&>(path)));
     }
     
+    SharedPtr<InStream> makeSharedMappedInStream(const Path & path) {
+        return SharedPtr<InStream>(new InMappedFileStream(path));
+    }
+    
+    SharedPtr<InStream> makeSharedMappedInStream(Path && path) {
+        return SharedPtr<InStream>(new InMappedFileStream(static_cast<Path &&>(path)));
+    }
+    
+    SharedPtr<InStream> makeSharedPositionalInStream(const Path & path) {
+        return SharedPtr<InStream>(new InPositionalFileStream(makeShared<PositionalFile>(path)));
+    }
+    
+    SharedPtr<InStream> makeSharedPositionalInStream(Path && path) {
+        return SharedPtr<InStream>(new InPositionalFileStream(makeShared<PositionalFile>(static_cast<Path &&>(path))));
+    }
+    
     SharedPtr<InStream> makeSharedInStream(const void * LIBPLZMA_NONNULL memory, const size_t size) {
         return SharedPtr<InStream>(new InMemStream(memory, size));
     }
@@ -470,6 +1124,13 @@ namespace plzma {
                                            const plzma_context context) {
         return SharedPtr<InStream>(new InCallbackStream(openCallback, closeCallback, seekCallback, readCallback, context));
     }
+    
+    SharedPtr<InStream> makeSharedSequentialInStream(plzma_in_stream_open_callback LIBPLZMA_NONNULL openCallback,
+                                                     plzma_in_stream_close_callback LIBPLZMA_NONNULL closeCallback,
+                                                     plzma_in_stream_read_callback LIBPLZMA_NONNULL readCallback,
+                                                     const plzma_context context) {
+        return SharedPtr<InStream>(new InSequentialCallbackStream(openCallback, closeCallback, readCallback, context));
+    }
 
     SharedPtr<InStream> makeSharedInStream(InStreamArray && streams) {
         return SharedPtr<InStream>(new InMultiStream(static_cast<InStreamArray &&>(streams)));
@@ -498,6 +1159,20 @@ plzma_in_stream plzma_in_stream_create_with_pathm(plzma_path * LIBPLZMA_NONNULL
     LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
 }
 
+plzma_in_stream plzma_in_stream_create_mapped_with_path(const plzma_path * LIBPLZMA_NONNULL path) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_in_stream, path)
+    auto stream = makeSharedMappedInStream(*static_cast<const Path *>(path->object));
+    createdCObject.object = static_cast<void *>(stream.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+plzma_in_stream plzma_in_stream_create_positional_with_path(const plzma_path * LIBPLZMA_NONNULL path) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_in_stream, path)
+    auto stream = makeSharedPositionalInStream(*static_cast<const Path *>(path->object));
+    createdCObject.object = static_cast<void *>(stream.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
 plzma_in_stream plzma_in_stream_create_with_memory_copy(const void * LIBPLZMA_NONNULL memory,
                                                         const size_t size) {
     LIBPLZMA_C_BINDINGS_CREATE_OBJECT_TRY(plzma_in_stream)
@@ -526,6 +1201,16 @@ plzma_in_stream plzma_in_stream_create_with_callbacks(plzma_in_stream_open_callb
     LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
 }
 
+plzma_in_stream plzma_in_stream_create_sequential_with_callbacks(plzma_in_stream_open_callback LIBPLZMA_NONNULL open_callback,
+                                                                 plzma_in_stream_close_callback LIBPLZMA_NONNULL close_callback,
+                                                                 plzma_in_stream_read_callback LIBPLZMA_NONNULL read_callback,
+                                                                 const plzma_context context) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_TRY(plzma_in_stream)
+    auto stream = makeSharedSequentialInStream(open_callback, close_callback, read_callback, context);
+    createdCObject.object = static_cast<void *>(stream.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
 plzma_in_stream plzma_in_stream_create_with_stream_arraym(plzma_in_stream_array * LIBPLZMA_NONNULL stream_array) {
     LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_in_stream, stream_array)
     auto stream = makeSharedInStream(static_cast<InStreamArray &&>(*static_cast<InStreamArray *>(stream_array->object)));
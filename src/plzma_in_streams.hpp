@@ -41,6 +41,10 @@
 #include "CPP/7zip/IStream.h"
 #include "CPP/7zip/Archive/Common/MultiStream.h"
 
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+#include "CPP/7zip/Common/StreamBinder.h"
+#endif
+
 namespace plzma {
     
     class LIBPLZMA_CPP_CLASS_API InStreamBase :
@@ -52,17 +56,31 @@ namespace plzma {
         
     protected:
         LIBPLZMA_MUTEX(mutable _mutex)
+        uint64_t _identity = 0;
         
         virtual void retain() override final;
         virtual void release() override final;
         virtual void * base() noexcept override final { return this; }
         
+        /// @return The identity of the file streams of the same path.
+        static uint64_t pathIdentity(const Path & path);
+        
         LIBPLZMA_NON_COPYABLE_NON_MOVABLE(InStreamBase)
         
     public:
+        /// @brief The identity of the stream's content, the same for the clones and for the file streams of the same path.
+        uint64_t identity() const noexcept { return _identity; }
+        
         virtual void open() = 0;
         virtual void close() = 0;
         
+        /// @brief Creates a new closed stream with the same content and independent reading position.
+        /// @return The cloned stream or empty pointer if the stream can't be cloned.
+        virtual SharedPtr<InStreamBase> clone();
+        
+        /// @brief Checks the stream can be read only once from the beginning to the end, without seeking.
+        virtual bool sequential() const noexcept { return false; }
+        
         InStreamBase();
         virtual ~InStreamBase() noexcept { }
     };
@@ -93,6 +111,7 @@ namespace plzma {
         
         virtual bool opened() const override final;
         virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual SharedPtr<InStreamBase> clone() override final;
         
         const Path & path() const noexcept;
         
@@ -101,8 +120,120 @@ namespace plzma {
         virtual ~InFileStream() noexcept;
     };
     
+    class InMappedFileStream final : public InStreamBase {
+    private:
+        Path _path;
+        void * _memory = nullptr;
+        FILE * _file = nullptr; // buffered reading if the file can't be mapped.
+        UInt64 _size = 0;
+        UInt64 _offset = 0;
+        bool _opened = false;
+        
+        void map(FILE * file);
+        void unmap() noexcept;
+        void adviseWillNeed() noexcept;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(InMappedFileStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(IInStream)
+        
+    public:
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(Read)(void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        
+        virtual void open() override final;
+        virtual void close() override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual SharedPtr<InStreamBase> clone() override final;
+        
+        const Path & path() const noexcept;
+        
+        InMappedFileStream(const Path & path);
+        InMappedFileStream(Path && path);
+        virtual ~InMappedFileStream() noexcept;
+    };
+    
+    /// @brief The file descriptor shared by the positional-read stream and its clones.
+    ///
+    /// The descriptor is opened by the first opened stream and closed by the last one.
+    /// The reading doesn't use or change the file position, so the streams read it at the same time without locking.
+    class PositionalFile final {
+    private:
+        friend struct SharedPtr<PositionalFile>;
+        LIBPLZMA_MUTEX(mutable _mutex)
+        Path _path;
+#if defined(LIBPLZMA_MSC) || defined(LIBPLZMA_MINGW)
+        FILE * _file = nullptr;
+        void * _handle = nullptr;
+#else
+        int _fd = -1;
+#endif
+        UInt64 _size = 0;
+        plzma_size_t _openedCount = 0;
+        plzma_size_t _referenceCounter = 0;
+        
+        void retain();
+        void release();
+        void closeDescriptor() noexcept;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(PositionalFile)
+        
+    public:
+        void open();
+        void close() noexcept;
+        bool opened() const;
+        
+        /// @brief Reads the content at offset, the short read happens only at the end of the file.
+        /// @return \a false in case of reading error.
+        bool read(void * data, const UInt32 size, const UInt64 offset, UInt32 & processedSize) const noexcept;
+        
+        /// @brief The size of the file at the moment of opening the descriptor.
+        UInt64 size() const noexcept { return _size; }
+        
+        const Path & path() const noexcept { return _path; }
+        
+        PositionalFile(const Path & path);
+        PositionalFile(Path && path);
+        ~PositionalFile() noexcept;
+    };
+    
+    class InPositionalFileStream final : public InStreamBase {
+    private:
+        SharedPtr<PositionalFile> _file;
+        UInt64 _offset = 0;
+        bool _opened = false;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(InPositionalFileStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(IInStream)
+        
+    public:
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(Read)(void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        
+        virtual void open() override final;
+        virtual void close() override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual SharedPtr<InStreamBase> clone() override final;
+        
+        const Path & path() const noexcept;
+        
+        InPositionalFileStream(const SharedPtr<PositionalFile> & file);
+        virtual ~InPositionalFileStream() noexcept;
+    };
+    
     class InMemStream final : public InStreamBase {
     private:
+        SharedPtr<InStreamBase> _source; // the owner of the memory of the cloned stream.
         void * _memory = nullptr;
         plzma_free_callback _freeCallback = nullptr;
         UInt64 _size = 0;
@@ -124,7 +255,9 @@ namespace plzma {
         
         virtual bool opened() const override final;
         virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual SharedPtr<InStreamBase> clone() override final;
         
+        InMemStream(const SharedPtr<InStreamBase> & source, void * memory, const UInt64 size);
         InMemStream(const void * memory, const size_t size);
         InMemStream(void * memory, const size_t size, plzma_free_callback freeCallback);
         
@@ -165,6 +298,76 @@ namespace plzma {
         virtual ~InCallbackStream() noexcept;
     };
 
+    class InSequentialCallbackStream final : public InStreamBase {
+    private:
+        plzma_context _context;
+        plzma_in_stream_open_callback _openCallback = nullptr;
+        plzma_in_stream_close_callback _closeCallback = nullptr;
+        plzma_in_stream_read_callback _readCallback = nullptr;
+        bool _opened = false;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(InSequentialCallbackStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(ISequentialInStream) // the archive handlers must not query the seekable stream.
+        
+    public:
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(Read)(void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        
+        virtual void open() override final;
+        virtual void close() override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual bool sequential() const noexcept override final { return true; }
+        
+        InSequentialCallbackStream(plzma_in_stream_open_callback openCallback,
+                                   plzma_in_stream_close_callback closeCallback,
+                                   plzma_in_stream_read_callback readCallback,
+                                   const plzma_context context);
+        
+        virtual ~InSequentialCallbackStream() noexcept;
+    };
+
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    /// @brief Reads the content from the reading side of the owned pipe, i.e. \a CStreamBinder.
+    ///
+    /// The writing side blocks until the written chunk is read, so nothing is buffered by the pipe.
+    class InPipeStream final : public InStreamBase {
+    private:
+        CStreamBinder _binder;
+        CMyComPtr<ISequentialInStream> _reader; // destroyed before the binder.
+        bool _opened = false;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(InPipeStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(ISequentialInStream)
+        
+    public:
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(Read)(void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        
+        virtual void open() override final;
+        virtual void close() override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual bool sequential() const noexcept override final { return true; }
+        
+        /// @brief Closes the reading side of the pipe, the pending and next writes are cut.
+        void closeReader() noexcept;
+        
+        /// @brief Creates the pipe.
+        /// @param writer The writing side of the pipe. Must be released before the stream.
+        InPipeStream(CMyComPtr<ISequentialOutStream> & writer);
+        virtual ~InPipeStream() noexcept { }
+    };
+#endif
+
     class InMultiStream final : public InStreamBase {
     private:
         Vector<SharedPtr<InStreamBase> > _streams;
@@ -186,6 +389,7 @@ namespace plzma {
         
         virtual bool opened() const override final;
         virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual SharedPtr<InStreamBase> clone() override final;
         
         InMultiStream(InStreamArray && streams);
         virtual ~InMultiStream() noexcept;
@@ -0,0 +1,366 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#include <cstddef>
+
+#include "plzma_item_table.hpp"
+#include "plzma_common.hpp"
+#include "plzma_c_bindings_private.hpp"
+
+#include "CPP/Windows/PropVariant.h"
+
+namespace plzma {
+    
+    static size_t pathHash(const char * path) noexcept {
+        uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a
+        for (const unsigned char * p = reinterpret_cast<const unsigned char *>(path); *p; p++) {
+            hash = (hash ^ *p) * 0x100000001b3ULL;
+        }
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+    
+    static const char * nextCharacter(const char * path) noexcept {
+        path++;
+        while ((static_cast<unsigned char>(*path) & 0xC0) == 0x80) {
+            path++; // UTF-8 continuation byte
+        }
+        return path;
+    }
+    
+    static bool pathMatches(const char * path, const char * pattern) noexcept {
+        const char * star = nullptr, * starPath = nullptr;
+        while (*path) {
+            if (*pattern == '*') {
+                star = pattern++;
+                starPath = path;
+            } else if (*pattern == '?') {
+                pattern++;
+                path = nextCharacter(path);
+            } else if (*pattern == *path) {
+                pattern++;
+                path++;
+            } else if (star) {
+                pattern = star + 1;
+                path = starPath = nextCharacter(starPath);
+            } else {
+                return false;
+            }
+        }
+        while (*pattern == '*') {
+            pattern++;
+        }
+        return *pattern == 0;
+    }
+    
+    void ItemTableImpl::retain() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RETAIN_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void ItemTableImpl::release() {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        LIBPLZMA_RELEASE_IMPL(_referenceCounter)
+#else
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+#endif
+    }
+    
+    void ItemTableImpl::checkIndex(const plzma_size_t index) const {
+        if (index >= _count) {
+            throw Exception(plzma_error_code_invalid_arguments, "Item index out of bounds.", __FILE__, __LINE__);
+        }
+    }
+    
+    plzma_size_t ItemTableImpl::count() const noexcept {
+        return _count;
+    }
+    
+    const char * LIBPLZMA_NONNULL ItemTableImpl::pathAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const char * paths = _paths;
+        const size_t * offsets = _pathOffsets;
+        return paths + offsets[index];
+    }
+    
+    uint64_t ItemTableImpl::sizeAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const uint64_t * sizes = _sizes;
+        return sizes[index];
+    }
+    
+    uint64_t ItemTableImpl::packSizeAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const uint64_t * packSizes = _packSizes;
+        return packSizes[index];
+    }
+    
+    uint32_t ItemTableImpl::crc32At(const plzma_size_t index) const {
+        checkIndex(index);
+        const uint32_t * crc32s = _crc32s;
+        return crc32s[index];
+    }
+    
+    plzma_path_timestamp ItemTableImpl::timestampAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const plzma_path_timestamp * timestamps = _timestamps;
+        return timestamps[index];
+    }
+    
+    bool ItemTableImpl::encryptedAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const uint8_t * flags = _flags;
+        return (flags[index] & FlagEncrypted) != 0;
+    }
+    
+    bool ItemTableImpl::isDirAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const uint8_t * flags = _flags;
+        return (flags[index] & FlagIsDir) != 0;
+    }
+    
+    SharedPtr<Item> ItemTableImpl::itemAt(const plzma_size_t index) const {
+        checkIndex(index);
+        const uint8_t * flags = _flags;
+        auto item = makeShared<Item>(static_cast<Path &&>(Path(pathAt(index))), index);
+        item->setSize(sizeAt(index));
+        item->setPackSize(packSizeAt(index));
+        item->setCrc32(crc32At(index));
+        item->setTimestamp(timestampAt(index));
+        item->setEncrypted((flags[index] & FlagEncrypted) != 0);
+        item->setIsDir((flags[index] & FlagIsDir) != 0);
+        return item;
+    }
+    
+    void ItemTableImpl::buildPathIndex() const {
+        size_t capacity = 16;
+        while (capacity < (static_cast<size_t>(_count) * 2)) {
+            capacity <<= 1;
+        }
+        RawHeapMemory pathIndex(sizeof(plzma_size_t) * capacity);
+        plzma_size_t * slots = pathIndex;
+        memset(slots, 0, sizeof(plzma_size_t) * capacity);
+        const size_t mask = capacity - 1;
+        const char * paths = _paths;
+        const size_t * offsets = _pathOffsets;
+        for (plzma_size_t index = 0; index < _count; index++) {
+            const char * path = paths + offsets[index];
+            for (size_t slot = pathHash(path) & mask; ; slot = (slot + 1) & mask) {
+                if (slots[slot] == 0) {
+                    slots[slot] = index + 1;
+                    break;
+                } else if (strcmp(paths + offsets[slots[slot] - 1], path) == 0) {
+                    break; // the duplicated path, the first item is found
+                }
+            }
+        }
+        _pathIndexMask = mask;
+        _pathIndex = static_cast<RawHeapMemory &&>(pathIndex);
+    }
+    
+    bool ItemTableImpl::findIndex(const char * LIBPLZMA_NONNULL path, plzma_size_t & index) const {
+        {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            if (!_pathIndex) {
+                buildPathIndex();
+            }
+        }
+        const plzma_size_t * slots = _pathIndex;
+        const char * paths = _paths;
+        const size_t * offsets = _pathOffsets;
+        for (size_t slot = pathHash(path) & _pathIndexMask; slots[slot] != 0; slot = (slot + 1) & _pathIndexMask) {
+            if (strcmp(paths + offsets[slots[slot] - 1], path) == 0) {
+                index = slots[slot] - 1;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    SharedPtr<ItemArray> ItemTableImpl::findItems(const char * LIBPLZMA_NONNULL pattern) const {
+        auto items = makeShared<ItemArray>();
+        const char * paths = _paths;
+        const size_t * offsets = _pathOffsets;
+        for (plzma_size_t index = 0; index < _count; index++) {
+            if (pathMatches(paths + offsets[index], pattern)) {
+                items->push(itemAt(index));
+            }
+        }
+        return items;
+    }
+    
+    ItemTableImpl::ItemTableImpl(IInArchive * LIBPLZMA_NONNULL archive, const plzma_size_t count) :
+        _pathOffsets(sizeof(size_t) * count),
+        _sizes(sizeof(uint64_t) * count),
+        _packSizes(sizeof(uint64_t) * count),
+        _crc32s(sizeof(uint32_t) * count),
+        _timestamps(sizeof(plzma_path_timestamp) * count),
+        _flags(sizeof(uint8_t) * count) {
+            size_t * offsets = _pathOffsets;
+            uint64_t * sizes = _sizes;
+            uint64_t * packSizes = _packSizes;
+            uint32_t * crc32s = _crc32s;
+            plzma_path_timestamp * timestamps = _timestamps;
+            uint8_t * flags = _flags;
+            size_t poolSize = 0, poolCapacity = 0;
+            NWindows::NCOM::CPropVariant prop;
+            for (plzma_size_t index = 0; index < count; index++) {
+                prop.Clear();
+                const wchar_t * path = nullptr;
+                size_t pathLength = 0;
+                if (archive->GetProperty(index, kpidPath, &prop) == S_OK && prop.vt == VT_BSTR && prop.bstrVal) {
+                    path = prop.bstrVal;
+                    pathLength = ::SysStringLen(prop.bstrVal);
+                }
+                const size_t maxPathSize = (pathLength * 4) + 1; // the maximum UTF-8 bytes of the wide char plus null-terminator
+                if ((poolSize + maxPathSize) > poolCapacity) {
+                    poolCapacity = (poolCapacity * 2 > poolSize + maxPathSize) ? poolCapacity * 2 : poolSize + maxPathSize;
+                    _paths.resize(poolCapacity);
+                }
+                char * paths = _paths;
+                offsets[index] = poolSize;
+                if (path) {
+                    poolSize += WideToUTF8(path, pathLength, paths + poolSize, poolCapacity - poolSize) + 1;
+                } else {
+                    paths[poolSize++] = 0;
+                }
+                
+                prop.Clear();
+                sizes[index] = (archive->GetProperty(index, kpidSize, &prop) == S_OK) ? PROPVARIANTGetUInt64(prop) : 0;
+                
+                prop.Clear();
+                packSizes[index] = (archive->GetProperty(index, kpidPackSize, &prop) == S_OK) ? PROPVARIANTGetUInt64(prop) : 0;
+                
+                prop.Clear();
+                crc32s[index] = (archive->GetProperty(index, kpidCRC, &prop) == S_OK) ? static_cast<uint32_t>(PROPVARIANTGetUInt64(prop)) : 0;
+                
+                plzma_path_timestamp & timestamp = timestamps[index];
+                timestamp.last_access = timestamp.last_modification = timestamp.creation = 0;
+                prop.Clear();
+                if (archive->GetProperty(index, kpidCTime, &prop) == S_OK && prop.vt == VT_FILETIME) {
+                    timestamp.creation = FILETIMEToUnixTime(prop.filetime);
+                }
+                
+                prop.Clear();
+                if (archive->GetProperty(index, kpidATime, &prop) == S_OK && prop.vt == VT_FILETIME) {
+                    timestamp.last_access = FILETIMEToUnixTime(prop.filetime);
+                }
+                
+                prop.Clear();
+                if (archive->GetProperty(index, kpidMTime, &prop) == S_OK && prop.vt == VT_FILETIME) {
+                    timestamp.last_modification = FILETIMEToUnixTime(prop.filetime);
+                }
+                
+                uint8_t itemFlags = 0;
+                prop.Clear();
+                if (archive->GetProperty(index, kpidEncrypted, &prop) == S_OK && PROPVARIANTGetBool(prop)) {
+                    itemFlags |= FlagEncrypted;
+                }
+                
+                prop.Clear();
+                if (archive->GetProperty(index, kpidIsDir, &prop) == S_OK && PROPVARIANTGetBool(prop)) {
+                    itemFlags |= FlagIsDir;
+                }
+                flags[index] = itemFlags;
+            }
+            if (poolSize < poolCapacity) {
+                _paths.resize(poolSize); // the pool is immutable from now
+            }
+            _count = count;
+    }
+    
+} // namespace plzma
+
+
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+
+using namespace plzma;
+
+plzma_size_t plzma_item_table_count(const plzma_item_table * LIBPLZMA_NONNULL table) {
+    return table->exception ? 0 : static_cast<const ItemTable *>(table->object)->count();
+}
+
+const char * LIBPLZMA_NULLABLE plzma_item_table_path_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, nullptr)
+    return static_cast<const ItemTable *>(table->object)->pathAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, nullptr)
+}
+
+uint64_t plzma_item_table_size_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, 0)
+    return static_cast<const ItemTable *>(table->object)->sizeAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, 0)
+}
+
+uint64_t plzma_item_table_pack_size_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, 0)
+    return static_cast<const ItemTable *>(table->object)->packSizeAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, 0)
+}
+
+uint32_t plzma_item_table_crc32_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, 0)
+    return static_cast<const ItemTable *>(table->object)->crc32At(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, 0)
+}
+
+plzma_path_timestamp plzma_item_table_timestamp_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, (plzma_path_timestamp{0, 0, 0}))
+    return static_cast<const ItemTable *>(table->object)->timestampAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, (plzma_path_timestamp{0, 0, 0}))
+}
+
+bool plzma_item_table_encrypted_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, false)
+    return static_cast<const ItemTable *>(table->object)->encryptedAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, false)
+}
+
+bool plzma_item_table_is_dir_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_TRY_RETURN(table, false)
+    return static_cast<const ItemTable *>(table->object)->isDirAt(index);
+    LIBPLZMA_C_BINDINGS_OBJECT_EXEC_CATCH_RETURN(table, false)
+}
+
+plzma_item plzma_item_table_item_at(plzma_item_table * LIBPLZMA_NONNULL table, const plzma_size_t index) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_FROM_TRY(plzma_item, table)
+    auto item = static_cast<const ItemTable *>(table->object)->itemAt(index);
+    createdCObject.object = static_cast<void *>(item.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+void plzma_item_table_release(plzma_item_table * LIBPLZMA_NONNULL table) {
+    plzma_object_exception_release(table);
+    SharedPtr<ItemTable> tableSPtr;
+    tableSPtr.assign(static_cast<ItemTable *>(table->object));
+    table->object = nullptr;
+}
+
+#endif // !LIBPLZMA_NO_C_BINDINGS
@@ -0,0 +1,99 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef __PLZMA_ITEM_TABLE_HPP__
+#define __PLZMA_ITEM_TABLE_HPP__ 1
+
+#include <cstddef>
+
+#include "../libplzma.hpp"
+#include "plzma_private.hpp"
+#include "plzma_mutex.hpp"
+
+#include "CPP/Common/Common.h"
+#include "CPP/Common/MyWindows.h"
+#include "CPP/Common/MyCom.h"
+#include "CPP/7zip/Archive/IArchive.h"
+
+namespace plzma {
+    
+    class ItemTableImpl final : public ItemTable {
+    private:
+        friend struct SharedPtr<ItemTableImpl>;
+        enum Flag : uint8_t {
+            FlagEncrypted = 1 << 0,
+            FlagIsDir = 1 << 1
+        };
+        
+        LIBPLZMA_MUTEX(mutable _mutex)
+        RawHeapMemory _paths;       // the pool of the null-terminated UTF-8 paths
+        RawHeapMemory _pathOffsets; // size_t, the offset of the path in the pool
+        RawHeapMemory _sizes;       // uint64_t
+        RawHeapMemory _packSizes;   // uint64_t
+        RawHeapMemory _crc32s;      // uint32_t
+        RawHeapMemory _timestamps;  // plzma_path_timestamp
+        RawHeapMemory _flags;       // uint8_t, combination of the Flag
+        mutable RawHeapMemory _pathIndex; // plzma_size_t, the open addressing hash table of the item index + 1, 0 - empty slot
+        mutable size_t _pathIndexMask = 0;
+        plzma_size_t _count = 0;
+        plzma_size_t _referenceCounter = 0;
+        
+        virtual void retain() override final;
+        virtual void release() override final;
+        
+        void checkIndex(const plzma_size_t index) const;
+        void buildPathIndex() const;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(ItemTableImpl)
+        
+    public:
+        virtual plzma_size_t count() const noexcept override final;
+        virtual const char * LIBPLZMA_NONNULL pathAt(const plzma_size_t index) const override final;
+        virtual uint64_t sizeAt(const plzma_size_t index) const override final;
+        virtual uint64_t packSizeAt(const plzma_size_t index) const override final;
+        virtual uint32_t crc32At(const plzma_size_t index) const override final;
+        virtual plzma_path_timestamp timestampAt(const plzma_size_t index) const override final;
+        virtual bool encryptedAt(const plzma_size_t index) const override final;
+        virtual bool isDirAt(const plzma_size_t index) const override final;
+        virtual SharedPtr<Item> itemAt(const plzma_size_t index) const override final;
+        
+        /// @brief Finds the first item with exactly the same UTF-8 path via the hash index of the paths.
+        /// The index is built once, during the first call.
+        bool findIndex(const char * LIBPLZMA_NONNULL path, plzma_size_t & index) const;
+        
+        /// @brief Finds all items with the UTF-8 paths matching the glob pattern.
+        SharedPtr<ItemArray> findItems(const char * LIBPLZMA_NONNULL pattern) const;
+        
+        /// @brief Reads the properties of all items of the opened archive via a single pass.
+        ItemTableImpl(IInArchive * LIBPLZMA_NONNULL archive, const plzma_size_t count);
+        virtual ~ItemTableImpl() noexcept = default;
+    };
+    
+} // namespace plzma
+
+#endif // !__PLZMA_ITEM_TABLE_HPP__
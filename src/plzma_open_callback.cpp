@@ -56,10 +56,22 @@ namespace plzma {
         CMyComPtr<OpenCallback> selfPtr(this);
         
         LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
-        HRESULT result = _archive->Open(_stream, nullptr, this);
+        HRESULT result = S_OK;
+        if (_stream->sequential()) {
+            CMyComPtr<IArchiveOpenSeq> openSeq;
+            result = _archive.QueryInterface(IID_IArchiveOpenSeq, &openSeq);
+            if (result == S_OK) {
+                result = openSeq->OpenSeq(_stream);
+            }
+        } else {
+            result = _archive->Open(_stream, nullptr, this);
+        }
         UInt32 numItems = 0;
         if (result == S_OK) {
             result = _archive->GetNumberOfItems(&numItems);
+            if (numItems == static_cast<UInt32>(static_cast<Int32>(-1))) {
+                numItems = 0; // the items of the sequential tar archive are unknown until extracting.
+            }
         }
         LIBPLZMA_UNIQUE_LOCK_LOCK(lock)
         
@@ -91,7 +103,7 @@ namespace plzma {
         _itemsCount = 0;
     }
     
-    CMyComPtr<IInArchive> OpenCallback::archive() const noexcept {
+    IInArchive * OpenCallback::archive() const noexcept {
         return _archive;
     }
     
@@ -76,7 +76,7 @@ namespace plzma {
         // ICryptoGetTextPassword2
         STDMETHOD(CryptoGetTextPassword2)(Int32 * passwordIsDefined, BSTR * password) throw() override final;
         
-        CMyComPtr<IInArchive> archive() const noexcept;
+        IInArchive * archive() const noexcept; // owned by the open callback
         bool open();
         void abort();
         plzma_size_t itemsCount() noexcept;
@@ -163,45 +163,62 @@ namespace plzma {
     }
     
     /// OutMemStream
+    static const uint64_t kOutMemStreamMinCapacity = 4 * 1024;
+    
+    HRESULT OutMemStream::resizeMemory(const uint64_t capacity) noexcept {
+        try {
+            _memory.resize(static_cast<size_t>(capacity));
+            _capacity = capacity;
+            return S_OK;
+        }
+        catch (const Exception & exception) {
+            delete _exception;
+            _exception = exception.moveToHeapCopy();
+        }
+#if defined(LIBPLZMA_HAVE_STD)
+        catch (const std::exception & exception) {
+            delete _exception;
+            _exception = Exception::create(plzma_error_code_internal, exception.what(), __FILE__, __LINE__);
+        }
+#endif
+        catch (...) {
+            delete _exception;
+            _exception = Exception::create(plzma_error_code_not_enough_memory, "Can't write to out memory stream.", __FILE__, __LINE__);
+        }
+        _size = _offset = 0;
+        _opened = false;
+        return E_OUTOFMEMORY;
+    }
+    
     STDMETHODIMP OutMemStream::Write(const void * data, UInt32 size, UInt32 * processedSize) throw() {
         if (_opened) {
             const uint64_t dstSize = _offset + static_cast<uint64_t>(size);
-            if (_size < dstSize) {
-                if (dstSize >= plzma_max_size()) {
+            if (_capacity < dstSize) {
+                const uint64_t maxSize = plzma_max_size();
+                if (dstSize >= maxSize) {
                     _size = _offset = 0;
                     _opened = false;
                     return E_OUTOFMEMORY;
                 }
-                try {
-                    _memory.resize(static_cast<size_t>(dstSize));
-                }
-                catch (const Exception & exception) {
-                    _size = _offset = 0;
-                    _opened = false;
-                    delete _exception;
-                    _exception = exception.moveToHeapCopy();
-                    return E_OUTOFMEMORY;
+                // Amortized geometric growth, the number of reallocations is logarithmic to the content size.
+                uint64_t capacity = (_capacity < (maxSize / 2)) ? (_capacity * 2) : (maxSize - 1);
+                if (capacity < kOutMemStreamMinCapacity) {
+                    capacity = kOutMemStreamMinCapacity;
                 }
-#if defined(LIBPLZMA_HAVE_STD)
-                catch (const std::exception & exception) {
-                    _size = _offset = 0;
-                    _opened = false;
-                    delete _exception;
-                    _exception = Exception::create(plzma_error_code_internal, exception.what(), __FILE__, __LINE__);
-                    return E_OUTOFMEMORY;
+                if (capacity < dstSize) {
+                    capacity = dstSize;
                 }
-#endif
-                catch (...) {
-                    _size = _offset = 0;
-                    _opened = false;
-                    delete _exception;
-                    _exception = Exception::create(plzma_error_code_not_enough_memory, "Can't write to out memory stream.", __FILE__, __LINE__);
-                    return E_OUTOFMEMORY;
+                const HRESULT res = resizeMemory(capacity);
+                if (res != S_OK) {
+                    LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+                    return res;
                 }
-                _size = dstSize;
             }
             memcpy(static_cast<uint8_t *>(_memory) + _offset, data, static_cast<size_t>(size));
             _offset += size;
+            if (_size < _offset) {
+                _size = _offset;
+            }
             LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, size)
             return S_OK;
         }
@@ -245,32 +262,13 @@ namespace plzma {
                 _opened = false;
                 return E_OUTOFMEMORY;
             }
-            try {
-                _memory.resize(static_cast<size_t>(newSize));
-            } catch (const Exception & exception) {
-                _size = _offset = 0;
-                _opened = false;
-                delete _exception;
-                _exception = exception.moveToHeapCopy();
-                return E_OUTOFMEMORY;
-            }
-#if defined(LIBPLZMA_HAVE_STD)
-            catch (const std::exception & exception) {
-                _size = _offset = 0;
-                _opened = false;
-                delete _exception;
-                _exception = Exception::create(plzma_error_code_internal, exception.what(), __FILE__, __LINE__);
-                return E_OUTOFMEMORY;
-            }
-#endif
-            catch (...) {
-                _size = _offset = 0;
-                _opened = false;
-                delete _exception;
-                _exception = Exception::create(plzma_error_code_not_enough_memory, "Can't set out memory stream size.", __FILE__, __LINE__);
-                return E_OUTOFMEMORY;
+            if (_capacity < newSize) {
+                RINOK(resizeMemory(newSize))
             }
             _size = static_cast<uint64_t>(newSize);
+            if (_offset > _size) {
+                _offset = _size;
+            }
             return S_OK;
         }
         return S_FALSE;
@@ -306,8 +304,8 @@ namespace plzma {
         if (_opened) {
             return false; // opened -> false
         }
-        _memory.clear(eraseType);
-        _size = _offset = 0;
+        _memory.clear(eraseType, static_cast<size_t>(_capacity));
+        _capacity = _size = _offset = 0;
         return true;
     }
     
@@ -323,11 +321,165 @@ namespace plzma {
         return content;
     }
     
+    void OutMemStream::reserve(const uint64_t size) noexcept {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (size > _capacity && size < plzma_max_size()) {
+            try {
+                _memory.resize(static_cast<size_t>(size));
+                _capacity = size;
+            } catch (...) {
+                // The reservation is only a hint, the memory will grow during the writing.
+            }
+        }
+    }
+    
+    OutMemStream::OutMemStream(const uint64_t expectedSize) noexcept : OutStreamBase() {
+        if (expectedSize > 0) {
+            reserve(expectedSize);
+        }
+    }
+    
     OutMemStream::~OutMemStream() noexcept {
         delete _exception;
         _exception = nullptr;
     }
     
+    /// OutArenaStream
+    STDMETHODIMP OutArenaStream::Write(const void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_opened) {
+            const uint64_t dstSize = _offset + static_cast<uint64_t>(size);
+            if (dstSize > _capacity) {
+                _opened = false;
+                delete _exception;
+                _exception = Exception::create(plzma_error_code_internal, "The item content exceeds the reserved arena size.", __FILE__, __LINE__);
+                LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+                return E_FAIL;
+            }
+            if (size > 0) {
+                memcpy(_memory + _offset, data, size);
+            }
+            _offset = dstSize;
+            if (_size < dstSize) {
+                _size = dstSize;
+            }
+            LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, size)
+            return S_OK;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return S_FALSE;
+    }
+    
+    STDMETHODIMP OutArenaStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        if (_opened) {
+            Int64 finalOffset;
+            switch (seekOrigin) {
+                case STREAM_SEEK_SET:
+                    finalOffset = offset;
+                    break;
+                case STREAM_SEEK_CUR:
+                    finalOffset = _offset;
+                    finalOffset += offset;
+                    break;
+                case STREAM_SEEK_END:
+                    finalOffset = _size;
+                    finalOffset += offset;
+                    break;
+                default:
+                    finalOffset = -1;
+                    break;
+            }
+            if (finalOffset >= 0 && static_cast<UInt64>(finalOffset) <= _size) {
+                _offset = finalOffset;
+                LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, _offset)
+                return S_OK;
+            }
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0)
+        return S_FALSE;
+    }
+    
+    STDMETHODIMP OutArenaStream::SetSize(UInt64 newSize) throw() {
+        if (_opened) {
+            if (newSize > _capacity) {
+                _opened = false;
+                delete _exception;
+                _exception = Exception::create(plzma_error_code_internal, "The item content exceeds the reserved arena size.", __FILE__, __LINE__);
+                return E_FAIL;
+            }
+            _size = newSize;
+            if (_offset > _size) {
+                _offset = _size;
+            }
+            return S_OK;
+        }
+        return S_FALSE;
+    }
+    
+    bool OutArenaStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    void OutArenaStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (!_opened) {
+            _size = _offset = 0;
+            _opened = true;
+        }
+    }
+    
+    void OutArenaStream::close() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _offset = 0;
+        _opened = false;
+    }
+    
+    Exception * OutArenaStream::takeException() noexcept {
+        Exception * exception = _exception;
+        _exception = nullptr;
+        return exception;
+    }
+    
+    bool OutArenaStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            return false; // opened -> false
+        }
+        if (eraseType == plzma_erase_zero && _size > 0) {
+            memset(_memory, 0, static_cast<size_t>(_size));
+        }
+        _size = _offset = 0;
+        return true;
+    }
+    
+    RawHeapMemorySize OutArenaStream::copyContent() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        RawHeapMemorySize content(RawHeapMemory(), 0);
+        if (!_opened && _size > 0) {
+            const size_t size = static_cast<size_t>(_size);
+            content.first.resize(size);
+            memcpy(static_cast<void *>(content.first), static_cast<const void *>(_memory), size);
+            content.second = size;
+        }
+        return content;
+    }
+    
+    uint64_t OutArenaStream::size() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _size;
+    }
+    
+    OutArenaStream::OutArenaStream(void * memory, const uint64_t capacity) noexcept : OutStreamBase(),
+        _memory(static_cast<uint8_t *>(memory)),
+        _capacity(capacity) {
+        
+    }
+    
+    OutArenaStream::~OutArenaStream() noexcept {
+        delete _exception;
+        _exception = nullptr;
+    }
+    
     /// OutTestStream
     STDMETHODIMP OutTestStream::Write(const void * data, UInt32 size, UInt32 * processedSize) throw() {
         if (_opened) {
@@ -373,6 +525,138 @@ namespace plzma {
         return RawHeapMemorySize(RawHeapMemory(), 0);
     }
 
+    /// OutSequentialCallbackStream
+    STDMETHODIMP OutSequentialCallbackStream::Write(const void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_opened && (size == 0 || _writeCallback(_context.context, data, size))) {
+            LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, size)
+            return S_OK;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return S_FALSE;
+    }
+    
+    STDMETHODIMP OutSequentialCallbackStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0)
+        return E_NOTIMPL; // sequential
+    }
+    
+    STDMETHODIMP OutSequentialCallbackStream::SetSize(UInt64 newSize) throw() {
+        return E_NOTIMPL; // sequential
+    }
+    
+    bool OutSequentialCallbackStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    void OutSequentialCallbackStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (!_opened && !(_opened = _openCallback(_context.context))) {
+            throw Exception(plzma_error_code_io, "Can't open out-stream using open callback.", __FILE__, __LINE__);
+        }
+    }
+    
+    void OutSequentialCallbackStream::close() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        if (_opened) {
+            _opened = false;
+            _closeCallback(_context.context);
+        }
+    }
+    
+    bool OutSequentialCallbackStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        // no erase functionality for a stream with user-defined callbacks.
+        return !_opened; // opened -> false
+    }
+    
+    RawHeapMemorySize OutSequentialCallbackStream::copyContent() const {
+        // nothing to copy, the content is written via callback
+        return RawHeapMemorySize(RawHeapMemory(), 0);
+    }
+    
+    OutSequentialCallbackStream::OutSequentialCallbackStream(plzma_out_stream_open_callback openCallback,
+                                                             plzma_out_stream_close_callback closeCallback,
+                                                             plzma_out_stream_write_callback writeCallback,
+                                                             const plzma_context context) : OutStreamBase(),
+        _context(context),
+        _openCallback(openCallback),
+        _closeCallback(closeCallback),
+        _writeCallback(writeCallback) {
+            if (!_openCallback || !_closeCallback || !_writeCallback) {
+                Exception exception(plzma_error_code_invalid_arguments, "Can't instantiate out-stream without required callback.", __FILE__, __LINE__);
+                if (!_openCallback) { exception.setReason("The open callback is null.", nullptr); }
+                else if (!_closeCallback) { exception.setReason("The close callback is null.", nullptr); }
+                else if (!_writeCallback) { exception.setReason("The write callback is null.", nullptr); }
+                throw exception;
+            }
+    }
+    
+    OutSequentialCallbackStream::~OutSequentialCallbackStream() noexcept {
+        if (_opened) {
+            _closeCallback(_context.context);
+        }
+        if (_context.context && _context.deinitializer) {
+            _context.deinitializer(_context.context);
+        }
+    }
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    /// OutPipeStream
+    STDMETHODIMP OutPipeStream::Write(const void * data, UInt32 size, UInt32 * processedSize) throw() {
+        if (_opened && _writer) {
+            const HRESULT res = _writer->Write(data, size, processedSize);
+            // The reading side is closed, stop the decoding without an error.
+            return (res == k_My_HRESULT_WritingWasCut) ? E_ABORT : res;
+        }
+        LIBPLZMA_CAST_VALUE_TO_PTR(processedSize, UInt32, 0)
+        return S_FALSE;
+    }
+    
+    STDMETHODIMP OutPipeStream::Seek(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() {
+        LIBPLZMA_CAST_VALUE_TO_PTR(newPosition, UInt64, 0)
+        return E_NOTIMPL; // sequential
+    }
+    
+    STDMETHODIMP OutPipeStream::SetSize(UInt64 newSize) throw() {
+        return E_NOTIMPL; // sequential
+    }
+    
+    bool OutPipeStream::opened() const {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        return _opened;
+    }
+    
+    void OutPipeStream::open() {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        _opened = (_writer != nullptr);
+    }
+    
+    void OutPipeStream::close() {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        CMyComPtr<ISequentialOutStream> writer(static_cast<CMyComPtr<ISequentialOutStream> &&>(_writer));
+        _opened = false;
+        LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+        writer.Release(); // the last reference closes the writing side
+    }
+    
+    bool OutPipeStream::erase(const plzma_erase eraseType) {
+        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        // nothing to erase, the content is not stored
+        return !_opened; // opened -> false
+    }
+    
+    RawHeapMemorySize OutPipeStream::copyContent() const {
+        // nothing to copy, the content is not stored
+        return RawHeapMemorySize(RawHeapMemory(), 0);
+    }
+    
+    OutPipeStream::OutPipeStream(const CMyComPtr<ISequentialOutStream> & writer) noexcept : OutStreamBase(),
+        _writer(writer) {
+        
+    }
+#endif
+    
     /// OutMultiStreamBase
     STDMETHODIMP OutMultiStreamBase::Write(const void * data, UInt32 size, UInt32 * processedSize) throw() {
         if (_opened) {
@@ -750,6 +1034,17 @@ namespace plzma {
     SharedPtr<OutStream> makeSharedOutStream(void) {
         return SharedPtr<OutStream>(new OutMemStream());
     }
+    
+    SharedPtr<OutStream> makeSharedOutStream(const uint64_t expectedSize) {
+        return SharedPtr<OutStream>(new OutMemStream(expectedSize));
+    }
+    
+    SharedPtr<OutStream> makeSharedSequentialOutStream(plzma_out_stream_open_callback openCallback,
+                                                       plzma_out_stream_close_callback closeCallback,
+                                                       plzma_out_stream_write_callback writeCallback,
+                                                       const plzma_context context) {
+        return SharedPtr<OutStream>(new OutSequentialCallbackStream(openCallback, closeCallback, writeCallback, context));
+    }
 
     SharedPtr<OutMultiStream> makeSharedOutMultiStream(const Path & dirPath,
                                                        const String & partName,
@@ -805,6 +1100,23 @@ plzma_out_stream plzma_out_stream_create_memory_stream(void) {
     LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
 }
 
+plzma_out_stream plzma_out_stream_create_memory_stream_with_expected_size(const uint64_t expected_size) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_TRY(plzma_out_stream)
+    auto stream = makeSharedOutStream(expected_size);
+    createdCObject.object = static_cast<void *>(stream.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
+plzma_out_stream plzma_out_stream_create_sequential_with_callbacks(plzma_out_stream_open_callback LIBPLZMA_NONNULL open_callback,
+                                                                   plzma_out_stream_close_callback LIBPLZMA_NONNULL close_callback,
+                                                                   plzma_out_stream_write_callback LIBPLZMA_NONNULL write_callback,
+                                                                   const plzma_context context) {
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_TRY(plzma_out_stream)
+    auto stream = makeSharedSequentialOutStream(open_callback, close_callback, write_callback, context);
+    createdCObject.object = static_cast<void *>(stream.take());
+    LIBPLZMA_C_BINDINGS_CREATE_OBJECT_CATCH
+}
+
 plzma_memory plzma_out_stream_copy_content(plzma_out_stream * LIBPLZMA_NONNULL stream) {
     plzma_memory createdCObject;
     createdCObject.memory = nullptr;
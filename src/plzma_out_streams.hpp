@@ -63,6 +63,12 @@ namespace plzma {
         virtual void close() = 0;
         virtual Exception * takeException() noexcept { return nullptr; }
         
+        /// @brief Hints the expected size of the content, before writing. Has no effect by default.
+        virtual void reserve(const uint64_t size) noexcept { }
+        
+        /// @return The stream can't be seeked, the content is written only once from the beginning to the end.
+        virtual bool sequential() const noexcept { return false; }
+        
         OutStreamBase();
         virtual ~OutStreamBase() noexcept { }
     };
@@ -107,10 +113,13 @@ namespace plzma {
     private:
         RawHeapMemory _memory;
         Exception * _exception = nullptr;
+        uint64_t _capacity = 0;
         uint64_t _size = 0;
         uint64_t _offset = 0;
         bool _opened = false;
         
+        HRESULT resizeMemory(const uint64_t capacity) noexcept;
+        
     protected:
         LIBPLZMA_NON_COPYABLE_NON_MOVABLE(OutMemStream)
         
@@ -131,10 +140,57 @@ namespace plzma {
         virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
         RawHeapMemorySize copyContent() const override final;
         
-        OutMemStream() = default;
+        /// @brief Preallocates the memory for the expected size of the content.
+        virtual void reserve(const uint64_t size) noexcept override final;
+        
+        /// @return The size of the allocated memory, which is not less than the content size.
+        uint64_t capacity() const {
+            LIBPLZMA_LOCKGUARD(lock, _mutex)
+            return _capacity;
+        }
+        
+        OutMemStream(const uint64_t expectedSize = 0) noexcept;
         virtual ~OutMemStream() noexcept;
     };
     
+    /// @brief The out-stream which writes to a fixed region of the externally owned arena memory.
+    /// Doesn't own or reallocate the memory, the content can't exceed the region size.
+    class OutArenaStream final : public OutStreamBase {
+    private:
+        uint8_t * _memory = nullptr;
+        Exception * _exception = nullptr;
+        uint64_t _capacity = 0;
+        uint64_t _size = 0;
+        uint64_t _offset = 0;
+        bool _opened = false;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(OutArenaStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(IOutStream)
+        
+    public:
+        STDMETHOD(Write)(const void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(SetSize)(UInt64 newSize) throw() override final;
+        
+        virtual void setTimestamp(const plzma_path_timestamp & timestamp) override final { }
+        virtual void open() override final;
+        virtual void close() override final;
+        virtual Exception * takeException() noexcept override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual RawHeapMemorySize copyContent() const override final;
+        
+        /// @return The number of written bytes.
+        uint64_t size() const;
+        
+        OutArenaStream(void * memory, const uint64_t capacity) noexcept;
+        virtual ~OutArenaStream() noexcept;
+    };
+    
     class OutTestStream final : public OutStreamBase {
     private:
         bool _opened;
@@ -161,6 +217,76 @@ namespace plzma {
         OutTestStream() = default;
         virtual ~OutTestStream() noexcept { }
     };
+    
+    class OutSequentialCallbackStream final : public OutStreamBase {
+    private:
+        plzma_context _context;
+        plzma_out_stream_open_callback _openCallback = nullptr;
+        plzma_out_stream_close_callback _closeCallback = nullptr;
+        plzma_out_stream_write_callback _writeCallback = nullptr;
+        bool _opened = false;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(OutSequentialCallbackStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(ISequentialOutStream) // the archive handlers must not query the seekable stream.
+        
+    public:
+        STDMETHOD(Write)(const void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(SetSize)(UInt64 newSize) throw() override final;
+        
+        virtual void setTimestamp(const plzma_path_timestamp & timestamp) override final { }
+        virtual void open() override final;
+        virtual void close() override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual RawHeapMemorySize copyContent() const override final;
+        virtual bool sequential() const noexcept override final { return true; }
+        
+        OutSequentialCallbackStream(plzma_out_stream_open_callback openCallback,
+                                    plzma_out_stream_close_callback closeCallback,
+                                    plzma_out_stream_write_callback writeCallback,
+                                    const plzma_context context);
+        
+        virtual ~OutSequentialCallbackStream() noexcept;
+    };
+    
+#if !defined(LIBPLZMA_THREAD_UNSAFE)
+    /// @brief Forwards the written content to the writing side of a pipe, i.e. \a CStreamBinder.
+    /// The writing blocks until the content is read from the reading side of the pipe.
+    class OutPipeStream final : public OutStreamBase {
+    private:
+        CMyComPtr<ISequentialOutStream> _writer;
+        bool _opened = false;
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(OutPipeStream)
+        
+    public:
+        Z7_COM_UNKNOWN_IMP_1(IOutStream)
+        
+    public:
+        STDMETHOD(Write)(const void * data, UInt32 size, UInt32 * processedSize) throw() override final;
+        STDMETHOD(Seek)(Int64 offset, UInt32 seekOrigin, UInt64 * newPosition) throw() override final;
+        STDMETHOD(SetSize)(UInt64 newSize) throw() override final;
+        
+        virtual void setTimestamp(const plzma_path_timestamp & timestamp) override final { }
+        virtual void open() override final;
+        
+        /// @brief Closes the writing side of the pipe, the reader receives the end of the content.
+        virtual void close() override final;
+        
+        virtual bool opened() const override final;
+        virtual bool erase(const plzma_erase eraseType = plzma_erase_none) override final;
+        virtual RawHeapMemorySize copyContent() const override final;
+        
+        OutPipeStream(const CMyComPtr<ISequentialOutStream> & writer) noexcept;
+        virtual ~OutPipeStream() noexcept { }
+    };
+#endif
 
     class OutMultiStreamBase : public OutStreamBase, public OutMultiStream {
     private:
@@ -366,7 +366,7 @@ namespace pathUtils {
                             pathCopy.erase(plzma_erase_zero, sizeof(T) * len);
                             return false;
                         }
-                    } else if (!createSingleDir<T>(pathCopy)) {
+                    } else if (!createSingleDir<T>(pathCopy) && !(pathExists<T>(pathCopy, &isDir) && isDir)) { // might be created by another thread
                         pathCopy.erase(plzma_erase_zero, sizeof(T) * len);
                         return false;
                     }
@@ -377,7 +377,8 @@ namespace pathUtils {
                 *s1++ = *cs1++;
             }
         }
-        const bool res = (l1 > 0 && !createSingleDir<T>(pathCopy)) ? false : true;
+        bool isDir = false;
+        const bool res = (l1 > 0 && !createSingleDir<T>(pathCopy) && !(pathExists<T>(pathCopy, &isDir) && isDir)) ? false : true;
         pathCopy.erase(plzma_erase_zero, sizeof(T) * len);
         return res;
     }
@@ -177,6 +177,12 @@ typedef uint32_t DWORD;
 #endif // LIBPLZMA_OS_WINDOWS
 
 
+#if defined(LIBPLZMA_MULTITHREAD) && defined(LIBPLZMA_THREAD_UNSAFE)
+#  error "Configuration error: the multithreaded build can't be thread unsafe."
+#endif
+
+#if !defined(LIBPLZMA_MULTITHREAD)
+
 #ifndef USE_MIXER_ST
 #  define USE_MIXER_ST
 #endif
@@ -189,6 +195,8 @@ typedef uint32_t DWORD;
 #  define Z7_ST 1
 #endif
 
+#endif // !LIBPLZMA_MULTITHREAD
+
 #if defined(LIBPLZMA_NO_TAR)
 #  define LIBPLZMA_NO_TAR_EXCEPTION_WHAT "The tar(tarball) support was explicitly disabled. Use cmake option 'LIBPLZMA_OPT_NO_TAR:BOOL=OFF' or undefine 'LIBPLZMA_NO_TAR' preprocessor definition globally to enable tar(tarball) support."
 #endif
@@ -199,6 +207,25 @@ typedef uint32_t DWORD;
 #  define LIBPLZMA_NO_CRYPTO_EXCEPTION_WHAT "The crypto functionality was explicitly disabled. Use cmake option 'LIBPLZMA_OPT_NO_CRYPTO:BOOL=OFF' or undefine 'LIBPLZMA_NO_CRYPTO' preprocessor definition globally to enable crypto functionality."
 #endif // LIBPLZMA_NO_CRYPTO
 
+// The x86-64 assembler LZMA decoder kernel, src/Asm/x86/LzmaDecOpt.S, has the same condition.
+#if defined(LIBPLZMA_LZMA_DEC_ASM) && defined(__x86_64__) && !defined(_WIN32) && !defined(__CYGWIN__) && !defined(Z7_LZMA_PROB32)
+#  if !defined(Z7_LZMA_DEC_OPT)
+#    define Z7_LZMA_DEC_OPT 1
+#  endif
+#endif
+
+// The x86/x86-64 hardware kernels selected at runtime: CRC32, CRC64, AES and SHA-256.
+#if defined(LIBPLZMA_CPU_DISPATCH) && (defined(__x86_64__) || defined(__i386__) || ((defined(_M_X64) || defined(_M_IX86)) && !defined(_M_ARM64EC)))
+#  if !defined(LIBPLZMA_CPU_DISPATCH_X86)
+#    define LIBPLZMA_CPU_DISPATCH_X86 1
+#  endif
+#  if !defined(LIBPLZMA_CRC_CLMUL)
+#    if (defined(__clang__) && (__clang_major__ >= 4)) || (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ >= 5)) || (!defined(__clang__) && defined(_MSC_VER))
+#      define LIBPLZMA_CRC_CLMUL 1
+#    endif
+#  endif
+#endif
+
 #if defined(DEBUG)
 #  define LIBPLZMA_DEBUG_ASSERT(ASSERT_CONDITION) assert(ASSERT_CONDITION);
 #else // !DEBUG
@@ -85,6 +85,12 @@ namespace plzma {
     /// CDecoder default: 1 << 22
     LIBPLZMA_CPP_API_PRIVATE(plzma_size_t) kDecoderWriteSize;
     
+    /// Progress default: 0.0, every change is reported
+    LIBPLZMA_CPP_API_PRIVATE(double) kProgressMinInterval;
+    
+    /// Progress default: 0.0, every change is reported
+    LIBPLZMA_CPP_API_PRIVATE(double) kProgressMinDelta;
+    
     LIBPLZMA_CPP_API_PRIVATE(void) initialize(void) noexcept;
 
 } // namespace plzma
@@ -30,6 +30,7 @@
 #include "../libplzma.hpp"
 #include "plzma_private.hpp"
 #include "plzma_progress.hpp"
+#include "plzma_common.hpp"
 
 #if !defined(LIBPLZMA_NO_PROGRESS)
 
@@ -45,6 +46,14 @@ namespace plzma {
     void Progress::release() noexcept {
         LIBPLZMA_RELEASE_IMPL(_referenceCounter)
     }
+    
+    void Progress::ReportPath::retain() noexcept {
+        LIBPLZMA_RETAIN_IMPL(_referenceCounter)
+    }
+    
+    void Progress::ReportPath::release() noexcept {
+        LIBPLZMA_RELEASE_IMPL(_referenceCounter)
+    }
 #else
     void Progress::retain() {
         LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
@@ -53,6 +62,14 @@ namespace plzma {
     void Progress::release() {
         LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
     }
+    
+    void Progress::ReportPath::retain() {
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+    
+    void Progress::ReportPath::release() {
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
 #endif
     
     bool Progress::calculateReportable() const noexcept {
@@ -63,6 +80,26 @@ namespace plzma {
 #endif
     }
     
+    bool Progress::throttled(const bool pathChanged) noexcept {
+        if (_progress >= 1.0) {
+            return false; // the completion is always reported
+        }
+        const double minDelta = kProgressMinDelta;
+        if (!pathChanged && minDelta > 0.0 && (_progress - _reportedProgress) < minDelta) {
+            return true;
+        }
+        const double minInterval = kProgressMinInterval;
+        if (minInterval > 0.0) {
+            const double time = MonotonicTime();
+            if ((_reportedTime >= 0.0) && ((time - _reportedTime) < minInterval)) {
+                return true;
+            }
+            _reportedTime = time;
+        }
+        _reportedProgress = _progress;
+        return false;
+    }
+    
     void Progress::updateProgress() noexcept {
         _progress = (_partNumber > 0) ? (_perPart * (_partNumber - 1)) : 0.0;
         if (_partTotal > 0) {
@@ -71,13 +108,35 @@ namespace plzma {
         }
     }
     
+    void Progress::updateChild(const uint64_t prevTotal, const uint64_t total, const uint64_t prevCompleted, const uint64_t completed) {
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        _partTotal = _partTotal - prevTotal + total;
+        _partCompleted = _partCompleted - prevCompleted + completed;
+        const auto prevProgress = _progress;
+        updateProgress();
+        if (_progress < prevProgress) {
+            _progress = prevProgress; // the totals of the children are known only after their start
+        }
+        if (_reportable && prevProgress != _progress && !throttled(false)) {
+            const auto report = reportData();
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            report.report();
+        }
+    }
+    
     void Progress::reset() {
-        LIBPLZMA_LOCKGUARD(lock, _mutex)
-        _path.clear(plzma_erase_zero);
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        const uint64_t prevTotal = _partTotal, prevCompleted = _partCompleted;
+        _path.clear();
         _partsCount = 1;
         _partNumber = 0;
         _partCompleted = _partTotal = 0;
-        _progress = _perPart = 0.0;
+        _progress = _perPart = _reportedProgress = 0.0;
+        _reportedTime = -1.0;
+        if (_parent) {
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            _parent->updateChild(prevTotal, 0, prevCompleted, 0);
+        }
     }
     
     void Progress::setDelegate(ProgressDelegate * delegate) {
@@ -123,17 +182,29 @@ namespace plzma {
     }
     
     void Progress::startPart() {
-        LIBPLZMA_LOCKGUARD(lock, _mutex)
+        LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        const uint64_t prevTotal = _partTotal, prevCompleted = _partCompleted;
         _partNumber++;
         _partCompleted = _partTotal = 0;
+        if (_parent) {
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            _parent->updateChild(prevTotal, 0, prevCompleted, 0);
+        }
     }
     
     void Progress::setCompleted(const uint64_t completed) {
         LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        if (_parent) {
+            const uint64_t prevCompleted = _partCompleted, total = _partTotal;
+            _partCompleted = completed;
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            _parent->updateChild(total, total, prevCompleted, completed);
+            return;
+        }
         _partCompleted = completed;
         const auto prevProgress = _progress;
         updateProgress();
-        if (_reportable && prevProgress != _progress) {
+        if (_reportable && prevProgress != _progress && !throttled(false)) {
             const auto report = reportData();
             LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
             report.report();
@@ -142,10 +213,17 @@ namespace plzma {
     
     void Progress::setTotal(const uint64_t total) {
         LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        if (_parent) {
+            const uint64_t prevTotal = _partTotal, completed = _partCompleted;
+            _partTotal = total;
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            _parent->updateChild(prevTotal, total, completed, completed);
+            return;
+        }
         _partTotal = total;
         const auto prevProgress = _progress;
         updateProgress();
-        if (_reportable && prevProgress != _progress) {
+        if (_reportable && prevProgress != _progress && !throttled(false)) {
             const auto report = reportData();
             LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
             report.report();
@@ -154,11 +232,18 @@ namespace plzma {
     
     void Progress::finish() {
         LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
+        if (_parent) {
+            const uint64_t prevCompleted = _partCompleted, total = _partTotal;
+            _partCompleted = total;
+            LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
+            _parent->updateChild(total, total, prevCompleted, total);
+            return;
+        }
         _partNumber = _partsCount;
         _partCompleted = _partTotal;
         const auto prevProgress = _progress;
         updateProgress();
-        if (_reportable && prevProgress != _progress) {
+        if (_reportable && prevProgress != _progress && !throttled(false)) {
             const auto report = reportData();
             LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
             report.report();
@@ -166,9 +251,14 @@ namespace plzma {
     }
     
     void Progress::setPath(Path && path) {
+        if (_parent) {
+            _parent->setPath(static_cast<Path &&>(path));
+            return;
+        }
+        auto reportPath = makeShared<ReportPath>(static_cast<Path &&>(path));
         LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
-        _path = static_cast<Path &&>(path);
-        if (_reportable) {
+        _path = static_cast<SharedPtr<ReportPath> &&>(reportPath);
+        if (_reportable && !throttled(true)) {
             const auto report = reportData();
             LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
             report.report();
@@ -176,15 +266,35 @@ namespace plzma {
     }
     
     void Progress::setPath(const Path & path) {
+        if (_parent) {
+            _parent->setPath(path);
+            return;
+        }
+        auto reportPath = makeShared<ReportPath>(path);
         LIBPLZMA_UNIQUE_LOCK(lock, _mutex)
-        _path = path;
-        if (_reportable) {
+        _path = static_cast<SharedPtr<ReportPath> &&>(reportPath);
+        if (_reportable && !throttled(true)) {
             const auto report = reportData();
             LIBPLZMA_UNIQUE_LOCK_UNLOCK(lock)
             report.report();
         }
     }
     
+    SharedPtr<Progress> Progress::makeConcurrent(const SharedPtr<Progress> & source) {
+        SharedPtr<Progress> progress(makeShared<Progress>(plzma_context{nullptr, nullptr}));
+        progress->_source = source; // retained before the lock, the retain locks the same mutex
+        Progress * sourceProgress = progress->_source.get();
+        LIBPLZMA_LOCKGUARD(lock, sourceProgress->_mutex)
+        progress->_context.context = sourceProgress->_context.context; // deinitialized by the source
+        progress->_delegate = sourceProgress->_delegate;
+#if !defined(LIBPLZMA_NO_C_BINDINGS)
+        progress->_utf8Callback = sourceProgress->_utf8Callback;
+        progress->_wideCallback = sourceProgress->_wideCallback;
+#endif
+        progress->_reportable = progress->calculateReportable();
+        return progress;
+    }
+    
     Progress::~Progress() noexcept {
         if (_context.context && _context.deinitializer) {
             _context.deinitializer(_context.context);
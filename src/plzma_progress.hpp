@@ -42,9 +42,39 @@ namespace plzma {
     private:
         friend struct SharedPtr<Progress>;
         
+        /// The immutable path of the current item shared by the reports.
+        /// Both UTF-8 and wide presentations are converted once, before the first report.
+        class ReportPath final {
+        private:
+            friend struct SharedPtr<ReportPath>;
+            LIBPLZMA_MUTEX(_mutex)
+            uint16_t _referenceCounter = 0;
+            
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            void retain() noexcept;
+            void release() noexcept;
+#else
+            void retain();
+            void release();
+#endif
+            
+        protected:
+            LIBPLZMA_NON_COPYABLE_NON_MOVABLE(ReportPath)
+            
+        public:
+            Path path;
+            bool converted = false;
+            
+            ReportPath(Path && p) noexcept : path(static_cast<Path &&>(p)) { }
+            ReportPath(const Path & p) : path(p) { }
+            ~ReportPath() noexcept {
+                path.clear(plzma_erase_zero);
+            }
+        };
+        
         struct ReportData final {
         private:
-            String _path;
+            SharedPtr<ReportPath> _path;
             void * _context = nullptr;
             ProgressDelegate * _delegate = nullptr;
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
@@ -55,15 +85,17 @@ namespace plzma {
             
         public:
             void report() const {
+                const String emptyPath;
+                const String & path = _path ? _path->path : emptyPath;
                 if (_delegate) {
-                    _delegate->onProgress(_context, _path, _progress);
+                    _delegate->onProgress(_context, path, _progress);
                 }
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
                 if (_utf8Callback) {
-                    _utf8Callback(_context, _path.utf8(), _progress);
+                    _utf8Callback(_context, path.utf8(), _progress);
                 }
                 if (_wideCallback) {
-                    _wideCallback(_context, _path.wide(), _progress);
+                    _wideCallback(_context, path.wide(), _progress);
                 }
 #endif
             }
@@ -74,7 +106,7 @@ namespace plzma {
             ReportData() = delete;
             
             ReportData(ReportData && data) noexcept :
-                _path(static_cast<String &&>(data._path)),
+                _path(static_cast<SharedPtr<ReportPath> &&>(data._path)),
                 _context(data._context),
                 _delegate(data._delegate),
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
@@ -83,7 +115,7 @@ namespace plzma {
 #endif
                 _progress(data._progress) { }
             
-            ReportData(const Path & path,
+            ReportData(const SharedPtr<ReportPath> & path,
                        void * context,
                        ProgressDelegate * delegate,
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
@@ -99,14 +131,12 @@ namespace plzma {
                 _wideCallback(wideCallback),
 #endif
                 _progress(progress) { }
-            
-            ~ReportData() noexcept {
-                _path.clear(plzma_erase_zero);
-            }
         };
         
         LIBPLZMA_MUTEX(_mutex)
-        Path _path;
+        SharedPtr<Progress> _parent; // the child progress of a parallel operation accumulates values in the parent.
+        SharedPtr<Progress> _source; // the progress of a concurrent operation keeps the context of the source.
+        SharedPtr<ReportPath> _path;
         plzma_context _context = plzma_context{nullptr, nullptr}; // C2059 = { .context = nullptr, .deinitializer = nullptr }
         ProgressDelegate * _delegate = nullptr;
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
@@ -117,6 +147,8 @@ namespace plzma {
         uint64_t _partTotal = 0;
         double _progress = 0.0;
         double _perPart = 0.0;
+        double _reportedProgress = 0.0;
+        double _reportedTime = -1.0; // never reported
         uint32_t _partsCount = 1;
         uint32_t _partNumber = 0;
         uint16_t _referenceCounter = 0;
@@ -130,9 +162,18 @@ namespace plzma {
         void release();
 #endif
         bool calculateReportable() const noexcept;
+        bool throttled(const bool pathChanged) noexcept;
         void updateProgress() noexcept;
+        void updateChild(const uint64_t prevTotal, const uint64_t total, const uint64_t prevCompleted, const uint64_t completed);
         
-        ReportData reportData() const {
+        ReportData reportData() {
+            ReportPath * path = _path.get();
+            if (path && !path->converted) {
+                // converted under the lock only once, the shared path is never modified after the first report.
+                path->path.utf8();
+                path->path.wide();
+                path->converted = true;
+            }
             return ReportData(_path, _context.context, _delegate,
 #if !defined(LIBPLZMA_NO_C_BINDINGS)
                               _utf8Callback,
@@ -158,7 +199,13 @@ namespace plzma {
         void finish(); // 1.0
         void setPath(Path && path);
         void setPath(const Path & path);
+        
+        /// @brief Creates the independent progress of the concurrent operation, i.e. the extraction
+        /// made while the decoder is busy. Reported via the current delegate and callbacks of the source.
+        static SharedPtr<Progress> makeConcurrent(const SharedPtr<Progress> & source);
+        
         Progress(const plzma_context context) : _context(context) { }
+        Progress(const SharedPtr<Progress> & parent) : _parent(parent) { }
         ~Progress() noexcept;
     };
     
@@ -0,0 +1,132 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <cstddef>
+
+#include "plzma_stats.hpp"
+#include "plzma_common.hpp"
+
+namespace plzma {
+    
+    static uint64_t monotonicMicroseconds(void) noexcept {
+        const uint64_t time = static_cast<uint64_t>(MonotonicTime() * 1000000.0);
+        return (time > 0) ? time : 1; // 0 is reserved for the unset time
+    }
+    
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+    void Stats::retain() noexcept {
+        LIBPLZMA_RETAIN_IMPL(_referenceCounter)
+    }
+    
+    void Stats::release() noexcept {
+        LIBPLZMA_RELEASE_IMPL(_referenceCounter)
+    }
+#else
+    void Stats::retain() {
+        LIBPLZMA_RETAIN_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+    
+    void Stats::release() {
+        LIBPLZMA_RELEASE_LOCKED_IMPL(_referenceCounter, _mutex)
+    }
+#endif
+    
+    void Stats::start(const uint64_t partsCount) noexcept {
+        _inSize.store(0);
+        _outSize.store(0);
+        _itemsCompleted.store(0);
+        _itemsCount.store(0);
+        _partsCount.store(partsCount);
+        _finishTime.store(0);
+        _startTime.store(monotonicMicroseconds());
+    }
+    
+    void Stats::join() noexcept {
+        _partsCount.add(1);
+        _finishTime.store(0); // in progress till the last part
+        if (_startTime.load() == 0) {
+            _startTime.store(monotonicMicroseconds());
+        }
+    }
+    
+    void Stats::finishPart() noexcept {
+        if (_partsCount.load() > 0 && _partsCount.decrement() == 0) {
+            _finishTime.store(monotonicMicroseconds());
+        }
+    }
+    
+    void Stats::finish() noexcept {
+        if (_finishTime.load() == 0) {
+            _partsCount.store(0);
+            _finishTime.store(monotonicMicroseconds());
+        }
+    }
+    
+    void Stats::addSizes(const uint64_t inSize, const uint64_t outSize) noexcept {
+        if (inSize > 0) {
+            _inSize.add(inSize);
+        }
+        if (outSize > 0) {
+            _outSize.add(outSize);
+        }
+    }
+    
+    void Stats::addItemsCount(const uint64_t count) noexcept {
+        _itemsCount.add(count);
+    }
+    
+    void Stats::completeItem() noexcept {
+        _itemsCompleted.add(1);
+    }
+    
+    void Stats::completeAllItems() noexcept {
+        _itemsCompleted.store(_itemsCount.load());
+    }
+    
+    plzma_stats Stats::snapshot() const noexcept {
+        plzma_stats stats{0, 0, 0, 0, 0.0, 0.0};
+        stats.in_size = _inSize.load();
+        stats.out_size = _outSize.load();
+        stats.items_completed = _itemsCompleted.load();
+        stats.items_count = _itemsCount.load();
+        if (stats.in_size > 0) {
+            stats.ratio = static_cast<double>(stats.out_size) / static_cast<double>(stats.in_size);
+        }
+        const uint64_t startTime = _startTime.load();
+        if (startTime > 0) {
+            uint64_t finishTime = _finishTime.load();
+            if (finishTime == 0) {
+                finishTime = monotonicMicroseconds();
+            }
+            if (finishTime > startTime) {
+                stats.elapsed = static_cast<double>(finishTime - startTime) / 1000000.0;
+            }
+        }
+        return stats;
+    }
+    
+} // namespace plzma
@@ -0,0 +1,180 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef __PLZMA_STATS_HPP__
+#define __PLZMA_STATS_HPP__ 1
+
+#include <cstddef>
+
+#include "../libplzma.hpp"
+#include "plzma_private.hpp"
+#include "plzma_mutex.hpp"
+
+#if !defined(LIBPLZMA_THREAD_UNSAFE) && defined(LIBPLZMA_HAVE_STD)
+#include <atomic>
+#endif
+
+namespace plzma {
+    
+    /// @brief The unsigned 64-bit counter, read and modified by different threads without locking.
+    struct AtomicUInt64 final {
+    private:
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        uint64_t _value = 0;
+#elif defined(LIBPLZMA_HAVE_STD)
+        std::atomic<uint64_t> _value{0};
+#elif defined(LIBPLZMA_MSC)
+        volatile LONG64 _value = 0;
+#else
+        uint64_t _value = 0;
+#endif
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(AtomicUInt64)
+        
+    public:
+        uint64_t load() const noexcept {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            return _value;
+#elif defined(LIBPLZMA_HAVE_STD)
+            return _value.load(std::memory_order_relaxed);
+#elif defined(LIBPLZMA_MSC)
+            return static_cast<uint64_t>(::InterlockedCompareExchange64(const_cast<volatile LONG64 *>(&_value), 0, 0));
+#else
+            return __atomic_load_n(&_value, __ATOMIC_RELAXED);
+#endif
+        }
+        
+        void store(const uint64_t value) noexcept {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            _value = value;
+#elif defined(LIBPLZMA_HAVE_STD)
+            _value.store(value, std::memory_order_relaxed);
+#elif defined(LIBPLZMA_MSC)
+            ::InterlockedExchange64(&_value, static_cast<LONG64>(value));
+#else
+            __atomic_store_n(&_value, value, __ATOMIC_RELAXED);
+#endif
+        }
+        
+        void add(const uint64_t value) noexcept {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            _value += value;
+#elif defined(LIBPLZMA_HAVE_STD)
+            _value.fetch_add(value, std::memory_order_relaxed);
+#elif defined(LIBPLZMA_MSC)
+            ::InterlockedExchangeAdd64(&_value, static_cast<LONG64>(value));
+#else
+            __atomic_fetch_add(&_value, value, __ATOMIC_RELAXED);
+#endif
+        }
+        
+        /// @return The incremented value.
+        uint64_t increment() noexcept {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            return ++_value;
+#elif defined(LIBPLZMA_HAVE_STD)
+            return _value.fetch_add(1, std::memory_order_relaxed) + 1;
+#elif defined(LIBPLZMA_MSC)
+            return static_cast<uint64_t>(::InterlockedIncrement64(&_value));
+#else
+            return __atomic_add_fetch(&_value, 1, __ATOMIC_RELAXED);
+#endif
+        }
+        
+        /// @return The decremented value.
+        uint64_t decrement() noexcept {
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+            return --_value;
+#elif defined(LIBPLZMA_HAVE_STD)
+            return _value.fetch_sub(1, std::memory_order_acq_rel) - 1;
+#elif defined(LIBPLZMA_MSC)
+            return static_cast<uint64_t>(::InterlockedDecrement64(&_value));
+#else
+            return __atomic_sub_fetch(&_value, 1, __ATOMIC_ACQ_REL);
+#endif
+        }
+        
+        AtomicUInt64() noexcept = default;
+    };
+    
+    /// @brief The raw counters of the encoder's or decoder's operation.
+    ///
+    /// The counters are updated by the callbacks of the operation and read by any thread without locking.
+    class Stats final {
+    private:
+        friend struct SharedPtr<Stats>;
+        LIBPLZMA_MUTEX(_mutex)
+        AtomicUInt64 _inSize;
+        AtomicUInt64 _outSize;
+        AtomicUInt64 _itemsCompleted;
+        AtomicUInt64 _itemsCount;
+        AtomicUInt64 _partsCount;   // the number of unfinished parts
+        AtomicUInt64 _startTime;    // microseconds of the monotonic clock, 0 - never started
+        AtomicUInt64 _finishTime;   // microseconds of the monotonic clock, 0 - in progress
+        uint16_t _referenceCounter = 0;
+        
+#if defined(LIBPLZMA_THREAD_UNSAFE)
+        void retain() noexcept;
+        void release() noexcept;
+#else
+        void retain();
+        void release();
+#endif
+        
+    protected:
+        LIBPLZMA_NON_COPYABLE_NON_MOVABLE(Stats)
+        
+    public:
+        /// @brief Resets the counters and starts the operation.
+        /// @param partsCount The number of parts, i.e. the callbacks, which finish the operation together.
+        void start(const uint64_t partsCount = 1) noexcept;
+        
+        /// @brief Adds the part of the concurrent operation to the current one, i.e. the extraction made while the decoder is busy.
+        void join() noexcept;
+        
+        /// @brief Finishes the part of the operation, the operation is finished after the last part.
+        void finishPart() noexcept;
+        
+        /// @brief Finishes the operation if it's not finished by the parts, i.e. some of them failed before processing.
+        void finish() noexcept;
+        
+        /// @brief Adds the consumed input and produced output sizes.
+        void addSizes(const uint64_t inSize, const uint64_t outSize) noexcept;
+        
+        void addItemsCount(const uint64_t count) noexcept;
+        void completeItem() noexcept;
+        void completeAllItems() noexcept;
+        
+        plzma_stats snapshot() const noexcept;
+        
+        Stats() = default;
+    };
+    
+} // namespace plzma
+
+#endif // !__PLZMA_STATS_HPP__
@@ -43,6 +43,37 @@ namespace StringConvertUTF {
 
 } // namespace StringConvertUTF
     
+    size_t WideToUTF8(const wchar_t * src, const size_t length, char * dst, const size_t dstSize) {
+        using namespace StringConvertUTF;
+        
+        UTF8 * dstStart = reinterpret_cast<UTF8 *>(dst);
+        UTF8 * dstEnd = dstStart + dstSize - 1; // null-terminator
+        UTF8 * d = dstStart;
+        ConversionResult convRes = sourceIllegal;
+        if (sizeof(wchar_t) == sizeof(UTF32)) {
+            const UTF32 * s = reinterpret_cast<const UTF32 *>(src);
+            convRes = ConvertUTF32toUTF8(&s, s + length, &d, dstEnd, strictConversion);
+            if (convRes != conversionOK) {
+                s = reinterpret_cast<const UTF32 *>(src);
+                d = dstStart;
+                convRes = ConvertUTF32toUTF8(&s, s + length, &d, dstEnd, lenientConversion);
+            }
+        } else if (sizeof(wchar_t) == sizeof(UTF16)) {
+            const UTF16 * s = reinterpret_cast<const UTF16 *>(src);
+            convRes = ConvertUTF16toUTF8(&s, s + length, &d, dstEnd, strictConversion);
+            if (convRes != conversionOK) {
+                s = reinterpret_cast<const UTF16 *>(src);
+                d = dstStart;
+                convRes = ConvertUTF16toUTF8(&s, s + length, &d, dstEnd, lenientConversion);
+            }
+        }
+        if (convRes != conversionOK) {
+            throw Exception(plzma_error_code_internal, "Wide character to UTF8 string conversion.", __FILE__, __LINE__);
+        }
+        *d = 0;
+        return static_cast<size_t>(d - dstStart);
+    }
+    
     void String::moveFrom(String && str, const plzma_erase eraseType) noexcept {
         _ws.erase(eraseType, sizeof(wchar_t) * _size);
         _cs.erase(eraseType, sizeof(char) * _cslen);
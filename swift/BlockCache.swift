@@ -0,0 +1,100 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+import Foundation
+#if SWIFT_PACKAGE
+import libplzma
+#endif
+
+/// The size-bounded cache of the decoded archive blocks, i.e. the solid 7z folders.
+///
+/// The whole decoded content of the block is kept in memory, so the next items of the same block are copied
+/// from the memory instead of decoding the block from the beginning. The least recently used blocks are removed
+/// to fit the capacity. The cache might be shared by the decoders opened on the same archive file.
+/// The encrypted blocks are not cached.
+/// - SeeAlso: `Decoder.setBlockCache(_:)`.
+public final class BlockCache: Sendable {
+    
+    internal let object: plzma_block_cache
+    
+    
+    /// The maximum size in bytes of the decoded content of all blocks. The larger blocks are not cached.
+    /// - Note: Thread-safe.
+    public var capacity: UInt64 {
+        var cache = object
+        return plzma_block_cache_capacity(&cache)
+    }
+    
+    
+    /// The size in bytes of the decoded content of the cached blocks.
+    /// - Note: Thread-safe.
+    public var size: UInt64 {
+        var cache = object
+        return plzma_block_cache_size(&cache)
+    }
+    
+    
+    /// The number of the cached blocks.
+    /// - Note: Thread-safe.
+    public var count: Size {
+        var cache = object
+        return plzma_block_cache_count(&cache)
+    }
+    
+    
+    /// The number of times the requested block was found in the cache.
+    /// - Note: Thread-safe.
+    public var hits: UInt64 {
+        var cache = object
+        return plzma_block_cache_hits(&cache)
+    }
+    
+    
+    /// Removes all cached blocks.
+    /// - Note: Thread-safe.
+    public func clear() {
+        var cache = object
+        plzma_block_cache_clear(&cache)
+    }
+    
+    
+    /// Initializes the empty cache.
+    /// - Parameter capacity: The maximum size in bytes of the decoded content of all blocks.
+    /// - Throws: `Exception` in case if the cache can't be created.
+    public init(capacity: UInt64) throws {
+        let cache = plzma_block_cache_create(capacity)
+        if let exception = cache.exception {
+            throw Exception(object: exception)
+        }
+        object = cache
+    }
+    
+    
+    deinit {
+        var cache = object
+        plzma_block_cache_release(&cache)
+    }
+}
@@ -128,6 +128,62 @@ public final class Decoder: Sendable {
         return Item(object: item)
     }
     
+    
+    /// Receives the table of all archive items.
+    ///
+    /// The table is built once, during the first call after opening, and is shared by the next calls.
+    /// - Returns: The archive item table.
+    /// - Note: The decoder must be opened.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func itemTable() throws -> ItemTable {
+        var decoder = object
+        let table = plzma_decoder_item_table(&decoder)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return ItemTable(object: table)
+    }
+    
+    
+    /// Finds the archive item with a specific path.
+    ///
+    /// The lookup uses the hash index of the archive paths, built once during the first call after opening.
+    /// - Parameter path: The path of the item inside the archive, i.e. 'dir/file.txt'.
+    /// - Returns: The first archive item with exactly the same path or `nil` if there is no such item.
+    /// - Note: The decoder must be opened.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func findItem(path: Path) throws -> Item? {
+        var decoder = object
+        var pathObject = path.object
+        let item = plzma_decoder_find_item(&decoder, &pathObject)
+        if let exception = item.exception {
+            throw Exception(object: exception)
+        }
+        return item.object != nil ? Item(object: item) : nil
+    }
+    
+    
+    /// Finds all archive items with the paths matching the glob pattern.
+    ///
+    /// The '*' matches any sequence of characters including the path separators, the '?' matches any single character.
+    /// The prefix lookup is the pattern with a trailing '*', i.e. 'dir/*'.
+    /// - Parameter pattern: The glob pattern of the paths inside the archive.
+    /// - Returns: The array with the matching items ordered by index.
+    /// - Note: The decoder must be opened.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func findItems(pattern: Path) throws -> ItemArray {
+        var decoder = object
+        var patternObject = pattern.object
+        let items = plzma_decoder_find_items(&decoder, &patternObject)
+        if let exception = items.exception {
+            throw Exception(object: exception)
+        }
+        return ItemArray(object: items)
+    }
+    
     // MARK: - Extracting
     
     /// Extracts all archive items to a specific path.
@@ -184,6 +240,93 @@ public final class Decoder: Sendable {
         return result
     }
     
+    /// Extracts archive items into a single contiguous memory arena owned by the decoder.
+    ///
+    /// The arena is allocated once with the total size of the items and each item is decoded directly to it's own region.
+    /// The arena data follows the archive order, the views follow the order of the `items` array, which is not modified.
+    /// - Parameter items: The array of items to extract.
+    /// - Note: The previous arena content is released only after a successful extraction.
+    /// - Note: Returns `false` if the decoder is already extracting.
+    /// - Note: The extracting progress might be executed in a separate thread.
+    /// - Note: The extracting progress might be aborted via `abort()` method.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func extractToArena(items: ItemArray) throws -> Bool {
+        var decoder = object
+        var itemsObject = items.object
+        let result = plzma_decoder_extract_items_to_arena(&decoder, &itemsObject)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// - Returns: The number of items of the last extraction to arena.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func arenaCount() throws -> Size {
+        var decoder = object
+        let count = plzma_decoder_arena_views_count(&decoder)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+        return count
+    }
+    
+    
+    /// Receives the content of the extracted item inside the arena memory without copying.
+    /// - Parameter index: The index of the item in the extracted items array. Must be less than the `arenaCount()` value.
+    /// - Returns: The data which references the arena memory.
+    /// - Note: The data is valid until the next extraction to arena or until the decoder exists.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func arenaData(at index: Size) throws -> Data {
+        var decoder = object
+        let view = plzma_decoder_arena_view_at(&decoder, index)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+        guard view.size > 0, let arena = plzma_decoder_arena(&decoder) else {
+            return Data()
+        }
+        return Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: arena.advanced(by: Int(view.offset))), count: Int(view.size), deallocator: .none)
+    }
+    
+    
+    /// Receives the raw counters of the current or last extracting or testing operation.
+    /// - Returns: The snapshot of the counters, read without waiting for the operation.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func stats() throws -> Stats {
+        var decoder = object
+        let result = plzma_decoder_stats(&decoder)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+        return Stats(stats: result)
+    }
+    
+    
+    /// Opens the readable stream of the archive item's content.
+    ///
+    /// The item is decoded in a separate thread, as long as the caller reads the stream.
+    /// The decoder is busy until the stream is read to the end or closed.
+    /// - Parameter item: The item to read.
+    /// - Returns: The item stream or nil if the decoder is not opened or busy.
+    /// - Note: The decoding might be aborted via `abort()` method.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func openItemStream(item: Item) throws -> ItemStream? {
+        var decoder = object
+        var itemObject = item.object
+        let stream = plzma_decoder_open_item_stream(&decoder, &itemObject)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+        return stream.object != nil ? ItemStream(object: stream) : nil
+    }
+    
     //MARK: - Testing
     
     /// Tests specific archive items.
@@ -237,6 +380,89 @@ public final class Decoder: Sendable {
         }
     }
     
+    
+    /// Getter for a number of threads used by the extracting or testing process.
+    /// - Returns: The number of threads. `0` means the number of hardware threads.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func numberOfThreads() throws -> UInt32 {
+        var decoder = object
+        let result = plzma_decoder_number_of_threads(&decoder)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// Setter for a number of threads used by the extracting or testing process.
+    ///
+    /// Applied to the 7z(LZMA2) and xz archives, the tar archives are always extracted in a single thread.
+    /// - Parameter threads: The number of threads. `0`, the default value, means the number of hardware threads.
+    /// - Note: Has no effect if the library was built without `LIBPLZMA_OPT_MULTITHREAD` option.
+    /// - Note: Thread-safe. Must be set before extracting or testing.
+    /// - Throws: `Exception`.
+    public func setNumberOfThreads(_ threads: UInt32) throws {
+        var decoder = object
+        plzma_decoder_set_number_of_threads(&decoder, threads)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+ 
+    
+    /// Getter for a parallel extracting or testing of the independent 7z blocks.
+    /// - Returns: `true` if the blocks are extracted in parallel, the default value is `false`.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func shouldExtractInParallel() throws -> Bool {
+        var decoder = object
+        let result = plzma_decoder_should_extract_in_parallel(&decoder)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// Setter for a parallel extracting or testing of the independent 7z blocks.
+    ///
+    /// The blocks of the requested items are distributed among the worker threads, where each worker has its own clone of the input stream.
+    /// The number of workers is limited by the number of threads value and by the number of the blocks.
+    /// Falls back to the single thread processing for the other archive types, archives with one block or input streams which can't be cloned.
+    /// - Parameter parallel: Extract or test in parallel.
+    /// - Note: Thread-safe. Must be set before extracting or testing.
+    /// - Throws: `Exception`.
+    public func setShouldExtractInParallel(_ parallel: Bool) throws {
+        var decoder = object
+        plzma_decoder_set_should_extract_in_parallel(&decoder, parallel)
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Provides the cache of the decoded blocks for extracting the items of the 7z archive to the output streams.
+    ///
+    /// The block of the requested item is decoded once to the memory and kept in the cache, the next requested items
+    /// of the same block are copied from the memory. Only the `extract(itemsToStreams:)` method uses the cache,
+    /// the items extracted to the paths or to the arena, tested or read via the item stream are decoded as usual,
+    /// so as the encrypted blocks and the blocks larger than the capacity of the cache.
+    /// - Parameter cache: The cache, possibly shared with the other decoders, or `nil` to disable the caching.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func setBlockCache(_ cache: BlockCache?) throws {
+        var decoder = object
+        if var cacheObject = cache?.object {
+            plzma_decoder_set_block_cache(&decoder, &cacheObject)
+        } else {
+            plzma_decoder_set_block_cache(&decoder, nil)
+        }
+        if let exception = decoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
     /// Initializes the decoder.
     /// - Parameter stream: The input stream with archive file content.
     ///                     After successful opening, the input stream will be opened as long as a decoder exists.
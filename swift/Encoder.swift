@@ -98,6 +98,40 @@ public final class Encoder: Sendable {
         return result
     }
     
+    
+    /// Receives the raw counters of the current or last compressing operation.
+    /// - Returns: The snapshot of the counters, read without waiting for the operation.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func stats() throws -> Stats {
+        var encoder = object
+        let result = plzma_encoder_stats(&encoder)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+        return Stats(stats: result)
+    }
+    
+    
+    /// Opens the push session of the xz or tar archive with the items, which content is written by the caller.
+    ///
+    /// The encoder is opened and compresses in a separate thread, which reads the content of the session items in order.
+    /// - Parameter items: The array of items with the archive paths. The item's size `0` means unknown size,
+    /// the tar archive of items with unknown size requires the seekable output stream, not the `OutStream(sequentialStream:)`. The xz archive supports exactly one item.
+    /// - Returns: The session or nil if the encoder was aborted.
+    /// - Note: The encoder must not be opened and must not have added paths or streams.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func openSession(items: ItemArray) throws -> EncoderSession? {
+        var encoder = object
+        var itemsObject = items.object
+        let session = plzma_encoder_open_session(&encoder, &itemsObject)
+        if let exception = session.exception {
+            throw Exception(object: exception)
+        }
+        return session.object != nil ? EncoderSession(object: session) : nil
+    }
+    
     // MARK: - Add data
     
     /// Adds the physical file or directory path to the encoder.
@@ -147,6 +181,67 @@ public final class Encoder: Sendable {
         }
     }
     
+    
+    /// Provides the existing archive of the same type to update.
+    ///
+    /// The items of the existing archive are copied to the output stream without recompression,
+    /// the added paths and streams with the same archive path replace the existing items.
+    /// - Parameter stream: The seekable input stream of the existing archive. nil means no update.
+    /// - Note: Supported by the 7z and tar archives. The output stream must not write to the updated archive.
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception`.
+    public func setUpdateArchive(_ stream: InStream?) throws {
+        var encoder = object
+        if let stream = stream {
+            var streamObject = stream.object
+            plzma_encoder_set_update_archive(&encoder, &streamObject)
+        } else {
+            plzma_encoder_set_update_archive(&encoder, nil)
+        }
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Removes the item of the updated archive.
+    ///
+    /// The content of the remaining items is copied without recompression,
+    /// only the solid blocks containing the removed items are recompressed.
+    /// The directory path removes all nested items, all items with the duplicated path are removed.
+    /// - Parameter archivePath: The path of the existing item or directory in archive. Empty path is not allowed.
+    /// - Note: Requires the updated archive, see `setUpdateArchive`.
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception`.
+    public func remove(archivePath: Path) throws {
+        var encoder = object
+        var archivePathObject = archivePath.object
+        plzma_encoder_remove(&encoder, &archivePathObject)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Renames the item of the updated archive without recompression of the content.
+    ///
+    /// The directory path renames all nested items, all items with the duplicated path are renamed.
+    /// The opening fails in case if the new path collides with the path of the existing, renamed or added item.
+    /// - Parameter archivePath: The path of the existing item or directory in archive. Empty path is not allowed.
+    /// - Parameter newArchivePath: The new path of the item in archive. Empty path is not allowed.
+    /// - Note: Requires the updated archive, see `setUpdateArchive`.
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception`.
+    public func rename(archivePath: Path, to newArchivePath: Path) throws {
+        var encoder = object
+        var archivePathObject = archivePath.object
+        var newArchivePathObject = newArchivePath.object
+        plzma_encoder_rename(&encoder, &archivePathObject, &newArchivePathObject)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
     // MARK: - Properties
     
     /// Provides the password for archive.
@@ -225,6 +320,122 @@ public final class Encoder: Sendable {
     }
     
     
+    /// Getter for a number of threads used by the compressing process.
+    /// - Returns: The number of threads. `0` means the number of hardware threads.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func numberOfThreads() throws -> UInt32 {
+        var encoder = object
+        let result = plzma_encoder_number_of_threads(&encoder)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// Setter for a number of threads used by the compressing process.
+    ///
+    /// Applied to the 7z and xz archives, the tar archives are always created in a single thread.
+    /// - Parameter threads: The number of threads. `0`, the default value, means the number of hardware threads.
+    /// - Note: Has no effect if the library was built without `LIBPLZMA_OPT_MULTITHREAD` option.
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception`.
+    public func setNumberOfThreads(_ threads: UInt32) throws {
+        var encoder = object
+        plzma_encoder_set_number_of_threads(&encoder, threads)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Getter for the properties of the `LZMA` and `LZMA2` compression methods.
+    /// - Returns: The properties, by default, all of them are defined by the compression level.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func methodProperties() throws -> MethodProperties {
+        var encoder = object
+        let result = plzma_encoder_method_properties(&encoder)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+        return MethodProperties(properties: result)
+    }
+    
+    
+    /// Setter for the properties of the `LZMA` and `LZMA2` compression methods.
+    ///
+    /// Applied to the 7z archives with `LZMA` or `LZMA2` method and to the xz archives.
+    /// - Parameter properties: The properties to validate and apply.
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception` if any property is out of range or not supported by the method, i.e. `PPMd` method or `LZMA` block size.
+    public func setMethodProperties(_ properties: MethodProperties) throws {
+        var encoder = object
+        var methodProperties = properties.properties
+        plzma_encoder_set_method_properties(&encoder, &methodProperties)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Getter for the filter which preprocesses the content before the compression method.
+    /// - Returns: The filter, by default, the `.auto`.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func filter() throws -> Filter {
+        var encoder = object
+        let result = plzma_encoder_filter(&encoder)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+        return result.type
+    }
+    
+    
+    /// Setter for the filter which preprocesses the content before the compression method.
+    ///
+    /// Applied to the 7z and xz archives, ignored by the tar archives.
+    /// - Parameter filter: The filter.
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception` if the filter is not supported by the archive type, i.e. `BCJ2` and xz archive.
+    public func setFilter(_ filter: Filter) throws {
+        var encoder = object
+        plzma_encoder_set_filter(&encoder, filter.type)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Getter for the distance of the `Delta` filter.
+    /// - Returns: The distance in bytes, by default, `1`.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func filterDeltaDistance() throws -> UInt32 {
+        var encoder = object
+        let result = plzma_encoder_filter_delta_distance(&encoder)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// Setter for the distance of the `Delta` filter, i.e. the size of the row of the tabular data.
+    /// - Parameter distance: The distance in bytes in a range [1; 256].
+    /// - Note: Thread-safe. Must be set before opening.
+    /// - Throws: `Exception` if the distance is out of range.
+    public func setFilterDeltaDistance(_ distance: UInt32) throws {
+        var encoder = object
+        plzma_encoder_set_filter_delta_distance(&encoder, distance)
+        if let exception = encoder.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
     /// Should encoder compress the archive header.
     /// - Note: Enabled by default, the value is `true`.
     /// - Note: Thread-safe.
@@ -0,0 +1,121 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+import Foundation
+#if SWIFT_PACKAGE
+import libplzma
+#endif
+
+/// The push session of the xz or tar archive, the content of the session items is written by the caller.
+///
+/// The written chunk is consumed directly by the encoder, so the memory usage doesn't depend on the item's size.
+/// The unfinished session is aborted during the deinitialization.
+/// - SeeAlso: `Encoder.openSession(items:)`.
+public final class EncoderSession: Sendable {
+    
+    internal let object: plzma_encoder_session
+    
+    
+    /// Writes the chunk of the current item's content, blocks until the chunk is consumed by the encoder.
+    /// - Parameter buffer: The chunk to write.
+    /// - Parameter length: The size in bytes of the chunk.
+    /// - Returns: `true` if the chunk was written, `false` if the compression was aborted.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if there is no item to write or the compression failed.
+    public func write(_ buffer: UnsafeRawPointer, length: Size) throws -> Bool {
+        var session = object
+        let result = plzma_encoder_session_write(&session, buffer, length)
+        if let exception = session.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// Writes the chunk of the current item's content, blocks until the chunk is consumed by the encoder.
+    /// - Parameter data: The chunk to write.
+    /// - Returns: `true` if the chunk was written, `false` if the compression was aborted.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if there is no item to write or the compression failed.
+    public func write(_ data: Data) throws -> Bool {
+        return try data.withUnsafeBytes({ ptr in
+            guard let address = ptr.baseAddress, ptr.count > 0 else {
+                return true
+            }
+            return try write(address, length: Size(ptr.count))
+        })
+    }
+    
+    
+    /// Ends the content of the current item, the next writes are related to the next item.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func nextItem() throws {
+        var session = object
+        plzma_encoder_session_next_item(&session)
+        if let exception = session.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    /// Ends the content of the remaining items and waits for the end of the compression.
+    /// - Returns: The compression result.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if the compression failed.
+    public func finish() throws -> Bool {
+        var session = object
+        let result = plzma_encoder_session_finish(&session)
+        if let exception = session.exception {
+            throw Exception(object: exception)
+        }
+        return result
+    }
+    
+    
+    /// Aborts the compression and waits for the end of the compression thread.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func abort() throws {
+        var session = object
+        plzma_encoder_session_abort(&session)
+        if let exception = session.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    internal init(object: plzma_encoder_session) {
+        self.object = object
+    }
+    
+    
+    deinit {
+        var session = object
+        plzma_encoder_session_release(&session)
+    }
+}
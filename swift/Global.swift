@@ -82,3 +82,49 @@ public var decoderWriteSize: Size {
         plzma_set_decoder_write_size(newValue)
     }
 }
+
+
+/// The minimum interval in seconds between two progress reports of the encoder or decoder.
+/// Default: 0, i.e. every change of the progress is reported.
+/// - Note: The completion of the operation is always reported.
+public var progressMinInterval: Double {
+    get {
+        return plzma_progress_min_interval()
+    }
+    set {
+        plzma_set_progress_min_interval(newValue)
+    }
+}
+
+
+/// The minimum increment of the progress value between two progress reports of the encoder or decoder.
+/// Default: 0, i.e. every change of the progress is reported.
+/// - Note: The path changes and the completion of the operation are not affected by this value.
+public var progressMinDelta: Double {
+    get {
+        return plzma_progress_min_delta()
+    }
+    set {
+        plzma_set_progress_min_delta(newValue)
+    }
+}
+
+
+/// Checks or selects the LZMA/LZMA2 decoder kernel: the optimized assembler kernel or the portable C kernel.
+/// - Note: The selection is global. Change it only while there are no active decoders.
+/// Always `false` if the library was built without the optimized kernel for the current target.
+public var lzmaDecoderOptimized: Bool {
+    get {
+        return plzma_lzma_decoder_optimized()
+    }
+    set {
+        plzma_set_lzma_decoder_optimized(newValue)
+    }
+}
+
+
+/// The hardware or assembler kernels currently used by the library.
+/// The CRC32, CRC64, SHA-256 and AES kernels are selected once via the CPUID during the library initialization.
+public var kernels: Kernels {
+    return Kernels(rawValue: plzma_kernels())
+}
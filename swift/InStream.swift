@@ -43,6 +43,13 @@ public final class InStream: Sendable {
         }
     }
     
+    private final class SequentialStreamContext {
+        let stream: Foundation.InputStream
+        init(_ s: Foundation.InputStream) {
+            stream = s
+        }
+    }
+    
     internal let object: plzma_in_stream
     
     
@@ -105,6 +112,39 @@ public final class InStream: Sendable {
     }
     
     
+    /// Initializes the input file stream with path, which reads the file content via memory mapping.
+    ///
+    /// The whole file is mapped to the address space during the opening, the reading doesn't require a system call
+    /// and the intermediate buffering. If the file can't be mapped, the stream reads the file as a regular file stream.
+    /// - Parameter mappedPath: The non-empty input file path.
+    /// - Note: The file should not be truncated while the stream is opened.
+    /// - Throws: `Exception` with `.invalidArguments` code in case if path is empty.
+    public init(mappedPath path: Path) throws {
+        var pathObject = path.object
+        let stream = plzma_in_stream_create_mapped_with_path(&pathObject)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+        object = stream
+    }
+    
+    
+    /// Initializes the input file stream with path, which reads the file content via positional reads of the file descriptor.
+    ///
+    /// The reading doesn't use the file position and the intermediate buffering. The clones of the stream, i.e. used
+    /// by the decoder for extracting in parallel, share a single descriptor and read the file at the same time without locking.
+    /// - Parameter positionalPath: The non-empty input file path.
+    /// - Throws: `Exception` with `.invalidArguments` code in case if path is empty.
+    public init(positionalPath path: Path) throws {
+        var pathObject = path.object
+        let stream = plzma_in_stream_create_positional_with_path(&pathObject)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+        object = stream
+    }
+    
+    
     /// Initializes the input file stream with the file data.
     /// During the creation, the data will copyed.
     /// - Parameter dataCopy: The file data.
@@ -211,6 +251,54 @@ public final class InStream: Sendable {
     }
     
     
+    /// Initializes the sequential input stream with the Foundation input stream, i.e. the stream of a pipe or a network response body.
+    /// The stream is read only once from the beginning to the end, without seeking and without the intermediate temporary file.
+    /// - Parameter sequentialStream: The Foundation input stream to read. The stream is opened and closed by the decoder.
+    /// - Note: Only the tar and xz archives can be decoded from the sequential stream, the decoder extracts or tests the items once.
+    ///         The items of the tar archive are unknown until extracting or testing, the number of the items of the opened decoder is zero.
+    /// - Throws: `Exception`.
+    public init(sequentialStream: Foundation.InputStream) throws {
+        let context = SequentialStreamContext(sequentialStream)
+        let unmanagedContext = Unmanaged<SequentialStreamContext>.passRetained(context)
+        let contextObject = plzma_context(context: unmanagedContext.toOpaque()) { unmanagedContext in
+            Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).release()
+        }
+        let stream = plzma_in_stream_create_sequential_with_callbacks({ unmanagedContext in
+            guard let unmanagedContext = unmanagedContext else {
+                return false
+            }
+            let context = Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).takeUnretainedValue()
+            if context.stream.streamStatus == .notOpen {
+                context.stream.open()
+            }
+            return context.stream.streamStatus != .error
+        }, { unmanagedContext in
+            guard let unmanagedContext = unmanagedContext else {
+                return
+            }
+            let context = Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).takeUnretainedValue()
+            context.stream.close()
+        }, { (unmanagedContext, data, size, processedSize) -> Bool in
+            guard let unmanagedContext = unmanagedContext else {
+                return false
+            }
+            let context = Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).takeUnretainedValue()
+            let readSize = context.stream.read(data.assumingMemoryBound(to: UInt8.self), maxLength: Int(size))
+            if readSize < 0 {
+                processedSize.pointee = 0
+                return false
+            }
+            processedSize.pointee = UInt32(readSize)
+            return true
+        }, contextObject)
+        if let exception = stream.exception {
+            unmanagedContext.release()
+            throw Exception(object: exception)
+        }
+        object = stream
+    }
+    
+    
     /// Initializes multi input stream with an array of input streams.
     /// The array should not be empty. The order: file.001, file.002, ..., file.XXX
     /// - Parameter streams: The non-empty array of input streams. Each stream inside array should also exist.
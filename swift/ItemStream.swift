@@ -0,0 +1,124 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+import Foundation
+#if SWIFT_PACKAGE
+import libplzma
+#endif
+
+/// The readable stream of the archive item's content.
+///
+/// The content is decoded lazily, only when the stream is read, so the memory usage doesn't depend on the item's size.
+/// The stream is closed during the deinitialization.
+/// - SeeAlso: `Decoder.openItemStream(item:)`.
+public final class ItemStream: Sendable {
+    
+    internal let object: plzma_item_stream
+    
+    
+    /// The item of the stream.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func item() throws -> Item {
+        var stream = object
+        let item = plzma_item_stream_item(&stream)
+        if let exception = item.exception {
+            throw Exception(object: exception)
+        }
+        return Item(object: item)
+    }
+    
+    
+    /// The number of bytes read from the stream.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func position() throws -> UInt64 {
+        var stream = object
+        let position = plzma_item_stream_position(&stream)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+        return position
+    }
+    
+    
+    /// Reads the next portion of the item's content, blocks until the content is decoded.
+    /// - Parameter buffer: The buffer to read to.
+    /// - Parameter maxLength: The size in bytes of the buffer.
+    /// - Returns: The number of bytes read or 0 if the whole content was read or the stream is closed.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if the item's content can't be decoded.
+    public func read(_ buffer: UnsafeMutableRawPointer, maxLength: Size) throws -> Size {
+        var stream = object
+        let readed = plzma_item_stream_read(&stream, buffer, maxLength)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+        return readed
+    }
+    
+    
+    /// Reads the next portion of the item's content, blocks until the content is decoded.
+    /// - Parameter maxLength: The maximum number of bytes to read.
+    /// - Returns: The data with read content. The data is empty if the whole content was read or the stream is closed.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if the item's content can't be decoded.
+    public func read(maxLength: Size) throws -> Data {
+        var data = Data(count: Int(maxLength))
+        let readed: Size = try data.withUnsafeMutableBytes({ ptr in
+            guard let address = ptr.baseAddress else {
+                return 0
+            }
+            return try read(address, maxLength: maxLength)
+        })
+        data.count = Int(readed)
+        return data
+    }
+    
+    
+    /// Stops the decoding and closes the stream. The remaining content is skipped.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception`.
+    public func close() throws {
+        var stream = object
+        plzma_item_stream_close(&stream)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+    }
+    
+    
+    internal init(object: plzma_item_stream) {
+        self.object = object
+    }
+    
+    
+    deinit {
+        var stream = object
+        plzma_item_stream_release(&stream)
+    }
+}
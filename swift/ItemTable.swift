@@ -0,0 +1,163 @@
+//
+// By using this Software, you are accepting original [LZMA SDK] and MIT license below:
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2015 - 2026 Oleh Kulykov <olehkulykov@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+import Foundation
+#if SWIFT_PACKAGE
+import libplzma
+#endif
+
+/// The read-only table of the archive items.
+///
+/// The properties of the items are stored by columns, listing of the huge archives doesn't allocate the object per item.
+/// The `Item` objects are created only on demand via `item(at:)` method.
+/// - SeeAlso: `Decoder.itemTable()`.
+public final class ItemTable: Sendable {
+    
+    internal let object: plzma_item_table
+    
+    
+    /// The number of items in the table, i.e. in the archive.
+    /// - Note: Thread-safe.
+    public var count: Size {
+        var table = object
+        return plzma_item_table_count(&table)
+    }
+    
+    
+    /// The path of the item at index.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func path(at index: Size) throws -> String {
+        var table = object
+        let path = plzma_item_table_path_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return path.map { String(cString: $0) } ?? ""
+    }
+    
+    
+    /// The size in bytes of the item at index.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func size(at index: Size) throws -> UInt64 {
+        var table = object
+        let size = plzma_item_table_size_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return size
+    }
+    
+    
+    /// The packed size in bytes of the item at index.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func packSize(at index: Size) throws -> UInt64 {
+        var table = object
+        let size = plzma_item_table_pack_size_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return size
+    }
+    
+    
+    /// The CRC32 checksum of the item at index.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func crc32(at index: Size) throws -> UInt32 {
+        var table = object
+        let crc32 = plzma_item_table_crc32_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return crc32
+    }
+    
+    
+    /// The creation, last access and last modification unix timestamps of the item at index.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func timestamp(at index: Size) throws -> plzma_path_timestamp {
+        var table = object
+        let timestamp = plzma_item_table_timestamp_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return timestamp
+    }
+    
+    
+    /// Checks the item at index is encrypted.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func encrypted(at index: Size) throws -> Bool {
+        var table = object
+        let encrypted = plzma_item_table_encrypted_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return encrypted
+    }
+    
+    
+    /// Checks the item at index is directory.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func isDir(at index: Size) throws -> Bool {
+        var table = object
+        let isDir = plzma_item_table_is_dir_at(&table, index)
+        if let exception = table.exception {
+            throw Exception(object: exception)
+        }
+        return isDir
+    }
+    
+    
+    /// Creates the item with the properties of the table's item at index.
+    /// - Note: Thread-safe.
+    /// - Throws: `Exception` in case if index is out of bounds.
+    public func item(at index: Size) throws -> Item {
+        var table = object
+        let item = plzma_item_table_item_at(&table, index)
+        if let exception = item.exception {
+            throw Exception(object: exception)
+        }
+        return Item(object: item)
+    }
+    
+    
+    internal init(object: plzma_item_table) {
+        self.object = object
+    }
+    
+    
+    deinit {
+        var table = object
+        plzma_item_table_release(&table)
+    }
+}
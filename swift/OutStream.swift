@@ -33,6 +33,13 @@ import libplzma
 /// The out file or memory or multi stream.
 public class OutStream: @unchecked Sendable {
     
+    private final class SequentialStreamContext {
+        let stream: Foundation.OutputStream
+        init(_ s: Foundation.OutputStream) {
+            stream = s
+        }
+    }
+    
     internal let object: plzma_out_stream
     
     internal var isMulti: Bool {
@@ -130,6 +137,67 @@ public class OutStream: @unchecked Sendable {
     }
     
     
+    /// Initializes the output file stream object for writing to memory with preallocated memory.
+    /// - Parameter expectedSize: The expected size in bytes of the stream's content. The memory grows if the content is larger.
+    /// - Throws: `Exception`.
+    public init(expectedSize: UInt64) throws {
+        let stream = plzma_out_stream_create_memory_stream_with_expected_size(expectedSize)
+        if let exception = stream.exception {
+            throw Exception(object: exception)
+        }
+        object = stream
+    }
+    
+    
+    /// Initializes the sequential output stream with the Foundation output stream, i.e. the stream of a pipe or a network request body.
+    /// The content is written only once from the beginning to the end, without seeking.
+    /// - Parameter sequentialStream: The Foundation output stream to write. The stream is opened and closed by the encoder.
+    /// - Note: Only the xz archive and the tar archive with the known sizes of the items can be encoded to the sequential stream.
+    /// - Throws: `Exception`.
+    public init(sequentialStream: Foundation.OutputStream) throws {
+        let context = SequentialStreamContext(sequentialStream)
+        let unmanagedContext = Unmanaged<SequentialStreamContext>.passRetained(context)
+        let contextObject = plzma_context(context: unmanagedContext.toOpaque()) { unmanagedContext in
+            Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).release()
+        }
+        let stream = plzma_out_stream_create_sequential_with_callbacks({ unmanagedContext in
+            guard let unmanagedContext = unmanagedContext else {
+                return false
+            }
+            let context = Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).takeUnretainedValue()
+            if context.stream.streamStatus == .notOpen {
+                context.stream.open()
+            }
+            return context.stream.streamStatus != .error
+        }, { unmanagedContext in
+            guard let unmanagedContext = unmanagedContext else {
+                return
+            }
+            let context = Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).takeUnretainedValue()
+            context.stream.close()
+        }, { (unmanagedContext, data, size) -> Bool in
+            guard let unmanagedContext = unmanagedContext else {
+                return false
+            }
+            let context = Unmanaged<SequentialStreamContext>.fromOpaque(unmanagedContext).takeUnretainedValue()
+            var offset = 0
+            while offset < Int(size) {
+                let written = context.stream.write(data.advanced(by: offset).assumingMemoryBound(to: UInt8.self), maxLength: Int(size) - offset)
+                if written <= 0 {
+                    return false
+                }
+                offset += written
+            }
+            return true
+        }, contextObject)
+        if let exception = stream.exception {
+            unmanagedContext.release()
+            throw Exception(object: exception)
+        }
+        object = stream
+    }
+    
+    
     deinit {
         var stream = object
         plzma_out_stream_release(&stream)
@@ -155,6 +155,181 @@ extension plzma_method: Enum, @retroactive @unchecked Sendable {
     public typealias EType = Method
 }
 
+/// Match finder of the `LZMA` and `LZMA2` compression methods.
+public enum MatchFinder: UInt8, Enum, Sendable {
+    
+    public typealias EType = plzma_match_finder
+    
+    /// The match finder defined by the compression level.
+    case `default` = 0
+    
+    /// Binary tree with 2 bytes hashing.
+    case bt2 = 1
+    
+    /// Binary tree with 3 bytes hashing.
+    case bt3 = 2
+    
+    /// Binary tree with 4 bytes hashing.
+    case bt4 = 3
+    
+    /// Binary tree with 5 bytes hashing.
+    case bt5 = 4
+    
+    /// Hash chain with 4 bytes hashing. Faster than binary tree, but with worse compression ratio.
+    case hc4 = 5
+    
+    /// Hash chain with 5 bytes hashing.
+    case hc5 = 6
+}
+
+extension plzma_match_finder: Enum, @retroactive @unchecked Sendable {
+    
+    public typealias EType = MatchFinder
+}
+
+/// Filter which preprocesses the content before the compression method to get a better compression ratio.
+///
+/// The branch converters(`BCJ`, `BCJ2`, `ARM64`, etc.) are useful for the executable files of the corresponding architecture,
+/// the `Delta` filter is useful for the tabular data with the fixed size rows, i.e. sensors data, uncompressed images or audio.
+public enum Filter: UInt8, Enum, Sendable {
+    
+    public typealias EType = plzma_filter
+    
+    /// The 7z archive automatically selects the branch converter for the executable files,
+    /// the xz archive doesn't use any filter.
+    case auto = 0
+    
+    /// Do not use any filter, including the automatic selection.
+    case none = 1
+    
+    /// Branch converter for the x86 and x86-64 executables.
+    case BCJ = 2
+    
+    /// Improved branch converter for the x86 and x86-64 executables with separated streams.
+    /// - Note: Supported only by the 7z archive and requires the library built with `LIBPLZMA_OPT_MULTITHREAD` option.
+    case BCJ2 = 3
+    
+    /// Branch converter for the ARM64 executables.
+    case ARM64 = 4
+    
+    /// Branch converter for the ARM(little-endian) executables.
+    case ARM = 5
+    
+    /// Branch converter for the ARM Thumb executables.
+    case ARMT = 6
+    
+    /// Branch converter for the PowerPC(big-endian) executables.
+    case PPC = 7
+    
+    /// Branch converter for the SPARC executables.
+    case SPARC = 8
+    
+    /// Branch converter for the Itanium executables.
+    case IA64 = 9
+    
+    /// Branch converter for the RISC-V executables.
+    case RISCV = 10
+    
+    /// Delta filter with the distance in bytes defined by the encoder's `filterDeltaDistance`.
+    case Delta = 11
+}
+
+extension plzma_filter: Enum, @retroactive @unchecked Sendable {
+    
+    public typealias EType = Filter
+}
+
+/// The properties of the `LZMA` and `LZMA2` compression methods.
+///
+/// Each non-nil property overrides the value defined by the compression level.
+public struct MethodProperties: Sendable {
+    
+    /// Dictionary size in bytes in a range [4KB; 3840MB].
+    public var dictionarySize: UInt64?
+    
+    /// `LZMA2` block size in bytes, at least 4KB. The `UInt64.max` means a single solid block.
+    /// The size of the blocks defines the number of the independent blocks, i.e. decoding parallelism and memory usage.
+    public var blockSize: UInt64?
+    
+    /// Number of fast bytes(word size) in a range [5; 273].
+    public var wordSize: UInt32?
+    
+    /// Number of cycles of the match finder in a range [1; 1073741824].
+    public var matchFinderCycles: UInt32?
+    
+    /// Match finder.
+    public var matchFinder: MatchFinder = .default
+    
+    /// Number of literal context bits in a range [0; 8]. `LZMA2` allows up to 4 bits for the sum of literal context and position bits.
+    public var literalContextBits: UInt8?
+    
+    /// Number of literal position bits in a range [0; 4].
+    public var literalPositionBits: UInt8?
+    
+    /// Number of position bits in a range [0; 4].
+    public var positionBits: UInt8?
+    
+    /// Initializes the properties, all of them are defined by the compression level.
+    public init() {
+        
+    }
+    
+    internal init(properties: plzma_method_properties) {
+        dictionarySize = properties.dictionary_size > 0 ? properties.dictionary_size : nil
+        blockSize = properties.block_size > 0 ? properties.block_size : nil
+        wordSize = properties.word_size > 0 ? properties.word_size : nil
+        matchFinderCycles = properties.match_finder_cycles > 0 ? properties.match_finder_cycles : nil
+        matchFinder = properties.match_finder.type
+        literalContextBits = properties.literal_context_bits >= 0 ? UInt8(properties.literal_context_bits) : nil
+        literalPositionBits = properties.literal_position_bits >= 0 ? UInt8(properties.literal_position_bits) : nil
+        positionBits = properties.position_bits >= 0 ? UInt8(properties.position_bits) : nil
+    }
+    
+    internal var properties: plzma_method_properties {
+        return plzma_method_properties(dictionary_size: dictionarySize ?? 0,
+                                       block_size: blockSize ?? 0,
+                                       word_size: wordSize ?? 0,
+                                       match_finder_cycles: matchFinderCycles ?? 0,
+                                       match_finder: matchFinder.type,
+                                       literal_context_bits: Int8(clamping: literalContextBits.map { Int($0) } ?? -1),
+                                       literal_position_bits: Int8(clamping: literalPositionBits.map { Int($0) } ?? -1),
+                                       position_bits: Int8(clamping: positionBits.map { Int($0) } ?? -1))
+    }
+}
+
+/// The snapshot of the raw counters of the current or last compressing, extracting or testing operation.
+///
+/// Each counter is read atomically, but the counters are updated independently of each other.
+public struct Stats: Sendable {
+    
+    /// The number of consumed input bytes, i.e. the packed size during decoding or the content size during encoding.
+    public let inSize: UInt64
+    
+    /// The number of produced output bytes, i.e. the content size during decoding or the packed size during encoding.
+    public let outSize: UInt64
+    
+    /// The number of processed items.
+    public let itemsCompleted: UInt64
+    
+    /// The number of items of the operation or `0` if unknown, i.e. the items of the sequential tar archive.
+    public let itemsCount: UInt64
+    
+    /// The ratio of the output to the input size or `0` if nothing was consumed.
+    public let ratio: Double
+    
+    /// The time in seconds since the beginning of the operation up to the current moment or to the end of the operation.
+    public let elapsed: Double
+    
+    internal init(stats: plzma_stats) {
+        inSize = stats.in_size
+        outSize = stats.out_size
+        itemsCompleted = stats.items_completed
+        itemsCount = stats.items_count
+        ratio = stats.ratio
+        elapsed = stats.elapsed
+    }
+}
+
 /// The enumeration with bitmask options for opening directory path.
 /// Currently uses for defining behavior of directory iteration.
 public struct OpenDirMode: OptionSet, Sendable {
@@ -174,6 +349,36 @@ public struct OpenDirMode: OptionSet, Sendable {
     public static let followSymlinks = OpenDirMode(rawValue: 1 << 0)
 }
 
+/// The bitmask of the hardware or assembler kernels selected at runtime.
+public struct Kernels: OptionSet, Sendable {
+    
+    public typealias RawValue = plzma_kernel_t
+    
+    public let rawValue: plzma_kernel_t
+    
+    public init(rawValue: plzma_kernel_t) {
+        self.rawValue = rawValue
+    }
+    
+    /// CRC32 of the 7z archives via the carry-less multiplication(PCLMULQDQ).
+    public static let crc32Clmul = Kernels(rawValue: 1 << 0)
+    
+    /// CRC64 of the xz archives via the carry-less multiplication(PCLMULQDQ).
+    public static let crc64Clmul = Kernels(rawValue: 1 << 1)
+    
+    /// SHA-256 of the 7z AES key derivation via the SHA extensions(SHA-NI).
+    public static let sha256Hardware = Kernels(rawValue: 1 << 2)
+    
+    /// AES of the encrypted 7z archives via the AES instructions(AES-NI).
+    public static let aesHardware = Kernels(rawValue: 1 << 3)
+    
+    /// AES decryption via the 256-bit vector AES instructions(VAES, AVX2).
+    public static let aesHardware256 = Kernels(rawValue: 1 << 4)
+    
+    /// The assembler LZMA/LZMA2 decoder kernel.
+    public static let lzmaDecoderOptimized = Kernels(rawValue: 1 << 5)
+}
+
 public enum MultiStreamPartNameFormat: UInt8, Enum, Sendable {
 
     public typealias EType = plzma_multi_stream_part_name_format